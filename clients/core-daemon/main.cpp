@@ -41,6 +41,7 @@ struct Config {
     std::string rpc_user = "";
     std::string rpc_password = "";
     bool rpc_allow_unauthenticated = false;
+    bool rpc_rest_enabled = false;
     std::string data_dir = "./data";
     std::string log_level = "info";
     bool mining_enabled = false;
@@ -201,6 +202,14 @@ class ConfigParser {
                 } else {
                     config.rpc_allow_unauthenticated = parsed_allow_unauthenticated;
                 }
+            } else if (key == "rpc.rest") {
+                bool parsed_rest = config.rpc_rest_enabled;
+                if (!TryParseBool(scalar_value, parsed_rest)) {
+                    std::cerr << "Warning: Invalid rpc.rest '" << scalar_value
+                              << "'; keeping default" << std::endl;
+                } else {
+                    config.rpc_rest_enabled = parsed_rest;
+                }
             } else if (key == "data_dir") {
                 config.data_dir = scalar_value;
             } else if (key == "log_level") {
@@ -442,6 +451,7 @@ class Node {
             rpc_server_->SetNode(core_node_.get());
             rpc_server_->SetWallet(wallet_.get());
             rpc_server_->ConfigureBasicAuth(config_.rpc_user, config_.rpc_password);
+            rpc_server_->EnableRest(config_.rpc_rest_enabled);
             if (!rpc_server_->Start()) {
                 std::cerr << "Failed to start RPC server" << std::endl;
                 core_node_->Stop();
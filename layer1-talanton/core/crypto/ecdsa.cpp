@@ -0,0 +1,571 @@
+// ParthenonChain - ECDSA Public Key Recovery Implementation
+
+#include "ecdsa.h"
+
+#include "sha256.h"
+
+#include <openssl/bn.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+
+namespace parthenon {
+namespace crypto {
+
+namespace {
+
+__extension__ typedef unsigned __int128 uint128;  // Quiet -Wpedantic
+
+// Element of the field mod p = 2^256 - 2^32 - 977 in little-endian 64-bit
+// limbs. Values stay below 2^256 but not necessarily below p; Normalize()
+// gives the canonical representative.
+struct Fe {
+    uint64_t n[4];
+};
+
+constexpr uint64_t kFold = 0x1000003D1ULL;  // 2^256 mod p
+constexpr uint64_t kP0 = 0xFFFFFFFEFFFFFC2FULL;
+constexpr uint64_t kOnes = ~0ULL;
+
+constexpr Fe kZero = {{0, 0, 0, 0}};
+constexpr Fe kOne = {{1, 0, 0, 0}};
+constexpr Fe kSeven = {{7, 0, 0, 0}};
+
+// r + top * 2^256, folding top * 2^256 back in as top * kFold
+inline void Fold(Fe& r, uint64_t top) {
+    while (top != 0) {
+        uint128 t = static_cast<uint128>(top) * kFold;
+        for (int i = 0; i < 4; ++i) {
+            t += r.n[i];
+            r.n[i] = static_cast<uint64_t>(t);
+            t >>= 64;
+        }
+        top = static_cast<uint64_t>(t);
+    }
+}
+
+inline Fe Add(const Fe& a, const Fe& b) {
+    Fe r;
+    uint128 t = 0;
+    for (int i = 0; i < 4; ++i) {
+        t += static_cast<uint128>(a.n[i]) + b.n[i];
+        r.n[i] = static_cast<uint64_t>(t);
+        t >>= 64;
+    }
+    Fold(r, static_cast<uint64_t>(t));
+    return r;
+}
+
+inline Fe Sub(const Fe& a, const Fe& b) {
+    Fe r;
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        const uint64_t d = a.n[i] - b.n[i];
+        const uint64_t b1 = a.n[i] < b.n[i];
+        r.n[i] = d - borrow;
+        borrow = b1 | (d < borrow);
+    }
+    // Each wrap added 2^256, which is kFold too much
+    while (borrow != 0) {
+        uint64_t sub = kFold;
+        for (int i = 0; i < 4; ++i) {
+            const uint64_t next = r.n[i] < sub;
+            r.n[i] -= sub;
+            sub = next;
+        }
+        borrow = sub;
+    }
+    return r;
+}
+
+inline Fe Mul(const Fe& a, const Fe& b) {
+    uint64_t t[8] = {};
+    for (int i = 0; i < 4; ++i) {
+        uint128 carry = 0;
+        for (int j = 0; j < 4; ++j) {
+            carry += static_cast<uint128>(a.n[i]) * b.n[j] + t[i + j];
+            t[i + j] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
+        t[i + 4] = static_cast<uint64_t>(carry);
+    }
+    Fe r;
+    uint128 c = 0;
+    for (int i = 0; i < 4; ++i) {
+        c += static_cast<uint128>(t[i + 4]) * kFold + t[i];
+        r.n[i] = static_cast<uint64_t>(c);
+        c >>= 64;
+    }
+    Fold(r, static_cast<uint64_t>(c));
+    return r;
+}
+
+// Squaring computes each cross product once
+inline Fe Sqr(const Fe& a) {
+    uint64_t t[8] = {};
+    for (int i = 0; i < 3; ++i) {
+        uint128 carry = 0;
+        for (int j = i + 1; j < 4; ++j) {
+            carry += static_cast<uint128>(a.n[i]) * a.n[j] + t[i + j];
+            t[i + j] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
+        t[i + 4] = static_cast<uint64_t>(carry);
+    }
+    uint64_t top = 0;
+    for (int i = 0; i < 8; ++i) {
+        const uint64_t doubled = (t[i] << 1) | top;
+        top = t[i] >> 63;
+        t[i] = doubled;
+    }
+    uint128 carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        carry += static_cast<uint128>(a.n[i]) * a.n[i] + t[2 * i];
+        t[2 * i] = static_cast<uint64_t>(carry);
+        carry >>= 64;
+        carry += t[2 * i + 1];
+        t[2 * i + 1] = static_cast<uint64_t>(carry);
+        carry >>= 64;
+    }
+    Fe r;
+    uint128 c = 0;
+    for (int i = 0; i < 4; ++i) {
+        c += static_cast<uint128>(t[i + 4]) * kFold + t[i];
+        r.n[i] = static_cast<uint64_t>(c);
+        c >>= 64;
+    }
+    Fold(r, static_cast<uint64_t>(c));
+    return r;
+}
+
+inline Fe SqrN(Fe a, int count) {
+    for (int i = 0; i < count; ++i) {
+        a = Sqr(a);
+    }
+    return a;
+}
+
+inline Fe Normalize(Fe a) {
+    if (a.n[3] == kOnes && a.n[2] == kOnes && a.n[1] == kOnes && a.n[0] >= kP0) {
+        // a - p = a + kFold - 2^256
+        uint128 t = static_cast<uint128>(a.n[0]) + kFold;
+        a.n[0] = static_cast<uint64_t>(t);
+        for (int i = 1; i < 4; ++i) {
+            t = (t >> 64) + a.n[i];
+            a.n[i] = static_cast<uint64_t>(t);
+        }
+    }
+    return a;
+}
+
+inline bool IsZero(const Fe& a) {
+    const Fe n = Normalize(a);
+    return (n.n[0] | n.n[1] | n.n[2] | n.n[3]) == 0;
+}
+
+inline bool Equal(const Fe& a, const Fe& b) {
+    return IsZero(Sub(a, b));
+}
+
+// Below p, so Normalize() leaves it alone
+inline bool IsCanonical(const Fe& a) {
+    const Fe n = Normalize(a);
+    return std::equal(n.n, n.n + 4, a.n);
+}
+
+// a^(2^223 - 1) and a^(2^22 - 1), shared by the inverse and square root
+// addition chains
+inline void PowerBlocks(const Fe& a, Fe& x2, Fe& x22, Fe& x223) {
+    x2 = Mul(Sqr(a), a);
+    const Fe x3 = Mul(Sqr(x2), a);
+    const Fe x6 = Mul(SqrN(x3, 3), x3);
+    const Fe x9 = Mul(SqrN(x6, 3), x3);
+    const Fe x11 = Mul(SqrN(x9, 2), x2);
+    x22 = Mul(SqrN(x11, 11), x11);
+    const Fe x44 = Mul(SqrN(x22, 22), x22);
+    const Fe x88 = Mul(SqrN(x44, 44), x44);
+    const Fe x176 = Mul(SqrN(x88, 88), x88);
+    const Fe x220 = Mul(SqrN(x176, 44), x44);
+    x223 = Mul(SqrN(x220, 3), x3);
+}
+
+// a^(p - 2)
+Fe Invert(const Fe& a) {
+    Fe x2, x22, x223;
+    PowerBlocks(a, x2, x22, x223);
+    Fe t = Mul(SqrN(x223, 23), x22);
+    t = Mul(SqrN(t, 5), a);
+    t = Mul(SqrN(t, 3), x2);
+    return Mul(SqrN(t, 2), a);
+}
+
+// a^((p + 1) / 4): a square root of a if there is one
+Fe SquareRoot(const Fe& a) {
+    Fe x2, x22, x223;
+    PowerBlocks(a, x2, x22, x223);
+    Fe t = Mul(SqrN(x223, 23), x22);
+    t = Mul(SqrN(t, 6), x2);
+    return SqrN(t, 2);
+}
+
+Fe FromBytes(const uint8_t* bytes) {
+    Fe r;
+    for (int i = 0; i < 4; ++i) {
+        uint64_t limb = 0;
+        for (int j = 0; j < 8; ++j) {
+            limb = (limb << 8) | bytes[(3 - i) * 8 + j];
+        }
+        r.n[i] = limb;
+    }
+    return r;
+}
+
+void ToBytes(const Fe& a, uint8_t* bytes) {
+    const Fe n = Normalize(a);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            bytes[(3 - i) * 8 + j] = static_cast<uint8_t>(n.n[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+struct Affine {
+    Fe x, y;
+};
+
+struct Jacobian {
+    Fe x, y, z;
+    bool infinity;
+};
+
+constexpr Jacobian kInfinity = {kZero, kOne, kZero, true};
+
+// dbl-2009-l (a = 0)
+Jacobian Double(const Jacobian& p) {
+    if (p.infinity) {
+        return p;
+    }
+    const Fe a = Sqr(p.x);
+    const Fe b = Sqr(p.y);
+    const Fe c = Sqr(b);
+    Fe d = Sub(Sub(Sqr(Add(p.x, b)), a), c);
+    d = Add(d, d);
+    const Fe e = Add(Add(a, a), a);
+    Fe c8 = Add(c, c);
+    c8 = Add(c8, c8);
+    c8 = Add(c8, c8);
+    Jacobian r;
+    r.infinity = false;
+    r.x = Sub(Sqr(e), Add(d, d));
+    r.y = Sub(Mul(e, Sub(d, r.x)), c8);
+    const Fe yz = Mul(p.y, p.z);
+    r.z = Add(yz, yz);
+    return r;
+}
+
+// madd-2007-bl: p + q with q in affine coordinates
+Jacobian AddAffine(const Jacobian& p, const Affine& q) {
+    if (p.infinity) {
+        return Jacobian{q.x, q.y, kOne, false};
+    }
+    const Fe z1z1 = Sqr(p.z);
+    const Fe u2 = Mul(q.x, z1z1);
+    const Fe s2 = Mul(q.y, Mul(p.z, z1z1));
+    const Fe h = Sub(u2, p.x);
+    Fe rr = Sub(s2, p.y);
+    rr = Add(rr, rr);
+    if (IsZero(h)) {
+        return IsZero(rr) ? Double(p) : kInfinity;
+    }
+    const Fe hh = Sqr(h);
+    Fe i = Add(hh, hh);
+    i = Add(i, i);
+    const Fe j = Mul(h, i);
+    const Fe v = Mul(p.x, i);
+    Jacobian r;
+    r.infinity = false;
+    r.x = Sub(Sub(Sqr(rr), j), Add(v, v));
+    const Fe y1j = Mul(p.y, j);
+    r.y = Sub(Mul(rr, Sub(v, r.x)), Add(y1j, y1j));
+    r.z = Sub(Sub(Sqr(Add(p.z, h)), z1z1), hh);
+    return r;
+}
+
+// add-2007-bl
+Jacobian Add(const Jacobian& p, const Jacobian& q) {
+    if (p.infinity) {
+        return q;
+    }
+    if (q.infinity) {
+        return p;
+    }
+    const Fe z1z1 = Sqr(p.z);
+    const Fe z2z2 = Sqr(q.z);
+    const Fe u1 = Mul(p.x, z2z2);
+    const Fe u2 = Mul(q.x, z1z1);
+    const Fe s1 = Mul(p.y, Mul(q.z, z2z2));
+    const Fe s2 = Mul(q.y, Mul(p.z, z1z1));
+    const Fe h = Sub(u2, u1);
+    Fe rr = Sub(s2, s1);
+    rr = Add(rr, rr);
+    if (IsZero(h)) {
+        return IsZero(rr) ? Double(p) : kInfinity;
+    }
+    const Fe i = Sqr(Add(h, h));
+    const Fe j = Mul(h, i);
+    const Fe v = Mul(u1, i);
+    Jacobian r;
+    r.infinity = false;
+    r.x = Sub(Sub(Sqr(rr), j), Add(v, v));
+    const Fe s1j = Mul(s1, j);
+    r.y = Sub(Mul(rr, Sub(v, r.x)), Add(s1j, s1j));
+    r.z = Mul(Sub(Sub(Sqr(Add(p.z, q.z)), z1z1), z2z2), h);
+    return r;
+}
+
+Affine ToAffine(const Jacobian& p) {
+    const Fe zi = Invert(p.z);
+    const Fe zi2 = Sqr(zi);
+    return Affine{Mul(p.x, zi2), Mul(p.y, Mul(zi2, zi))};
+}
+
+// Window widths: the generator's table is built once, R's per call
+constexpr int kGeneratorWindow = 8;
+constexpr int kPointWindow = 5;
+constexpr int kWnafSize = 256 + kGeneratorWindow + 1;
+
+// Odd multiples G, 3G, ..., (2^(w-1) - 1)G in affine coordinates
+const Affine* GeneratorTable() {
+    static const auto table = []() {
+        static const uint8_t kGx[32] = {
+            0x79, 0xBE, 0x66, 0x7E, 0xF9, 0xDC, 0xBB, 0xAC, 0x55, 0xA0, 0x62,
+            0x95, 0xCE, 0x87, 0x0B, 0x07, 0x02, 0x9B, 0xFC, 0xDB, 0x2D, 0xCE,
+            0x28, 0xD9, 0x59, 0xF2, 0x81, 0x5B, 0x16, 0xF8, 0x17, 0x98};
+        static const uint8_t kGy[32] = {
+            0x48, 0x3A, 0xDA, 0x77, 0x26, 0xA3, 0xC4, 0x65, 0x5D, 0xA4, 0xFB,
+            0xFC, 0x0E, 0x11, 0x08, 0xA8, 0xFD, 0x17, 0xB4, 0x48, 0xA6, 0x85,
+            0x54, 0x19, 0x9C, 0x47, 0xD0, 0x8F, 0xFB, 0x10, 0xD4, 0xB8};
+        std::array<Affine, 1 << (kGeneratorWindow - 2)> odd;
+        const Jacobian g{FromBytes(kGx), FromBytes(kGy), kOne, false};
+        const Jacobian g2 = Double(g);
+        Jacobian multiple = g;
+        for (auto& entry : odd) {
+            entry = ToAffine(multiple);
+            multiple = Add(multiple, g2);
+        }
+        return odd;
+    }();
+    return table.data();
+}
+
+// Width-w NAF of a 256-bit scalar: odd digits below 2^(w-1) in magnitude
+// with at least w - 1 zeros between them. Returns the number of digits.
+int ComputeWnaf(int* wnaf, const uint64_t scalar[4], int w) {
+    auto bits = [&](int pos, int count) {
+        uint32_t value = 0;
+        for (int k = 0; k < count && pos + k < 256; ++k) {
+            value |= static_cast<uint32_t>((scalar[(pos + k) / 64] >> ((pos + k) % 64)) & 1) << k;
+        }
+        return static_cast<int>(value);
+    };
+    std::fill(wnaf, wnaf + kWnafSize, 0);
+    int carry = 0;
+    int bit = 0;
+    int length = 0;
+    while (bit < 256) {
+        if (bits(bit, 1) == carry) {
+            ++bit;
+            continue;
+        }
+        int digit = bits(bit, w) + carry;
+        carry = (digit >> (w - 1)) & 1;
+        digit -= carry << w;
+        wnaf[bit] = digit;
+        length = bit + 1;
+        bit += w;
+    }
+    if (carry != 0) {
+        wnaf[bit] = 1;
+        length = bit + 1;
+    }
+    return length;
+}
+
+void ScalarLimbs(const uint8_t* bytes, uint64_t limbs[4]) {
+    const Fe value = FromBytes(bytes);  // Only the limb layout is wanted
+    std::copy(value.n, value.n + 4, limbs);
+}
+
+// u1 G + u2 R (Strauss-Shamir: one doubling chain for both products)
+Jacobian DoubleMultiply(const uint8_t* u1, const Jacobian& r, const uint8_t* u2) {
+    Jacobian r_odd[1 << (kPointWindow - 2)];
+    const Jacobian r2 = Double(r);
+    r_odd[0] = r;
+    for (size_t i = 1; i < std::size(r_odd); ++i) {
+        r_odd[i] = Add(r_odd[i - 1], r2);
+    }
+    const Affine* g_odd = GeneratorTable();
+
+    uint64_t limbs[4];
+    int wnaf_g[kWnafSize];
+    int wnaf_r[kWnafSize];
+    ScalarLimbs(u1, limbs);
+    const int length_g = ComputeWnaf(wnaf_g, limbs, kGeneratorWindow);
+    ScalarLimbs(u2, limbs);
+    const int length_r = ComputeWnaf(wnaf_r, limbs, kPointWindow);
+
+    Jacobian q = kInfinity;
+    for (int i = std::max(length_g, length_r) - 1; i >= 0; --i) {
+        q = Double(q);
+        if (const int d = wnaf_r[i]; d != 0) {
+            Jacobian addend = r_odd[(std::abs(d) - 1) / 2];
+            if (d < 0) {
+                addend.y = Sub(kZero, addend.y);
+            }
+            q = Add(q, addend);
+        }
+        if (const int d = wnaf_g[i]; d != 0) {
+            Affine addend = g_odd[(std::abs(d) - 1) / 2];
+            if (d < 0) {
+                addend.y = Sub(kZero, addend.y);
+            }
+            q = AddAffine(q, addend);
+        }
+    }
+    return q;
+}
+
+struct BnCtxDeleter {
+    void operator()(BN_CTX* ctx) const { BN_CTX_free(ctx); }
+};
+
+// Curve order n, big-endian
+const uint8_t kOrder[32] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                            0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48,
+                            0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41};
+
+// u1 = -e / r and u2 = s / r mod n, as 32-byte big-endian scalars
+bool RecoveryScalars(const uint8_t* msg_hash, const uint8_t* r_bytes, const uint8_t* s_bytes,
+                     uint8_t* u1_bytes, uint8_t* u2_bytes) {
+    std::unique_ptr<BN_CTX, BnCtxDeleter> ctx(BN_CTX_new());
+    if (!ctx) {
+        return false;
+    }
+    BN_CTX_start(ctx.get());
+    BIGNUM* n = BN_CTX_get(ctx.get());
+    BIGNUM* r = BN_CTX_get(ctx.get());
+    BIGNUM* s = BN_CTX_get(ctx.get());
+    BIGNUM* e = BN_CTX_get(ctx.get());
+    BIGNUM* r_inv = BN_CTX_get(ctx.get());
+    BIGNUM* u1 = BN_CTX_get(ctx.get());
+    BIGNUM* u2 = BN_CTX_get(ctx.get());
+    const bool ok =
+        u2 != nullptr && BN_bin2bn(kOrder, 32, n) && BN_bin2bn(r_bytes, 32, r) &&
+        BN_bin2bn(s_bytes, 32, s) && BN_bin2bn(msg_hash, 32, e) && !BN_is_zero(r) &&
+        !BN_is_zero(s) && BN_cmp(r, n) < 0 && BN_cmp(s, n) < 0 &&
+        BN_mod_inverse(r_inv, r, n, ctx.get()) && BN_nnmod(e, e, n, ctx.get()) &&
+        BN_sub(e, n, e) && BN_mod_mul(u1, e, r_inv, n, ctx.get()) &&
+        BN_mod_mul(u2, s, r_inv, n, ctx.get()) && BN_bn2binpad(u1, u1_bytes, 32) == 32 &&
+        BN_bn2binpad(u2, u2_bytes, 32) == 32;
+    BN_CTX_end(ctx.get());
+    return ok;
+}
+
+// -e mod n for the BIP-340 challenge hash e, rejecting s >= n
+bool ChallengeScalar(const uint8_t* challenge, const uint8_t* s_bytes, uint8_t* neg_e_bytes) {
+    std::unique_ptr<BN_CTX, BnCtxDeleter> ctx(BN_CTX_new());
+    if (!ctx) {
+        return false;
+    }
+    BN_CTX_start(ctx.get());
+    BIGNUM* n = BN_CTX_get(ctx.get());
+    BIGNUM* s = BN_CTX_get(ctx.get());
+    BIGNUM* e = BN_CTX_get(ctx.get());
+    const bool ok = e != nullptr && BN_bin2bn(kOrder, 32, n) && BN_bin2bn(s_bytes, 32, s) &&
+                    BN_bin2bn(challenge, 32, e) && BN_cmp(s, n) < 0 &&
+                    BN_nnmod(e, e, n, ctx.get()) && BN_sub(e, n, e) &&
+                    BN_nnmod(e, e, n, ctx.get()) && BN_bn2binpad(e, neg_e_bytes, 32) == 32;
+    BN_CTX_end(ctx.get());
+    return ok;
+}
+
+}  // namespace
+
+std::optional<ECDSA::PublicKey> ECDSA::Recover(const uint8_t* msg_hash,
+                                               const Signature& signature, int recovery_id) {
+    if (recovery_id != 0 && recovery_id != 1) {
+        return std::nullopt;
+    }
+    uint8_t u1[32];
+    uint8_t u2[32];
+    if (!RecoveryScalars(msg_hash, signature.data(), signature.data() + 32, u1, u2)) {
+        return std::nullopt;
+    }
+
+    // R: the curve point with x = r (below n, so below p) and y of the
+    // given parity
+    const Fe x = FromBytes(signature.data());
+    const Fe y2 = Add(Mul(Sqr(x), x), kSeven);
+    Fe y = SquareRoot(y2);
+    if (!Equal(Sqr(y), y2)) {
+        return std::nullopt;
+    }
+    y = Normalize(y);
+    if (static_cast<int>(y.n[0] & 1) != recovery_id) {
+        y = Sub(kZero, y);
+    }
+
+    // Q = r^-1 (s R - e G)
+    const Jacobian q = DoubleMultiply(u1, Jacobian{x, y, kOne, false}, u2);
+    if (q.infinity) {
+        return std::nullopt;
+    }
+    const Affine affine = ToAffine(q);
+    PublicKey pubkey;
+    ToBytes(affine.x, pubkey.data());
+    ToBytes(affine.y, pubkey.data() + 32);
+    return pubkey;
+}
+
+bool ECDSA::VerifySchnorr(const uint8_t* pubkey_x, const uint8_t* msg,
+                          const uint8_t* signature) {
+    const Fe r = FromBytes(signature);
+    const Fe px = FromBytes(pubkey_x);
+    if (!IsCanonical(r) || !IsCanonical(px)) {
+        return false;
+    }
+
+    // P: the point with x = px and even y
+    const Fe y2 = Add(Mul(Sqr(px), px), kSeven);
+    Fe py = SquareRoot(y2);
+    if (!Equal(Sqr(py), y2)) {
+        return false;
+    }
+    py = Normalize(py);
+    if (py.n[0] & 1) {
+        py = Sub(kZero, py);
+    }
+
+    uint8_t data[96];
+    std::copy(signature, signature + 32, data);
+    std::copy(pubkey_x, pubkey_x + 32, data + 32);
+    std::copy(msg, msg + 32, data + 64);
+    const auto challenge = TaggedSHA256::HashTagged("BIP0340/challenge", data, sizeof(data));
+    uint8_t neg_e[32];
+    if (!ChallengeScalar(challenge.data(), signature + 32, neg_e)) {
+        return false;
+    }
+
+    // R = s G - e P must have even y and x = r
+    const Jacobian q = DoubleMultiply(signature + 32, Jacobian{px, py, kOne, false}, neg_e);
+    if (q.infinity) {
+        return false;
+    }
+    const Affine affine = ToAffine(q);
+    return (Normalize(affine.y).n[0] & 1) == 0 && Equal(affine.x, r);
+}
+
+}  // namespace crypto
+}  // namespace parthenon
@@ -0,0 +1,59 @@
+// ParthenonChain - Cryptographic Primitives
+// ECDSA public key recovery and BIP-340 verification over secp256k1
+
+#ifndef PARTHENON_CRYPTO_ECDSA_H
+#define PARTHENON_CRYPTO_ECDSA_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace parthenon {
+namespace crypto {
+
+/**
+ * ECDSA public key recovery (Ethereum's ecrecover)
+ *
+ * Native secp256k1 arithmetic: 4x64-bit field limbs with the special-form
+ * reduction, Jacobian coordinates, and a Strauss-Shamir double
+ * multiplication over wNAF digits with a precomputed generator table.
+ * Uses only public inputs, so it is variable-time by design.
+ */
+class ECDSA {
+  public:
+    static constexpr size_t SIGNATURE_SIZE = 64;   // (r, s) where r and s are 32 bytes each
+    static constexpr size_t PUBLIC_KEY_SIZE = 64;  // Uncompressed x || y, no 0x04 prefix
+
+    using Signature = std::array<uint8_t, SIGNATURE_SIZE>;
+    using PublicKey = std::array<uint8_t, PUBLIC_KEY_SIZE>;
+
+    /**
+     * Recover the key that produced signature over a 32-byte msg_hash
+     *
+     * recovery_id is the parity of the nonce point's y (0 or 1). High-s
+     * signatures are accepted, as by the EVM precompile.
+     *
+     * @return nullopt if r or s is out of range or no key matches
+     */
+    static std::optional<PublicKey> Recover(const uint8_t* msg_hash, const Signature& signature,
+                                            int recovery_id);
+
+    /**
+     * Verify a BIP-340 Schnorr signature with the same native arithmetic
+     *
+     * Schnorr::Verify remains the consensus check; this exists so the
+     * Schnorr precompile can be priced on equal footing with ecrecover.
+     *
+     * @param pubkey_x 32-byte x-only public key
+     * @param msg 32-byte message
+     * @param signature 64-byte (r, s)
+     */
+    static bool VerifySchnorr(const uint8_t* pubkey_x, const uint8_t* msg,
+                              const uint8_t* signature);
+};
+
+}  // namespace crypto
+}  // namespace parthenon
+
+#endif  // PARTHENON_CRYPTO_ECDSA_H
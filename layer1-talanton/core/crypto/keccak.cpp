@@ -0,0 +1,251 @@
+// ParthenonChain - Cryptographic Primitives
+// Keccak-256 Implementation
+
+#include "keccak.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace parthenon {
+namespace crypto {
+
+#ifdef PARTHENON_KECCAK_AVX2
+namespace detail {
+// keccak_avx2.cpp, built with -mavx2; only called after a CPU check
+void Keccak256x4(const uint8_t* const data[4], const size_t sizes[4], uint8_t* const out[4]);
+}  // namespace detail
+#endif
+
+namespace {
+
+constexpr uint64_t kRoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+inline uint64_t Rol(uint64_t x, unsigned n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+inline uint64_t LoadLE64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+inline void StoreLE64(uint8_t* p, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+// Lanes kept complemented during the permutation (be, bi, go, ki, mi, sa)
+inline void ComplementLanes(uint64_t* a) {
+    a[1] = ~a[1];
+    a[2] = ~a[2];
+    a[8] = ~a[8];
+    a[12] = ~a[12];
+    a[17] = ~a[17];
+    a[20] = ~a[20];
+}
+
+// One round from a into e: theta, rho and pi fused, then chi and iota.
+// With the lanes above complemented, chi takes one NOT per row.
+inline void Round(const uint64_t* a, uint64_t* e, uint64_t rc) {
+    const uint64_t ca = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20];
+    const uint64_t ce = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21];
+    const uint64_t ci = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22];
+    const uint64_t co = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23];
+    const uint64_t cu = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24];
+    const uint64_t da = cu ^ Rol(ce, 1);
+    const uint64_t de = ca ^ Rol(ci, 1);
+    const uint64_t di = ce ^ Rol(co, 1);
+    const uint64_t dd = ci ^ Rol(cu, 1);
+    const uint64_t du = co ^ Rol(ca, 1);
+
+    uint64_t ba = a[0] ^ da;
+    uint64_t be = Rol(a[6] ^ de, 44);
+    uint64_t bi = Rol(a[12] ^ di, 43);
+    uint64_t bo = Rol(a[18] ^ dd, 21);
+    uint64_t bu = Rol(a[24] ^ du, 14);
+    e[0] = ba ^ (be | bi) ^ rc;
+    e[1] = be ^ (~bi | bo);
+    e[2] = bi ^ (bo & bu);
+    e[3] = bo ^ (bu | ba);
+    e[4] = bu ^ (ba & be);
+
+    ba = Rol(a[3] ^ dd, 28);
+    be = Rol(a[9] ^ du, 20);
+    bi = Rol(a[10] ^ da, 3);
+    bo = Rol(a[16] ^ de, 45);
+    bu = Rol(a[22] ^ di, 61);
+    e[5] = ba ^ (be | bi);
+    e[6] = be ^ (bi & bo);
+    e[7] = bi ^ (bo | ~bu);
+    e[8] = bo ^ (bu | ba);
+    e[9] = bu ^ (ba & be);
+
+    ba = Rol(a[1] ^ de, 1);
+    be = Rol(a[7] ^ di, 6);
+    bi = Rol(a[13] ^ dd, 25);
+    bo = Rol(a[19] ^ du, 8);
+    bu = Rol(a[20] ^ da, 18);
+    e[10] = ba ^ (be | bi);
+    e[11] = be ^ (bi & bo);
+    e[12] = bi ^ (~bo & bu);
+    e[13] = ~bo ^ (bu | ba);
+    e[14] = bu ^ (ba & be);
+
+    ba = Rol(a[4] ^ du, 27);
+    be = Rol(a[5] ^ da, 36);
+    bi = Rol(a[11] ^ de, 10);
+    bo = Rol(a[17] ^ di, 15);
+    bu = Rol(a[23] ^ dd, 56);
+    e[15] = ba ^ (be & bi);
+    e[16] = be ^ (bi | bo);
+    e[17] = bi ^ (~bo | bu);
+    e[18] = ~bo ^ (bu & ba);
+    e[19] = bu ^ (ba | be);
+
+    ba = Rol(a[2] ^ di, 62);
+    be = Rol(a[8] ^ dd, 55);
+    bi = Rol(a[14] ^ du, 39);
+    bo = Rol(a[15] ^ da, 41);
+    bu = Rol(a[21] ^ de, 2);
+    e[20] = ba ^ (~be & bi);
+    e[21] = ~be ^ (bi | bo);
+    e[22] = bi ^ (bo & bu);
+    e[23] = bo ^ (bu | ba);
+    e[24] = bu ^ (ba & be);
+}
+
+void KeccakF1600(uint64_t* state) {
+    uint64_t scratch[25];
+    ComplementLanes(state);
+    for (size_t round = 0; round < 24; round += 2) {
+        Round(state, scratch, kRoundConstants[round]);
+        Round(scratch, state, kRoundConstants[round + 1]);
+    }
+    ComplementLanes(state);
+}
+
+}  // namespace
+
+Keccak256::Keccak256() {
+    Reset();
+}
+
+void Keccak256::Reset() {
+    std::memset(state_, 0, sizeof(state_));
+    buffer_size_ = 0;
+}
+
+void Keccak256::Absorb(const uint8_t* block) {
+    for (size_t i = 0; i < RATE / 8; ++i) {
+        state_[i] ^= LoadLE64(block + 8 * i);
+    }
+    KeccakF1600(state_);
+}
+
+void Keccak256::Write(const uint8_t* data, size_t len) {
+    if (buffer_size_ > 0) {
+        const size_t take = std::min(len, RATE - buffer_size_);
+        std::memcpy(buffer_ + buffer_size_, data, take);
+        buffer_size_ += take;
+        data += take;
+        len -= take;
+        if (buffer_size_ < RATE) {
+            return;
+        }
+        Absorb(buffer_);
+        buffer_size_ = 0;
+    }
+    for (; len >= RATE; data += RATE, len -= RATE) {
+        Absorb(data);
+    }
+    if (len > 0) {
+        std::memcpy(buffer_, data, len);
+        buffer_size_ = len;
+    }
+}
+
+void Keccak256::Write(const std::vector<uint8_t>& data) {
+    Write(data.data(), data.size());
+}
+
+Keccak256::Hash Keccak256::Finalize() {
+    std::memset(buffer_ + buffer_size_, 0, RATE - buffer_size_);
+    buffer_[buffer_size_] = 0x01;
+    buffer_[RATE - 1] |= 0x80;
+    Absorb(buffer_);
+
+    Hash hash;
+    for (size_t i = 0; i < OUTPUT_SIZE / 8; ++i) {
+        StoreLE64(hash.data() + 8 * i, state_[i]);
+    }
+    Reset();
+    return hash;
+}
+
+Keccak256::Hash Keccak256::Hash256(const uint8_t* data, size_t len) {
+    Keccak256 hasher;
+    hasher.Write(data, len);
+    return hasher.Finalize();
+}
+
+Keccak256::Hash Keccak256::Hash256(const std::vector<uint8_t>& data) {
+    return Hash256(data.data(), data.size());
+}
+
+bool Keccak256::HasMultiBuffer() {
+#ifdef PARTHENON_KECCAK_AVX2
+    static const bool available = __builtin_cpu_supports("avx2");
+    return available;
+#else
+    return false;
+#endif
+}
+
+void Keccak256::HashBatch(const uint8_t* const* data, const size_t* sizes, size_t count,
+                          Hash* out) {
+    size_t done = 0;
+#ifdef PARTHENON_KECCAK_AVX2
+    if (HasMultiBuffer() && count >= 4) {
+        // Lanes run until the longest message of their group is absorbed,
+        // so group messages by length
+        std::vector<size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return sizes[a] / RATE < sizes[b] / RATE; });
+        for (; done + 4 <= count; done += 4) {
+            const uint8_t* group_data[4];
+            size_t group_sizes[4];
+            uint8_t* group_out[4];
+            for (size_t lane = 0; lane < 4; ++lane) {
+                const size_t index = order[done + lane];
+                group_data[lane] = data[index];
+                group_sizes[lane] = sizes[index];
+                group_out[lane] = out[index].data();
+            }
+            detail::Keccak256x4(group_data, group_sizes, group_out);
+        }
+        for (; done < count; ++done) {
+            out[order[done]] = Hash256(data[order[done]], sizes[order[done]]);
+        }
+        return;
+    }
+#endif
+    for (; done < count; ++done) {
+        out[done] = Hash256(data[done], sizes[done]);
+    }
+}
+
+}  // namespace crypto
+}  // namespace parthenon
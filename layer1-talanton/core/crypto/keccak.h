@@ -0,0 +1,68 @@
+// ParthenonChain - Cryptographic Primitives
+// Keccak-256 Implementation (Ethereum variant, 0x01 padding)
+
+#ifndef PARTHENON_CRYPTO_KECCAK_H
+#define PARTHENON_CRYPTO_KECCAK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parthenon {
+namespace crypto {
+
+/**
+ * Keccak-256 hasher
+ * The hash Ethereum calls SHA3 (KECCAK256): Keccak-f[1600] with a 1088-bit
+ * rate and the original Keccak padding, not the FIPS 202 SHA3-256 padding.
+ *
+ * The permutation keeps six lanes complemented so that chi needs one NOT
+ * per row instead of five. HashBatch() hashes independent messages four
+ * at a time in AVX2 registers when the CPU supports it.
+ */
+class Keccak256 {
+  public:
+    static constexpr size_t OUTPUT_SIZE = 32;
+    static constexpr size_t RATE = 136;  // Bytes absorbed per permutation
+
+    using Hash = std::array<uint8_t, OUTPUT_SIZE>;
+
+    Keccak256();
+
+    // Reset the hasher to initial state
+    void Reset();
+
+    // Update the hash with new data
+    void Write(const uint8_t* data, size_t len);
+    void Write(const std::vector<uint8_t>& data);
+
+    // Finalize and return the hash
+    Hash Finalize();
+
+    // Convenience function: hash data in one call
+    static Hash Hash256(const uint8_t* data, size_t len);
+    static Hash Hash256(const std::vector<uint8_t>& data);
+
+    /**
+     * Hash count independent messages: out[i] = Hash256(data[i], sizes[i])
+     * Messages of similar length batch best.
+     */
+    static void HashBatch(const uint8_t* const* data, const size_t* sizes, size_t count,
+                          Hash* out);
+
+    // Whether HashBatch() uses the 4-way AVX2 permutation on this CPU
+    static bool HasMultiBuffer();
+
+  private:
+    void Absorb(const uint8_t* block);
+
+    uint64_t state_[25];
+    uint8_t buffer_[RATE];
+    size_t buffer_size_;
+};
+
+}  // namespace crypto
+}  // namespace parthenon
+
+#endif  // PARTHENON_CRYPTO_KECCAK_H
@@ -0,0 +1,182 @@
+// ParthenonChain - RIPEMD-160 Implementation
+
+#include "ripemd160.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace parthenon {
+namespace crypto {
+
+namespace {
+
+// Message word used by each step, left and right lines
+constexpr uint8_t kWordLeft[80] = {
+    0, 1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 7,  4,  13, 1,
+    10, 6,  15, 3,  12, 0,  9,  5,  2,  14, 11, 8,  3,  10, 14, 4,  9,  15, 8,  1,
+    2,  7,  0,  6,  13, 11, 5,  12, 1,  9,  11, 10, 0,  8,  12, 4,  13, 3,  7,  15,
+    14, 5,  6,  2,  4,  0,  5,  9,  7,  12, 2,  10, 14, 1,  3,  8,  11, 6,  15, 13};
+constexpr uint8_t kWordRight[80] = {
+    5,  14, 7,  0,  9, 2,  11, 4,  13, 6,  15, 8,  1,  10, 3,  12, 6,  11, 3,  7,
+    0,  13, 5,  10, 14, 15, 8,  12, 4,  9,  1,  2,  15, 5,  1,  3,  7,  14, 6,  9,
+    11, 8,  12, 2,  10, 0,  4,  13, 8,  6,  4,  1,  3,  11, 15, 0,  5,  12, 2,  13,
+    9,  7,  10, 14, 12, 15, 10, 4,  1,  5,  8,  7,  6,  2,  13, 14, 0,  3,  9,  11};
+
+// Left rotation of each step
+constexpr uint8_t kShiftLeft[80] = {
+    11, 14, 15, 12, 5,  8,  7,  9,  11, 13, 14, 15, 6,  7,  9,  8,  7,  6,  8,  13,
+    11, 9,  7,  15, 7,  12, 15, 9,  11, 7,  13, 12, 11, 13, 6,  7,  14, 9,  13, 15,
+    14, 8,  13, 6,  5,  12, 7,  5,  11, 12, 14, 15, 14, 15, 9,  8,  9,  14, 5,  6,
+    8,  6,  5,  12, 9,  15, 5,  11, 6,  8,  13, 12, 5,  12, 13, 14, 11, 8,  5,  6};
+constexpr uint8_t kShiftRight[80] = {
+    8,  9,  9,  11, 13, 15, 15, 5,  7,  7,  8,  11, 14, 14, 12, 6,  9,  13, 15, 7,
+    12, 8,  9,  11, 7,  7,  12, 7,  6,  15, 13, 11, 9,  7,  15, 11, 8,  6,  6,  14,
+    12, 13, 5,  14, 13, 13, 7,  5,  15, 5,  8,  11, 14, 14, 6,  14, 6,  9,  12, 9,
+    12, 5,  15, 8,  8,  5,  12, 9,  12, 5,  14, 6,  8,  13, 6,  5,  15, 13, 11, 11};
+
+constexpr uint32_t kConstLeft[5] = {0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E};
+constexpr uint32_t kConstRight[5] = {0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000};
+
+constexpr uint32_t kInitialState[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476,
+                                       0xC3D2E1F0};
+
+inline uint32_t Rol(uint32_t x, unsigned n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+// Boolean function of round 0..4
+inline uint32_t F(unsigned round, uint32_t x, uint32_t y, uint32_t z) {
+    switch (round) {
+        case 0:
+            return x ^ y ^ z;
+        case 1:
+            return (x & y) | (~x & z);
+        case 2:
+            return (x | ~y) ^ z;
+        case 3:
+            return (x & z) | (y & ~z);
+        default:
+            return x ^ (y | ~z);
+    }
+}
+
+inline uint32_t ReadLE32(const uint8_t* ptr) {
+    return static_cast<uint32_t>(ptr[0]) | (static_cast<uint32_t>(ptr[1]) << 8) |
+           (static_cast<uint32_t>(ptr[2]) << 16) | (static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+inline void WriteLE32(uint8_t* ptr, uint32_t val) {
+    ptr[0] = static_cast<uint8_t>(val);
+    ptr[1] = static_cast<uint8_t>(val >> 8);
+    ptr[2] = static_cast<uint8_t>(val >> 16);
+    ptr[3] = static_cast<uint8_t>(val >> 24);
+}
+
+}  // namespace
+
+RIPEMD160::RIPEMD160() {
+    Reset();
+}
+
+void RIPEMD160::Reset() {
+    std::copy(kInitialState, kInitialState + 5, state_);
+    byte_count_ = 0;
+    buffer_size_ = 0;
+}
+
+void RIPEMD160::Transform(const uint8_t* chunk) {
+    uint32_t x[16];
+    for (size_t i = 0; i < 16; ++i) {
+        x[i] = ReadLE32(chunk + 4 * i);
+    }
+
+    uint32_t al = state_[0], bl = state_[1], cl = state_[2], dl = state_[3], el = state_[4];
+    uint32_t ar = al, br = bl, cr = cl, dr = dl, er = el;
+    for (unsigned j = 0; j < 80; ++j) {
+        const unsigned round = j / 16;
+        uint32_t t = Rol(al + F(round, bl, cl, dl) + x[kWordLeft[j]] + kConstLeft[round],
+                         kShiftLeft[j]) +
+                     el;
+        al = el;
+        el = dl;
+        dl = Rol(cl, 10);
+        cl = bl;
+        bl = t;
+
+        // The right line runs the boolean functions in reverse order
+        t = Rol(ar + F(4 - round, br, cr, dr) + x[kWordRight[j]] + kConstRight[round],
+                kShiftRight[j]) +
+            er;
+        ar = er;
+        er = dr;
+        dr = Rol(cr, 10);
+        cr = br;
+        br = t;
+    }
+
+    const uint32_t t = state_[1] + cl + dr;
+    state_[1] = state_[2] + dl + er;
+    state_[2] = state_[3] + el + ar;
+    state_[3] = state_[4] + al + br;
+    state_[4] = state_[0] + bl + cr;
+    state_[0] = t;
+}
+
+void RIPEMD160::Write(const uint8_t* data, size_t len) {
+    byte_count_ += len;
+    if (buffer_size_ > 0) {
+        const size_t take = std::min(len, BLOCK_SIZE - buffer_size_);
+        std::memcpy(buffer_ + buffer_size_, data, take);
+        buffer_size_ += take;
+        data += take;
+        len -= take;
+        if (buffer_size_ < BLOCK_SIZE) {
+            return;
+        }
+        Transform(buffer_);
+        buffer_size_ = 0;
+    }
+    for (; len >= BLOCK_SIZE; data += BLOCK_SIZE, len -= BLOCK_SIZE) {
+        Transform(data);
+    }
+    if (len > 0) {
+        std::memcpy(buffer_, data, len);
+        buffer_size_ = len;
+    }
+}
+
+void RIPEMD160::Write(const std::vector<uint8_t>& data) {
+    Write(data.data(), data.size());
+}
+
+RIPEMD160::Hash RIPEMD160::Finalize() {
+    // MD4-style padding with a little-endian bit length
+    const uint64_t bit_count = byte_count_ * 8;
+    uint8_t padding[BLOCK_SIZE + 8] = {0x80};
+    const size_t pad_len = buffer_size_ < 56 ? 56 - buffer_size_ : 120 - buffer_size_;
+    uint8_t length[8];
+    WriteLE32(length, static_cast<uint32_t>(bit_count));
+    WriteLE32(length + 4, static_cast<uint32_t>(bit_count >> 32));
+    Write(padding, pad_len);
+    Write(length, 8);
+
+    Hash hash;
+    for (size_t i = 0; i < 5; ++i) {
+        WriteLE32(hash.data() + 4 * i, state_[i]);
+    }
+    Reset();
+    return hash;
+}
+
+RIPEMD160::Hash RIPEMD160::Hash160(const uint8_t* data, size_t len) {
+    RIPEMD160 hasher;
+    hasher.Write(data, len);
+    return hasher.Finalize();
+}
+
+RIPEMD160::Hash RIPEMD160::Hash160(const std::vector<uint8_t>& data) {
+    return Hash160(data.data(), data.size());
+}
+
+}  // namespace crypto
+}  // namespace parthenon
@@ -0,0 +1,55 @@
+// ParthenonChain - Cryptographic Primitives
+// RIPEMD-160 Implementation
+
+#ifndef PARTHENON_CRYPTO_RIPEMD160_H
+#define PARTHENON_CRYPTO_RIPEMD160_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parthenon {
+namespace crypto {
+
+/**
+ * RIPEMD-160 hasher
+ * As specified by Dobbertin, Bosselaers and Preneel; used by Bitcoin
+ * HASH160 and the EVM precompile at address 0x03
+ */
+class RIPEMD160 {
+  public:
+    static constexpr size_t OUTPUT_SIZE = 20;
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    using Hash = std::array<uint8_t, OUTPUT_SIZE>;
+
+    RIPEMD160();
+
+    // Reset the hasher to initial state
+    void Reset();
+
+    // Update the hash with new data
+    void Write(const uint8_t* data, size_t len);
+    void Write(const std::vector<uint8_t>& data);
+
+    // Finalize and return the hash
+    Hash Finalize();
+
+    // Convenience function: hash data in one call
+    static Hash Hash160(const uint8_t* data, size_t len);
+    static Hash Hash160(const std::vector<uint8_t>& data);
+
+  private:
+    void Transform(const uint8_t* chunk);
+
+    uint32_t state_[5];
+    uint8_t buffer_[BLOCK_SIZE];
+    uint64_t byte_count_;
+    size_t buffer_size_;
+};
+
+}  // namespace crypto
+}  // namespace parthenon
+
+#endif  // PARTHENON_CRYPTO_RIPEMD160_H
@@ -9,6 +9,7 @@
 #include <chrono>
 #include <charconv>
 #include <iostream>
+#include <shared_mutex>
 #include <stdexcept>
 #include <thread>
 
@@ -63,6 +64,7 @@ Node::Node(const std::string& data_dir, uint16_t port, NetworkMode network_mode)
     mempool_ = std::make_unique<mempool::Mempool>();
     block_storage_ = std::make_unique<storage::BlockStorage>();
     utxo_storage_ = std::make_unique<storage::UTXOStorage>();
+    tip_snapshot_ = std::make_shared<const ChainTipSnapshot>(ChainTipSnapshot{0, {}, 0});
 
     const auto params = GetNetworkParams(network_mode_);
     network_ = std::make_unique<p2p::NetworkManager>(port, params.magic);
@@ -82,6 +84,8 @@ bool Node::Start() {
     std::cout << "Starting ParthenonChain node on port " << port_
               << " (" << params.name << ")" << std::endl;
 
+    std::unique_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+
     // Open block storage database
     std::string block_db_path = data_dir_ + "/blocks";
     if (!block_storage_->Open(block_db_path)) {
@@ -164,8 +168,10 @@ bool Node::Start() {
         }
     }
 
-    sync_target_height_ = static_cast<uint32_t>(chain_->GetHeight());
+    sync_target_height_.store(static_cast<uint32_t>(chain_->GetHeight()));
     is_syncing_.store(false);
+    PublishTipSnapshot();
+    chain_lock.unlock();
 
     // Set up network callbacks
     network_->SetOnNewPeer([this](const std::string& peer_id) { HandleNewPeer(peer_id); });
@@ -190,6 +196,7 @@ bool Node::Start() {
     // Start network manager
     if (!network_->Start()) {
         std::cerr << "Failed to start P2P network" << std::endl;
+        chain_lock.lock();
         block_storage_->Close();
         utxo_storage_->Close();
         return false;
@@ -240,15 +247,19 @@ void Node::Stop() {
     std::cout << "Stopping P2P network..." << std::endl;
     network_->Stop();
 
-    // Save UTXO set to disk
-    std::cout << "Saving UTXO set to disk..." << std::endl;
-    auto& utxo_set = chain_->GetUTXOSet();
-    utxo_storage_->SaveUTXOSet(utxo_set);
+    {
+        std::unique_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+
+        // Save UTXO set to disk
+        std::cout << "Saving UTXO set to disk..." << std::endl;
+        auto& utxo_set = chain_->GetUTXOSet();
+        utxo_storage_->SaveUTXOSet(utxo_set);
 
-    // Close storage databases
-    std::cout << "Closing storage databases..." << std::endl;
-    block_storage_->Close();
-    utxo_storage_->Close();
+        // Close storage databases
+        std::cout << "Closing storage databases..." << std::endl;
+        block_storage_->Close();
+        utxo_storage_->Close();
+    }
 
     running_.store(false);
 
@@ -259,12 +270,14 @@ SyncStatus Node::GetSyncStatus() const {
     SyncStatus status;
     status.is_syncing = is_syncing_.load();
     status.current_height = GetHeight();
-    status.target_height = sync_target_height_;
+    status.target_height = sync_target_height_.load();
 
-    if (sync_target_height_ > 0) {
-        status.blocks_remaining = sync_target_height_ - status.current_height;
+    if (status.target_height > 0) {
+        status.blocks_remaining = status.target_height > status.current_height
+                                      ? status.target_height - status.current_height
+                                      : 0;
         status.progress_percent = (static_cast<double>(status.current_height) /
-                                   static_cast<double>(sync_target_height_)) *
+                                   static_cast<double>(status.target_height)) *
                                   100.0;
     } else {
         status.blocks_remaining = 0;
@@ -275,7 +288,9 @@ SyncStatus Node::GetSyncStatus() const {
 }
 
 std::vector<PeerInfo> Node::GetPeers() const {
+    std::lock_guard<RankedMutex> lock(peers_mutex_);
     std::vector<PeerInfo> peer_list;
+    peer_list.reserve(peers_.size());
     for (const auto& [id, info] : peers_) {
         peer_list.push_back(info);
     }
@@ -285,19 +300,22 @@ std::vector<PeerInfo> Node::GetPeers() const {
 void Node::AddPeer(const std::string& address, uint16_t port) {
     std::string peer_id = address + ":" + std::to_string(port);
 
-    if (peers_.find(peer_id) != peers_.end()) {
-        return;  // Already have this peer
-    }
+    {
+        std::lock_guard<RankedMutex> lock(peers_mutex_);
+        if (peers_.find(peer_id) != peers_.end()) {
+            return;  // Already have this peer
+        }
 
-    PeerInfo info;
-    info.address = address;
-    info.port = port;
-    info.version = kDefaultPeerVersion;
-    info.height = 0;
-    info.is_connected = false;
-    info.last_seen = 0;
+        PeerInfo info;
+        info.address = address;
+        info.port = port;
+        info.version = kDefaultPeerVersion;
+        info.height = 0;
+        info.is_connected = false;
+        info.last_seen = 0;
 
-    peers_[peer_id] = info;
+        peers_[peer_id] = info;
+    }
 
     // Initiate connection to peer via network manager
     if (network_ && running_.load()) {
@@ -310,29 +328,19 @@ void Node::AddPeer(const std::string& address, uint16_t port) {
 
 bool Node::ProcessBlock(const primitives::Block& block, const std::string& peer_id) {
     // Validate block
-    if (!ValidateAndApplyBlock(block)) {
+    uint32_t block_height = 0;
+    if (!ValidateAndApplyBlock(block, &block_height)) {
         std::cout << "Rejected invalid block from peer: " << peer_id << std::endl;
         return false;
     }
 
     // Update sync status
-    uint32_t block_height = GetHeight();
-    if (block_height >= sync_target_height_) {
+    if (block_height >= sync_target_height_.load()) {
         is_syncing_.store(false);
     }
 
-    // Update wallet if attached
-    {
-        std::lock_guard<std::mutex> lock(wallet_mutex_);
-        if (wallet_) {
-            wallet_->ProcessBlock(block, block_height);
-        }
-    }
-
     // Notify callbacks
-    for (const auto& callback : block_callbacks_) {
-        callback(block);
-    }
+    NotifyBlock(block);
 
     // Broadcast to other peers
     BroadcastBlock(block);
@@ -348,29 +356,35 @@ bool Node::SubmitTransaction(const primitives::Transaction& tx) {
         return false;
     }
 
-    error = validation::TransactionValidator::ValidateAgainstUTXO(tx, chain_->GetUTXOSet(),
-                                                                  GetHeight());
-    if (error) {
-        std::cout << "Transaction validation failed: " << error->message << std::endl;
-        return false;
-    }
+    {
+        // Readers share the chainstate lock; block connection is excluded
+        // until the transaction is in the mempool.
+        std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+        const auto& utxo_set = chain_->GetUTXOSet();
+        const uint32_t height = chain_->GetHeight();
 
-    error = validation::TransactionValidator::ValidateSignatures(tx, chain_->GetUTXOSet());
-    if (error) {
-        std::cout << "Invalid transaction signature: " << error->message << std::endl;
-        return false;
-    }
+        error = validation::TransactionValidator::ValidateAgainstUTXO(tx, utxo_set, height);
+        if (error) {
+            std::cout << "Transaction validation failed: " << error->message << std::endl;
+            return false;
+        }
 
-    // Add to mempool
-    if (!mempool_->AddTransaction(tx, chain_->GetUTXOSet(), GetHeight())) {
-        std::cout << "Transaction already in mempool" << std::endl;
-        return false;
+        error = validation::TransactionValidator::ValidateSignatures(tx, utxo_set);
+        if (error) {
+            std::cout << "Invalid transaction signature: " << error->message << std::endl;
+            return false;
+        }
+
+        // Add to mempool
+        std::lock_guard<RankedMutex> mempool_lock(mempool_mutex_);
+        if (!mempool_->AddTransaction(tx, utxo_set, height)) {
+            std::cout << "Transaction already in mempool" << std::endl;
+            return false;
+        }
     }
 
     // Notify callbacks
-    for (const auto& callback : tx_callbacks_) {
-        callback(tx);
-    }
+    NotifyTransaction(tx);
 
     // Broadcast to peers
     BroadcastTransaction(tx);
@@ -379,10 +393,22 @@ bool Node::SubmitTransaction(const primitives::Transaction& tx) {
 }
 
 uint32_t Node::GetHeight() const {
-    return static_cast<uint32_t>(chain_->GetHeight());
+    return GetTipSnapshot()->height;
+}
+
+std::shared_ptr<const ChainTipSnapshot> Node::GetTipSnapshot() const {
+    return std::atomic_load(&tip_snapshot_);
+}
+
+void Node::PublishTipSnapshot() {
+    const auto previous = std::atomic_load(&tip_snapshot_);
+    auto snapshot = std::make_shared<const ChainTipSnapshot>(ChainTipSnapshot{
+        chain_->GetHeight(), chain_->GetTip(), previous ? previous->sequence + 1 : 1});
+    std::atomic_store(&tip_snapshot_, std::shared_ptr<const ChainTipSnapshot>(snapshot));
 }
 
 std::optional<primitives::Block> Node::GetBlockByHeight(uint32_t height) const {
+    std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
     if (block_storage_ && block_storage_->IsOpen()) {
         return block_storage_->GetBlockByHeight(height);
     }
@@ -390,20 +416,122 @@ std::optional<primitives::Block> Node::GetBlockByHeight(uint32_t height) const {
 }
 
 std::optional<primitives::Block> Node::GetBlockByHash(const std::array<uint8_t, 32>& hash) const {
+    std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
     if (block_storage_ && block_storage_->IsOpen()) {
         return block_storage_->GetBlockByHash(hash);
     }
     return std::nullopt;
 }
 
-void Node::OnNewBlock(std::function<void(const primitives::Block&)> callback) {
-    block_callbacks_.push_back(callback);
+std::optional<uint32_t> Node::GetBlockHeight(const std::array<uint8_t, 32>& hash) const {
+    std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+    if (block_storage_ && block_storage_->IsOpen()) {
+        return block_storage_->GetHeightByHash(hash);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> Node::GetRawBlockByHash(const std::array<uint8_t, 32>& hash) const {
+    std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+    if (block_storage_ && block_storage_->IsOpen()) {
+        return block_storage_->GetRawBlockByHash(hash);
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> Node::GetRawHeaders(const std::array<uint8_t, 32>& hash,
+                                             size_t count) const {
+    std::vector<std::string> headers;
+    std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+    if (!block_storage_ || !block_storage_->IsOpen() || count == 0) {
+        return headers;
+    }
+
+    auto start = block_storage_->GetHeightByHash(hash);
+    if (!start) {
+        return headers;
+    }
+
+    const uint32_t tip = chain_->GetHeight();
+    for (uint32_t height = *start; height <= tip && headers.size() < count; ++height) {
+        auto raw = block_storage_->GetRawHeaderByHeight(height);
+        if (!raw || raw->size() != storage::BlockStorage::kHeaderSize) {
+            break;
+        }
+        headers.push_back(std::move(*raw));
+    }
+    return headers;
+}
+
+std::optional<std::string> Node::GetRawTransaction(const std::array<uint8_t, 32>& txid,
+                                                   std::optional<uint32_t>* height_out) const {
+    std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+    {
+        std::lock_guard<RankedMutex> mempool_lock(mempool_mutex_);
+        auto tx = mempool_->GetTransaction(txid);
+        if (tx) {
+            if (height_out) {
+                *height_out = std::nullopt;
+            }
+            const auto bytes = tx->Serialize();
+            return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+    }
+
+    if (!block_storage_ || !block_storage_->IsOpen()) {
+        return std::nullopt;
+    }
+
+    uint32_t height = 0;
+    auto raw = block_storage_->GetRawTransaction(txid, &height);
+    if (raw && height_out) {
+        *height_out = height;
+    }
+    return raw;
+}
+
+uint64_t Node::OnNewBlock(std::function<void(const primitives::Block&)> callback) {
+    std::lock_guard<RankedMutex> lock(callbacks_mutex_);
+    const uint64_t token = next_block_callback_token_++;
+    block_callbacks_.emplace(token, std::move(callback));
+    return token;
+}
+
+void Node::RemoveBlockCallback(uint64_t token) {
+    std::lock_guard<RankedMutex> lock(callbacks_mutex_);
+    block_callbacks_.erase(token);
 }
 
 void Node::OnNewTransaction(std::function<void(const primitives::Transaction&)> callback) {
+    std::lock_guard<RankedMutex> lock(callbacks_mutex_);
     tx_callbacks_.push_back(callback);
 }
 
+void Node::NotifyBlock(const primitives::Block& block) {
+    std::vector<std::function<void(const primitives::Block&)>> callbacks;
+    {
+        std::lock_guard<RankedMutex> lock(callbacks_mutex_);
+        callbacks.reserve(block_callbacks_.size());
+        for (const auto& [token, callback] : block_callbacks_) {
+            callbacks.push_back(callback);
+        }
+    }
+    for (const auto& callback : callbacks) {
+        callback(block);
+    }
+}
+
+void Node::NotifyTransaction(const primitives::Transaction& tx) {
+    std::vector<std::function<void(const primitives::Transaction&)>> callbacks;
+    {
+        std::lock_guard<RankedMutex> lock(callbacks_mutex_);
+        callbacks = tx_callbacks_;
+    }
+    for (const auto& callback : callbacks) {
+        callback(tx);
+    }
+}
+
 void Node::SyncLoop() {
     std::cout << "Starting sync loop..." << std::endl;
 
@@ -420,8 +548,9 @@ void Node::SyncLoop() {
         }
 
         // If we haven't reached the target, request more blocks
-        if (current_height < sync_target_height_) {
-            std::cout << "Syncing: " << current_height << "/" << sync_target_height_ << std::endl;
+        const uint32_t target_height = sync_target_height_.load();
+        if (current_height < target_height) {
+            std::cout << "Syncing: " << current_height << "/" << target_height << std::endl;
 
             // Request blocks from first available peer
             if (!peers.empty()) {
@@ -432,7 +561,7 @@ void Node::SyncLoop() {
             std::this_thread::sleep_for(std::chrono::seconds(1));
         } else {
             // Caught up or no target set
-            if (sync_target_height_ > 0) {
+            if (target_height > 0) {
                 is_syncing_.store(false);
                 std::cout << "Sync complete at height " << current_height << std::endl;
             } else {
@@ -454,19 +583,7 @@ void Node::RequestBlocks(const std::string& peer_id, uint32_t start_height, uint
     }
 }
 
-bool Node::ValidateAndApplyBlock(const primitives::Block& block) {
-    // Validate block structure
-    if (!block.IsValid()) {
-        return false;
-    }
-
-    if (!chain_state_.ValidateBlock(block)) {
-        std::cerr << "Block failed chain state validation at height " << (GetHeight() + 1)
-                  << std::endl;
-        return false;
-    }
-
-    // Validate all transactions
+bool Node::ValidateBlockTransactions(const primitives::Block& block, uint32_t height) const {
     for (const auto& tx : block.transactions) {
         // Skip validation for coinbase (first transaction)
         if (&tx == &block.transactions[0]) {
@@ -481,7 +598,7 @@ bool Node::ValidateAndApplyBlock(const primitives::Block& block) {
 
         // Validate against UTXO
         error = validation::TransactionValidator::ValidateAgainstUTXO(tx, chain_->GetUTXOSet(),
-                                                                      GetHeight());
+                                                                      height);
         if (error) {
             return false;
         }
@@ -492,6 +609,40 @@ bool Node::ValidateAndApplyBlock(const primitives::Block& block) {
             return false;
         }
     }
+    return true;
+}
+
+bool Node::ValidateAndApplyBlock(const primitives::Block& block, uint32_t* connected_height) {
+    // Validate block structure
+    if (!block.IsValid()) {
+        return false;
+    }
+
+    // Signature and UTXO checks are the expensive part of block validation, so
+    // run them under the shared lock and only take the exclusive lock to
+    // connect. If another block was connected in between, re-validate against
+    // the new tip.
+    uint64_t validated_sequence = 0;
+    {
+        std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+        if (!ValidateBlockTransactions(block, chain_->GetHeight())) {
+            return false;
+        }
+        validated_sequence = GetTipSnapshot()->sequence;
+    }
+
+    std::unique_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+
+    if (!chain_state_.ValidateBlock(block)) {
+        std::cerr << "Block failed chain state validation at height " << (chain_->GetHeight() + 1)
+                  << std::endl;
+        return false;
+    }
+
+    if (GetTipSnapshot()->sequence != validated_sequence &&
+        !ValidateBlockTransactions(block, chain_->GetHeight())) {
+        return false;
+    }
 
     // Apply block to chain
     chainstate::BlockUndo undo;
@@ -500,8 +651,8 @@ bool Node::ValidateAndApplyBlock(const primitives::Block& block) {
     }
 
     if (!chain_state_.ApplyBlock(block)) {
-        std::cerr << "Warning: failed to update mining chain state at height " << GetHeight()
-                  << "; mining height may be stale" << std::endl;
+        std::cerr << "Warning: failed to update mining chain state at height "
+                  << chain_->GetHeight() << "; mining height may be stale" << std::endl;
     }
 
     // Store block to disk
@@ -517,9 +668,29 @@ bool Node::ValidateAndApplyBlock(const primitives::Block& block) {
         utxo_storage_->SaveUTXOSet(chain_->GetUTXOSet());
     }
 
+    PublishTipSnapshot();
+
     // Remove transactions from mempool
-    for (const auto& tx : block.transactions) {
-        mempool_->RemoveTransaction(tx.GetTxID());
+    {
+        std::lock_guard<RankedMutex> mempool_lock(mempool_mutex_);
+        for (const auto& tx : block.transactions) {
+            mempool_->RemoveTransaction(tx.GetTxID());
+        }
+    }
+
+    // Deliver to the wallet before releasing the chainstate lock, so the
+    // wallet receives blocks in connection order and never interleaves with
+    // a rescan (SyncWalletWithChain holds the chainstate lock shared)
+    {
+        std::lock_guard<RankedMutex> wallet_lock(wallet_mutex_);
+        if (wallet_) {
+            wallet_->ProcessBlock(block, height);
+        }
+    }
+    chain_lock.unlock();
+
+    if (connected_height) {
+        *connected_height = height;
     }
 
     std::cout << "Block " << height << " validated, applied, and stored" << std::endl;
@@ -557,34 +728,41 @@ void Node::HandleNewPeer(const std::string& peer_id) {
     auto last_seen = static_cast<uint64_t>(
         std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count());
 
-    auto it = peers_.find(peer_id);
-    if (it == peers_.end()) {
-        PeerInfo info;
-        info.address = address;
-        info.port = port;
-        info.version = kDefaultPeerVersion;
-        info.height = GetHeight();
-        info.is_connected = true;
-        info.last_seen = last_seen;
-        peers_[peer_id] = info;
-    } else {
-        it->second.is_connected = true;
-        it->second.last_seen = last_seen;
+    {
+        std::lock_guard<RankedMutex> lock(peers_mutex_);
+        auto it = peers_.find(peer_id);
+        if (it == peers_.end()) {
+            PeerInfo info;
+            info.address = address;
+            info.port = port;
+            info.version = kDefaultPeerVersion;
+            info.height = GetHeight();
+            info.is_connected = true;
+            info.last_seen = last_seen;
+            peers_[peer_id] = info;
+        } else {
+            it->second.is_connected = true;
+            it->second.last_seen = last_seen;
+        }
     }
     RecomputeSyncTarget();
 }
 
 void Node::RecomputeSyncTarget() {
-    uint32_t best_height = GetHeight();
-    for (const auto& kv : peers_) {
-        const auto& info = kv.second;
-        if (info.is_connected && info.height > best_height) {
-            best_height = info.height;
+    const uint32_t current_height = GetHeight();
+    uint32_t best_height = current_height;
+    {
+        std::lock_guard<RankedMutex> lock(peers_mutex_);
+        for (const auto& kv : peers_) {
+            const auto& info = kv.second;
+            if (info.is_connected && info.height > best_height) {
+                best_height = static_cast<uint32_t>(info.height);
+            }
         }
     }
 
-    sync_target_height_ = best_height;
-    if (sync_target_height_ > GetHeight()) {
+    sync_target_height_.store(best_height);
+    if (best_height > current_height) {
         is_syncing_.store(true);
     }
 }
@@ -617,16 +795,20 @@ void Node::HandleInvReceived(const std::string& peer_id, const p2p::InvMessage&
 
     // Build a getdata request for inventory items we don't already have
     p2p::GetDataMessage getdata;
-    for (const auto& item : inv.inventory) {
-        if (item.type == p2p::InvType::MSG_BLOCK) {
-            // Request the block if we don't have it
-            if (!block_storage_ || !block_storage_->GetBlockByHash(item.hash)) {
-                getdata.inventory.push_back(item);
-            }
-        } else if (item.type == p2p::InvType::MSG_TX) {
-            // Request the transaction if it's not in our mempool
-            if (!mempool_ || !mempool_->HasTransaction(item.hash)) {
-                getdata.inventory.push_back(item);
+    {
+        std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+        std::lock_guard<RankedMutex> mempool_lock(mempool_mutex_);
+        for (const auto& item : inv.inventory) {
+            if (item.type == p2p::InvType::MSG_BLOCK) {
+                // Request the block if we don't have it
+                if (!block_storage_ || !block_storage_->GetBlockByHash(item.hash)) {
+                    getdata.inventory.push_back(item);
+                }
+            } else if (item.type == p2p::InvType::MSG_TX) {
+                // Request the transaction if it's not in our mempool
+                if (!mempool_ || !mempool_->HasTransaction(item.hash)) {
+                    getdata.inventory.push_back(item);
+                }
             }
         }
     }
@@ -647,20 +829,22 @@ void Node::HandleGetDataReceived(const std::string& peer_id, const p2p::GetDataM
     for (const auto& item : msg.inventory) {
         if (item.type == p2p::InvType::MSG_BLOCK) {
             // Look up and send the requested block
-            if (block_storage_) {
-                auto block = block_storage_->GetBlockByHash(item.hash);
-                if (block) {
-                    network_->SendBlockToPeer(peer_id, *block);
-                }
+            auto block = GetBlockByHash(item.hash);
+            if (block) {
+                network_->SendBlockToPeer(peer_id, *block);
             }
         } else if (item.type == p2p::InvType::MSG_TX) {
             // Look up and send the requested transaction from mempool
-            if (mempool_) {
-                auto tx = mempool_->GetTransaction(item.hash);
-                if (tx) {
-                    network_->SendTxToPeer(peer_id, *tx);
+            std::optional<primitives::Transaction> tx;
+            {
+                std::lock_guard<RankedMutex> mempool_lock(mempool_mutex_);
+                if (mempool_) {
+                    tx = mempool_->GetTransaction(item.hash);
                 }
             }
+            if (tx) {
+                network_->SendTxToPeer(peer_id, *tx);
+            }
         }
     }
 }
@@ -727,7 +911,11 @@ void Node::MiningLoop(size_t thread_id) {
 
     while (is_mining_) {
         // Create block template
-        auto template_opt = miner_->CreateBlockTemplate(1000);
+        std::optional<mining::BlockTemplate> template_opt;
+        {
+            std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+            template_opt = miner_->CreateBlockTemplate(1000);
+        }
         if (!template_opt) {
             // Failed to create template, wait and retry
             std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -755,9 +943,7 @@ void Node::MiningLoop(size_t thread_id) {
                 BroadcastBlock(block);
 
                 // Trigger callbacks
-                for (const auto& callback : block_callbacks_) {
-                    callback(block);
-                }
+                NotifyBlock(block);
 
                 std::cout << "Block accepted! Total blocks mined: " << blocks_mined_.load()
                           << std::endl;
@@ -782,6 +968,7 @@ Node::MiningStats Node::GetMiningStats() const {
 
     // Calculate hashrate (approximate)
     if (miner_) {
+        std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
         auto status = miner_->GetStatus();
         stats.hashrate = status.hashrate;
     } else {
@@ -792,41 +979,58 @@ Node::MiningStats Node::GetMiningStats() const {
 }
 
 void Node::AttachWallet(std::shared_ptr<wallet::Wallet> wallet) {
-    std::lock_guard<std::mutex> lock(wallet_mutex_);
-    wallet_ = wallet;
+    {
+        std::lock_guard<RankedMutex> lock(wallet_mutex_);
+        wallet_ = wallet;
+    }
     std::cout << "Wallet attached to node" << std::endl;
 
     // Sync wallet with current chain state if node is running
-    if (running_.load() && wallet_) {
+    if (running_.load() && wallet) {
         std::cout << "Syncing wallet with blockchain..." << std::endl;
         SyncWalletWithChain();
     }
 }
 
 void Node::DetachWallet() {
-    std::lock_guard<std::mutex> lock(wallet_mutex_);
+    std::lock_guard<RankedMutex> lock(wallet_mutex_);
     wallet_ = nullptr;
     std::cout << "Wallet detached from node" << std::endl;
 }
 
+std::shared_ptr<wallet::Wallet> Node::GetWallet() const {
+    std::lock_guard<RankedMutex> lock(wallet_mutex_);
+    return wallet_;
+}
+
 void Node::SyncWalletWithChain() {
-    std::lock_guard<std::mutex> lock(wallet_mutex_);
+    // Hold the chainstate lock for the whole rescan so no block is connected
+    // (and delivered to the wallet a second time) while it runs.
+    std::shared_lock<RankedSharedMutex> chain_lock(chain_mutex_);
+    std::lock_guard<RankedMutex> wallet_lock(wallet_mutex_);
 
     if (!wallet_) {
         std::cout << "No wallet attached" << std::endl;
         return;
     }
 
+    SyncWalletWithChainLocked(wallet_);
+}
+
+void Node::SyncWalletWithChainLocked(const std::shared_ptr<wallet::Wallet>& wallet) {
     std::cout << "Syncing wallet with chain..." << std::endl;
 
-    uint32_t current_height = GetHeight();
+    uint32_t current_height = chain_->GetHeight();
     std::cout << "Processing " << current_height + 1 << " blocks..." << std::endl;
 
     // Process all blocks from genesis to current height
     for (uint32_t height = 0; height <= current_height; height++) {
-        auto block_opt = GetBlockByHeight(height);
+        std::optional<primitives::Block> block_opt;
+        if (block_storage_ && block_storage_->IsOpen()) {
+            block_opt = block_storage_->GetBlockByHeight(height);
+        }
         if (block_opt) {
-            wallet_->ProcessBlock(*block_opt, height);
+            wallet->ProcessBlock(*block_opt, height);
         }
 
         // Show progress every 100 blocks
@@ -839,7 +1043,7 @@ void Node::SyncWalletWithChain() {
     std::cout << "Wallet sync complete!" << std::endl;
 
     // Display wallet balances
-    auto balances = wallet_->GetBalances();
+    auto balances = wallet->GetBalances();
     std::cout << "Wallet balances:" << std::endl;
     std::cout << "  TALANTON: "
               << static_cast<double>(balances[primitives::AssetID::TALANTON]) / 100000000.0
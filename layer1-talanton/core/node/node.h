@@ -13,6 +13,7 @@
 #include "mining/miner.h"
 #include "storage/block_storage.h"
 #include "storage/utxo_storage.h"
+#include "sync.h"
 #include "wallet/wallet.h"
 
 #include <atomic>
@@ -50,6 +51,19 @@ struct SyncStatus {
     double progress_percent;
 };
 
+/**
+ * Immutable view of the active chain tip.
+ *
+ * A new snapshot is published after every block connection; readers obtain
+ * the current one without taking the chainstate lock, so RPC handlers keep a
+ * consistent height/hash pair even while ConnectBlock runs.
+ */
+struct ChainTipSnapshot {
+    uint32_t height;
+    std::array<uint8_t, 32> hash;
+    uint64_t sequence;  // Incremented on every publish
+};
+
 /**
  * Runtime network selection for node startup.
  */
@@ -61,6 +75,13 @@ enum class NetworkMode {
 
 /**
  * Node manages blockchain state and peer connections
+ *
+ * Concurrency: the node is shared between the sync thread, per-peer network
+ * threads, mining threads and RPC handlers. Shared state is guarded by ranked
+ * locks (see node/sync.h) that must be taken in the order
+ * chainstate -> mempool -> wallet -> peers -> callbacks. Lock order is checked
+ * at runtime in debug builds. Public methods acquire the locks they need;
+ * callbacks and network broadcasts run with no node lock held.
  */
 class Node {
   public:
@@ -124,10 +145,15 @@ class Node {
     bool SubmitTransaction(const primitives::Transaction& tx);
 
     /**
-     * Get current blockchain height
+     * Get current blockchain height (lock-free, from the tip snapshot)
      */
     uint32_t GetHeight() const;
 
+    /**
+     * Get the current immutable tip snapshot (never null)
+     */
+    std::shared_ptr<const ChainTipSnapshot> GetTipSnapshot() const;
+
     /**
      * Get block by height
      */
@@ -138,10 +164,40 @@ class Node {
      */
     std::optional<primitives::Block> GetBlockByHash(const std::array<uint8_t, 32>& hash) const;
 
+    /**
+     * Get block height by hash
+     */
+    std::optional<uint32_t> GetBlockHeight(const std::array<uint8_t, 32>& hash) const;
+
+    /**
+     * Get serialized block bytes by hash, read straight from block storage
+     */
+    std::optional<std::string> GetRawBlockByHash(const std::array<uint8_t, 32>& hash) const;
+
+    /**
+     * Get up to count consecutive serialized headers, starting at hash
+     */
+    std::vector<std::string> GetRawHeaders(const std::array<uint8_t, 32>& hash,
+                                           size_t count) const;
+
+    /**
+     * Get a serialized transaction from the mempool or a stored block
+     * @param height_out Receives the block height if the transaction is
+     *        confirmed, nullopt if it was found in the mempool
+     */
+    std::optional<std::string> GetRawTransaction(const std::array<uint8_t, 32>& txid,
+                                                 std::optional<uint32_t>* height_out = nullptr) const;
+
     /**
      * Register callback for new blocks
+     * @return Token that unregisters the callback via RemoveBlockCallback
+     */
+    uint64_t OnNewBlock(std::function<void(const primitives::Block&)> callback);
+
+    /**
+     * Unregister a callback added with OnNewBlock (no-op if unknown)
      */
-    void OnNewBlock(std::function<void(const primitives::Block&)> callback);
+    void RemoveBlockCallback(uint64_t token);
 
     /**
      * Register callback for new transactions
@@ -193,7 +249,7 @@ class Node {
      * Get attached wallet
      * @return Shared pointer to wallet, or nullptr if no wallet attached
      */
-    std::shared_ptr<wallet::Wallet> GetWallet() const { return wallet_; }
+    std::shared_ptr<wallet::Wallet> GetWallet() const;
 
     /**
      * Sync wallet with current blockchain state
@@ -209,25 +265,36 @@ class Node {
     std::atomic<bool> running_;
     NetworkMode network_mode_;
 
+    // Lock hierarchy (acquire in this order only)
+    mutable RankedSharedMutex chain_mutex_{LockRank::CHAINSTATE, "chainstate"};
+    mutable RankedMutex mempool_mutex_{LockRank::MEMPOOL, "mempool"};
+    mutable RankedMutex wallet_mutex_{LockRank::WALLET, "wallet"};
+    mutable RankedMutex peers_mutex_{LockRank::PEERS, "peers"};
+    mutable RankedMutex callbacks_mutex_{LockRank::CALLBACKS, "callbacks"};
+
     // Core components
-    std::unique_ptr<chainstate::Chain> chain_;
-    chainstate::ChainState chain_state_;
-    std::unique_ptr<mempool::Mempool> mempool_;
+    std::unique_ptr<chainstate::Chain> chain_;     // guarded by chain_mutex_
+    chainstate::ChainState chain_state_;           // guarded by chain_mutex_
+    std::unique_ptr<mempool::Mempool> mempool_;    // guarded by mempool_mutex_
+
+    // Published tip view; accessed only via std::atomic_load/atomic_store
+    std::shared_ptr<const ChainTipSnapshot> tip_snapshot_;
 
     // Peer management
     std::unique_ptr<p2p::NetworkManager> network_;
-    std::map<std::string, PeerInfo> peers_;
+    std::map<std::string, PeerInfo> peers_;        // guarded by peers_mutex_
 
     // Synchronization state
     std::atomic<bool> is_syncing_;
-    uint32_t sync_target_height_;
+    std::atomic<uint32_t> sync_target_height_;
     std::thread sync_thread_;
 
-    // Callbacks
-    std::vector<std::function<void(const primitives::Block&)>> block_callbacks_;
+    // Callbacks (guarded by callbacks_mutex_, invoked with no lock held)
+    std::map<uint64_t, std::function<void(const primitives::Block&)>> block_callbacks_;
+    uint64_t next_block_callback_token_ = 1;
     std::vector<std::function<void(const primitives::Transaction&)>> tx_callbacks_;
 
-    // Storage backends
+    // Storage backends (guarded by chain_mutex_)
     std::unique_ptr<storage::BlockStorage> block_storage_;
     std::unique_ptr<storage::UTXOStorage> utxo_storage_;
 
@@ -239,15 +306,21 @@ class Node {
     std::atomic<uint32_t> blocks_mined_;
     std::vector<uint8_t> coinbase_pubkey_;
 
-    // Wallet for UTXO tracking
+    // Wallet for UTXO tracking (guarded by wallet_mutex_)
     std::shared_ptr<wallet::Wallet> wallet_;
-    std::mutex wallet_mutex_;
 
     // Internal methods
     void SyncLoop();
     void MiningLoop(size_t thread_id);
     void RequestBlocks(const std::string& peer_id, uint32_t start_height, uint32_t count);
-    bool ValidateAndApplyBlock(const primitives::Block& block);
+    bool ValidateAndApplyBlock(const primitives::Block& block,
+                               uint32_t* connected_height = nullptr);
+    bool ValidateBlockTransactions(const primitives::Block& block,
+                                   uint32_t height) const;  // requires chain_mutex_ held
+    void PublishTipSnapshot();  // requires chain_mutex_ held
+    void SyncWalletWithChainLocked(const std::shared_ptr<wallet::Wallet>& wallet);
+    void NotifyBlock(const primitives::Block& block);
+    void NotifyTransaction(const primitives::Transaction& tx);
     void BroadcastBlock(const primitives::Block& block);
     void BroadcastTransaction(const primitives::Transaction& tx);
     void HandleNewPeer(const std::string& peer_id);
@@ -0,0 +1,83 @@
+// ParthenonChain - Node Synchronization Primitives Implementation
+
+#include "sync.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace parthenon {
+namespace node {
+
+namespace {
+
+struct HeldLock {
+    LockRank rank;
+    const char* name;
+};
+
+// Locks held by the current thread, in acquisition order.
+thread_local std::vector<HeldLock> held_locks;
+
+std::mutex handler_mutex;
+LockOrderViolationHandler violation_handler;
+
+void ReportViolation(const HeldLock& held, const char* acquiring) {
+    LockOrderViolationHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(handler_mutex);
+        handler = violation_handler;
+    }
+
+    if (handler) {
+        handler(held.name, acquiring);
+        return;
+    }
+
+    std::cerr << "Lock order violation: acquiring " << acquiring << " while holding "
+              << held.name << std::endl;
+    std::abort();
+}
+
+}  // namespace
+
+void SetLockOrderViolationHandler(LockOrderViolationHandler handler) {
+    std::lock_guard<std::mutex> lock(handler_mutex);
+    violation_handler = std::move(handler);
+}
+
+size_t HeldLockCount() {
+    return held_locks.size();
+}
+
+namespace detail {
+
+void OnAcquire(LockRank rank, const char* name) {
+    // Ranks must strictly increase; re-acquiring the same rank is also an
+    // error since none of the ranked mutexes are recursive.
+    for (const auto& held : held_locks) {
+        if (held.rank >= rank) {
+            ReportViolation(held, name);
+            break;
+        }
+    }
+    held_locks.push_back(HeldLock{rank, name});
+}
+
+void OnRelease(LockRank rank, const char* name) {
+    // Locks are usually released in LIFO order, but std::unique_lock allows
+    // early unlock, so search from the back.
+    auto it = std::find_if(held_locks.rbegin(), held_locks.rend(), [&](const HeldLock& held) {
+        return held.rank == rank && held.name == name;
+    });
+    if (it != held_locks.rend()) {
+        held_locks.erase(std::next(it).base());
+    }
+}
+
+}  // namespace detail
+
+}  // namespace node
+}  // namespace parthenon
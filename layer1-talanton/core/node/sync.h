@@ -0,0 +1,158 @@
+// ParthenonChain - Node Synchronization Primitives
+// Ranked mutexes with debug-mode lock-order checking
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+// Lock-order checking is enabled in debug builds and can be forced on in
+// release builds with -DPARTHENON_DEBUG_LOCKORDER=1.
+#ifndef PARTHENON_DEBUG_LOCKORDER
+#ifdef NDEBUG
+#define PARTHENON_DEBUG_LOCKORDER 0
+#else
+#define PARTHENON_DEBUG_LOCKORDER 1
+#endif
+#endif
+
+namespace parthenon {
+namespace node {
+
+/**
+ * Lock ranks for node-wide shared state.
+ *
+ * Locks must be acquired in strictly increasing rank order:
+ *
+ *   CHAINSTATE -> MEMPOOL -> WALLET -> PEERS -> CALLBACKS
+ *
+ * - CHAINSTATE guards Chain (UTXO set, block index), ChainState, block and
+ *   UTXO storage. Readers (RPC, mining templates, tx validation) take it
+ *   shared; block connection takes it exclusive.
+ * - MEMPOOL guards the Mempool. It may be taken while holding CHAINSTATE
+ *   (e.g. removing confirmed transactions after ConnectBlock), never the
+ *   other way around.
+ * - WALLET guards the attached wallet pointer and wallet updates.
+ * - PEERS guards the peer table.
+ * - CALLBACKS guards callback registration; callbacks themselves are invoked
+ *   on a copy with no lock held.
+ */
+enum class LockRank : uint8_t {
+    CHAINSTATE = 10,
+    MEMPOOL = 20,
+    WALLET = 30,
+    PEERS = 40,
+    CALLBACKS = 50,
+};
+
+/**
+ * Called when a lock-order violation is detected. The default handler prints
+ * both lock names and aborts; tests may install their own handler.
+ */
+using LockOrderViolationHandler =
+    std::function<void(const std::string& held, const std::string& acquiring)>;
+
+void SetLockOrderViolationHandler(LockOrderViolationHandler handler);
+
+/**
+ * Number of ranked locks currently held by the calling thread.
+ * Always 0 when lock-order checking is compiled out.
+ */
+size_t HeldLockCount();
+
+namespace detail {
+void OnAcquire(LockRank rank, const char* name);
+void OnRelease(LockRank rank, const char* name);
+}  // namespace detail
+
+/**
+ * Exclusive mutex with a fixed rank. Satisfies Lockable, so it can be used
+ * with std::lock_guard / std::unique_lock.
+ */
+class RankedMutex {
+  public:
+    RankedMutex(LockRank rank, const char* name) : rank_(rank), name_(name) {}
+
+    RankedMutex(const RankedMutex&) = delete;
+    RankedMutex& operator=(const RankedMutex&) = delete;
+
+    void lock() {
+#if PARTHENON_DEBUG_LOCKORDER
+        detail::OnAcquire(rank_, name_);
+#endif
+        mutex_.lock();
+    }
+
+    bool try_lock() {
+        if (!mutex_.try_lock()) {
+            return false;
+        }
+#if PARTHENON_DEBUG_LOCKORDER
+        detail::OnAcquire(rank_, name_);
+#endif
+        return true;
+    }
+
+    void unlock() {
+        mutex_.unlock();
+#if PARTHENON_DEBUG_LOCKORDER
+        detail::OnRelease(rank_, name_);
+#endif
+    }
+
+  private:
+    std::mutex mutex_;
+    LockRank rank_;
+    const char* name_;
+};
+
+/**
+ * Reader/writer mutex with a fixed rank. Satisfies SharedLockable, so it can
+ * be used with std::shared_lock for readers and std::unique_lock for writers.
+ */
+class RankedSharedMutex {
+  public:
+    RankedSharedMutex(LockRank rank, const char* name) : rank_(rank), name_(name) {}
+
+    RankedSharedMutex(const RankedSharedMutex&) = delete;
+    RankedSharedMutex& operator=(const RankedSharedMutex&) = delete;
+
+    void lock() {
+#if PARTHENON_DEBUG_LOCKORDER
+        detail::OnAcquire(rank_, name_);
+#endif
+        mutex_.lock();
+    }
+
+    void unlock() {
+        mutex_.unlock();
+#if PARTHENON_DEBUG_LOCKORDER
+        detail::OnRelease(rank_, name_);
+#endif
+    }
+
+    void lock_shared() {
+#if PARTHENON_DEBUG_LOCKORDER
+        detail::OnAcquire(rank_, name_);
+#endif
+        mutex_.lock_shared();
+    }
+
+    void unlock_shared() {
+        mutex_.unlock_shared();
+#if PARTHENON_DEBUG_LOCKORDER
+        detail::OnRelease(rank_, name_);
+#endif
+    }
+
+  private:
+    std::shared_mutex mutex_;
+    LockRank rank_;
+    const char* name_;
+};
+
+}  // namespace node
+}  // namespace parthenon
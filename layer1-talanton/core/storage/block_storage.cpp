@@ -2,6 +2,8 @@
 
 #include "block_storage.h"
 
+#include "crypto/sha256.h"
+
 #include <charconv>
 #include <iomanip>
 #include <sstream>
@@ -29,6 +31,35 @@ bool TryParseUint32(const std::string& value, uint32_t& out) {
     return true;
 }
 
+size_t CompactSizeLength(uint64_t size) {
+    if (size < 253) {
+        return 1;
+    }
+    if (size <= 0xFFFF) {
+        return 3;
+    }
+    if (size <= 0xFFFFFFFF) {
+        return 5;
+    }
+    return 9;
+}
+
+bool TryParseTxLocation(const std::string& value, uint32_t& height, uint64_t& offset,
+                        uint64_t& length) {
+    const auto first = value.find(':');
+    const auto second = value.find(':', first == std::string::npos ? first : first + 1);
+    if (first == std::string::npos || second == std::string::npos) {
+        return false;
+    }
+
+    const char* begin = value.data();
+    auto [h_end, h_ec] = std::from_chars(begin, begin + first, height);
+    auto [o_end, o_ec] = std::from_chars(begin + first + 1, begin + second, offset);
+    auto [l_end, l_ec] = std::from_chars(begin + second + 1, begin + value.size(), length);
+    return h_ec == std::errc{} && h_end == begin + first && o_ec == std::errc{} &&
+           o_end == begin + second && l_ec == std::errc{} && l_end == begin + value.size();
+}
+
 }  // namespace
 
 bool BlockStorage::Open(const std::string& db_path) {
@@ -43,6 +74,10 @@ bool BlockStorage::Open(const std::string& db_path) {
     }
 
     db_.reset(db_ptr);
+    if (!BackfillIndexes()) {
+        db_.reset();
+        return false;
+    }
     return true;
 }
 
@@ -56,6 +91,10 @@ std::string BlockStorage::HeightKey(uint32_t height) {
     return oss.str();
 }
 
+std::string BlockStorage::HeaderKey(uint32_t height) {
+    return "H" + HeightKey(height).substr(1);
+}
+
 std::string BlockStorage::HashKey(const std::array<uint8_t, 32>& hash) {
     std::string key = "h";
     for (uint8_t byte : hash) {
@@ -66,6 +105,16 @@ std::string BlockStorage::HashKey(const std::array<uint8_t, 32>& hash) {
     return key;
 }
 
+std::string BlockStorage::TxKey(const std::array<uint8_t, 32>& txid) {
+    std::string key = "t";
+    for (uint8_t byte : txid) {
+        char buf[3];
+        snprintf(buf, sizeof(buf), "%02x", byte);
+        key += buf;
+    }
+    return key;
+}
+
 std::string BlockStorage::SerializeBlock(const primitives::Block& block) {
     const auto bytes = block.Serialize();
     return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
@@ -75,6 +124,68 @@ std::optional<primitives::Block> BlockStorage::DeserializeBlock(const std::strin
     return primitives::Block::Deserialize(reinterpret_cast<const uint8_t*>(data.data()), data.size());
 }
 
+void BlockStorage::IndexBlock(const primitives::Block& block, uint32_t height,
+                              const std::string& block_data, leveldb::WriteBatch& batch) {
+    // Header on its own, so header-only reads skip the block body
+    batch.Put(HeaderKey(height), block_data.substr(0, kHeaderSize));
+
+    // txid -> location so raw transactions can be sliced from the block
+    const std::string height_str = std::to_string(height);
+    uint64_t offset = kHeaderSize + CompactSizeLength(block.transactions.size());
+    for (const auto& tx : block.transactions) {
+        const uint64_t length = tx.GetSerializedSize();
+        batch.Put(TxKey(tx.GetTxID()), height_str + ":" + std::to_string(offset) + ":" +
+                                           std::to_string(length));
+        offset += length;
+    }
+}
+
+bool BlockStorage::BackfillIndexes() {
+    std::string value;
+    uint32_t version = 0;
+    if (db_->Get(leveldb::ReadOptions(), "meta:index_version", &value).ok() &&
+        TryParseUint32(value, version) && version >= kIndexVersion) {
+        return true;
+    }
+
+    // One pass over every stored block; written in chunks to bound memory
+    constexpr size_t kBlocksPerBatch = 1000;
+    leveldb::WriteBatch batch;
+    size_t pending = 0;
+    const std::string prefix = "b";
+    std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(leveldb::ReadOptions()));
+    for (it->Seek(leveldb::Slice(prefix)); it->Valid(); it->Next()) {
+        const std::string key = it->key().ToString();
+        if (key.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        uint32_t height = 0;
+        if (!TryParseUint32(key.substr(prefix.size()), height)) {
+            continue;
+        }
+        const std::string block_data = it->value().ToString();
+        auto block = DeserializeBlock(block_data);
+        if (!block) {
+            continue;
+        }
+        IndexBlock(*block, height, block_data, batch);
+        if (++pending == kBlocksPerBatch) {
+            if (!db_->Write(leveldb::WriteOptions(), &batch).ok()) {
+                return false;
+            }
+            batch.Clear();
+            pending = 0;
+        }
+    }
+    if (!it->status().ok()) {
+        return false;
+    }
+
+    // Written last, so an interrupted backfill is redone on the next open
+    batch.Put("meta:index_version", std::to_string(kIndexVersion));
+    return db_->Write(leveldb::WriteOptions(), &batch).ok();
+}
+
 bool BlockStorage::StoreBlock(const primitives::Block& block, uint32_t height) {
     if (!db_) {
         return false;
@@ -93,6 +204,9 @@ bool BlockStorage::StoreBlock(const primitives::Block& block, uint32_t height) {
     std::string height_str = std::to_string(height);
     batch.Put(hash_key, height_str);
 
+    // Store the header and txid -> location secondary indexes
+    IndexBlock(block, height, block_data, batch);
+
     // Write batch atomically
     leveldb::WriteOptions options;
     leveldb::Status status = db_->Write(options, &batch);
@@ -139,6 +253,96 @@ std::optional<primitives::Block> BlockStorage::GetBlockByHash(const std::array<u
     return GetBlockByHeight(height);
 }
 
+std::optional<std::string> BlockStorage::GetRawBlockByHeight(uint32_t height) {
+    if (!db_) {
+        return std::nullopt;
+    }
+
+    std::string value;
+    leveldb::Status status = db_->Get(leveldb::ReadOptions(), HeightKey(height), &value);
+    if (!status.ok()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<std::string> BlockStorage::GetRawHeaderByHeight(uint32_t height) {
+    if (!db_) {
+        return std::nullopt;
+    }
+
+    std::string value;
+    leveldb::Status status = db_->Get(leveldb::ReadOptions(), HeaderKey(height), &value);
+    if (!status.ok()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<uint32_t> BlockStorage::GetHeightByHash(const std::array<uint8_t, 32>& hash) {
+    if (!db_) {
+        return std::nullopt;
+    }
+
+    std::string height_str;
+    leveldb::Status status = db_->Get(leveldb::ReadOptions(), HashKey(hash), &height_str);
+    if (!status.ok()) {
+        return std::nullopt;
+    }
+
+    uint32_t height = 0;
+    if (!TryParseUint32(height_str, height)) {
+        return std::nullopt;
+    }
+    return height;
+}
+
+std::optional<std::string> BlockStorage::GetRawBlockByHash(const std::array<uint8_t, 32>& hash) {
+    auto height = GetHeightByHash(hash);
+    if (!height) {
+        return std::nullopt;
+    }
+    return GetRawBlockByHeight(*height);
+}
+
+std::optional<std::string> BlockStorage::GetRawTransaction(const std::array<uint8_t, 32>& txid,
+                                                           uint32_t* height_out) {
+    if (!db_) {
+        return std::nullopt;
+    }
+
+    std::string location;
+    leveldb::Status status = db_->Get(leveldb::ReadOptions(), TxKey(txid), &location);
+    if (!status.ok()) {
+        return std::nullopt;
+    }
+
+    uint32_t height = 0;
+    uint64_t offset = 0;
+    uint64_t length = 0;
+    if (!TryParseTxLocation(location, height, offset, length)) {
+        return std::nullopt;
+    }
+
+    auto raw_block = GetRawBlockByHeight(height);
+    if (!raw_block || offset > raw_block->size() || length > raw_block->size() - offset) {
+        return std::nullopt;
+    }
+
+    // Never serve some other transaction from a stale or corrupted location
+    std::string raw_tx = raw_block->substr(offset, length);
+    const auto hash = crypto::SHA256d::Hash256d(
+        reinterpret_cast<const uint8_t*>(raw_tx.data()), raw_tx.size());
+    if (hash != txid) {
+        return std::nullopt;
+    }
+
+    if (height_out) {
+        *height_out = height;
+    }
+    return raw_tx;
+}
+
 uint32_t BlockStorage::GetHeight() {
     if (!db_) {
         return 0;
@@ -18,12 +18,21 @@ namespace storage {
  *
  * Storage layout:
  * - "b{height}" -> serialized Block
+ * - "H{height}" -> serialized header (first kHeaderSize bytes of the block)
  * - "h{hash}" -> height (uint32_t)
+ * - "t{txid}" -> "{height}:{offset}:{length}" location of the tx in its block
  * - "meta:height" -> current chain height
  * - "meta:best_hash" -> hash of best block
+ * - "meta:index_version" -> version of the secondary indexes written above;
+ *   Open() backfills databases created by older versions
  */
 class BlockStorage {
   public:
+    /**
+     * Serialized header size (80 bytes Bitcoin-like + 24 bytes EVM fields)
+     */
+    static constexpr size_t kHeaderSize = 104;
+
     /**
      * Open block storage database
      * @param db_path Path to LevelDB database directory
@@ -58,6 +67,39 @@ class BlockStorage {
      */
     std::optional<primitives::Block> GetBlockByHash(const std::array<uint8_t, 32>& hash);
 
+    /**
+     * Retrieve the serialized block bytes exactly as stored (no deserialization)
+     * @param height Block height
+     * @return Serialized block if found, nullopt otherwise
+     */
+    std::optional<std::string> GetRawBlockByHeight(uint32_t height);
+
+    /**
+     * Retrieve the serialized header of the block at height, without reading
+     * the block itself
+     */
+    std::optional<std::string> GetRawHeaderByHeight(uint32_t height);
+
+    /**
+     * Retrieve the serialized block bytes by hash
+     */
+    std::optional<std::string> GetRawBlockByHash(const std::array<uint8_t, 32>& hash);
+
+    /**
+     * Look up the height of a stored block
+     */
+    std::optional<uint32_t> GetHeightByHash(const std::array<uint8_t, 32>& hash);
+
+    /**
+     * Retrieve a confirmed transaction's serialized bytes, sliced from its
+     * block without deserializing it
+     * @param txid Transaction ID
+     * @param height_out Optional; receives the containing block height
+     * @return Serialized transaction if indexed, nullopt otherwise
+     */
+    std::optional<std::string> GetRawTransaction(const std::array<uint8_t, 32>& txid,
+                                                 uint32_t* height_out = nullptr);
+
     /**
      * Get current chain height
      * @return Chain height (0 if no blocks)
@@ -77,11 +119,19 @@ class BlockStorage {
     bool IsOpen() const { return db_ != nullptr; }
 
   private:
+    // 1: "t{txid}" transaction locations, 2: "H{height}" headers
+    static constexpr uint32_t kIndexVersion = 2;
+
     std::unique_ptr<leveldb::DB> db_;
 
     // Helper functions
     std::string HeightKey(uint32_t height);
+    std::string HeaderKey(uint32_t height);
     std::string HashKey(const std::array<uint8_t, 32>& hash);
+    std::string TxKey(const std::array<uint8_t, 32>& txid);
+    void IndexBlock(const primitives::Block& block, uint32_t height,
+                    const std::string& block_data, leveldb::WriteBatch& batch);
+    bool BackfillIndexes();
     std::string SerializeBlock(const primitives::Block& block);
     std::optional<primitives::Block> DeserializeBlock(const std::string& data);
 };
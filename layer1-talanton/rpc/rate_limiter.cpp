@@ -0,0 +1,349 @@
+// ParthenonChain - RPC Rate Limiter Implementation
+
+#include "rate_limiter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace parthenon {
+namespace rpc {
+
+namespace {
+
+constexpr int64_t kNanosPerSecond = 1000000000;
+constexpr int64_t kDefaultIdleTimeoutNs = 10LL * 60 * kNanosPerSecond;
+constexpr int64_t kMinSweepIntervalNs = kNanosPerSecond;
+
+bool ParseIPv4(const std::string& text, uint8_t out[4]) {
+    size_t pos = 0;
+    for (int part = 0; part < 4; ++part) {
+        if (part > 0) {
+            if (pos >= text.size() || text[pos] != '.') {
+                return false;
+            }
+            ++pos;
+        }
+        const size_t start = pos;
+        uint32_t value = 0;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && pos - start < 3) {
+            value = value * 10 + static_cast<uint32_t>(text[pos] - '0');
+            ++pos;
+        }
+        if (pos == start || value > 255) {
+            return false;
+        }
+        out[part] = static_cast<uint8_t>(value);
+    }
+    return pos == text.size();
+}
+
+int HexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return 10 + c - 'a';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return 10 + c - 'A';
+    }
+    return -1;
+}
+
+bool ParseIPv6(std::string text, uint8_t out[16]) {
+    // Strip brackets and zone index ("[fe80::1%eth0]")
+    if (!text.empty() && text.front() == '[') {
+        const auto close = text.find(']');
+        if (close == std::string::npos) {
+            return false;
+        }
+        text = text.substr(1, close - 1);
+    }
+    const auto zone = text.find('%');
+    if (zone != std::string::npos) {
+        text = text.substr(0, zone);
+    }
+
+    std::vector<uint16_t> head;
+    std::vector<uint16_t> tail;
+    bool compressed = false;
+    size_t pos = 0;
+
+    if (text.compare(0, 2, "::") == 0) {
+        compressed = true;
+        pos = 2;
+    }
+
+    while (pos < text.size()) {
+        auto& groups = compressed ? tail : head;
+
+        // Embedded IPv4 in the final 32 bits ("::ffff:1.2.3.4")
+        const auto next_colon = text.find(':', pos);
+        const std::string segment = text.substr(pos, next_colon - pos);
+        if (next_colon == std::string::npos && segment.find('.') != std::string::npos) {
+            uint8_t v4[4];
+            if (!ParseIPv4(segment, v4)) {
+                return false;
+            }
+            groups.push_back(static_cast<uint16_t>((v4[0] << 8) | v4[1]));
+            groups.push_back(static_cast<uint16_t>((v4[2] << 8) | v4[3]));
+            pos = text.size();
+            break;
+        }
+
+        if (segment.empty() || segment.size() > 4) {
+            return false;
+        }
+        uint16_t value = 0;
+        for (char c : segment) {
+            const int nibble = HexValue(c);
+            if (nibble < 0) {
+                return false;
+            }
+            value = static_cast<uint16_t>((value << 4) | nibble);
+        }
+        groups.push_back(value);
+
+        if (next_colon == std::string::npos) {
+            pos = text.size();
+        } else if (text.compare(next_colon, 2, "::") == 0) {
+            if (compressed) {
+                return false;  // Only one "::" allowed
+            }
+            compressed = true;
+            pos = next_colon + 2;
+        } else {
+            pos = next_colon + 1;
+            if (pos == text.size()) {
+                return false;  // Trailing single colon
+            }
+        }
+    }
+
+    const size_t total = head.size() + tail.size();
+    if ((compressed && total > 7) || (!compressed && total != 8)) {
+        return false;
+    }
+
+    uint16_t groups[8] = {};
+    for (size_t i = 0; i < head.size(); ++i) {
+        groups[i] = head[i];
+    }
+    for (size_t i = 0; i < tail.size(); ++i) {
+        groups[8 - tail.size() + i] = tail[i];
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        out[2 * i] = static_cast<uint8_t>(groups[i] >> 8);
+        out[2 * i + 1] = static_cast<uint8_t>(groups[i] & 0xFF);
+    }
+    return true;
+}
+
+uint64_t Fnv1a64(const std::string& data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : data) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+}  // namespace
+
+ClientKey MakeClientKey(const std::string& ip_address) {
+    ClientKey key{};
+
+    uint8_t v4[4];
+    if (ParseIPv4(ip_address, v4)) {
+        // ::ffff:a.b.c.d
+        key[10] = 0xFF;
+        key[11] = 0xFF;
+        std::memcpy(key.data() + 12, v4, 4);
+        return key;
+    }
+
+    uint8_t v6[16];
+    if (ParseIPv6(ip_address, v6)) {
+        const bool v4_mapped = std::all_of(v6, v6 + 10, [](uint8_t b) { return b == 0; }) &&
+                               v6[10] == 0xFF && v6[11] == 0xFF;
+        // Keep the full address for mapped IPv4, otherwise the /64 prefix
+        std::memcpy(key.data(), v6, v4_mapped ? 16 : 8);
+        return key;
+    }
+
+    // Not an address (unix socket, test label): 0xFE-prefixed hash space
+    const uint64_t hash = Fnv1a64(ip_address);
+    key[0] = 0xFE;
+    key[1] = 0xFF;
+    std::memcpy(key.data() + 8, &hash, sizeof(hash));
+    return key;
+}
+
+size_t RateLimiter::ClientKeyHash::operator()(const ClientKey& key) const {
+    uint64_t a = 0;
+    uint64_t b = 0;
+    std::memcpy(&a, key.data(), 8);
+    std::memcpy(&b, key.data() + 8, 8);
+    uint64_t h = a * 0x9E3779B97F4A7C15ULL ^ (b + 0x632BE59BD9B4E019ULL + (a << 6) + (a >> 2));
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+RateLimiter::RateLimiter(uint32_t requests_per_window, uint32_t window_seconds,
+                         uint32_t burst_size)
+    : burst_size_(burst_size > 0 ? burst_size : std::max<uint32_t>(requests_per_window, 1)),
+      idle_timeout_ns_(kDefaultIdleTimeoutNs),
+      epoch_(std::chrono::steady_clock::now()),
+      stripes_(new Stripe[kStripes]) {
+    const int64_t window_ns = static_cast<int64_t>(std::max<uint32_t>(window_seconds, 1)) *
+                              kNanosPerSecond;
+    emission_interval_ns_ =
+        std::max<int64_t>(1, window_ns / std::max<uint32_t>(requests_per_window, 1));
+
+    // Saturate instead of overflowing for extreme configurations
+    const int64_t max_capacity = std::numeric_limits<int64_t>::max() / 4;
+    burst_tolerance_ns_ = burst_size_ > max_capacity / emission_interval_ns_
+                              ? max_capacity
+                              : static_cast<int64_t>(burst_size_) * emission_interval_ns_;
+}
+
+int64_t RateLimiter::NowNs() const {
+    // Offset by one window so a fresh bucket (tat = 0) is always full
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch_)
+               .count() +
+           burst_tolerance_ns_;
+}
+
+RateLimiter::Stripe& RateLimiter::StripeFor(const ClientKey& key) const {
+    return stripes_[ClientKeyHash()(key) % kStripes];
+}
+
+bool RateLimiter::TryConsume(Bucket& bucket, int64_t now, uint32_t cost) const {
+    const int64_t cost_ns = static_cast<int64_t>(std::min(cost, burst_size_)) *
+                            emission_interval_ns_;
+
+    int64_t tat = bucket.tat_ns.load(std::memory_order_relaxed);
+    while (true) {
+        const int64_t new_tat = std::max(tat, now) + cost_ns;
+        if (new_tat - now > burst_tolerance_ns_) {
+            return false;
+        }
+        if (bucket.tat_ns.compare_exchange_weak(tat, new_tat, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+bool RateLimiter::AllowRequest(const std::string& ip_address, const std::string& method) {
+    return AllowCost(MakeClientKey(ip_address), GetMethodCost(method));
+}
+
+bool RateLimiter::AllowCost(const ClientKey& key, uint32_t cost) {
+    if (cost == 0) {
+        return true;
+    }
+
+    const int64_t now = NowNs();
+    Stripe& stripe = StripeFor(key);
+
+    int64_t next_sweep = stripe.next_sweep_ns.load(std::memory_order_relaxed);
+    if (now >= next_sweep) {
+        const int64_t interval =
+            std::max(kMinSweepIntervalNs, idle_timeout_ns_.load(std::memory_order_relaxed) / 4);
+        if (stripe.next_sweep_ns.compare_exchange_strong(next_sweep, now + interval,
+                                                         std::memory_order_relaxed)) {
+            SweepStripe(stripe, now);
+        }
+    }
+
+    // Fast path: known client, shared stripe lock plus one CAS
+    {
+        std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+        auto it = stripe.buckets.find(key);
+        if (it != stripe.buckets.end()) {
+            return TryConsume(it->second, now, cost);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+    auto& bucket = stripe.buckets[key];
+    return TryConsume(bucket, now, cost);
+}
+
+void RateLimiter::SetMethodCost(const std::string& method, uint32_t cost) {
+    method_costs_[method] = cost;
+}
+
+uint32_t RateLimiter::GetMethodCost(const std::string& method) const {
+    if (method.empty() || method_costs_.empty()) {
+        return 1;
+    }
+    auto it = method_costs_.find(method);
+    return it == method_costs_.end() ? 1 : it->second;
+}
+
+uint32_t RateLimiter::GetAvailableTokens(const std::string& ip_address) const {
+    const ClientKey key = MakeClientKey(ip_address);
+    const Stripe& stripe = StripeFor(key);
+
+    std::shared_lock<std::shared_mutex> lock(stripe.mutex);
+    auto it = stripe.buckets.find(key);
+    if (it == stripe.buckets.end()) {
+        return burst_size_;
+    }
+
+    const int64_t debt = std::max<int64_t>(
+        0, it->second.tat_ns.load(std::memory_order_relaxed) - NowNs());
+    return static_cast<uint32_t>((burst_tolerance_ns_ - debt) / emission_interval_ns_);
+}
+
+void RateLimiter::ResetIP(const std::string& ip_address) {
+    const ClientKey key = MakeClientKey(ip_address);
+    Stripe& stripe = StripeFor(key);
+    std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+    stripe.buckets.erase(key);
+}
+
+void RateLimiter::SweepStripe(Stripe& stripe, int64_t now) {
+    const int64_t idle_before = now - idle_timeout_ns_.load(std::memory_order_relaxed);
+
+    std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+    for (auto it = stripe.buckets.begin(); it != stripe.buckets.end();) {
+        // A bucket that has been full since idle_before carries no state
+        if (it->second.tat_ns.load(std::memory_order_relaxed) <= idle_before) {
+            it = stripe.buckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RateLimiter::Cleanup() {
+    const int64_t now = NowNs();
+    for (size_t i = 0; i < kStripes; ++i) {
+        SweepStripe(stripes_[i], now);
+    }
+}
+
+void RateLimiter::SetIdleTimeout(std::chrono::milliseconds timeout) {
+    idle_timeout_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count(),
+                           std::memory_order_relaxed);
+}
+
+size_t RateLimiter::GetTrackedIPCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < kStripes; ++i) {
+        std::shared_lock<std::shared_mutex> lock(stripes_[i].mutex);
+        count += stripes_[i].buckets.size();
+    }
+    return count;
+}
+
+}  // namespace rpc
+}  // namespace parthenon
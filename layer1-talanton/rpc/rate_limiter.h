@@ -4,139 +4,139 @@
 #ifndef PARTHENON_RPC_RATE_LIMITER_H
 #define PARTHENON_RPC_RATE_LIMITER_H
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <map>
-#include <mutex>
+#include <memory>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 namespace parthenon {
 namespace rpc {
 
 /**
- * Request tracking information for rate limiting
+ * Compact binary client key: IPv4 addresses are stored IPv4-mapped, IPv6
+ * addresses are truncated to their /64 prefix (one subscriber allocation),
+ * anything unparseable is hashed into a separate key space.
  */
-struct RateLimitInfo {
-    uint32_t request_count;
-    std::chrono::steady_clock::time_point window_start;
-    std::chrono::steady_clock::time_point last_request;
-
-    RateLimitInfo()
-        : request_count(0),
-          window_start(std::chrono::steady_clock::now()),
-          last_request(std::chrono::steady_clock::now()) {}
-};
+using ClientKey = std::array<uint8_t, 16>;
+
+/**
+ * Convert a textual client address to its rate-limit key
+ */
+ClientKey MakeClientKey(const std::string& ip_address);
 
 /**
  * Rate limiter for RPC endpoints
- * Implements token bucket algorithm with per-IP tracking
+ *
+ * Token bucket per client: capacity burst_size, refilled at
+ * requests_per_window / window_seconds tokens per second. Each bucket is a
+ * single atomic 64-bit "theoretical arrival time" (GCRA form of the token
+ * bucket), so a decision is one CAS with no lock held on the bucket.
+ *
+ * Clients are spread over hashed stripes; a stripe's reader/writer lock is
+ * only taken exclusively to insert a new client or sweep idle ones. Idle
+ * clients (bucket full for longer than the idle timeout) are expired by a
+ * periodic per-stripe sweep piggybacked on AllowRequest().
  */
 class RateLimiter {
   public:
     /**
      * Constructor
-     * @param requests_per_window Maximum requests allowed per time window
+     * @param requests_per_window Sustained requests allowed per time window
      * @param window_seconds Time window in seconds
-     * @param burst_size Maximum burst size (default = requests_per_window)
+     * @param burst_size Bucket capacity (default = requests_per_window)
      */
     RateLimiter(uint32_t requests_per_window = 100, uint32_t window_seconds = 60,
-                uint32_t burst_size = 0)
-        : max_requests_(requests_per_window),
-          window_duration_(std::chrono::seconds(window_seconds)),
-          burst_size_(burst_size > 0 ? burst_size : requests_per_window) {}
+                uint32_t burst_size = 0);
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
 
     /**
      * Check if a request from an IP should be allowed
      * @param ip_address Client IP address
+     * @param method RPC method, used to look up its cost weight (default 1)
      * @return true if request is allowed, false if rate limit exceeded
      */
-    bool AllowRequest(const std::string& ip_address) {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        auto now = std::chrono::steady_clock::now();
-        auto& info = clients_[ip_address];
+    bool AllowRequest(const std::string& ip_address, const std::string& method = "");
 
-        // Check if we need to reset the window
-        auto elapsed = now - info.window_start;
-        if (elapsed >= window_duration_) {
-            info.request_count = 0;
-            info.window_start = now;
-        }
-
-        // Check rate limit
-        if (info.request_count >= max_requests_) {
-            return false;  // Rate limit exceeded
-        }
-
-        // Check burst limit (prevent too many requests in short time)
-        auto time_since_last = now - info.last_request;
-        if (time_since_last < std::chrono::milliseconds(100) && info.request_count >= burst_size_) {
-            return false;  // Burst limit exceeded
-        }
+    /**
+     * Charge an explicit cost against a pre-computed client key
+     */
+    bool AllowCost(const ClientKey& key, uint32_t cost);
 
-        // Allow request
-        info.request_count++;
-        info.last_request = now;
+    /**
+     * Set the token cost of a method (e.g. expensive scans > 1).
+     * Configure before the server starts handling requests.
+     */
+    void SetMethodCost(const std::string& method, uint32_t cost);
 
-        return true;
-    }
+    /**
+     * Get the token cost of a method (1 if not configured)
+     */
+    uint32_t GetMethodCost(const std::string& method) const;
 
     /**
-     * Get current request count for an IP
-     * @param ip_address Client IP address
-     * @return Number of requests in current window
+     * Get tokens currently available to an IP (burst size if untracked)
      */
-    uint32_t GetRequestCount(const std::string& ip_address) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = clients_.find(ip_address);
-        if (it == clients_.end()) {
-            return 0;
-        }
-        return it->second.request_count;
-    }
+    uint32_t GetAvailableTokens(const std::string& ip_address) const;
 
     /**
      * Reset rate limit for an IP (admin use)
      * @param ip_address Client IP address
      */
-    void ResetIP(const std::string& ip_address) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        clients_.erase(ip_address);
-    }
+    void ResetIP(const std::string& ip_address);
+
+    /**
+     * Expire clients idle for longer than the idle timeout. Runs
+     * automatically; exposed for tests and admin use.
+     */
+    void Cleanup();
 
     /**
-     * Clean up old entries (call periodically)
-     * Removes entries that haven't been used recently
+     * Set how long a client must be idle (bucket full) before expiry
      */
-    void Cleanup() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto now = std::chrono::steady_clock::now();
-        auto cleanup_threshold = std::chrono::hours(1);
-
-        for (auto it = clients_.begin(); it != clients_.end();) {
-            if (now - it->second.last_request > cleanup_threshold) {
-                it = clients_.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
+    void SetIdleTimeout(std::chrono::milliseconds timeout);
 
     /**
      * Get number of tracked IPs
      */
-    size_t GetTrackedIPCount() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return clients_.size();
-    }
+    size_t GetTrackedIPCount() const;
 
   private:
-    uint32_t max_requests_;
-    std::chrono::seconds window_duration_;
+    static constexpr size_t kStripes = 64;
+
+    struct ClientKeyHash {
+        size_t operator()(const ClientKey& key) const;
+    };
+
+    struct Bucket {
+        std::atomic<int64_t> tat_ns{0};  // Time at which the bucket is full again
+    };
+
+    struct alignas(64) Stripe {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<ClientKey, Bucket, ClientKeyHash> buckets;
+        std::atomic<int64_t> next_sweep_ns{0};
+    };
+
+    int64_t NowNs() const;
+    Stripe& StripeFor(const ClientKey& key) const;
+    bool TryConsume(Bucket& bucket, int64_t now, uint32_t cost) const;
+    void SweepStripe(Stripe& stripe, int64_t now);
+
+    int64_t emission_interval_ns_;  // Time to refill one token
+    int64_t burst_tolerance_ns_;    // burst_size * emission interval
     uint32_t burst_size_;
+    std::atomic<int64_t> idle_timeout_ns_;
+    std::chrono::steady_clock::time_point epoch_;
 
-    mutable std::mutex mutex_;
-    std::map<std::string, RateLimitInfo> clients_;
+    std::unique_ptr<Stripe[]> stripes_;
+    std::unordered_map<std::string, uint32_t> method_costs_;
 };
 
 }  // namespace rpc
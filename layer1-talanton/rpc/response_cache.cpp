@@ -0,0 +1,111 @@
+// ParthenonChain - RPC Response Cache Implementation
+
+#include "response_cache.h"
+
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace parthenon {
+namespace rpc {
+
+RPCResponseCache::RPCResponseCache(size_t max_entries, size_t max_bytes)
+    : max_entries_(max_entries), max_bytes_(max_bytes), bytes_(0), evictions_(0) {}
+
+std::string RPCResponseCache::MakeKey(const std::string& method, const std::string& params,
+                                      const std::string& version) {
+    std::string canonical_params;
+    if (!params.empty()) {
+        try {
+            canonical_params = json::parse(params).dump();
+        } catch (...) {
+            canonical_params = params;
+        }
+    }
+
+    std::string key;
+    key.reserve(method.size() + canonical_params.size() + version.size() + 2);
+    key += method;
+    key += '\0';
+    key += canonical_params;
+    key += '\0';
+    key += version;
+    return key;
+}
+
+std::optional<std::string> RPCResponseCache::Get(const std::string& key,
+                                                 std::chrono::milliseconds max_age) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+
+    if (max_age.count() > 0 &&
+        std::chrono::steady_clock::now() - it->second->inserted > max_age) {
+        bytes_ -= it->second->key.size() + it->second->result.size();
+        lru_.erase(it->second);
+        index_.erase(it);
+        return std::nullopt;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->result;
+}
+
+void RPCResponseCache::Put(const std::string& key, const std::string& result) {
+    const size_t entry_bytes = key.size() + result.size();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_entries_ == 0 || entry_bytes > max_bytes_) {
+        return;
+    }
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        bytes_ -= it->second->key.size() + it->second->result.size();
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    lru_.push_front(Entry{key, result, std::chrono::steady_clock::now()});
+    index_[key] = lru_.begin();
+    bytes_ += entry_bytes;
+    EvictLocked();
+}
+
+void RPCResponseCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+void RPCResponseCache::Resize(size_t max_entries, size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_entries_ = max_entries;
+    max_bytes_ = max_bytes;
+    EvictLocked();
+}
+
+RPCResponseCache::Stats RPCResponseCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.entries = lru_.size();
+    stats.bytes = bytes_;
+    stats.evictions = evictions_;
+    return stats;
+}
+
+void RPCResponseCache::EvictLocked() {
+    while (!lru_.empty() && (lru_.size() > max_entries_ || bytes_ > max_bytes_)) {
+        const auto& victim = lru_.back();
+        bytes_ -= victim.key.size() + victim.result.size();
+        index_.erase(victim.key);
+        lru_.pop_back();
+        ++evictions_;
+    }
+}
+
+}  // namespace rpc
+}  // namespace parthenon
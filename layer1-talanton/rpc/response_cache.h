@@ -0,0 +1,88 @@
+// ParthenonChain - RPC Response Cache
+// Size-bounded LRU cache of serialized RPC results keyed by chain state
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace parthenon {
+namespace rpc {
+
+/**
+ * Caches successful RPC results for read-only methods.
+ *
+ * Entries are keyed by (method, canonical params, state version); the
+ * version string encodes the chain tip and governance state, so a stale
+ * entry can never be returned for a newer state even before Clear() runs.
+ * Eviction is LRU, bounded by both entry count and total result bytes.
+ */
+class RPCResponseCache {
+  public:
+    struct Stats {
+        size_t entries = 0;
+        size_t bytes = 0;
+        uint64_t evictions = 0;
+    };
+
+    RPCResponseCache(size_t max_entries, size_t max_bytes);
+
+    /**
+     * Build a cache key. Params are canonicalized (parsed and re-dumped) so
+     * whitespace and object key order do not split entries.
+     */
+    static std::string MakeKey(const std::string& method, const std::string& params,
+                               const std::string& version);
+
+    /**
+     * Look up a cached result
+     * @param max_age Entries older than this are treated as misses
+     *        (zero = no age limit)
+     */
+    std::optional<std::string> Get(const std::string& key,
+                                   std::chrono::milliseconds max_age = std::chrono::milliseconds(0));
+
+    /**
+     * Insert or replace a result. Results larger than max_bytes are ignored.
+     */
+    void Put(const std::string& key, const std::string& result);
+
+    /**
+     * Drop every entry (e.g. on a new block)
+     */
+    void Clear();
+
+    /**
+     * Change the size limits, evicting as needed
+     */
+    void Resize(size_t max_entries, size_t max_bytes);
+
+    Stats GetStats() const;
+
+  private:
+    struct Entry {
+        std::string key;
+        std::string result;
+        std::chrono::steady_clock::time_point inserted;
+    };
+
+    void EvictLocked();
+
+    size_t max_entries_;
+    size_t max_bytes_;
+    size_t bytes_;
+    uint64_t evictions_;
+
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;  // Front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace rpc
+}  // namespace parthenon
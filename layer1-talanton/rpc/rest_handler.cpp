@@ -0,0 +1,281 @@
+// ParthenonChain - REST Interface Implementation
+
+#include "rest_handler.h"
+
+#include "node/node.h"
+#include "primitives/block.h"
+#include "primitives/transaction.h"
+#include "storage/block_storage.h"
+
+#include <array>
+#include <charconv>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace parthenon {
+namespace rpc {
+
+namespace {
+
+constexpr const char* kBinaryContentType = "application/octet-stream";
+constexpr const char* kTextContentType = "text/plain";
+constexpr const char* kJsonContentType = "application/json";
+
+RestResponse Error(int status, const std::string& message) {
+    RestResponse response;
+    response.status = status;
+    response.content_type = kTextContentType;
+    response.body = message + "\r\n";
+    return response;
+}
+
+std::string ToHex(const uint8_t* data, size_t len) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    out.resize(len * 2);
+    for (size_t i = 0; i < len; ++i) {
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 0x0F];
+    }
+    return out;
+}
+
+std::string ToHex(const std::string& bytes) {
+    return ToHex(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+}
+
+std::string ToHex(const std::array<uint8_t, 32>& hash) {
+    return ToHex(hash.data(), hash.size());
+}
+
+bool TryParseHash(const std::string& hex, std::array<uint8_t, 32>& out) {
+    if (hex.size() != 64) {
+        return false;
+    }
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return 10 + c - 'a';
+        }
+        if (c >= 'A' && c <= 'F') {
+            return 10 + c - 'A';
+        }
+        return -1;
+    };
+    for (size_t i = 0; i < 32; ++i) {
+        const int hi = nibble(hex[2 * i]);
+        const int lo = nibble(hex[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+bool TryParseSize(const std::string& value, size_t& out) {
+    if (value.empty()) {
+        return false;
+    }
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), out);
+    return ec == std::errc{} && ptr == value.data() + value.size();
+}
+
+/**
+ * Split "<id>.<ext>" into id and format; the format must be bin, hex or json
+ */
+bool SplitFormat(const std::string& segment, std::string& id, std::string& format) {
+    const auto dot = segment.rfind('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    id = segment.substr(0, dot);
+    format = segment.substr(dot + 1);
+    return format == "bin" || format == "hex" || format == "json";
+}
+
+RestResponse WithFormat(const std::string& raw, const std::string& format, json json_body) {
+    RestResponse response;
+    if (format == "bin") {
+        response.content_type = kBinaryContentType;
+        response.body = raw;
+    } else if (format == "hex") {
+        response.content_type = kTextContentType;
+        response.body = ToHex(raw) + "\n";
+    } else {
+        response.content_type = kJsonContentType;
+        response.body = json_body.dump();
+    }
+    return response;
+}
+
+json HeaderToJson(const primitives::BlockHeader& header, std::optional<uint32_t> height) {
+    json out;
+    out["hash"] = ToHex(header.GetHash());
+    if (height) {
+        out["height"] = *height;
+    }
+    out["version"] = header.version;
+    out["previousblockhash"] = ToHex(header.prev_block_hash);
+    out["merkleroot"] = ToHex(header.merkle_root);
+    out["timestamp"] = header.timestamp;
+    out["bits"] = header.bits;
+    out["nonce"] = header.nonce;
+    out["base_fee_per_gas"] = header.base_fee_per_gas;
+    out["gas_used"] = header.gas_used;
+    out["gas_limit"] = header.gas_limit;
+    return out;
+}
+
+json TxToJson(const primitives::Transaction& tx, size_t size) {
+    json out;
+    out["txid"] = ToHex(tx.GetTxID());
+    out["version"] = tx.version;
+    out["locktime"] = tx.locktime;
+    out["size"] = size;
+    out["vin"] = tx.inputs.size();
+    out["vout"] = tx.outputs.size();
+    return out;
+}
+
+}  // namespace
+
+RestResponse RestHandler::Handle(const std::string& path) const {
+    if (!node_) {
+        return Error(503, "Node not initialized");
+    }
+
+    std::vector<std::string> parts;
+    size_t start = 1;  // Skip leading '/'
+    while (start <= path.size()) {
+        const auto slash = path.find('/', start);
+        const auto end = slash == std::string::npos ? path.size() : slash;
+        parts.push_back(path.substr(start, end - start));
+        if (slash == std::string::npos) {
+            break;
+        }
+        start = slash + 1;
+    }
+
+    if (parts.size() < 3 || parts[0] != "rest") {
+        return Error(404, "Not found");
+    }
+
+    std::string id;
+    std::string format;
+    if (parts[1] == "block" && parts.size() == 3 && SplitFormat(parts[2], id, format)) {
+        return HandleBlock(id, format);
+    }
+    if (parts[1] == "tx" && parts.size() == 3 && SplitFormat(parts[2], id, format)) {
+        return HandleTx(id, format);
+    }
+    if (parts[1] == "headers" && parts.size() == 4 && SplitFormat(parts[3], id, format)) {
+        size_t count = 0;
+        if (!TryParseSize(parts[2], count) || count == 0 || count > kMaxHeaders) {
+            return Error(400, "Header count must be between 1 and " +
+                                  std::to_string(kMaxHeaders));
+        }
+        return HandleHeaders(count, id, format);
+    }
+    return Error(404, "Not found; use /rest/{block,tx}/<hash>.<bin|hex|json> or "
+                      "/rest/headers/<count>/<hash>.<bin|hex|json>");
+}
+
+RestResponse RestHandler::HandleBlock(const std::string& hash_hex,
+                                      const std::string& format) const {
+    std::array<uint8_t, 32> hash{};
+    if (!TryParseHash(hash_hex, hash)) {
+        return Error(400, "Invalid hash: " + hash_hex.substr(0, 64));
+    }
+
+    auto raw = node_->GetRawBlockByHash(hash);
+    if (!raw) {
+        return Error(404, hash_hex + " not found");
+    }
+
+    json body;
+    if (format == "json") {
+        auto block = primitives::Block::Deserialize(
+            reinterpret_cast<const uint8_t*>(raw->data()), raw->size());
+        if (!block) {
+            return Error(500, "Stored block is corrupt");
+        }
+        body = HeaderToJson(block->header, node_->GetBlockHeight(hash));
+        json txids = json::array();
+        for (const auto& tx : block->transactions) {
+            txids.push_back(ToHex(tx.GetTxID()));
+        }
+        body["tx"] = txids;
+        body["size"] = raw->size();
+    }
+    return WithFormat(*raw, format, body);
+}
+
+RestResponse RestHandler::HandleHeaders(size_t count, const std::string& hash_hex,
+                                        const std::string& format) const {
+    std::array<uint8_t, 32> hash{};
+    if (!TryParseHash(hash_hex, hash)) {
+        return Error(400, "Invalid hash: " + hash_hex.substr(0, 64));
+    }
+
+    const auto headers = node_->GetRawHeaders(hash, count);
+
+    std::string raw;
+    raw.reserve(headers.size() * storage::BlockStorage::kHeaderSize);
+    for (const auto& header : headers) {
+        raw += header;
+    }
+
+    json body = json::array();
+    if (format == "json") {
+        auto height = node_->GetBlockHeight(hash);
+        for (size_t i = 0; i < headers.size(); ++i) {
+            auto header = primitives::BlockHeader::Deserialize(
+                reinterpret_cast<const uint8_t*>(headers[i].data()));
+            std::optional<uint32_t> header_height;
+            if (height) {
+                header_height = *height + static_cast<uint32_t>(i);
+            }
+            body.push_back(HeaderToJson(header, header_height));
+        }
+    }
+    return WithFormat(raw, format, body);
+}
+
+RestResponse RestHandler::HandleTx(const std::string& txid_hex, const std::string& format) const {
+    std::array<uint8_t, 32> txid{};
+    if (!TryParseHash(txid_hex, txid)) {
+        return Error(400, "Invalid hash: " + txid_hex.substr(0, 64));
+    }
+
+    std::optional<uint32_t> height;
+    auto raw = node_->GetRawTransaction(txid, &height);
+    if (!raw) {
+        return Error(404, txid_hex + " not found");
+    }
+
+    json body;
+    if (format == "json") {
+        size_t consumed = 0;
+        auto tx = primitives::Transaction::Deserialize(
+            reinterpret_cast<const uint8_t*>(raw->data()), raw->size(), consumed);
+        if (!tx) {
+            return Error(500, "Stored transaction is corrupt");
+        }
+        body = TxToJson(*tx, raw->size());
+        if (height) {
+            body["height"] = *height;
+        } else {
+            body["mempool"] = true;
+        }
+    }
+    return WithFormat(*raw, format, body);
+}
+
+}  // namespace rpc
+}  // namespace parthenon
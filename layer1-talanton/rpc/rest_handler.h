@@ -0,0 +1,61 @@
+// ParthenonChain - REST Interface
+// Unauthenticated read-only block, header and transaction endpoints
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace parthenon {
+namespace node {
+class Node;
+}
+
+namespace rpc {
+
+/**
+ * REST response, independent of the HTTP library
+ */
+struct RestResponse {
+    int status = 200;
+    std::string content_type;
+    std::string body;
+};
+
+/**
+ * Serves raw chain data without going through JSON-RPC:
+ *
+ *   /rest/block/<hash>.<bin|hex|json>
+ *   /rest/headers/<count>/<hash>.<bin|hex|json>
+ *   /rest/tx/<txid>.<bin|hex|json>
+ *
+ * .bin bodies are the serialized bytes exactly as held in block storage, so
+ * blocks are never deserialized on the .bin/.hex paths. HTTP Range requests
+ * are served by cpp-httplib, which slices the body set here.
+ */
+class RestHandler {
+  public:
+    /**
+     * Maximum headers returned by one /rest/headers request
+     */
+    static constexpr size_t kMaxHeaders = 2000;
+
+    explicit RestHandler(const node::Node* node) : node_(node) {}
+
+    /**
+     * Handle a GET request
+     * @param path Request path (query string already removed)
+     */
+    RestResponse Handle(const std::string& path) const;
+
+  private:
+    const node::Node* node_;
+
+    RestResponse HandleBlock(const std::string& hash_hex, const std::string& format) const;
+    RestResponse HandleHeaders(size_t count, const std::string& hash_hex,
+                               const std::string& format) const;
+    RestResponse HandleTx(const std::string& txid_hex, const std::string& format) const;
+};
+
+}  // namespace rpc
+}  // namespace parthenon
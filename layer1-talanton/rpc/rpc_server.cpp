@@ -1,6 +1,7 @@
 // ParthenonChain - JSON-RPC Server Implementation with HTTP Support
 
 #include "rpc_server.h"
+#include "rest_handler.h"
 
 #include "primitives/transaction.h"
 
@@ -22,8 +23,11 @@
 
 #include <httplib.h>
 #include <algorithm>
+#include <array>
 #include <charconv>
 #include <cctype>
+#include <condition_variable>
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <nlohmann/json.hpp>
@@ -199,16 +203,227 @@ bool TryParseUint64Decimal(const std::string& value, uint64_t& out) {
 namespace parthenon {
 namespace rpc {
 
+namespace {
+
+// Handlers are mostly storage-bound, so keep a few workers even on small hosts
+constexpr size_t kMinBatchWorkers = 4;
+constexpr size_t kDefaultBatchQueue = 1024;
+constexpr size_t kDefaultMaxBatchSize = 1000;
+constexpr size_t kDefaultCacheEntries = 4096;
+constexpr size_t kDefaultCacheBytes = 64 * 1024 * 1024;
+constexpr uint64_t kDefaultEvmCallGas = 10000000;
+
+template <size_t N>
+std::array<uint8_t, N> ParseEvmBytes(const json& value, const char* field) {
+    std::vector<uint8_t> bytes;
+    if (!value.is_string() || !pantheon::obolos::DecodeHex(value.get<std::string>(), bytes) ||
+        bytes.size() > N) {
+        throw std::invalid_argument(std::string("invalid ") + field);
+    }
+    std::array<uint8_t, N> out{};
+    std::copy(bytes.begin(), bytes.end(), out.end() - bytes.size());
+    return out;
+}
+
+/**
+ * Decode evm/call and evm/estimate_gas parameters: an object (or an array
+ * holding one) with hex "to" (or "address"), "from", "data" (or "input")
+ * and "value" (hex or number), numeric "gas" and "base_fee", and an
+ * EIP-2930 "accessList" of {"address", "storageKeys"} objects. "gas" is
+ * clamped to gas_cap.
+ */
+pantheon::obolos::CallRequest ParseEvmCall(const std::string& params, uint64_t gas_cap) {
+    json p = json::parse(params);
+    if (p.is_array() && !p.empty()) {
+        json first = p[0];
+        p = std::move(first);
+    }
+    if (!p.is_object()) {
+        throw std::invalid_argument("expected call object");
+    }
+
+    pantheon::obolos::CallRequest call;
+    const char* to_field = p.contains("to") ? "to" : "address";
+    if (p.contains(to_field) && !p[to_field].is_null()) {
+        call.to = ParseEvmBytes<20>(p[to_field], to_field);
+    }
+    if (p.contains("from")) {
+        call.from = ParseEvmBytes<20>(p["from"], "from");
+    }
+    const char* data_field = p.contains("data") ? "data" : "input";
+    if (p.contains(data_field) &&
+        (!p[data_field].is_string() ||
+         !pantheon::obolos::DecodeHex(p[data_field].get<std::string>(), call.data))) {
+        throw std::invalid_argument(std::string("invalid ") + data_field);
+    }
+    if (p.contains("value")) {
+        call.value = p["value"].is_number_unsigned()
+                         ? parthenon::evm::ToUint256(p["value"].get<uint64_t>())
+                         : ParseEvmBytes<32>(p["value"], "value");
+    }
+    if (p.contains("accessList")) {
+        const json& access_list = p["accessList"];
+        if (!access_list.is_array()) {
+            throw std::invalid_argument("invalid accessList");
+        }
+        for (const json& item : access_list) {
+            if (!item.is_object() || !item["storageKeys"].is_array()) {
+                throw std::invalid_argument("invalid accessList entry");
+            }
+            parthenon::evm::AccessListEntry entry;
+            entry.address = ParseEvmBytes<20>(item["address"], "accessList address");
+            for (const json& key : item["storageKeys"]) {
+                entry.storage_keys.push_back(ParseEvmBytes<32>(key, "accessList storage key"));
+            }
+            call.access_list.push_back(std::move(entry));
+        }
+    }
+    call.gas_limit = (std::min)(p.value("gas", kDefaultEvmCallGas), gas_cap);
+    call.gas_price = p.value("base_fee", uint64_t{10});  // OBL_GWEI default
+    return call;
+}
+
+std::string SerializeError(int code, const std::string& message, const json& id = nullptr) {
+    json error_response;
+    error_response["jsonrpc"] = "2.0";
+    error_response["error"] = {{"code", code}, {"message", message}};
+    error_response["id"] = id;
+    return error_response.dump();
+}
+
+// id is the request's "id" exactly as the client sent it: a string, a
+// number or null
+std::string SerializeResponse(const RPCResponse& rpc_res, const json& id) {
+    json response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = id;
+
+    if (rpc_res.IsError()) {
+        response["error"] = {{"code", -1}, {"message", rpc_res.error}};
+    } else {
+        // Parse result as JSON if possible
+        try {
+            response["result"] = json::parse(rpc_res.result);
+        } catch (...) {
+            response["result"] = rpc_res.result;
+        }
+    }
+    return response.dump();
+}
+
+/**
+ * Decode one request object without throwing
+ * @param id Receives the request's "id" to echo back (null if absent)
+ * @return false if j is not a valid request object (-32600), including an
+ *         "id" that is not a string, number or null; id is then null
+ */
+bool ParseRequestObject(const json& j, RPCRequest& rpc_req, json& id) {
+    id = nullptr;
+    if (!j.is_object()) {
+        return false;
+    }
+    if (j.contains("id")) {
+        const json& request_id = j["id"];
+        if (!request_id.is_string() && !request_id.is_number() && !request_id.is_null()) {
+            return false;
+        }
+        id = request_id;
+    }
+
+    if (!j.contains("method") || !j["method"].is_string()) {
+        return false;
+    }
+    rpc_req.method = j["method"].get<std::string>();
+
+    // Handlers see string ids as-is and other ids as JSON text
+    rpc_req.id = id.is_string() ? id.get<std::string>() : id.is_null() ? "" : id.dump();
+
+    // Convert params to JSON string
+    if (j.contains("params")) {
+        const json& params = j["params"];
+        if (!params.is_array() && !params.is_object()) {
+            return false;
+        }
+        rpc_req.params = params.dump();
+    }
+    return true;
+}
+
+#ifndef CPP_HTTPLIB_STUB_H
+bool IsBatchBody(const std::string& body) {
+    for (char c : body) {
+        if (std::isspace(static_cast<unsigned char>(c)) == 0) {
+            return c == '[';
+        }
+    }
+    return false;
+}
+#endif
+
+/**
+ * Completed batch elements waiting to be streamed to the client.
+ * Shared with worker tasks so it outlives any early return.
+ */
+struct BatchState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::string> completed;
+    size_t pending = 0;
+};
+
+}  // namespace
+
 RPCServer::RPCServer(uint16_t port)
     : port_(port),
       running_(false),
       node_(nullptr),
       wallet_(nullptr),
-      rate_limiter_(std::make_unique<RateLimiter>(100, 60)) {
+      rate_limiter_(std::make_unique<RateLimiter>(100, 60)),
+      worker_pool_(std::make_unique<RPCWorkerPool>(
+          (std::max)(kMinBatchWorkers, static_cast<size_t>(std::thread::hardware_concurrency())),
+          kDefaultBatchQueue)),
+      max_batch_size_(kDefaultMaxBatchSize),
+      response_cache_(std::make_shared<RPCResponseCache>(kDefaultCacheEntries,
+                                                          kDefaultCacheBytes)) {
     if (!parthenon::common::monetary::ValidateMonetaryInvariants()) {
         throw std::runtime_error("Monetary constants invariant violation at startup");
     }
     InitializeStandardMethods();
+
+    // Wallet mutations are serialized so concurrent batch elements cannot
+    // race on key derivation or coin selection.
+    SetMethodConcurrencyLimit("getnewaddress", 1);
+    SetMethodConcurrencyLimit("sendtoaddress", 1);
+    SetMethodConcurrencyLimit("stop", 1);
+
+    // Deploys run the EVM and block fetches serialize whole blocks; charge
+    // them more than plain lookups.
+    SetMethodRateCost("evm/deploy", 10);
+    SetMethodRateCost("evm/call", 5);
+    SetMethodRateCost("evm/estimate_gas", 5);
+    SetMethodRateCost("getblock", 2);
+
+    // Read-only methods whose result depends only on the tip and governance
+    // state. chain/info also reports peers and sync progress, so bound its age.
+    CachePolicy cached;
+    cached.cacheable = true;
+    for (const char* method : {"getblock", "getblockcount", "chain/monetary_spec",
+                               "governance/list_proposals", "governance/get_proposal",
+                               "governance/tally", "treasury/balance", "staking/get_power",
+                               "ostracism/list_bans"}) {
+        SetMethodCachePolicy(method, cached);
+    }
+    CachePolicy short_lived = cached;
+    short_lived.max_age = std::chrono::milliseconds(1000);
+    SetMethodCachePolicy("chain/info", short_lived);
+
+    CachePolicy invalidates;
+    invalidates.invalidates = true;
+    for (const char* method : {"governance/submit_proposal", "governance/vote",
+                               "governance/execute", "staking/stake", "staking/unstake",
+                               "staking/deposit", "ostracism/nominate"}) {
+        SetMethodCachePolicy(method, invalidates);
+    }
 }
 
 RPCServer::~RPCServer() {
@@ -216,7 +431,22 @@ RPCServer::~RPCServer() {
 }
 
 void RPCServer::SetNode(node::Node* node) {
+    // Unhook the previous node so repeated calls don't pile up callbacks
+    if (node_) {
+        node_->RemoveBlockCallback(node_block_callback_);
+        node_block_callback_ = 0;
+    }
     node_ = node;
+    response_cache_->Clear();
+    if (node_) {
+        // The node may outlive this server, so only hold the cache weakly
+        std::weak_ptr<RPCResponseCache> weak_cache = response_cache_;
+        node_block_callback_ = node_->OnNewBlock([weak_cache](const primitives::Block&) {
+            if (auto cache = weak_cache.lock()) {
+                cache->Clear();
+            }
+        });
+    }
 }
 
 void RPCServer::SetWallet(wallet::Wallet* wallet) {
@@ -267,6 +497,31 @@ bool RPCServer::Start() {
         std::string body = metrics_.PrometheusText();
         res.set_content(body, "text/plain; version=0.0.4; charset=utf-8");
     });
+
+    // Explorers and relayers fetch many blocks back to back; keep connections open
+    http_server_->set_keep_alive_max_count(1000);
+    http_server_->set_keep_alive_timeout(10);
+
+    if (rest_enabled_) {
+        http_server_->Get(R"(/rest/.*)", [this](const httplib::Request& req,
+                                               httplib::Response& res) {
+            if (!rate_limiter_->AllowRequest(req.remote_addr)) {
+                res.status = 429;
+                res.set_content("Rate limit exceeded\r\n", "text/plain");
+                return;
+            }
+
+            auto rest = RestHandler(node_).Handle(req.path);
+            metrics_.Increment("pantheon_rest_requests_total",
+                               {{"status", std::to_string(rest.status)}});
+
+            // cpp-httplib applies any Range header to the body and answers
+            // 206/416 with Content-Range itself
+            res.status = rest.status;
+            res.set_header("Accept-Ranges", "bytes");
+            res.set_content(std::move(rest.body), rest.content_type);
+        });
+    }
 #endif
 
     http_server_->Post("/", [this](const httplib::Request& req, httplib::Response& res) {
@@ -301,46 +556,34 @@ bool RPCServer::Start() {
                 }
             }
 
-            // Parse JSON-RPC request
-            auto j = json::parse(req.body);
-
-            RPCRequest rpc_req;
-            rpc_req.method = j.value("method", "");
-            rpc_req.id = j.value("id", "");
-
-            // Convert params to JSON string
-            if (j.contains("params")) {
-                rpc_req.params = j["params"].dump();
-            }
-
-            // Handle the request
-            RPCResponse rpc_res = HandleRequest(rpc_req, client_ip);
-
-            // Build JSON-RPC response
-            json response;
-            response["jsonrpc"] = "2.0";
-            response["id"] = rpc_res.id;
-
-            if (rpc_res.IsError()) {
-                response["error"] = {{"code", -1}, {"message", rpc_res.error}};
-            } else {
-                // Parse result as JSON if possible
-                try {
-                    response["result"] = json::parse(rpc_res.result);
-                } catch (...) {
-                    response["result"] = rpc_res.result;
-                }
+#ifndef CPP_HTTPLIB_STUB_H
+            // Stream batch responses element by element as handlers finish
+            if (IsBatchBody(req.body)) {
+                auto body = req.body;
+                res.set_chunked_content_provider(
+                    "application/json",
+                    [this, body, client_ip](size_t /* offset */, httplib::DataSink& sink) {
+                        // Nothing above this lambda would catch, so end the
+                        // response rather than let an exception reach httplib
+                        try {
+                            ProcessRequestBody(body, client_ip, [&sink](const std::string& chunk) {
+                                return sink.write(chunk.data(), chunk.size());
+                            });
+                        } catch (const std::exception& e) {
+                            std::cerr << "RPC batch aborted: " << e.what() << std::endl;
+                        }
+                        sink.done();
+                        return true;
+                    });
+                return;
             }
+#endif
 
-            res.set_content(response.dump(), "application/json");
+            res.set_content(ProcessRequestBody(req.body, client_ip), "application/json");
 
         } catch (const std::exception& e) {
-            json error_response;
-            error_response["jsonrpc"] = "2.0";
-            error_response["error"] = {{"code", -32700},
-                                       {"message", "Parse error: " + std::string(e.what())}};
-            error_response["id"] = nullptr;
-            res.set_content(error_response.dump(), "application/json");
+            res.set_content(SerializeError(-32700, "Parse error: " + std::string(e.what())),
+                            "application/json");
         }
     });
 
@@ -381,8 +624,61 @@ void RPCServer::RegisterMethod(const std::string& method, RPCHandler handler) {
     methods_[method] = handler;
 }
 
+void RPCServer::ConfigureWorkerPool(size_t num_threads, size_t max_queue) {
+    worker_pool_ = std::make_unique<RPCWorkerPool>(num_threads, max_queue);
+}
+
+void RPCServer::SetMethodConcurrencyLimit(const std::string& method, size_t limit) {
+    method_limits_.SetLimit(method, limit);
+}
+
+void RPCServer::SetMethodCachePolicy(const std::string& method, const CachePolicy& policy) {
+    cache_policies_[method] = policy;
+}
+
+void RPCServer::ConfigureResponseCache(size_t max_entries, size_t max_bytes) {
+    response_cache_->Resize(max_entries, max_bytes);
+}
+
+void RPCServer::InvalidateResponseCache() {
+    state_version_.fetch_add(1);
+    response_cache_->Clear();
+}
+
+std::string RPCServer::CacheVersion() const {
+    std::string version;
+    if (node_) {
+        const auto tip = node_->GetTipSnapshot();
+        version = std::to_string(tip->sequence) + ":";
+        static const char digits[] = "0123456789abcdef";
+        for (uint8_t byte : tip->hash) {
+            version += digits[byte >> 4];
+            version += digits[byte & 0x0F];
+        }
+    }
+    version += "/" + std::to_string(state_version_.load());
+    return version;
+}
+
 void RPCServer::ConfigureRateLimit(uint32_t requests_per_window, uint32_t window_seconds) {
     rate_limiter_ = std::make_unique<RateLimiter>(requests_per_window, window_seconds);
+    for (const auto& [method, cost] : rate_costs_) {
+        rate_limiter_->SetMethodCost(method, cost);
+    }
+}
+
+void RPCServer::SetMethodRateCost(const std::string& method, uint32_t cost) {
+    rate_costs_[method] = cost;
+    rate_limiter_->SetMethodCost(method, cost);
+}
+
+bool RPCServer::ChargeRateLimit(const std::string& client_ip, const std::string& method,
+                                bool already_charged) {
+    uint32_t cost = rate_limiter_->GetMethodCost(method);
+    if (already_charged && cost > 0) {
+        --cost;
+    }
+    return cost == 0 || rate_limiter_->AllowCost(MakeClientKey(client_ip), cost);
 }
 
 void RPCServer::ConfigureBasicAuth(const std::string& user, const std::string& password) {
@@ -421,6 +717,25 @@ RPCResponse RPCServer::HandleRequest(const RPCRequest& request,
         return response;
     }
 
+    CachePolicy policy;
+    auto policy_it = cache_policies_.find(request.method);
+    if (policy_it != cache_policies_.end()) {
+        policy = policy_it->second;
+    }
+
+    std::string cache_key;
+    if (policy.cacheable) {
+        cache_key = RPCResponseCache::MakeKey(request.method, request.params, CacheVersion());
+        if (auto cached = response_cache_->Get(cache_key, policy.max_age)) {
+            metrics_.Increment("pantheon_rpc_cache_hits_total", {{"method", request.method}});
+            metrics_.Increment("pantheon_rpc_requests_total",
+                               {{"method", request.method}, {"status", "ok"}});
+            response.result = std::move(*cached);
+            return response;
+        }
+        metrics_.Increment("pantheon_rpc_cache_misses_total", {{"method", request.method}});
+    }
+
     // Time the handler and update Prometheus metrics.
     {
         pantheon::common::ScopedTimer timer(
@@ -430,9 +745,167 @@ RPCResponse RPCServer::HandleRequest(const RPCRequest& request,
     const std::string status = response.IsError() ? "error" : "ok";
     metrics_.Increment("pantheon_rpc_requests_total",
                        {{"method", request.method}, {"status", status}});
+
+    if (!response.IsError()) {
+        if (policy.cacheable) {
+            response_cache_->Put(cache_key, response.result);
+            const auto stats = response_cache_->GetStats();
+            metrics_.SetGauge("pantheon_rpc_cache_entries", static_cast<double>(stats.entries));
+            metrics_.SetGauge("pantheon_rpc_cache_bytes", static_cast<double>(stats.bytes));
+        } else if (policy.invalidates) {
+            InvalidateResponseCache();
+        }
+    }
     return response;
 }
 
+std::string RPCServer::DispatchSerialized(const RPCRequest& request, const json& id,
+                                          const std::string& client_ip) {
+    std::string out;
+    try {
+        out = SerializeResponse(HandleRequest(request, client_ip), id);
+    } catch (const std::exception& e) {
+        out = SerializeError(-32603, "Internal error: " + std::string(e.what()), id);
+    }
+    method_limits_.Release(request.method);
+    return out;
+}
+
+std::string RPCServer::ProcessRequestBody(const std::string& body, const std::string& client_ip) {
+    std::string out;
+    ProcessRequestBody(body, client_ip, [&out](const std::string& chunk) {
+        out += chunk;
+        return true;
+    });
+    return out;
+}
+
+void RPCServer::ProcessRequestBody(const std::string& body, const std::string& client_ip,
+                                   const std::function<bool(const std::string&)>& write) {
+    json j;
+    try {
+        j = json::parse(body);
+    } catch (const std::exception& e) {
+        write(SerializeError(-32700, "Parse error: " + std::string(e.what())));
+        return;
+    }
+
+    if (!j.is_array()) {
+        RPCRequest rpc_req;
+        json id;
+        if (!ParseRequestObject(j, rpc_req, id)) {
+            write(SerializeError(-32600, "Invalid Request", id));
+            return;
+        }
+        if (!ChargeRateLimit(client_ip, rpc_req.method, true)) {
+            write(SerializeError(-32001, "Rate limit exceeded. Please try again later.", id));
+            return;
+        }
+        method_limits_.Acquire(rpc_req.method);
+        write(DispatchSerialized(rpc_req, id, client_ip));
+        return;
+    }
+
+    if (j.empty()) {
+        write(SerializeError(-32600, "Invalid Request: empty batch"));
+        return;
+    }
+    if (j.size() > max_batch_size_) {
+        write(SerializeError(-32600, "Invalid Request: batch exceeds " +
+                                         std::to_string(max_batch_size_) + " elements"));
+        return;
+    }
+
+    metrics_.Increment("pantheon_rpc_batch_requests_total");
+    metrics_.Observe("pantheon_rpc_batch_size", static_cast<double>(j.size()));
+
+    auto state = std::make_shared<BatchState>();
+    bool client_open = write("[");
+    bool first_element = true;
+
+    auto emit = [&](const std::string& element) {
+        if (!client_open) {
+            return;
+        }
+        client_open = write(first_element ? element : "," + element);
+        first_element = false;
+    };
+
+    // Write out everything that has completed so far without blocking
+    auto drain = [&]() {
+        std::deque<std::string> ready;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            ready.swap(state->completed);
+        }
+        for (const auto& element : ready) {
+            emit(element);
+        }
+    };
+
+    for (size_t i = 0; i < j.size(); ++i) {
+        // A bad element gets its own error; the rest of the batch still runs
+        RPCRequest rpc_req;
+        json id;
+        if (!ParseRequestObject(j[i], rpc_req, id)) {
+            emit(SerializeError(-32600, "Invalid Request", id));
+            continue;
+        }
+
+        // The HTTP request itself already consumed one rate-limit token
+        if (!ChargeRateLimit(client_ip, rpc_req.method, i == 0)) {
+            emit(SerializeError(-32001, "Rate limit exceeded. Please try again later.", id));
+            continue;
+        }
+
+        // Block the dispatching thread, never a pool worker, on method limits
+        method_limits_.Acquire(rpc_req.method);
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            ++state->pending;
+        }
+
+        auto task = [this, state, rpc_req, id, client_ip]() {
+            std::string element = DispatchSerialized(rpc_req, id, client_ip);
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->completed.push_back(std::move(element));
+                --state->pending;
+            }
+            state->cv.notify_all();
+        };
+
+        // Queue full: run inline, which also throttles this batch
+        if (!worker_pool_->TrySubmit(task)) {
+            task();
+        }
+        drain();
+    }
+
+    while (true) {
+        std::deque<std::string> ready;
+        bool done = false;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->cv.wait(lock, [&state]() {
+                return state->pending == 0 || !state->completed.empty();
+            });
+            ready.swap(state->completed);
+            done = state->pending == 0;
+        }
+        for (const auto& element : ready) {
+            emit(element);
+        }
+        if (done) {
+            break;
+        }
+    }
+
+    if (client_open) {
+        write("]");
+    }
+}
+
 void RPCServer::InitializeStandardMethods() {
     RegisterMethod("getinfo", [this](const RPCRequest& req) { return HandleGetInfo(req); });
     RegisterMethod("getbalance", [this](const RPCRequest& req) { return HandleGetBalance(req); });
@@ -453,21 +926,26 @@ void RPCServer::InitializeStandardMethods() {
     RegisterMethod("commitments/list", [this](const RPCRequest& req) { return HandleCommitmentList(req); });
     RegisterMethod("evm/deploy", [this](const RPCRequest& req) { return HandleEvmDeploy(req); });
     RegisterMethod("evm/call", [this](const RPCRequest& req) {
-        // Execute a read-only EVM-like call using the L3 execution engine.
+        // Execute a read-only call against the latest published L3 state.
         RPCResponse response;
         response.id = req.id;
         try {
-            auto p = json::parse(req.params);
-            std::string payload   = p.value("data", "");
-            uint64_t gas_limit    = p.value("gas", uint64_t{21000});
-            uint64_t base_fee     = p.value("base_fee", uint64_t{10});  // OBL_GWEI default
-
-            auto exec_result = pantheon::obolos::ExecuteEvmLikeCall(payload, gas_limit, base_fee);
+            const auto call = ParseEvmCall(req.params, evm_gas_cap_);
+            const auto state = evm_state_.Get();
+            if (!state) {
+                response.error = "evm/call error: EVM state not available";
+                return response;
+            }
+            const auto exec_result = pantheon::obolos::ExecuteCall(*state, call);
 
             json result;
-            result["status"]      = exec_result.success ? "ok" : "revert";
-            result["return_data"] = exec_result.output;
+            result["status"]      = exec_result.Succeeded() ? "ok" : "revert";
+            result["return_data"] = pantheon::obolos::EncodeHex(exec_result.output);
             result["gas_used"]    = exec_result.gas_used;
+            if (exec_result.created) {
+                result["contract_address"] = pantheon::obolos::EncodeHex(
+                    std::vector<uint8_t>(exec_result.created->begin(), exec_result.created->end()));
+            }
             response.result = result.dump();
         } catch (const std::exception& e) {
             response.error = std::string("evm/call error: ") + e.what();
@@ -475,19 +953,25 @@ void RPCServer::InitializeStandardMethods() {
         return response;
     });
     RegisterMethod("evm/estimate_gas", [this](const RPCRequest& req) {
-        // Estimate gas by performing a dry-run through the L3 execution engine.
+        // Binary search the lowest gas limit the call succeeds with; "gas"
+        // is the ceiling.
         RPCResponse response;
         response.id = req.id;
         try {
-            auto p = json::parse(req.params);
-            std::string payload = p.value("data", "");
-            uint64_t gas_limit  = p.value("gas", uint64_t{10000000});  // generous ceiling
-            uint64_t base_fee   = p.value("base_fee", uint64_t{10});
-
-            auto exec_result = pantheon::obolos::ExecuteEvmLikeCall(payload, gas_limit, base_fee);
+            const auto call = ParseEvmCall(req.params, evm_gas_cap_);
+            const auto state = evm_state_.Get();
+            if (!state) {
+                response.error = "evm/estimate_gas error: EVM state not available";
+                return response;
+            }
+            const auto estimate = pantheon::obolos::EstimateGas(*state, call, evm_gas_cap_);
+            if (!estimate.success) {
+                response.error = "evm/estimate_gas error: call fails with " +
+                                 std::to_string(estimate.gas) + " gas";
+                return response;
+            }
 
-            // Return the gas consumed by the dry-run.
-            json result = exec_result.gas_used;
+            json result = estimate.gas;
             response.result = result.dump();
         } catch (const std::exception& e) {
             response.error = std::string("evm/estimate_gas error: ") + e.what();
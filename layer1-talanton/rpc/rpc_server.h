@@ -4,8 +4,15 @@
 #pragma once
 
 #include "rate_limiter.h"
+#include "response_cache.h"
+#include "worker_pool.h"
 #include "common/metrics/metrics.h"
+#include "evm/execution.h"
 
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -47,7 +54,7 @@ namespace rpc {
 struct RPCRequest {
     std::string method;
     std::string params;  // JSON string
-    std::string id;
+    std::string id;      // String ids as-is, numeric ids as JSON text
 };
 
 /**
@@ -66,11 +73,24 @@ struct RPCResponse {
  */
 using RPCHandler = std::function<RPCResponse(const RPCRequest&)>;
 
+/**
+ * Response caching policy for one RPC method
+ */
+struct CachePolicy {
+    bool cacheable = false;                // Serve repeat calls from the response cache
+    bool invalidates = false;              // Successful calls change cached state
+    std::chrono::milliseconds max_age{0};  // 0 = valid until tip/state changes
+};
+
 /**
  * JSON-RPC Server
  *
  * Provides HTTP/JSON-RPC interface for blockchain operations.
  * Handles wallet commands, blockchain queries, and network information.
+ *
+ * JSON-RPC 2.0 batch arrays are executed concurrently on a bounded worker
+ * pool; response objects are streamed back in completion order (the spec
+ * allows any order, clients match on "id").
  */
 class RPCServer {
   public:
@@ -101,6 +121,22 @@ class RPCServer {
     void SetSnapshotRegistry(governance::SnapshotRegistry* s){ snapshot_registry_= s; }
     void SetOstracism(governance::Ostracism* o)              { ostracism_        = o; }
 
+    /**
+     * Publish the Obolos state that evm/call and evm/estimate_gas run
+     * against. Call with a copy after each block; dry runs in progress keep
+     * the state they started with. Until the first publish both methods
+     * report that EVM state is not available.
+     */
+    void PublishEvmState(std::shared_ptr<const parthenon::evm::WorldState> state) {
+        evm_state_.Publish(std::move(state));
+    }
+
+    /**
+     * Most gas one evm/call or evm/estimate_gas may use; larger "gas"
+     * values are clamped to it
+     */
+    void ConfigureEvmGasCap(uint64_t gas_cap) { evm_gas_cap_ = gas_cap; }
+
     /**
      * Start the RPC server
      * @return true if server started successfully
@@ -132,6 +168,72 @@ class RPCServer {
      */
     RPCResponse HandleRequest(const RPCRequest& request, const std::string& client_ip = "");
 
+    /**
+     * Process a raw JSON-RPC HTTP body (single request object or batch array)
+     * @param body HTTP request body
+     * @param client_ip Client IP address; every batch element after the first
+     *        is charged against the rate limiter
+     * @param write Receives the serialized response in one or more chunks.
+     *        Returning false stops further writes (client went away); handlers
+     *        already in flight still run to completion.
+     */
+    void ProcessRequestBody(const std::string& body, const std::string& client_ip,
+                            const std::function<bool(const std::string&)>& write);
+
+    /**
+     * Process a raw JSON-RPC HTTP body and return the complete response
+     */
+    std::string ProcessRequestBody(const std::string& body, const std::string& client_ip = "");
+
+    /**
+     * Configure the batch worker pool. Call before Start().
+     * @param num_threads Worker threads (0 = hardware concurrency)
+     * @param max_queue Queued tasks before the dispatching thread runs
+     *        handlers inline
+     */
+    void ConfigureWorkerPool(size_t num_threads, size_t max_queue);
+
+    /**
+     * Limit concurrent in-flight calls of one method (0 = unlimited)
+     */
+    void SetMethodConcurrencyLimit(const std::string& method, size_t limit);
+
+    /**
+     * Maximum number of elements accepted in one batch
+     */
+    void ConfigureMaxBatchSize(size_t max_batch_size) { max_batch_size_ = max_batch_size; }
+
+    /**
+     * Set the caching policy for a method. Cached results are keyed by
+     * (method, canonical params, tip, state version) and are dropped on every
+     * new block.
+     */
+    void SetMethodCachePolicy(const std::string& method, const CachePolicy& policy);
+
+    /**
+     * Configure response cache limits (max_entries = 0 disables caching)
+     */
+    void ConfigureResponseCache(size_t max_entries, size_t max_bytes);
+
+    /**
+     * Drop all cached responses. Call after changing governance state outside
+     * of RPC so cached reads do not outlive it.
+     */
+    void InvalidateResponseCache();
+
+    /**
+     * Server metrics (request counts, latencies, cache hit/miss counters)
+     */
+    const pantheon::common::MetricsRegistry& GetMetrics() const { return metrics_; }
+
+    /**
+     * Enable the unauthenticated read-only REST interface under /rest/
+     * (see rest_handler.h). Disabled by default. Call before Start().
+     */
+    void EnableRest(bool enabled) { rest_enabled_ = enabled; }
+
+    bool IsRestEnabled() const { return rest_enabled_; }
+
     /**
      * Configure rate limiting
      * @param requests_per_window Maximum requests per window
@@ -139,6 +241,12 @@ class RPCServer {
      */
     void ConfigureRateLimit(uint32_t requests_per_window, uint32_t window_seconds);
 
+    /**
+     * Set how many rate-limit tokens one call of a method consumes (default 1).
+     * Costs survive ConfigureRateLimit().
+     */
+    void SetMethodRateCost(const std::string& method, uint32_t cost);
+
     /**
      * Configure optional HTTP Basic authentication.
      * Authentication is enabled only when both user and password are non-empty.
@@ -162,6 +270,7 @@ class RPCServer {
 
     // Component references
     node::Node* node_;
+    uint64_t node_block_callback_{0};  // OnNewBlock token held on node_
     wallet::Wallet* wallet_;
 
     // Governance subsystems (optional, not owned)
@@ -172,9 +281,27 @@ class RPCServer {
     governance::GovernanceParams*   gov_params_{nullptr};
     governance::SnapshotRegistry*   snapshot_registry_{nullptr};
     governance::Ostracism*          ostracism_{nullptr};
+
+    // Obolos state for EVM dry runs
+    pantheon::obolos::DryRunState evm_state_;
+    uint64_t evm_gas_cap_{pantheon::obolos::DEFAULT_CALL_GAS_CAP};
     
     // Rate limiting
     std::unique_ptr<RateLimiter> rate_limiter_;
+    std::map<std::string, uint32_t> rate_costs_;
+
+    // Batch execution
+    std::unique_ptr<RPCWorkerPool> worker_pool_;
+    MethodConcurrencyLimiter method_limits_;
+    size_t max_batch_size_;
+
+    // REST interface
+    bool rest_enabled_{false};
+
+    // Response cache (shared with the node's new-block callback)
+    std::shared_ptr<RPCResponseCache> response_cache_;
+    std::map<std::string, CachePolicy> cache_policies_;
+    std::atomic<uint64_t> state_version_{0};
 
     // Prometheus-compatible metrics registry
     mutable pantheon::common::MetricsRegistry metrics_;
@@ -193,6 +320,19 @@ class RPCServer {
     // Initialize standard RPC methods
     void InitializeStandardMethods();
 
+    // Version component of response cache keys (tip + state version)
+    std::string CacheVersion() const;
+
+    // Charge a method's rate-limit cost; already_charged = the HTTP request
+    // itself consumed one token for this call
+    bool ChargeRateLimit(const std::string& client_ip, const std::string& method,
+                         bool already_charged);
+
+    // Run one request under its method concurrency limit and serialize it;
+    // id is the client's "id", echoed back unchanged
+    std::string DispatchSerialized(const RPCRequest& request, const nlohmann::json& id,
+                                   const std::string& client_ip);
+
     // Standard method handlers
     RPCResponse HandleGetInfo(const RPCRequest& req);
     RPCResponse HandleGetBalance(const RPCRequest& req);
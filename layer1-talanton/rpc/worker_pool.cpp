@@ -0,0 +1,118 @@
+// ParthenonChain - RPC Worker Pool Implementation
+
+#include "worker_pool.h"
+
+#include <utility>
+
+namespace parthenon {
+namespace rpc {
+
+RPCWorkerPool::RPCWorkerPool(size_t num_threads, size_t max_queue)
+    : max_queue_(max_queue), stopping_(false) {
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+        if (num_threads == 0) {
+            num_threads = 2;
+        }
+    }
+
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.emplace_back(&RPCWorkerPool::WorkerLoop, this);
+    }
+}
+
+RPCWorkerPool::~RPCWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool RPCWorkerPool::TrySubmit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ || queue_.size() >= max_queue_) {
+            return false;
+        }
+        queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+size_t RPCWorkerPool::QueueDepth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void RPCWorkerPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            // Drain queued work before exiting so no caller waits forever
+            if (queue_.empty()) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();
+    }
+}
+
+void MethodConcurrencyLimiter::SetLimit(const std::string& method, size_t limit) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slots_[method].limit = limit;
+    }
+    cv_.notify_all();
+}
+
+size_t MethodConcurrencyLimiter::GetLimit(const std::string& method) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = slots_.find(method);
+    return it == slots_.end() ? 0 : it->second.limit;
+}
+
+void MethodConcurrencyLimiter::Acquire(const std::string& method) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = slots_.find(method);
+    if (it == slots_.end()) {
+        return;  // Unlimited and never configured
+    }
+
+    Slot& slot = it->second;
+    cv_.wait(lock, [&slot]() { return slot.limit == 0 || slot.active < slot.limit; });
+    ++slot.active;
+}
+
+void MethodConcurrencyLimiter::Release(const std::string& method) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = slots_.find(method);
+        if (it == slots_.end() || it->second.active == 0) {
+            return;
+        }
+        --it->second.active;
+    }
+    cv_.notify_all();
+}
+
+size_t MethodConcurrencyLimiter::InFlight(const std::string& method) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = slots_.find(method);
+    return it == slots_.end() ? 0 : it->second.active;
+}
+
+}  // namespace rpc
+}  // namespace parthenon
@@ -0,0 +1,97 @@
+// ParthenonChain - RPC Worker Pool
+// Bounded thread pool and per-method concurrency limits for RPC dispatch
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace parthenon {
+namespace rpc {
+
+/**
+ * Fixed-size worker pool with a bounded task queue.
+ *
+ * TrySubmit() never blocks: when the queue is full it returns false and the
+ * caller is expected to run the task itself, which throttles producers to the
+ * rate the pool can drain.
+ */
+class RPCWorkerPool {
+  public:
+    /**
+     * @param num_threads Worker threads (0 = hardware concurrency)
+     * @param max_queue Maximum number of queued (not yet running) tasks
+     */
+    RPCWorkerPool(size_t num_threads, size_t max_queue);
+    ~RPCWorkerPool();
+
+    RPCWorkerPool(const RPCWorkerPool&) = delete;
+    RPCWorkerPool& operator=(const RPCWorkerPool&) = delete;
+
+    /**
+     * Queue a task for execution on a worker thread
+     * @return false if the queue is full or the pool is shutting down
+     */
+    bool TrySubmit(std::function<void()> task);
+
+    size_t ThreadCount() const { return workers_.size(); }
+    size_t MaxQueue() const { return max_queue_; }
+    size_t QueueDepth() const;
+
+  private:
+    void WorkerLoop();
+
+    size_t max_queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::thread> workers_;
+    bool stopping_;
+};
+
+/**
+ * Caps the number of in-flight calls per RPC method.
+ *
+ * Methods without a configured limit are unrestricted. Acquire() blocks the
+ * dispatching thread (never a pool worker) until a slot is free.
+ */
+class MethodConcurrencyLimiter {
+  public:
+    /**
+     * Set the maximum concurrent calls for a method (0 removes the limit)
+     */
+    void SetLimit(const std::string& method, size_t limit);
+
+    /**
+     * Get the configured limit for a method (0 = unlimited)
+     */
+    size_t GetLimit(const std::string& method) const;
+
+    void Acquire(const std::string& method);
+    void Release(const std::string& method);
+
+    /**
+     * Number of calls currently holding a slot for a method
+     */
+    size_t InFlight(const std::string& method) const;
+
+  private:
+    struct Slot {
+        size_t limit = 0;
+        size_t active = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<std::string, Slot> slots_;
+};
+
+}  // namespace rpc
+}  // namespace parthenon
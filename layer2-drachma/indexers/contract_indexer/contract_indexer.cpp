@@ -3,126 +3,361 @@
 
 #include "contract_indexer.h"
 
+#include <leveldb/db.h>
+#include <leveldb/write_batch.h>
+
 #include <algorithm>
-#include <fstream>
-#include <sstream>
+#include <functional>
+#include <map>
+#include <set>
 
 namespace parthenon {
 namespace layer2 {
 namespace indexers {
 
+namespace {
+
+using Address = std::array<uint8_t, 20>;
+using Topic = std::array<uint8_t, 32>;
+using evm::LogBloom;
+
+constexpr size_t kVectorBytes = ContractIndexer::kSectionSize / 8;
+// Bit vector of the blocks that have any events, stored after the bloom bits
+constexpr uint16_t kAnyLogBit = LogBloom::kBits;
+
+void AppendU32(std::string& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+void AppendU64(std::string& out, uint64_t value) {
+    AppendU32(out, static_cast<uint32_t>(value >> 32));
+    AppendU32(out, static_cast<uint32_t>(value));
+}
+
+template <size_t N>
+void AppendBytes(std::string& out, const std::array<uint8_t, N>& bytes) {
+    out.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// Bounds-checked reader over an encoded record
+class Reader {
+  public:
+    explicit Reader(const std::string& data) : data_(data) {}
+
+    bool U32(uint32_t& value) {
+        if (pos_ + 4 > data_.size()) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value = (value << 8) | static_cast<uint8_t>(data_[pos_++]);
+        }
+        return true;
+    }
+
+    bool U64(uint64_t& value) {
+        uint32_t hi = 0;
+        uint32_t lo = 0;
+        if (!U32(hi) || !U32(lo)) {
+            return false;
+        }
+        value = (static_cast<uint64_t>(hi) << 32) | lo;
+        return true;
+    }
+
+    bool Bytes(uint8_t* out, size_t size) {
+        if (pos_ + size > data_.size()) {
+            return false;
+        }
+        std::copy(data_.begin() + pos_, data_.begin() + pos_ + size, out);
+        pos_ += size;
+        return true;
+    }
+
+    bool AtEnd() const { return pos_ == data_.size(); }
+
+  private:
+    const std::string& data_;
+    size_t pos_ = 0;
+};
+
+std::string BlockKey(char prefix, uint32_t height) {
+    std::string key(1, prefix);
+    AppendU32(key, height);
+    return key;
+}
+
+std::string VectorKey(uint32_t section, uint16_t bit) {
+    std::string key = BlockKey('s', section);
+    key.push_back(static_cast<char>(bit >> 8));
+    key.push_back(static_cast<char>(bit & 0xFF));
+    return key;
+}
+
+std::string ContractKey(const Address& address) {
+    std::string key = "a";
+    AppendBytes(key, address);
+    return key;
+}
+
+const std::string kHeadKey = "m:head";
+const std::string kEventCountKey = "m:events";
+
+void EncodeEvent(std::string& out, const ContractEvent& event) {
+    AppendBytes(out, event.contract_address);
+    AppendU32(out, event.tx_index);
+    AppendU32(out, static_cast<uint32_t>(event.topics.size()));
+    for (const auto& topic : event.topics) {
+        AppendBytes(out, topic);
+    }
+    AppendU32(out, static_cast<uint32_t>(event.data.size()));
+    out.append(event.data.begin(), event.data.end());
+}
+
+bool DecodeEvents(const std::string& data, uint32_t height, std::vector<ContractEvent>& events) {
+    Reader reader(data);
+    while (!reader.AtEnd()) {
+        ContractEvent event;
+        event.block_height = height;
+        uint32_t topic_count = 0;
+        uint32_t data_size = 0;
+        if (!reader.Bytes(event.contract_address.data(), event.contract_address.size()) ||
+            !reader.U32(event.tx_index) || !reader.U32(topic_count) || topic_count > 4) {
+            return false;
+        }
+        event.topics.resize(topic_count);
+        for (auto& topic : event.topics) {
+            if (!reader.Bytes(topic.data(), topic.size())) {
+                return false;
+            }
+        }
+        if (!reader.U32(data_size) || data_size > data.size()) {
+            return false;
+        }
+        event.data.resize(data_size);
+        if (!reader.Bytes(event.data.data(), data_size)) {
+            return false;
+        }
+        events.push_back(std::move(event));
+    }
+    return true;
+}
+
+bool Contains(const std::vector<Topic>& topics, const Topic& topic) {
+    return std::find(topics.begin(), topics.end(), topic) != topics.end();
+}
+
+}  // namespace
+
 class ContractIndexer::Impl {
   public:
-    Impl() : is_open_(false) {}
+    ~Impl() { Close(); }
 
     bool Open(const std::string& db_path) {
-        db_path_ = db_path;
+        Close();
+        leveldb::Options options;
+        options.create_if_missing = true;
+        leveldb::DB* db = nullptr;
+        if (!leveldb::DB::Open(options, db_path, &db).ok()) {
+            return false;
+        }
+        db_.reset(db);
 
-        // Load existing index
-        std::ifstream file(db_path_ + "/contract_index.dat", std::ios::binary);
-        if (file.is_open()) {
-            // Load contract index from file
-            file.close();
+        std::string value;
+        uint32_t head = 0;
+        if (Get(kHeadKey, value) && Reader(value).U32(head)) {
+            head_ = head;
+        }
+        if (Get(kEventCountKey, value)) {
+            Reader(value).U64(event_count_);
         }
 
-        is_open_ = true;
+        // Contract records sort first ("a"), so the scan stops at the first other key
+        std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(leveldb::ReadOptions()));
+        for (it->SeekToFirst(); it->Valid(); it->Next()) {
+            const std::string key = it->key().ToString();
+            if (key.size() != 1 + 20 || key[0] != 'a') {
+                break;
+            }
+            ContractInfo info;
+            std::copy(key.begin() + 1, key.end(), info.address.begin());
+            const std::string record = it->value().ToString();
+            Reader reader(record);
+            if (reader.U32(info.deployment_height) && reader.U64(info.event_count)) {
+                info.code.assign(record.begin() + 12, record.end());
+                contracts_[info.address] = std::move(info);
+            }
+        }
         return true;
     }
 
     void Close() {
-        if (!is_open_)
+        if (!db_) {
             return;
-
-        // Save index to file
-        std::ofstream file(db_path_ + "/contract_index.dat", std::ios::binary | std::ios::trunc);
-        if (file.is_open()) {
-            // Save contract index
-            file.close();
         }
-
-        is_open_ = false;
+        Flush();
+        db_.reset();
+        contracts_.clear();
+        section_cache_.clear();
+        head_.reset();
+        event_count_ = 0;
     }
 
-    void IndexContractDeployment(const std::array<uint8_t, 20>& address,
-                                 const std::vector<uint8_t>& code, uint32_t height) {
-        ContractInfo info;
+    void IndexContractDeployment(const Address& address, const std::vector<uint8_t>& code,
+                                 uint32_t height) {
+        ContractInfo& info = contracts_[address];
         info.address = address;
         info.code = code;
         info.deployment_height = height;
         info.event_count = 0;
-
-        contracts_[address] = info;
+        if (db_) {
+            db_->Put(leveldb::WriteOptions(), ContractKey(address), EncodeContract(info));
+        }
     }
 
     void IndexEvent(const ContractEvent& event) {
-        events_.push_back(event);
+        if (!pending_.empty() && pending_.front().block_height != event.block_height) {
+            Flush();
+        }
+        pending_.push_back(event);
+    }
 
-        // Update contract event count
-        auto it = contracts_.find(event.contract_address);
-        if (it != contracts_.end()) {
-            it->second.event_count++;
+    // Writes the buffered block: its events, bloom and bloom bits, and the
+    // updated counters, in one batch
+    void Flush() {
+        if (pending_.empty() || !db_) {
+            return;
+        }
+        const uint32_t height = pending_.front().block_height;
+        const uint32_t section = height / kSectionSize;
+        const uint32_t bit_in_section = height % kSectionSize;
+        leveldb::WriteBatch batch;
+
+        // A block indexed in several rounds is appended to
+        std::string events;
+        Get(BlockKey('l', height), events);
+        LogBloom block_bloom;
+        std::string stored_bloom;
+        if (Get(BlockKey('b', height), stored_bloom) && stored_bloom.size() == LogBloom::kBytes) {
+            LogBloom::Bytes bytes;
+            std::copy(stored_bloom.begin(), stored_bloom.end(), bytes.begin());
+            block_bloom = LogBloom(bytes);
         }
 
-        // Index by contract
-        events_by_contract_[event.contract_address].push_back(event);
+        std::set<uint16_t> bits = {kAnyLogBit};
+        std::set<Address> touched;
+        for (const auto& event : pending_) {
+            EncodeEvent(events, event);
+            for (const auto& positions : EventPositions(event)) {
+                block_bloom.Add(positions);
+                bits.insert(positions.begin(), positions.end());
+            }
+            auto it = contracts_.find(event.contract_address);
+            if (it != contracts_.end()) {
+                ++it->second.event_count;
+                touched.insert(event.contract_address);
+            }
+        }
+        batch.Put(BlockKey('l', height), events);
+        const auto& bloom_bytes = block_bloom.Data();
+        batch.Put(BlockKey('b', height), std::string(bloom_bytes.begin(), bloom_bytes.end()));
 
-        // Index by topic (for efficient filtering)
-        for (const auto& topic : event.topics) {
-            events_by_topic_[topic].push_back(events_.size() - 1);
+        if (section != cached_section_) {
+            section_cache_.clear();
+            cached_section_ = section;
+        }
+        for (uint16_t bit : bits) {
+            std::string& vector = CachedVector(section, bit);
+            vector[bit_in_section / 8] |= static_cast<char>(1 << (bit_in_section % 8));
+            batch.Put(VectorKey(section, bit), vector);
         }
-    }
 
-    std::vector<ContractEvent> GetEventsByContract(const std::array<uint8_t, 20>& contract_address,
-                                                   uint32_t limit) {
-        std::vector<ContractEvent> result;
+        for (const auto& address : touched) {
+            batch.Put(ContractKey(address), EncodeContract(contracts_[address]));
+        }
+        event_count_ += pending_.size();
+        if (!head_ || height > *head_) {
+            head_ = height;
+        }
+        std::string head;
+        AppendU32(head, *head_);
+        batch.Put(kHeadKey, head);
+        std::string count;
+        AppendU64(count, event_count_);
+        batch.Put(kEventCountKey, count);
+
+        db_->Write(leveldb::WriteOptions(), &batch);
+        pending_.clear();
+    }
 
-        auto it = events_by_contract_.find(contract_address);
-        if (it != events_by_contract_.end()) {
-            size_t count = std::min(static_cast<size_t>(limit), it->second.size());
-            result.assign(it->second.begin(), it->second.begin() + count);
+    std::vector<ContractEvent> GetLogs(const LogFilter& filter, uint32_t limit) {
+        std::vector<std::vector<LogBloom::Positions>> groups;
+        if (!filter.addresses.empty()) {
+            groups.emplace_back();
+            for (const auto& address : filter.addresses) {
+                groups.back().push_back(LogBloom::BitPositions(address));
+            }
+        }
+        for (const auto& alternatives : filter.topics) {
+            if (alternatives.empty()) {
+                continue;
+            }
+            groups.emplace_back();
+            for (const auto& topic : alternatives) {
+                groups.back().push_back(LogBloom::BitPositions(topic));
+            }
         }
 
-        return result;
+        return Query(filter.from_block, filter.to_block, groups, limit,
+                     [&](const ContractEvent& event) {
+                         if (!filter.addresses.empty() &&
+                             std::find(filter.addresses.begin(), filter.addresses.end(),
+                                       event.contract_address) == filter.addresses.end()) {
+                             return false;
+                         }
+                         for (size_t i = 0; i < filter.topics.size(); ++i) {
+                             if (!filter.topics[i].empty() &&
+                                 (i >= event.topics.size() ||
+                                  !Contains(filter.topics[i], event.topics[i]))) {
+                                 return false;
+                             }
+                         }
+                         return true;
+                     });
     }
 
-    std::vector<ContractEvent> GetEventsByTopic(const std::array<uint8_t, 32>& topic,
-                                                uint32_t limit) {
-        std::vector<ContractEvent> result;
+    std::vector<ContractEvent> GetEventsByTopic(const Topic& topic, uint32_t limit) {
+        return Query(0, UINT32_MAX, {{LogBloom::BitPositions(topic)}}, limit,
+                     [&](const ContractEvent& event) { return Contains(event.topics, topic); });
+    }
 
-        auto it = events_by_topic_.find(topic);
-        if (it != events_by_topic_.end()) {
-            for (size_t i = 0; i < std::min(static_cast<size_t>(limit), it->second.size()); ++i) {
-                size_t event_idx = it->second[i];
-                if (event_idx < events_.size()) {
-                    result.push_back(events_[event_idx]);
-                }
-            }
+    LogBloom GetBlockBloom(uint32_t height) {
+        Flush();
+        std::string value;
+        LogBloom::Bytes bytes{};
+        if (Get(BlockKey('b', height), value) && value.size() == bytes.size()) {
+            std::copy(value.begin(), value.end(), bytes.begin());
         }
-
-        return result;
+        return LogBloom(bytes);
     }
 
-    std::optional<ContractIndexer::ContractInfo>
-    GetContractInfo(const std::array<uint8_t, 20>& address) {
+    std::optional<ContractIndexer::ContractInfo> GetContractInfo(const Address& address) {
+        Flush();
         auto it = contracts_.find(address);
-        if (it != contracts_.end()) {
-            // Convert internal ContractInfo to external ContractInfo
-            ContractIndexer::ContractInfo result;
-            result.address = it->second.address;
-            result.code = it->second.code;
-            result.deployment_height = it->second.deployment_height;
-            result.event_count = it->second.event_count;
-            return result;
+        if (it == contracts_.end()) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        return it->second;
     }
 
     size_t GetContractCount() const { return contracts_.size(); }
 
-    size_t GetEventCount() const { return events_.size(); }
+    size_t GetEventCount() const { return event_count_ + pending_.size(); }
 
-    std::vector<std::array<uint8_t, 20>> GetAllContracts() const {
-        std::vector<std::array<uint8_t, 20>> result;
+    std::vector<Address> GetAllContracts() const {
+        std::vector<Address> result;
         for (const auto& pair : contracts_) {
             result.push_back(pair.first);
         }
@@ -130,28 +365,137 @@ class ContractIndexer::Impl {
     }
 
   private:
-    struct ContractInfo {
-        std::array<uint8_t, 20> address;
-        std::vector<uint8_t> code;
-        uint32_t deployment_height;
-        uint64_t event_count;
-    };
-
-    std::string db_path_;
-    bool is_open_;
-    std::map<std::array<uint8_t, 20>, ContractInfo> contracts_;
-    std::vector<ContractEvent> events_;
-    std::map<std::array<uint8_t, 20>, std::vector<ContractEvent>> events_by_contract_;
-    std::map<std::array<uint8_t, 32>, std::vector<size_t>> events_by_topic_;
+    using ContractInfo = ContractIndexer::ContractInfo;
+    using BitVector = std::string;  // kVectorBytes, bit i of the section in byte i / 8
+
+    static std::string EncodeContract(const ContractInfo& info) {
+        std::string record;
+        AppendU32(record, info.deployment_height);
+        AppendU64(record, info.event_count);
+        record.append(info.code.begin(), info.code.end());
+        return record;
+    }
+
+    static std::vector<LogBloom::Positions> EventPositions(const ContractEvent& event) {
+        std::vector<LogBloom::Positions> positions;
+        positions.push_back(LogBloom::BitPositions(event.contract_address));
+        for (const auto& topic : event.topics) {
+            positions.push_back(LogBloom::BitPositions(topic));
+        }
+        return positions;
+    }
+
+    bool Get(const std::string& key, std::string& value) const {
+        return db_ && db_->Get(leveldb::ReadOptions(), key, &value).ok();
+    }
+
+    // Vectors of the section being written are kept so each block costs no reads
+    BitVector& CachedVector(uint32_t section, uint16_t bit) {
+        auto it = section_cache_.find(bit);
+        if (it == section_cache_.end()) {
+            BitVector vector;
+            if (!Get(VectorKey(section, bit), vector) || vector.size() != kVectorBytes) {
+                vector.assign(kVectorBytes, '\0');
+            }
+            it = section_cache_.emplace(bit, std::move(vector)).first;
+        }
+        return it->second;
+    }
+
+    // Blocks of a section that may hold a match: for every group, any of its
+    // alternatives has all of its bits set. Empty if nothing can match.
+    BitVector Candidates(uint32_t section,
+                         const std::vector<std::vector<LogBloom::Positions>>& groups) {
+        BitVector candidates;
+        if (!Get(VectorKey(section, kAnyLogBit), candidates)) {
+            return {};
+        }
+        for (const auto& group : groups) {
+            BitVector any(kVectorBytes, '\0');
+            for (const auto& positions : group) {
+                BitVector all(kVectorBytes, '\xFF');
+                for (uint16_t bit : positions) {
+                    BitVector vector;
+                    if (!Get(VectorKey(section, bit), vector) || vector.size() != kVectorBytes) {
+                        all.clear();
+                        break;
+                    }
+                    for (size_t i = 0; i < kVectorBytes; ++i) {
+                        all[i] &= vector[i];
+                    }
+                }
+                if (!all.empty()) {
+                    for (size_t i = 0; i < kVectorBytes; ++i) {
+                        any[i] |= all[i];
+                    }
+                }
+            }
+            bool none = true;
+            for (size_t i = 0; i < kVectorBytes; ++i) {
+                candidates[i] &= any[i];
+                none = none && candidates[i] == 0;
+            }
+            if (none) {
+                return {};
+            }
+        }
+        return candidates;
+    }
+
+    std::vector<ContractEvent> Query(uint32_t from, uint32_t to,
+                                     const std::vector<std::vector<LogBloom::Positions>>& groups,
+                                     uint32_t limit,
+                                     const std::function<bool(const ContractEvent&)>& match) {
+        Flush();
+        std::vector<ContractEvent> result;
+        if (!head_ || from > to || limit == 0) {
+            return result;
+        }
+        to = std::min(to, *head_);
+
+        for (uint32_t section = from / kSectionSize; section <= to / kSectionSize; ++section) {
+            const BitVector candidates = Candidates(section, groups);
+            if (candidates.empty()) {
+                continue;
+            }
+            const uint32_t first = std::max(from, section * kSectionSize);
+            const uint32_t last = std::min<uint64_t>(to, uint64_t{section + 1} * kSectionSize - 1);
+            for (uint32_t height = first; height <= last; ++height) {
+                const uint32_t bit = height % kSectionSize;
+                if ((candidates[bit / 8] & (1 << (bit % 8))) == 0) {
+                    continue;
+                }
+                std::string record;
+                std::vector<ContractEvent> events;
+                if (!Get(BlockKey('l', height), record) || !DecodeEvents(record, height, events)) {
+                    continue;
+                }
+                for (auto& event : events) {
+                    if (match(event)) {
+                        result.push_back(std::move(event));
+                        if (result.size() >= limit) {
+                            return result;
+                        }
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    std::unique_ptr<leveldb::DB> db_;
+    std::map<Address, ContractInfo> contracts_;
+    std::optional<uint32_t> head_;  // Highest block with events
+    uint64_t event_count_ = 0;      // Written events
+    std::vector<ContractEvent> pending_;  // Events of the block being indexed
+
+    uint32_t cached_section_ = UINT32_MAX;
+    std::map<uint16_t, BitVector> section_cache_;
 };
 
 ContractIndexer::ContractIndexer() : impl_(std::make_unique<Impl>()) {}
 
-ContractIndexer::~ContractIndexer() {
-    if (impl_) {
-        impl_->Close();
-    }
-}
+ContractIndexer::~ContractIndexer() = default;
 
 bool ContractIndexer::Open(const std::string& db_path) {
     return impl_->Open(db_path);
@@ -173,7 +517,9 @@ void ContractIndexer::IndexEvent(const ContractEvent& event) {
 std::vector<ContractEvent>
 ContractIndexer::GetEventsByContract(const std::array<uint8_t, 20>& contract_address,
                                      uint32_t limit) {
-    return impl_->GetEventsByContract(contract_address, limit);
+    LogFilter filter;
+    filter.addresses.push_back(contract_address);
+    return impl_->GetLogs(filter, limit);
 }
 
 std::vector<ContractEvent> ContractIndexer::GetEventsByTopic(const std::array<uint8_t, 32>& topic,
@@ -181,18 +527,21 @@ std::vector<ContractEvent> ContractIndexer::GetEventsByTopic(const std::array<ui
     return impl_->GetEventsByTopic(topic, limit);
 }
 
+std::vector<ContractEvent> ContractIndexer::GetLogs(const LogFilter& filter, uint32_t limit) {
+    return impl_->GetLogs(filter, limit);
+}
+
+evm::LogBloom ContractIndexer::GetBlockBloom(uint32_t height) {
+    return impl_->GetBlockBloom(height);
+}
+
+void ContractIndexer::Flush() {
+    impl_->Flush();
+}
+
 std::optional<ContractIndexer::ContractInfo>
 ContractIndexer::GetContractInfo(const std::array<uint8_t, 20>& address) {
-    auto info_opt = impl_->GetContractInfo(address);
-    if (info_opt) {
-        ContractInfo result;
-        result.address = info_opt->address;
-        result.code = info_opt->code;
-        result.deployment_height = info_opt->deployment_height;
-        result.event_count = info_opt->event_count;
-        return result;
-    }
-    return std::nullopt;
+    return impl_->GetContractInfo(address);
 }
 
 size_t ContractIndexer::GetContractCount() const {
@@ -3,8 +3,10 @@
 
 #pragma once
 
+#include "layer3-obolos/evm/bloom.h"
 #include "layer3-obolos/evm/state.h"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -25,13 +27,41 @@ struct ContractEvent {
     uint32_t tx_index;
 };
 
+/**
+ * Log query in the style of eth_getLogs
+ */
+struct LogFilter {
+    uint32_t from_block = 0;
+    uint32_t to_block = UINT32_MAX;                  // Clamped to the last indexed block
+    std::vector<std::array<uint8_t, 20>> addresses;  // Any of these; empty matches all
+    // Per topic position, any of these; an empty position matches anything
+    std::vector<std::vector<std::array<uint8_t, 32>>> topics;
+};
+
 /**
  * Contract Indexer
  *
- * Indexes EVM smart contracts and their events
+ * Indexes EVM smart contracts and their events in LevelDB:
+ * - "a{address}" -> deployment height, event count and code
+ * - "b{height}" -> log bloom of the block
+ * - "l{height}" -> the block's events, in index order
+ * - "s{section}{bit}" -> bloom bit vector of a section
+ * - "m:*" -> indexed height and event count
+ *
+ * Heights and sections are big-endian. Blocks are grouped into sections of
+ * kSectionSize; for each of the 2048 bloom bits a section stores one bit per
+ * block (the blooms transposed), plus a vector of the blocks that have logs
+ * at all. A query ANDs the vectors of the bits its addresses and topics set,
+ * so it reads the events of candidate blocks only, and a section where any
+ * required vector is absent costs a single read.
+ *
+ * Events are buffered per block and written once the block changes, or on
+ * Flush(), a query or Close().
  */
 class ContractIndexer {
   public:
+    static constexpr uint32_t kSectionSize = 4096;
+
     ContractIndexer();
     ~ContractIndexer();
 
@@ -63,11 +93,26 @@ class ContractIndexer {
                                                    uint32_t limit = 100);
 
     /**
-     * Get events by topic (event signature)
+     * Get events by topic (event signature), in any topic position
      */
     std::vector<ContractEvent> GetEventsByTopic(const std::array<uint8_t, 32>& topic,
                                                 uint32_t limit = 100);
 
+    /**
+     * Events matching a filter, in block order
+     */
+    std::vector<ContractEvent> GetLogs(const LogFilter& filter, uint32_t limit = 10000);
+
+    /**
+     * Log bloom of a block (empty if the block has no events)
+     */
+    evm::LogBloom GetBlockBloom(uint32_t height);
+
+    /**
+     * Write events buffered for the current block
+     */
+    void Flush();
+
     /**
      * Contract information
      */
@@ -3,169 +3,744 @@
 
 #include "tx_indexer.h"
 
+#include "storage/block_storage.h"
+
+#include <leveldb/db.h>
+#include <leveldb/write_batch.h>
+
 #include <algorithm>
-#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <map>
 #include <memory>
-#include <sstream>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <thread>
 
 namespace parthenon {
 namespace layer2 {
 namespace indexers {
 
-// Simple file-based storage for now (can be upgraded to LevelDB/RocksDB later)
-class TxIndexer::Impl {
-  public:
-    Impl() : is_open_(false) {}
+namespace {
+
+const std::string kNextHeightKey = "m:next";
+const std::string kCountKey = "m:count";
+
+void AppendU32(std::string& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+void AppendU64(std::string& out, uint64_t value) {
+    AppendU32(out, static_cast<uint32_t>(value >> 32));
+    AppendU32(out, static_cast<uint32_t>(value));
+}
+
+uint32_t ReadU32(const std::string& data, size_t pos) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        value = (value << 8) | static_cast<uint8_t>(data[pos + i]);
+    }
+    return value;
+}
+
+uint64_t ReadU64(const std::string& data, size_t pos) {
+    return (static_cast<uint64_t>(ReadU32(data, pos)) << 32) | ReadU32(data, pos + 4);
+}
+
+std::string TxKey(const std::array<uint8_t, 32>& txid) {
+    return "t" + std::string(txid.begin(), txid.end());
+}
+
+std::string BlockKey(uint32_t height) {
+    std::string key = "b";
+    AppendU32(key, height);
+    return key;
+}
+
+std::string AddressPrefix(const std::vector<uint8_t>& address) {
+    std::string prefix = "a";
+    prefix.push_back(static_cast<char>(std::min<size_t>(address.size(), 0xFF)));
+    prefix.append(address.begin(), address.end());
+    return prefix;
+}
+
+// Inverted so that newer entries sort first
+std::string AddressKey(const std::vector<uint8_t>& address, uint32_t height, uint32_t tx_index) {
+    std::string key = AddressPrefix(address);
+    AppendU32(key, ~height);
+    AppendU32(key, ~tx_index);
+    return key;
+}
+
+// Size of a Bitcoin CompactSize, as BlockStorage lays blocks out
+size_t CompactSizeLength(uint64_t size) {
+    if (size < 253) {
+        return 1;
+    }
+    if (size <= 0xFFFF) {
+        return 3;
+    }
+    if (size <= 0xFFFFFFFF) {
+        return 5;
+    }
+    return 9;
+}
+
+// Addresses a transaction is indexed under
+std::set<std::vector<uint8_t>> TxAddresses(const primitives::Transaction& tx) {
+    std::set<std::vector<uint8_t>> addresses;
+    for (const auto& input : tx.inputs) {
+        // Skip coinbase inputs (all-zero txid)
+        if (input.prevout.txid != std::array<uint8_t, 32>{}) {
+            addresses.emplace(input.prevout.txid.begin(), input.prevout.txid.end());
+        }
+    }
+    for (const auto& output : tx.outputs) {
+        if (!output.pubkey_script.empty()) {
+            addresses.insert(output.pubkey_script);
+        }
+    }
+    return addresses;
+}
+
+using IndexEntries = std::vector<std::pair<std::string, std::string>>;
+
+// Location and address entries of a block's transactions, then the block's
+// record: its hash and each of those keys, length-prefixed
+void AppendBlockEntries(const primitives::Block& block, uint32_t height, IndexEntries& out) {
+    const size_t first = out.size();
+    uint64_t offset =
+        storage::BlockStorage::kHeaderSize + CompactSizeLength(block.transactions.size());
+    for (size_t i = 0; i < block.transactions.size(); ++i) {
+        const auto& tx = block.transactions[i];
+        const auto txid = tx.GetTxID();
+        const uint64_t length = tx.GetSerializedSize();
+
+        std::string location;
+        AppendU32(location, height);
+        AppendU32(location, static_cast<uint32_t>(i));
+        AppendU64(location, offset);
+        AppendU32(location, static_cast<uint32_t>(length));
+        out.emplace_back(TxKey(txid), std::move(location));
+
+        const std::string txid_value(txid.begin(), txid.end());
+        for (const auto& address : TxAddresses(tx)) {
+            out.emplace_back(AddressKey(address, height, static_cast<uint32_t>(i)), txid_value);
+        }
+        offset += length;
+    }
+
+    const auto hash = block.GetHash();
+    std::string record(hash.begin(), hash.end());
+    for (size_t i = first; i < out.size(); ++i) {
+        AppendU32(record, static_cast<uint32_t>(out[i].first.size()));
+        record += out[i].first;
+    }
+    out.emplace_back(BlockKey(height), std::move(record));
+}
+
+// Entries of a run of consecutive blocks, sorted by key
+struct IndexRun {
+    IndexEntries entries;
+    uint32_t end_height = 0;  // First height not included
+    bool complete = false;    // False if a block was missing
+    uint64_t transactions = 0;
+};
+
+IndexRun BuildRun(storage::BlockStorage& blocks, uint32_t from, uint32_t to) {
+    IndexRun run;
+    run.end_height = from;
+    for (uint32_t height = from; height < to; ++height) {
+        auto block = blocks.GetBlockByHeight(height);
+        if (!block) {
+            std::sort(run.entries.begin(), run.entries.end());
+            return run;
+        }
+        AppendBlockEntries(*block, height, run.entries);
+        run.transactions += block->transactions.size();
+        run.end_height = height + 1;
+    }
+    std::sort(run.entries.begin(), run.entries.end());
+    run.complete = true;
+    return run;
+}
+
+// Runs for [from, to), one chunk per worker thread
+std::vector<IndexRun> BuildRound(storage::BlockStorage& blocks, uint32_t from, uint32_t to,
+                                 uint32_t threads) {
+    std::vector<IndexRun> runs((to - from + TxIndexer::kReindexChunkBlocks - 1) /
+                               TxIndexer::kReindexChunkBlocks);
+    std::atomic<size_t> next_chunk{0};
+    auto worker = [&]() {
+        for (size_t chunk = next_chunk++; chunk < runs.size(); chunk = next_chunk++) {
+            const uint32_t start = from + static_cast<uint32_t>(chunk) * TxIndexer::kReindexChunkBlocks;
+            runs[chunk] =
+                BuildRun(blocks, start, std::min(to, start + TxIndexer::kReindexChunkBlocks));
+        }
+    };
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    return runs;
+}
 
-    bool Open(const std::string& db_path) {
-        db_path_ = db_path;
+}  // namespace
 
-        // Load existing index
-        std::ifstream file(db_path_ + "/tx_index.dat", std::ios::binary);
-        if (file.is_open()) {
-            // Load transaction index from file
-            // Format: txid(32) height(4) block_time(4) address_count(4) addresses...
-            file.close();
+class TxIndexer::Impl {
+  public:
+    ~Impl() { Close(); }
+
+    bool Open(const std::string& db_path, storage::BlockStorage* blocks) {
+        Close();
+        leveldb::Options options;
+        options.create_if_missing = true;
+        leveldb::DB* db = nullptr;
+        if (!leveldb::DB::Open(options, db_path, &db).ok()) {
+            return false;
         }
 
-        is_open_ = true;
+        std::lock_guard<std::mutex> lock(mutex_);
+        db_.reset(db);
+        blocks_ = blocks;
+        std::string value;
+        next_height_ = Get(kNextHeightKey, value) && value.size() == 4 ? ReadU32(value, 0) : 0;
+        count_ = Get(kCountKey, value) && value.size() == 8 ? ReadU64(value, 0) : 0;
         return true;
     }
 
     void Close() {
-        if (!is_open_)
-            return;
+        Stop();
+        std::lock_guard<std::mutex> lock(mutex_);
+        db_.reset();
+        blocks_ = nullptr;
+        next_height_ = 0;
+        count_ = 0;
+    }
 
-        // Save index to file
-        std::ofstream file(db_path_ + "/tx_index.dat", std::ios::binary | std::ios::trunc);
-        if (file.is_open()) {
-            // Save transaction index
-            file.close();
+    bool IndexBlock(const primitives::Block& block, uint32_t height) {
+        IndexEntries entries;
+        AppendBlockEntries(block, height, entries);
+        leveldb::WriteBatch batch;
+        for (const auto& [key, value] : entries) {
+            batch.Put(key, value);
         }
 
-        is_open_ = false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!db_ || height != next_height_) {
+            return false;
+        }
+        std::string next;
+        AppendU32(next, height + 1);
+        batch.Put(kNextHeightKey, next);
+        std::string count;
+        AppendU64(count, count_ + block.transactions.size());
+        batch.Put(kCountKey, count);
+        if (!db_->Write(leveldb::WriteOptions(), &batch).ok()) {
+            return false;
+        }
+        next_height_ = height + 1;
+        count_ += block.transactions.size();
+        progress_cv_.notify_all();
+        return true;
     }
 
-    void IndexTransaction(const primitives::Transaction& tx, uint32_t height, uint32_t block_time) {
-        auto txid = tx.GetTxID();
+    bool Rewind(uint32_t height) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (db_ && next_height_ > height) {
+            if (!DisconnectTip()) {
+                return false;
+            }
+        }
+        return db_ != nullptr;
+    }
 
-        TxInfo info;
-        info.tx = tx;
-        info.height = height;
-        info.block_time = block_time;
+    bool Reindex(uint32_t end_height, uint32_t threads, const ReindexProgressCallback& progress) {
+        Stop();
+        storage::BlockStorage* blocks = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocks = blocks_;
+        }
+        if (blocks == nullptr || !Clear()) {
+            return false;
+        }
 
-        // Store by txid
-        tx_by_id_[txid] = info;
+        // Workers build the next round of runs while this thread merges and
+        // writes the current one
+        threads = std::max<uint32_t>(threads, 1);
+        const uint32_t round_blocks = threads * kReindexChunkBlocks;
+        const auto started = std::chrono::steady_clock::now();
+        uint32_t round_end = std::min(end_height, round_blocks);
+        std::vector<IndexRun> current = BuildRound(*blocks, 0, round_end, threads);
+        while (!current.empty()) {
+            // Later runs are useless once a block is missing
+            auto missing = std::find_if(current.begin(), current.end(),
+                                        [](const IndexRun& run) { return !run.complete; });
+            if (missing != current.end()) {
+                current.erase(missing + 1, current.end());
+            }
+            const bool more = missing == current.end() && round_end < end_height;
+
+            std::vector<IndexRun> next;
+            std::thread builder;
+            const uint32_t next_end =
+                round_end + std::min(end_height - round_end, round_blocks);
+            if (more) {
+                builder = std::thread(
+                    [&, from = round_end]() { next = BuildRound(*blocks, from, next_end, threads); });
+            }
+            const bool written = WriteRuns(current);
+            if (builder.joinable()) {
+                builder.join();
+            }
+            if (!written) {
+                return false;
+            }
 
-        // Index spent transaction IDs from inputs for reverse lookup
-        for (const auto& input : tx.inputs) {
-            // Skip coinbase inputs (all-zero txid)
-            const bool is_coinbase =
-                input.prevout.txid == std::array<uint8_t, 32>{};
-            if (!is_coinbase) {
-                std::vector<uint8_t> spent_key(input.prevout.txid.begin(),
-                                               input.prevout.txid.end());
-                tx_by_address_[spent_key].push_back(txid);
+            if (progress) {
+                const double seconds = std::chrono::duration<double>(
+                                           std::chrono::steady_clock::now() - started)
+                                           .count();
+                ReindexProgress report;
+                report.next_height = GetNextHeight();
+                report.end_height = end_height;
+                report.transactions = GetTransactionCount();
+                report.blocks_per_second = seconds > 0 ? report.next_height / seconds : 0;
+                progress(report);
             }
+            if (!more) {
+                break;
+            }
+            round_end = next_end;
+            current = std::move(next);
+        }
+        return GetNextHeight() == end_height;
+    }
+
+    uint32_t GetNextHeight() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return next_height_;
+    }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_ || !db_ || blocks_ == nullptr) {
+            return;
+        }
+        running_ = true;
+        stopping_ = false;
+        notified_ = true;  // Catch up on whatever is stored already
+        thread_ = std::thread([this]() { CatchUpLoop(); });
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
         }
+    }
+
+    void NotifyNewBlock() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            notified_ = true;
+        }
+        wake_cv_.notify_one();
+    }
+
+    bool WaitForHeight(uint32_t height) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        progress_cv_.wait(lock, [&]() { return next_height_ >= height || !running_; });
+        return next_height_ >= height;
+    }
 
-        for (size_t i = 0; i < tx.outputs.size(); ++i) {
-            const auto& output = tx.outputs[i];
-            // Extract address from output script
-            std::vector<uint8_t> address;
+    std::vector<AddressTx> GetAddressHistory(const std::vector<uint8_t>& address, uint32_t limit,
+                                             const std::optional<AddressTx>& before) {
+        std::vector<AddressTx> result;
+        const std::string prefix = AddressPrefix(address);
+        const std::string start =
+            before ? AddressKey(address, before->height, before->tx_index) : prefix;
 
-            // Use pubkey_script as address identifier (first 20 bytes or full script)
-            if (output.pubkey_script.size() > 0) {
-                address = output.pubkey_script;
-                tx_by_address_[address].push_back(txid);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!db_) {
+            return result;
+        }
+        std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(leveldb::ReadOptions()));
+        for (it->Seek(leveldb::Slice(start)); it->Valid() && result.size() < limit; it->Next()) {
+            const std::string key = it->key().ToString();
+            if (key.compare(0, prefix.size(), prefix) != 0 || key.size() != prefix.size() + 8) {
+                break;
+            }
+            if (before && key == start) {
+                continue;
             }
+            const std::string value = it->value().ToString();
+            AddressTx entry;
+            std::copy(value.begin(), value.begin() + std::min<size_t>(value.size(), 32),
+                      entry.txid.begin());
+            entry.height = ~ReadU32(key, prefix.size());
+            entry.tx_index = ~ReadU32(key, prefix.size() + 4);
+            result.push_back(entry);
         }
+        return result;
     }
 
     std::vector<primitives::Transaction>
     GetTransactionsByAddress(const std::vector<uint8_t>& address, uint32_t limit) {
         std::vector<primitives::Transaction> result;
-
-        auto it = tx_by_address_.find(address);
-        if (it != tx_by_address_.end()) {
-            for (const auto& txid : it->second) {
-                if (result.size() >= limit)
-                    break;
-
-                auto tx_it = tx_by_id_.find(txid);
-                if (tx_it != tx_by_id_.end()) {
-                    result.push_back(tx_it->second.tx);
-                }
+        BlockCache cache;
+        for (const auto& entry : GetAddressHistory(address, limit, std::nullopt)) {
+            if (auto tx = LoadTransaction(entry.txid, cache)) {
+                result.push_back(std::move(*tx));
             }
         }
-
         return result;
     }
 
     std::optional<primitives::Transaction> GetTransactionById(const std::array<uint8_t, 32>& txid) {
-        auto it = tx_by_id_.find(txid);
-        if (it != tx_by_id_.end()) {
-            return it->second.tx;
+        BlockCache cache;
+        return LoadTransaction(txid, cache);
+    }
+
+    std::optional<TxLocation> GetTransactionLocation(const std::array<uint8_t, 32>& txid) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string value;
+        if (!Get(TxKey(txid), value) || value.size() != 20) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        return TxLocation{ReadU32(value, 0), ReadU32(value, 4), ReadU64(value, 8),
+                          ReadU32(value, 16)};
     }
 
-    size_t GetTransactionCount() const { return tx_by_id_.size(); }
+    size_t GetTransactionCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
 
     std::vector<primitives::Transaction> GetRecentTransactions(uint32_t limit) {
         std::vector<primitives::Transaction> result;
+        storage::BlockStorage* blocks = nullptr;
+        uint32_t height = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocks = blocks_;
+            height = next_height_;
+        }
+        while (blocks != nullptr && height > 0 && result.size() < limit) {
+            auto block = blocks->GetBlockByHeight(--height);
+            if (!block) {
+                break;
+            }
+            for (auto it = block->transactions.rbegin();
+                 it != block->transactions.rend() && result.size() < limit; ++it) {
+                result.push_back(*it);
+            }
+        }
+        return result;
+    }
 
-        // Collect all transactions
-        std::vector<TxInfo> all_txs;
-        for (const auto& pair : tx_by_id_) {
-            all_txs.push_back(pair.second);
+  private:
+    static constexpr size_t kWriteBatchBytes = 4 << 20;
+
+    // Delete every key, a batch at a time
+    bool Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!db_) {
+            return false;
         }
+        while (true) {
+            leveldb::WriteBatch batch;
+            size_t keys = 0;
+            {
+                std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(leveldb::ReadOptions()));
+                for (it->SeekToFirst(); it->Valid() && keys < 10000; it->Next(), ++keys) {
+                    batch.Delete(it->key().ToString());
+                }
+            }
+            if (keys == 0) {
+                break;
+            }
+            if (!db_->Write(leveldb::WriteOptions(), &batch).ok()) {
+                return false;
+            }
+        }
+        next_height_ = 0;
+        count_ = 0;
+        return true;
+    }
 
-        // Sort by height (descending)
-        std::sort(all_txs.begin(), all_txs.end(),
-                  [](const TxInfo& a, const TxInfo& b) { return a.height > b.height; });
+    // Merge sorted runs of consecutive blocks into key-ordered batch writes;
+    // the last batch also records the new height and count
+    bool WriteRuns(const std::vector<IndexRun>& runs) {
+        using Cursor = std::pair<size_t, size_t>;  // Run, entry
+        auto later = [&](const Cursor& a, const Cursor& b) {
+            return runs[a.first].entries[a.second].first > runs[b.first].entries[b.second].first;
+        };
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(later);
+        uint64_t transactions = 0;
+        for (size_t i = 0; i < runs.size(); ++i) {
+            if (!runs[i].entries.empty()) {
+                heap.push({i, 0});
+            }
+            transactions += runs[i].transactions;
+        }
 
-        // Return top limit
-        for (size_t i = 0; i < std::min(static_cast<size_t>(limit), all_txs.size()); ++i) {
-            result.push_back(all_txs[i].tx);
+        leveldb::WriteBatch batch;
+        size_t batch_bytes = 0;
+        while (!heap.empty()) {
+            const auto [run, entry] = heap.top();
+            heap.pop();
+            const auto& [key, value] = runs[run].entries[entry];
+            batch.Put(key, value);
+            batch_bytes += key.size() + value.size();
+            if (entry + 1 < runs[run].entries.size()) {
+                heap.push({run, entry + 1});
+            }
+            if (batch_bytes >= kWriteBatchBytes) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!db_ || !db_->Write(leveldb::WriteOptions(), &batch).ok()) {
+                    return false;
+                }
+                batch.Clear();
+                batch_bytes = 0;
+            }
         }
 
-        return result;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!db_ || runs.empty()) {
+            return db_ != nullptr;
+        }
+        std::string next;
+        AppendU32(next, runs.back().end_height);
+        batch.Put(kNextHeightKey, next);
+        std::string count;
+        AppendU64(count, count_ + transactions);
+        batch.Put(kCountKey, count);
+        if (!db_->Write(leveldb::WriteOptions(), &batch).ok()) {
+            return false;
+        }
+        next_height_ = runs.back().end_height;
+        count_ += transactions;
+        progress_cv_.notify_all();
+        return true;
     }
 
-  private:
-    struct TxInfo {
-        primitives::Transaction tx;
-        uint32_t height;
-        uint32_t block_time;
+    // Delete the entries of the block at next_height_ - 1. Caller holds mutex_.
+    bool DisconnectTip() {
+        std::string record;
+        const uint32_t height = next_height_ - 1;
+        if (next_height_ == 0 || !Get(BlockKey(height), record) || record.size() < 32) {
+            return false;
+        }
+
+        leveldb::WriteBatch batch;
+        uint64_t transactions = 0;
+        for (size_t pos = 32; pos + 4 <= record.size();) {
+            const uint32_t size = ReadU32(record, pos);
+            pos += 4;
+            if (size > record.size() - pos) {
+                return false;
+            }
+            const std::string key = record.substr(pos, size);
+            pos += size;
+            transactions += key[0] == 't' ? 1 : 0;
+            batch.Delete(key);
+        }
+        batch.Delete(BlockKey(height));
+        transactions = std::min(transactions, count_);
+
+        std::string next;
+        AppendU32(next, height);
+        batch.Put(kNextHeightKey, next);
+        std::string count;
+        AppendU64(count, count_ - transactions);
+        batch.Put(kCountKey, count);
+        if (!db_->Write(leveldb::WriteOptions(), &batch).ok()) {
+            return false;
+        }
+        next_height_ = height;
+        count_ -= transactions;
+        return true;
+    }
+
+    // Unwind indexed blocks that BlockStorage has replaced or dropped, newest
+    // first, down to the fork point. Indexes without block records are left
+    // alone.
+    void UnwindReplacedBlocks() {
+        while (true) {
+            uint32_t height = 0;
+            std::string record;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_ || next_height_ == 0) {
+                    return;
+                }
+                height = next_height_ - 1;
+                if (!Get(BlockKey(height), record) || record.size() < 32) {
+                    return;
+                }
+            }
+            auto block = blocks_->GetBlockByHeight(height);
+            if (block) {
+                const auto hash = block->GetHash();
+                if (std::equal(hash.begin(), hash.end(), record.begin())) {
+                    return;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (next_height_ != height + 1 || !DisconnectTip()) {
+                return;
+            }
+        }
+    }
+
+    // Last block read, so transactions from the same block cost one read
+    struct BlockCache {
+        std::optional<uint32_t> height;
+        std::string data;
     };
 
-    std::string db_path_;
-    bool is_open_;
-    std::map<std::array<uint8_t, 32>, TxInfo> tx_by_id_;
-    std::map<std::vector<uint8_t>, std::vector<std::array<uint8_t, 32>>> tx_by_address_;
+    bool Get(const std::string& key, std::string& value) const {
+        return db_ && db_->Get(leveldb::ReadOptions(), key, &value).ok();
+    }
+
+    std::optional<primitives::Transaction> LoadTransaction(const std::array<uint8_t, 32>& txid,
+                                                           BlockCache& cache) {
+        const auto location = GetTransactionLocation(txid);
+        storage::BlockStorage* blocks = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocks = blocks_;
+        }
+        if (!location || blocks == nullptr) {
+            return std::nullopt;
+        }
+        if (cache.height != location->height) {
+            auto raw = blocks->GetRawBlockByHeight(location->height);
+            if (!raw) {
+                return std::nullopt;
+            }
+            cache.height = location->height;
+            cache.data = std::move(*raw);
+        }
+        if (location->offset > cache.data.size() ||
+            location->length > cache.data.size() - location->offset) {
+            return std::nullopt;
+        }
+        // The block at that height may have been replaced since it was indexed
+        auto tx = primitives::Transaction::Deserialize(
+            reinterpret_cast<const uint8_t*>(cache.data.data()) + location->offset,
+            location->length);
+        if (!tx || tx->GetTxID() != txid) {
+            return std::nullopt;
+        }
+        return tx;
+    }
+
+    // Indexes stored blocks until one is missing, then sleeps until notified.
+    // Block storage is read without holding mutex_.
+    void CatchUpLoop() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_cv_.wait(lock, [this]() { return notified_ || stopping_; });
+                if (stopping_) {
+                    break;
+                }
+                notified_ = false;
+            }
+            UnwindReplacedBlocks();
+            while (true) {
+                uint32_t height = 0;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (stopping_) {
+                        break;
+                    }
+                    height = next_height_;
+                }
+                auto block = blocks_->GetBlockByHeight(height);
+                if (!block || !IndexBlock(*block, height)) {
+                    break;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        progress_cv_.notify_all();
+    }
+
+    mutable std::mutex mutex_;
+    std::unique_ptr<leveldb::DB> db_;
+    storage::BlockStorage* blocks_ = nullptr;
+    uint32_t next_height_ = 0;
+    uint64_t count_ = 0;
+
+    std::thread thread_;
+    std::condition_variable wake_cv_;
+    std::condition_variable progress_cv_;
+    bool running_ = false;
+    bool stopping_ = false;
+    bool notified_ = false;
 };
 
 TxIndexer::TxIndexer() : impl_(std::make_unique<Impl>()) {}
 
-TxIndexer::~TxIndexer() {
-    if (impl_) {
-        impl_->Close();
-    }
-}
+TxIndexer::~TxIndexer() = default;
 
-bool TxIndexer::Open(const std::string& db_path) {
-    return impl_->Open(db_path);
+bool TxIndexer::Open(const std::string& db_path, storage::BlockStorage* blocks) {
+    return impl_->Open(db_path, blocks);
 }
 
 void TxIndexer::Close() {
     impl_->Close();
 }
 
-void TxIndexer::IndexTransaction(const primitives::Transaction& tx, uint32_t height,
-                                 uint32_t block_time) {
-    impl_->IndexTransaction(tx, height, block_time);
+bool TxIndexer::IndexBlock(const primitives::Block& block, uint32_t height) {
+    return impl_->IndexBlock(block, height);
+}
+
+bool TxIndexer::Rewind(uint32_t height) {
+    return impl_->Rewind(height);
+}
+
+bool TxIndexer::Reindex(uint32_t end_height, uint32_t threads,
+                        const ReindexProgressCallback& progress) {
+    return impl_->Reindex(end_height, threads, progress);
+}
+
+uint32_t TxIndexer::GetNextHeight() const {
+    return impl_->GetNextHeight();
+}
+
+void TxIndexer::Start() {
+    impl_->Start();
+}
+
+void TxIndexer::Stop() {
+    impl_->Stop();
+}
+
+void TxIndexer::NotifyNewBlock() {
+    impl_->NotifyNewBlock();
+}
+
+bool TxIndexer::WaitForHeight(uint32_t height) {
+    return impl_->WaitForHeight(height);
 }
 
 std::vector<primitives::Transaction>
@@ -173,11 +748,22 @@ TxIndexer::GetTransactionsByAddress(const std::vector<uint8_t>& address, uint32_
     return impl_->GetTransactionsByAddress(address, limit);
 }
 
+std::vector<TxIndexer::AddressTx>
+TxIndexer::GetAddressHistory(const std::vector<uint8_t>& address, uint32_t limit,
+                             const std::optional<AddressTx>& before) {
+    return impl_->GetAddressHistory(address, limit, before);
+}
+
 std::optional<primitives::Transaction>
 TxIndexer::GetTransactionById(const std::array<uint8_t, 32>& txid) {
     return impl_->GetTransactionById(txid);
 }
 
+std::optional<TxIndexer::TxLocation>
+TxIndexer::GetTransactionLocation(const std::array<uint8_t, 32>& txid) {
+    return impl_->GetTransactionLocation(txid);
+}
+
 size_t TxIndexer::GetTransactionCount() const {
     return impl_->GetTransactionCount();
 }
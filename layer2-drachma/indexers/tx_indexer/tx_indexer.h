@@ -3,61 +3,188 @@
 
 #pragma once
 
+#include "primitives/block.h"
 #include "primitives/transaction.h"
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace parthenon {
+namespace storage {
+class BlockStorage;
+}
+
 namespace layer2 {
 namespace indexers {
 
 /**
  * Transaction Indexer
  *
- * Indexes all transactions in the blockchain for fast lookups
- * by address, asset, time range, etc.
+ * Indexes all transactions in the blockchain for fast lookups by ID and by
+ * address. The index lives in LevelDB and holds no transaction data, only
+ * where each transaction sits in its block in BlockStorage:
+ * - "t{txid}" -> height, byte offset and length within the serialized block
+ * - "a{address length}{address}{~height}{~tx index}" -> txid
+ * - "b{height}" -> block hash and the keys the block added, for unwinding
+ * - "m:next", "m:count" -> next block height to index, transactions indexed
+ *
+ * Heights and indexes are big-endian and inverted in address keys, so an
+ * address's history reads newest first and a page continues with a seek.
+ * As before, outputs are indexed under their pubkey script and inputs
+ * under the txid they spend.
+ *
+ * Blocks are indexed in height order, either directly with IndexBlock() or
+ * by a background thread (Start()) that follows BlockStorage, so block
+ * connection only has to call NotifyNewBlock(). Before indexing more, that
+ * thread unwinds indexed blocks whose hash no longer matches the block
+ * BlockStorage holds at their height, so after a reorg it re-indexes from
+ * the fork point. Reindex() rebuilds the whole index from BlockStorage in
+ * parallel.
  */
 class TxIndexer {
   public:
+    // Blocks per worker run when reindexing
+    static constexpr uint32_t kReindexChunkBlocks = 256;
+
+    /**
+     * Position of a transaction in the chain
+     */
+    struct TxLocation {
+        uint32_t height;
+        uint32_t tx_index;
+        uint64_t offset;  // Within the serialized block
+        uint32_t length;
+    };
+
+    /**
+     * One transaction in an address's history
+     */
+    struct AddressTx {
+        std::array<uint8_t, 32> txid;
+        uint32_t height;
+        uint32_t tx_index;
+    };
+
+    /**
+     * Reindex progress, reported after each round of runs is written
+     */
+    struct ReindexProgress {
+        uint32_t next_height;  // Blocks indexed so far
+        uint32_t end_height;
+        uint64_t transactions;
+        double blocks_per_second;
+    };
+
+    using ReindexProgressCallback = std::function<void(const ReindexProgress&)>;
+
     TxIndexer();
     ~TxIndexer();
 
     /**
      * Open the indexer database
+     * @param db_path LevelDB directory
+     * @param blocks Block store transactions are read from; must outlive
+     *               the indexer (or the next Open())
      */
-    bool Open(const std::string& db_path);
+    bool Open(const std::string& db_path, storage::BlockStorage* blocks);
 
     /**
-     * Close the indexer database
+     * Stop catching up and close the indexer database
      */
     void Close();
 
     /**
-     * Index a transaction
+     * Index the block at the next height; blocks must be indexed in order
+     * @return false if height is not the next one or the write failed
+     */
+    bool IndexBlock(const primitives::Block& block, uint32_t height);
+
+    /**
+     * Remove every block at or above height from the index, newest first,
+     * e.g. before indexing the other side of a reorg with IndexBlock()
+     * @return false if a block's record is missing or a write failed;
+     *         blocks above GetNextHeight() are removed either way
      */
-    void IndexTransaction(const primitives::Transaction& tx, uint32_t height, uint32_t block_time);
+    bool Rewind(uint32_t height);
 
     /**
-     * Get transactions for an address
+     * Rebuild the index from genesis up to (not including) end_height
+     *
+     * Stops the catch-up thread and deletes the existing index. Worker
+     * threads read and decode chunks of blocks from BlockStorage and sort
+     * their entries into runs, while the calling thread merges the previous
+     * round of runs into key-ordered batch writes. The height is recorded
+     * with each round, so an interrupted rebuild resumes with Start().
+     *
+     * @return false if a block is missing or a write failed; blocks below
+     *         GetNextHeight() are indexed either way
+     */
+    bool Reindex(uint32_t end_height, uint32_t threads,
+                 const ReindexProgressCallback& progress = nullptr);
+
+    /**
+     * Height the next IndexBlock() expects (number of blocks indexed)
+     */
+    uint32_t GetNextHeight() const;
+
+    /**
+     * Start a thread indexing blocks from BlockStorage until it runs out,
+     * then again on each NotifyNewBlock()
+     */
+    void Start();
+
+    /**
+     * Stop the catch-up thread
+     */
+    void Stop();
+
+    /**
+     * Wake the catch-up thread; never blocks on indexing
+     */
+    void NotifyNewBlock();
+
+    /**
+     * Wait until every block below height is indexed
+     * @return false if the catch-up thread stopped first
+     */
+    bool WaitForHeight(uint32_t height);
+
+    /**
+     * Get transactions for an address, newest first
      */
     std::vector<primitives::Transaction>
     GetTransactionsByAddress(const std::vector<uint8_t>& address, uint32_t limit = 100);
 
     /**
-     * Get transaction by ID
+     * Page through an address's history, newest first
+     * @param before Only entries older than this one (the last entry of the
+     *               previous page); nullopt starts from the newest
+     */
+    std::vector<AddressTx> GetAddressHistory(const std::vector<uint8_t>& address,
+                                             uint32_t limit = 100,
+                                             const std::optional<AddressTx>& before = std::nullopt);
+
+    /**
+     * Get transaction by ID; nullopt if the stored block no longer holds it
      */
     std::optional<primitives::Transaction> GetTransactionById(const std::array<uint8_t, 32>& txid);
 
+    /**
+     * Where a transaction is stored
+     */
+    std::optional<TxLocation> GetTransactionLocation(const std::array<uint8_t, 32>& txid);
+
     /**
      * Get total number of indexed transactions
      */
     size_t GetTransactionCount() const;
 
     /**
-     * Get recent transactions
+     * Get recent transactions, newest first
      */
     std::vector<primitives::Transaction> GetRecentTransactions(uint32_t limit = 100);
 
@@ -0,0 +1,86 @@
+// ParthenonChain - EVM Access Lists
+// EIP-2930 access lists and EIP-2929 warm/cold access tracking
+
+#pragma once
+
+#include "opcodes.h"
+#include "state.h"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * One address and the storage keys a transaction declares it will touch
+ */
+struct AccessListEntry {
+    Address address{};
+    std::vector<uint256_t> storage_keys;
+};
+
+/**
+ * EIP-2930 access list
+ */
+using AccessList = std::vector<AccessListEntry>;
+
+/**
+ * Intrinsic gas for declaring an access list
+ */
+inline uint64_t AccessListGas(const AccessList& access_list) {
+    uint64_t gas = 0;
+    for (const auto& entry : access_list) {
+        gas += ACCESS_LIST_ADDRESS_COST + ACCESS_LIST_STORAGE_KEY_COST * entry.storage_keys.size();
+    }
+    return gas;
+}
+
+/**
+ * Addresses and storage slots accessed so far in a transaction
+ *
+ * The first access to each is cold and pays the EIP-2929 surcharge; later
+ * ones are warm.
+ */
+class AccessedSet {
+  public:
+    /**
+     * Mark an address accessed
+     * @return true if it was cold
+     */
+    bool AddAddress(const Address& addr) { return addresses_.insert(addr).second; }
+
+    /**
+     * Mark a storage slot accessed
+     * @return true if it was cold
+     */
+    bool AddSlot(const Address& addr, const uint256_t& key) {
+        return slots_.emplace(addr, key).second;
+    }
+
+    bool ContainsAddress(const Address& addr) const { return addresses_.count(addr) != 0; }
+
+    bool ContainsSlot(const Address& addr, const uint256_t& key) const {
+        return slots_.count(std::make_pair(addr, key)) != 0;
+    }
+
+    /**
+     * Pre-warm everything an access list declares
+     */
+    void AddAccessList(const AccessList& access_list) {
+        for (const auto& entry : access_list) {
+            AddAddress(entry.address);
+            for (const auto& key : entry.storage_keys) {
+                AddSlot(entry.address, key);
+            }
+        }
+    }
+
+  private:
+    std::set<Address> addresses_;
+    std::set<std::pair<Address, uint256_t>> slots_;
+};
+
+}  // namespace evm
+}  // namespace parthenon
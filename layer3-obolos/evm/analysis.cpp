@@ -0,0 +1,312 @@
+// ParthenonChain - EVM Code Analysis Implementation
+
+#include "analysis.h"
+
+#include <algorithm>
+
+namespace parthenon {
+namespace evm {
+
+namespace {
+
+struct OpTraits {
+    Handler handler;
+    int8_t inputs;
+    int8_t outputs;
+    bool ends_block;  // Following instruction starts a new block
+};
+
+OpTraits GetTraits(uint8_t byte) {
+    const Opcode op = static_cast<Opcode>(byte);
+    if (IsPushOp(op)) {
+        return {Handler::PUSH, 0, 1, false};
+    }
+    if (IsDupOp(op)) {
+        const int8_t n = static_cast<int8_t>(GetDupDepth(op));
+        return {Handler::DUP, n, static_cast<int8_t>(n + 1), false};
+    }
+    if (IsSwapOp(op)) {
+        const int8_t n = static_cast<int8_t>(GetSwapDepth(op) + 1);
+        return {Handler::SWAP, n, n, false};
+    }
+    if (IsLogOp(op)) {
+        return {Handler::LOG, static_cast<int8_t>(GetLogTopics(op) + 2), 0, false};
+    }
+
+    switch (op) {
+        case Opcode::STOP:
+            return {Handler::STOP, 0, 0, true};
+        case Opcode::ADD:
+            return {Handler::ADD, 2, 1, false};
+        case Opcode::MUL:
+            return {Handler::MUL, 2, 1, false};
+        case Opcode::SUB:
+            return {Handler::SUB, 2, 1, false};
+        case Opcode::DIV:
+            return {Handler::DIV, 2, 1, false};
+        case Opcode::SDIV:
+            return {Handler::SDIV, 2, 1, false};
+        case Opcode::MOD:
+            return {Handler::MOD, 2, 1, false};
+        case Opcode::SMOD:
+            return {Handler::SMOD, 2, 1, false};
+        case Opcode::ADDMOD:
+            return {Handler::ADDMOD, 3, 1, false};
+        case Opcode::MULMOD:
+            return {Handler::MULMOD, 3, 1, false};
+        case Opcode::EXP:
+            return {Handler::EXP, 2, 1, false};
+        case Opcode::SIGNEXTEND:
+            return {Handler::SIGNEXTEND, 2, 1, false};
+        case Opcode::LT:
+            return {Handler::LT, 2, 1, false};
+        case Opcode::GT:
+            return {Handler::GT, 2, 1, false};
+        case Opcode::SLT:
+            return {Handler::SLT, 2, 1, false};
+        case Opcode::SGT:
+            return {Handler::SGT, 2, 1, false};
+        case Opcode::EQ:
+            return {Handler::EQ, 2, 1, false};
+        case Opcode::ISZERO:
+            return {Handler::ISZERO, 1, 1, false};
+        case Opcode::AND:
+            return {Handler::AND, 2, 1, false};
+        case Opcode::OR:
+            return {Handler::OR, 2, 1, false};
+        case Opcode::XOR:
+            return {Handler::XOR, 2, 1, false};
+        case Opcode::NOT:
+            return {Handler::NOT, 1, 1, false};
+        case Opcode::BYTE:
+            return {Handler::BYTE, 2, 1, false};
+        case Opcode::SHL:
+            return {Handler::SHL, 2, 1, false};
+        case Opcode::SHR:
+            return {Handler::SHR, 2, 1, false};
+        case Opcode::SAR:
+            return {Handler::SAR, 2, 1, false};
+        case Opcode::SHA3:
+            return {Handler::SHA3, 2, 1, false};
+        case Opcode::ADDRESS:
+            return {Handler::ADDRESS, 0, 1, false};
+        case Opcode::BALANCE:
+            return {Handler::BALANCE, 1, 1, false};
+        case Opcode::ORIGIN:
+            return {Handler::ORIGIN, 0, 1, false};
+        case Opcode::CALLER:
+            return {Handler::CALLER, 0, 1, false};
+        case Opcode::CALLVALUE:
+            return {Handler::CALLVALUE, 0, 1, false};
+        case Opcode::CALLDATALOAD:
+            return {Handler::CALLDATALOAD, 1, 1, false};
+        case Opcode::CALLDATASIZE:
+            return {Handler::CALLDATASIZE, 0, 1, false};
+        case Opcode::CALLDATACOPY:
+            return {Handler::CALLDATACOPY, 3, 0, false};
+        case Opcode::CODESIZE:
+            return {Handler::CODESIZE, 0, 1, false};
+        case Opcode::CODECOPY:
+            return {Handler::CODECOPY, 3, 0, false};
+        case Opcode::GASPRICE:
+            return {Handler::GASPRICE, 0, 1, false};
+        case Opcode::RETURNDATASIZE:
+            return {Handler::RETURNDATASIZE, 0, 1, false};
+        case Opcode::RETURNDATACOPY:
+            return {Handler::RETURNDATACOPY, 3, 0, false};
+        case Opcode::COINBASE:
+            return {Handler::COINBASE, 0, 1, false};
+        case Opcode::TIMESTAMP:
+            return {Handler::TIMESTAMP, 0, 1, false};
+        case Opcode::NUMBER:
+            return {Handler::NUMBER, 0, 1, false};
+        case Opcode::DIFFICULTY:
+            return {Handler::DIFFICULTY, 0, 1, false};
+        case Opcode::GASLIMIT:
+            return {Handler::GASLIMIT, 0, 1, false};
+        case Opcode::CHAINID:
+            return {Handler::CHAINID, 0, 1, false};
+        case Opcode::SELFBALANCE:
+            return {Handler::SELFBALANCE, 0, 1, false};
+        case Opcode::BASEFEE:
+            return {Handler::BASEFEE, 0, 1, false};
+        case Opcode::POP:
+            return {Handler::POP, 1, 0, false};
+        case Opcode::MLOAD:
+            return {Handler::MLOAD, 1, 1, false};
+        case Opcode::MSTORE:
+            return {Handler::MSTORE, 2, 0, false};
+        case Opcode::MSTORE8:
+            return {Handler::MSTORE8, 2, 0, false};
+        case Opcode::SLOAD:
+            return {Handler::SLOAD, 1, 1, false};
+        case Opcode::SSTORE:
+            return {Handler::SSTORE, 2, 0, false};
+        case Opcode::JUMP:
+            return {Handler::JUMP, 1, 0, true};
+        case Opcode::JUMPI:
+            return {Handler::JUMPI, 2, 0, true};
+        case Opcode::PC:
+            return {Handler::PC, 0, 1, false};
+        case Opcode::MSIZE:
+            return {Handler::MSIZE, 0, 1, false};
+        case Opcode::GAS:
+            return {Handler::GAS, 0, 1, true};
+        case Opcode::CALL:
+            return {Handler::CALL, 7, 1, true};  // The callee's gas depends on the exact gas left
+        case Opcode::CALLCODE:
+            return {Handler::CALLCODE, 7, 1, true};
+        case Opcode::DELEGATECALL:
+            return {Handler::DELEGATECALL, 6, 1, true};
+        case Opcode::STATICCALL:
+            return {Handler::STATICCALL, 6, 1, true};
+        case Opcode::RETURN:
+            return {Handler::RETURN, 2, 0, true};
+        case Opcode::REVERT:
+            return {Handler::REVERT, 2, 0, true};
+        default:
+            // Undefined, or not implemented yet (creates, ...)
+            return {Handler::INVALID, 0, 0, true};
+    }
+}
+
+// Record the key of an SLOAD/SSTORE if the instruction before it produced one
+// that is known without running the code
+void AddStorageKeyHint(CodeAnalysis& analysis, const Instruction& previous) {
+    StorageKeyHint hint{};
+    switch (previous.handler) {
+        case Handler::PUSH:
+            hint.source = StorageKeyHint::Source::CONSTANT;
+            hint.key = analysis.push_values[previous.arg].ToBytes();
+            break;
+        case Handler::CALLER:
+            hint.source = StorageKeyHint::Source::CALLER;
+            break;
+        case Handler::ORIGIN:
+            hint.source = StorageKeyHint::Source::ORIGIN;
+            break;
+        case Handler::ADDRESS:
+            hint.source = StorageKeyHint::Source::ADDRESS;
+            break;
+        default:
+            return;
+    }
+    for (const auto& existing : analysis.storage_key_hints) {
+        if (existing.source == hint.source && existing.key == hint.key) {
+            return;
+        }
+    }
+    analysis.storage_key_hints.push_back(hint);
+}
+
+}  // namespace
+
+const Instruction* CodeAnalysis::FindJumpTarget(const Word& offset) const {
+    if (!offset.FitsUint64() || !IsJumpDest(offset.ToUint64())) {
+        return nullptr;
+    }
+    auto it = std::lower_bound(jumpdest_offsets.begin(), jumpdest_offsets.end(),
+                               static_cast<uint32_t>(offset.ToUint64()));
+    return &instructions[jumpdest_targets[it - jumpdest_offsets.begin()]];
+}
+
+std::shared_ptr<const CodeAnalysis> AnalyzeCode(const std::vector<uint8_t>& code) {
+    auto analysis = std::make_shared<CodeAnalysis>();
+    analysis->code_size = code.size();
+    analysis->jumpdest_bitmap.assign((code.size() + 63) / 64, 0);
+    analysis->instructions.reserve(code.size() + 2);
+
+    auto& instructions = analysis->instructions;
+    auto& blocks = analysis->blocks;
+
+    // Stack height relative to the start of the current block
+    int32_t height = 0;
+
+    auto begin_block = [&]() {
+        instructions.push_back(
+            Instruction{Handler::BEGIN_BLOCK, 0, static_cast<uint32_t>(blocks.size())});
+        blocks.emplace_back();
+        height = 0;
+    };
+    begin_block();
+
+    for (size_t pc = 0; pc < code.size(); ++pc) {
+        const uint8_t byte = code[pc];
+
+        if (static_cast<Opcode>(byte) == Opcode::JUMPDEST) {
+            // A JUMPDEST starts a block; reuse the current one if nothing is in it yet
+            if (instructions.back().handler != Handler::BEGIN_BLOCK || blocks.back().gas_cost != 0) {
+                begin_block();
+            }
+            analysis->jumpdest_bitmap[pc / 64] |= uint64_t{1} << (pc % 64);
+            analysis->jumpdest_offsets.push_back(static_cast<uint32_t>(pc));
+            analysis->jumpdest_targets.push_back(static_cast<uint32_t>(instructions.size() - 1));
+            blocks.back().gas_cost += GetOpcodeCost(Opcode::JUMPDEST);
+            continue;
+        }
+
+        const OpTraits traits = GetTraits(byte);
+        BlockInfo& block = blocks.back();
+        block.gas_cost += GetOpcodeCost(static_cast<Opcode>(byte));
+        block.stack_required = std::max(block.stack_required, traits.inputs - height);
+        height += traits.outputs - traits.inputs;
+        block.stack_max_growth = std::max(block.stack_max_growth, height);
+
+        Instruction instr{traits.handler, byte, 0};
+        switch (traits.handler) {
+            case Handler::PUSH: {
+                // Immediates truncated by the end of code are zero-padded on the right
+                const size_t size = GetPushSize(static_cast<Opcode>(byte));
+                const size_t available = std::min(size, code.size() - pc - 1);
+                instr.arg = static_cast<uint32_t>(analysis->push_values.size());
+                analysis->push_values.push_back(
+                    Word::FromBytes(code.data() + pc + 1, available) << (8 * (size - available)));
+                pc += size;
+                break;
+            }
+            case Handler::DUP:
+                instr.arg = GetDupDepth(static_cast<Opcode>(byte));
+                break;
+            case Handler::SWAP:
+                instr.arg = GetSwapDepth(static_cast<Opcode>(byte));
+                break;
+            case Handler::LOG:
+                instr.arg = GetLogTopics(static_cast<Opcode>(byte));
+                break;
+            case Handler::PC:
+                instr.arg = static_cast<uint32_t>(pc);
+                break;
+            default:
+                break;
+        }
+        instructions.push_back(instr);
+
+        if (traits.handler == Handler::SLOAD || traits.handler == Handler::SSTORE) {
+            AddStorageKeyHint(*analysis, instructions[instructions.size() - 2]);
+        }
+
+        if (traits.ends_block && pc + 1 < code.size()) {
+            begin_block();
+        }
+    }
+
+    // Sentinel: falling off the end of the code is a STOP
+    instructions.push_back(Instruction{Handler::STOP, static_cast<uint8_t>(Opcode::STOP), 0});
+
+    // SSTORE's stipend check needs the gas left as if charged per instruction
+    uint32_t later = 0;
+    for (auto it = instructions.rbegin(); it != instructions.rend(); ++it) {
+        if (it->handler == Handler::BEGIN_BLOCK) {
+            later = 0;
+            continue;
+        }
+        if (it->handler == Handler::SSTORE) {
+            it->arg = later;
+        }
+        later += static_cast<uint32_t>(GetOpcodeCost(static_cast<Opcode>(it->opcode)));
+    }
+    return analysis;
+}
+
+}  // namespace evm
+}  // namespace parthenon
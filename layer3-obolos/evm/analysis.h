@@ -0,0 +1,175 @@
+// ParthenonChain - EVM Code Analysis
+// Pre-decoded instruction streams and basic-block metadata for the interpreter
+
+#pragma once
+
+#include "opcodes.h"
+#include "uint256.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * Interpreter handlers. Several opcodes share one handler (PUSH1..PUSH32,
+ * DUPn, SWAPn, LOGn) with the variant carried in Instruction::arg; opcodes
+ * the interpreter does not implement map to INVALID.
+ */
+#define PARTHENON_EVM_HANDLERS(X) \
+    X(BEGIN_BLOCK)                \
+    X(STOP)                       \
+    X(ADD)                        \
+    X(MUL)                        \
+    X(SUB)                        \
+    X(DIV)                        \
+    X(SDIV)                       \
+    X(MOD)                        \
+    X(SMOD)                       \
+    X(ADDMOD)                     \
+    X(MULMOD)                     \
+    X(EXP)                        \
+    X(SIGNEXTEND)                 \
+    X(LT)                         \
+    X(GT)                         \
+    X(SLT)                        \
+    X(SGT)                        \
+    X(EQ)                         \
+    X(ISZERO)                     \
+    X(AND)                        \
+    X(OR)                         \
+    X(XOR)                        \
+    X(NOT)                        \
+    X(BYTE)                       \
+    X(SHL)                        \
+    X(SHR)                        \
+    X(SAR)                        \
+    X(SHA3)                       \
+    X(ADDRESS)                    \
+    X(BALANCE)                    \
+    X(ORIGIN)                     \
+    X(CALLER)                     \
+    X(CALLVALUE)                  \
+    X(CALLDATALOAD)               \
+    X(CALLDATASIZE)               \
+    X(CALLDATACOPY)               \
+    X(CODESIZE)                   \
+    X(CODECOPY)                   \
+    X(GASPRICE)                   \
+    X(RETURNDATASIZE)             \
+    X(RETURNDATACOPY)             \
+    X(COINBASE)                   \
+    X(TIMESTAMP)                  \
+    X(NUMBER)                     \
+    X(DIFFICULTY)                 \
+    X(GASLIMIT)                   \
+    X(CHAINID)                    \
+    X(SELFBALANCE)                \
+    X(BASEFEE)                    \
+    X(POP)                        \
+    X(MLOAD)                      \
+    X(MSTORE)                     \
+    X(MSTORE8)                    \
+    X(SLOAD)                      \
+    X(SSTORE)                     \
+    X(JUMP)                       \
+    X(JUMPI)                      \
+    X(PC)                         \
+    X(MSIZE)                      \
+    X(GAS)                        \
+    X(PUSH)                       \
+    X(DUP)                        \
+    X(SWAP)                       \
+    X(LOG)                        \
+    X(CALL)                       \
+    X(CALLCODE)                   \
+    X(DELEGATECALL)               \
+    X(STATICCALL)                 \
+    X(RETURN)                     \
+    X(REVERT)                     \
+    X(INVALID)
+
+enum class Handler : uint8_t {
+#define PARTHENON_EVM_HANDLER_ENUM(name) name,
+    PARTHENON_EVM_HANDLERS(PARTHENON_EVM_HANDLER_ENUM)
+#undef PARTHENON_EVM_HANDLER_ENUM
+};
+
+/**
+ * One decoded instruction
+ *
+ * arg meaning by handler: BEGIN_BLOCK = block index, PUSH = index into
+ * push_values, DUP/SWAP = depth, LOG = topic count, PC = code offset,
+ * SSTORE = static gas of the rest of its block (already charged on entry).
+ */
+struct Instruction {
+    Handler handler;
+    uint8_t opcode;  // Original opcode (tracing, diagnostics)
+    uint32_t arg;
+};
+
+/**
+ * Basic block metadata, checked once by BEGIN_BLOCK instead of per opcode
+ */
+struct BlockInfo {
+    uint64_t gas_cost = 0;          // Sum of static opcode costs in the block
+    int32_t stack_required = 0;     // Minimum stack height on entry
+    int32_t stack_max_growth = 0;   // Maximum height increase inside the block
+};
+
+/**
+ * A storage key an SLOAD or SSTORE is known to use before execution: a
+ * constant pushed right before it, or an address from the call context
+ */
+struct StorageKeyHint {
+    enum class Source : uint8_t { CONSTANT, CALLER, ORIGIN, ADDRESS };
+    Source source;
+    uint256_t key{};  // CONSTANT only
+};
+
+/**
+ * Result of analysing a contract's bytecode. Immutable once built and shared
+ * between concurrent executions (see ContractCode in code_cache.h).
+ *
+ * Blocks start at offset 0, at every JUMPDEST and after every instruction that
+ * ends control flow or needs exact gas (JUMP, JUMPI, GAS, calls, STOP,
+ * RETURN, REVERT, invalid opcodes). The stream always ends in a STOP so running off
+ * the end of the code needs no bounds check.
+ */
+struct CodeAnalysis {
+    std::vector<Instruction> instructions;
+    std::vector<Word> push_values;
+    std::vector<BlockInfo> blocks;
+
+    // Valid jump destinations: bitmap over code offsets, plus sorted offsets
+    // mapped to the BEGIN_BLOCK instruction of their block
+    std::vector<uint64_t> jumpdest_bitmap;
+    std::vector<uint32_t> jumpdest_offsets;
+    std::vector<uint32_t> jumpdest_targets;
+
+    // Storage keys used by the code regardless of input, for prefetching
+    std::vector<StorageKeyHint> storage_key_hints;
+
+    size_t code_size = 0;
+
+    bool IsJumpDest(uint64_t offset) const {
+        return offset < code_size && ((jumpdest_bitmap[offset / 64] >> (offset % 64)) & 1) != 0;
+    }
+
+    /**
+     * Instruction to continue at after jumping to a code offset, or nullptr
+     * if the offset is not a JUMPDEST
+     */
+    const Instruction* FindJumpTarget(const Word& offset) const;
+};
+
+/**
+ * Decode bytecode into an instruction stream with block metadata
+ */
+std::shared_ptr<const CodeAnalysis> AnalyzeCode(const std::vector<uint8_t>& code);
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,52 @@
+// ParthenonChain - EVM Ahead-of-Time Compiled Contracts Implementation
+
+#include "aot.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace parthenon {
+namespace evm {
+
+#ifndef PARTHENON_EVM_AOT
+namespace generated {
+
+const CompiledContract* const kContracts = nullptr;
+const size_t kContractCount = 0;
+
+}  // namespace generated
+#endif
+
+namespace {
+
+std::atomic<bool> g_aot_enabled{true};
+
+}  // namespace
+
+const CompiledContract* FindCompiledContract(const CodeHash& hash) {
+    const CompiledContract* begin = generated::kContracts;
+    const CompiledContract* end = begin + generated::kContractCount;
+    const CompiledContract* it = std::lower_bound(
+        begin, end, hash,
+        [](const CompiledContract& contract, const CodeHash& key) { return contract.hash < key; });
+    return it != end && it->hash == hash ? it : nullptr;
+}
+
+std::vector<const CompiledContract*> ListCompiledContracts() {
+    std::vector<const CompiledContract*> contracts;
+    for (size_t i = 0; i < generated::kContractCount; ++i) {
+        contracts.push_back(&generated::kContracts[i]);
+    }
+    return contracts;
+}
+
+void SetAotEnabled(bool enabled) {
+    g_aot_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AotEnabled() {
+    return g_aot_enabled.load(std::memory_order_relaxed);
+}
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,105 @@
+// ParthenonChain - EVM Ahead-of-Time Compiled Contracts
+// Native code for a pinned set of hot contracts, generated at build time
+
+#pragma once
+
+#include "code_cache.h"
+#include "vm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * What generated code sees of the VM running it
+ *
+ * Compiled contracts inline stack, arithmetic and control flow, and call
+ * back here for everything that touches memory, storage or the context,
+ * so those instructions run exactly the interpreter's code.
+ */
+class AotFrame {
+  public:
+    AotFrame(VM& vm, const std::vector<uint8_t>& code) : vm_(vm), code_(code) {}
+
+    // The frame's stack; STACK_SLOTS words, bottom first
+    Word* Stack() const { return vm_.stack_; }
+
+    Word Environment(Handler handler) const { return vm_.Environment(handler, code_); }
+
+    ExecResult Sha3(Word* sp, int64_t& gas_left) { return vm_.OpSha3(sp, gas_left); }
+    ExecResult Balance(Word* sp, int64_t& gas_left) { return vm_.OpBalance(sp, gas_left); }
+    void CallDataLoad(Word* sp) const { vm_.OpCallDataLoad(sp); }
+    ExecResult CallDataCopy(Word* sp, int64_t& gas_left) {
+        return vm_.OpCopy(sp, gas_left, vm_.ctx_.input_data);
+    }
+    ExecResult CodeCopy(Word* sp, int64_t& gas_left) { return vm_.OpCopy(sp, gas_left, code_); }
+    ExecResult Mload(Word* sp, int64_t& gas_left) { return vm_.OpMload(sp, gas_left); }
+    ExecResult Mstore(Word* sp, int64_t& gas_left) { return vm_.OpMstore(sp, gas_left); }
+    ExecResult Mstore8(Word* sp, int64_t& gas_left) { return vm_.OpMstore8(sp, gas_left); }
+    ExecResult Sload(Word* sp, int64_t& gas_left) { return vm_.OpSload(sp, gas_left); }
+    ExecResult Sstore(Word* sp, int64_t& gas_left, uint32_t later_gas) {
+        return vm_.OpSstore(sp, gas_left, later_gas);
+    }
+    ExecResult Log(Word* sp, int64_t& gas_left, uint32_t topics) {
+        return vm_.OpLog(sp, gas_left, topics);
+    }
+    ExecResult Return(Word* sp, int64_t& gas_left) { return vm_.OpReturn(sp, gas_left); }
+    ExecResult ReturnDataCopy(Word* sp, int64_t& gas_left) {
+        return vm_.OpReturnDataCopy(sp, gas_left);
+    }
+    ExecResult Call(Word* sp, int64_t& gas_left, Handler handler) {
+        return vm_.OpCall(sp, gas_left, handler, nullptr);
+    }
+
+  private:
+    VM& vm_;
+    const std::vector<uint8_t>& code_;
+};
+
+/**
+ * A contract compiled to native code by evm_aotc
+ *
+ * run behaves exactly like the interpreter on the same code: it charges
+ * each basic block's static gas and checks its stack bounds on entry,
+ * updates gas_left as it goes and returns the same result. The
+ * differential tests (test_aot) hold it to that.
+ */
+struct CompiledContract {
+    CodeHash hash;
+    const char* name;  // File name in evm/aot/contracts, without .hex
+    const uint8_t* code;
+    size_t code_size;
+    ExecResult (*run)(AotFrame& frame, int64_t& gas_left);
+};
+
+/**
+ * Compiled code for the contract with this code hash, or nullptr
+ */
+const CompiledContract* FindCompiledContract(const CodeHash& hash);
+
+/**
+ * Every compiled contract, sorted by hash; empty when the build has
+ * PARTHENON_EVM_AOT off
+ */
+std::vector<const CompiledContract*> ListCompiledContracts();
+
+/**
+ * Switch compiled execution on or off process-wide (default on). When off,
+ * every contract is interpreted.
+ */
+void SetAotEnabled(bool enabled);
+bool AotEnabled();
+
+namespace generated {
+
+// Defined by the evm_aotc output, or empty in aot.cpp without it
+extern const CompiledContract* const kContracts;
+extern const size_t kContractCount;
+
+}  // namespace generated
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,441 @@
+// ParthenonChain - EVM Ahead-of-Time Contract Compiler
+//
+// Translates the pinned contracts in evm/aot/contracts into C++ that is
+// compiled into parthenon_evm (see aot.h). Run by the build:
+//
+//   evm_aotc [--namespace <name>] <output.cpp> <contract.hex>...
+//
+// The table of compiled contracts is defined in evm::generated, or in
+// evm::<name> for translations built outside the library (tests).
+//
+// Each .hex file holds the contract's runtime bytecode as hex digits; '#'
+// starts a comment and whitespace is ignored. The output walks the same
+// analysed instruction stream as the interpreter, one label per jump
+// destination, so block gas and stack checks are identical by construction.
+
+#include "evm/analysis.h"
+#include "evm/opcodes.h"
+#include "crypto/sha256.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace parthenon;
+using namespace parthenon::evm;
+
+namespace {
+
+struct Contract {
+    std::string name;
+    std::vector<uint8_t> code;
+    std::array<uint8_t, 32> hash;
+};
+
+bool ReadHexFile(const std::string& path, std::vector<uint8_t>& code, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open";
+        return false;
+    }
+    std::string digits;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        for (char c : line) {
+            if (std::isxdigit(static_cast<unsigned char>(c))) {
+                digits.push_back(c);
+            } else if (!std::isspace(static_cast<unsigned char>(c))) {
+                error = std::string("unexpected character '") + c + "'";
+                return false;
+            }
+        }
+    }
+    if (digits.empty() || digits.size() % 2 != 0) {
+        error = "expected a non-empty, even number of hex digits";
+        return false;
+    }
+    for (size_t i = 0; i < digits.size(); i += 2) {
+        code.push_back(static_cast<uint8_t>(std::stoi(digits.substr(i, 2), nullptr, 16)));
+    }
+    return true;
+}
+
+// Contract name from the file name, as a C++ identifier
+std::string NameFromPath(const std::string& path) {
+    std::string name = path.substr(path.find_last_of("/\\") + 1);
+    name = name.substr(0, name.rfind(".hex"));
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) {
+            c = '_';
+        }
+    }
+    return name;
+}
+
+std::string Hex64(uint64_t value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "0x%016llxULL", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+std::string WordLiteral(const Word& value) {
+    if (value.limbs[1] == 0 && value.limbs[2] == 0 && value.limbs[3] == 0) {
+        return "Word(" + Hex64(value.limbs[0]) + ")";
+    }
+    return "Word(" + Hex64(value.limbs[0]) + ", " + Hex64(value.limbs[1]) + ", " +
+           Hex64(value.limbs[2]) + ", " + Hex64(value.limbs[3]) + ")";
+}
+
+// Statements for instructions that only touch the stack; mirrors Run()
+const std::map<Handler, const char*>& InlineHandlers() {
+    static const std::map<Handler, const char*> handlers = {
+        {Handler::ADD, "sp[-2] = sp[-1] + sp[-2]; --sp;"},
+        {Handler::MUL, "sp[-2] = sp[-1] * sp[-2]; --sp;"},
+        {Handler::SUB, "sp[-2] = sp[-1] - sp[-2]; --sp;"},
+        {Handler::DIV, "sp[-2] = sp[-1] / sp[-2]; --sp;"},
+        {Handler::SDIV, "sp[-2] = SignedDiv(sp[-1], sp[-2]); --sp;"},
+        {Handler::MOD, "sp[-2] = sp[-1] % sp[-2]; --sp;"},
+        {Handler::SMOD, "sp[-2] = SignedMod(sp[-1], sp[-2]); --sp;"},
+        {Handler::ADDMOD, "sp[-3] = AddMod(sp[-1], sp[-2], sp[-3]); sp -= 2;"},
+        {Handler::MULMOD, "sp[-3] = MulMod(sp[-1], sp[-2], sp[-3]); sp -= 2;"},
+        {Handler::EXP, "sp[-2] = Exp(sp[-1], sp[-2]); --sp;"},
+        {Handler::SIGNEXTEND, "sp[-2] = SignExtend(sp[-1], sp[-2]); --sp;"},
+        {Handler::LT, "sp[-2] = Word(sp[-1] < sp[-2] ? 1 : 0); --sp;"},
+        {Handler::GT, "sp[-2] = Word(sp[-1] > sp[-2] ? 1 : 0); --sp;"},
+        {Handler::SLT, "sp[-2] = Word(SignedLess(sp[-1], sp[-2]) ? 1 : 0); --sp;"},
+        {Handler::SGT, "sp[-2] = Word(SignedLess(sp[-2], sp[-1]) ? 1 : 0); --sp;"},
+        {Handler::EQ, "sp[-2] = Word(sp[-1] == sp[-2] ? 1 : 0); --sp;"},
+        {Handler::ISZERO, "sp[-1] = Word(sp[-1].IsZero() ? 1 : 0);"},
+        {Handler::AND, "sp[-2] = sp[-1] & sp[-2]; --sp;"},
+        {Handler::OR, "sp[-2] = sp[-1] | sp[-2]; --sp;"},
+        {Handler::XOR, "sp[-2] = sp[-1] ^ sp[-2]; --sp;"},
+        {Handler::NOT, "sp[-1] = ~sp[-1];"},
+        {Handler::BYTE, "sp[-2] = Byte(sp[-1], sp[-2]); --sp;"},
+        {Handler::SHL, "sp[-2] = sp[-2] << ShiftAmount(sp[-1]); --sp;"},
+        {Handler::SHR, "sp[-2] = sp[-2] >> ShiftAmount(sp[-1]); --sp;"},
+        {Handler::SAR, "sp[-2] = Sar(sp[-2], ShiftAmount(sp[-1])); --sp;"},
+        {Handler::POP, "--sp;"},
+        {Handler::CALLDATALOAD, "f.CallDataLoad(sp);"},
+        {Handler::BALANCE, "AOT_CHECK(f.Balance(sp, gas));"},
+        {Handler::SHA3, "AOT_CHECK(f.Sha3(sp, gas)); --sp;"},
+        {Handler::CALLDATACOPY, "AOT_CHECK(f.CallDataCopy(sp, gas)); sp -= 3;"},
+        {Handler::CODECOPY, "AOT_CHECK(f.CodeCopy(sp, gas)); sp -= 3;"},
+        {Handler::RETURNDATACOPY, "AOT_CHECK(f.ReturnDataCopy(sp, gas)); sp -= 3;"},
+        {Handler::MLOAD, "AOT_CHECK(f.Mload(sp, gas));"},
+        {Handler::MSTORE, "AOT_CHECK(f.Mstore(sp, gas)); sp -= 2;"},
+        {Handler::MSTORE8, "AOT_CHECK(f.Mstore8(sp, gas)); sp -= 2;"},
+        {Handler::SLOAD, "AOT_CHECK(f.Sload(sp, gas));"},
+        {Handler::GAS, "*sp++ = Word(static_cast<uint64_t>(gas));"},
+        {Handler::CALL, "AOT_CHECK(f.Call(sp, gas, Handler::CALL)); sp -= 6;"},
+        {Handler::CALLCODE, "AOT_CHECK(f.Call(sp, gas, Handler::CALLCODE)); sp -= 6;"},
+        {Handler::DELEGATECALL, "AOT_CHECK(f.Call(sp, gas, Handler::DELEGATECALL)); sp -= 5;"},
+        {Handler::STATICCALL, "AOT_CHECK(f.Call(sp, gas, Handler::STATICCALL)); sp -= 5;"},
+        {Handler::STOP, "AOT_HALT(ExecResult::SUCCESS);"},
+        {Handler::RETURN, "AOT_CHECK(f.Return(sp, gas)); AOT_HALT(ExecResult::RETURNED);"},
+        {Handler::REVERT, "AOT_CHECK(f.Return(sp, gas)); AOT_HALT(ExecResult::REVERT);"},
+        {Handler::INVALID, "AOT_HALT(ExecResult::INVALID_OPCODE);"},
+    };
+    return handlers;
+}
+
+// Push-only instructions answered by AotFrame::Environment()
+const std::map<Handler, const char*>& EnvironmentHandlers() {
+    static const std::map<Handler, const char*> handlers = {
+        {Handler::ADDRESS, "ADDRESS"},         {Handler::ORIGIN, "ORIGIN"},
+        {Handler::CALLER, "CALLER"},           {Handler::CALLVALUE, "CALLVALUE"},
+        {Handler::CALLDATASIZE, "CALLDATASIZE"}, {Handler::CODESIZE, "CODESIZE"},
+        {Handler::GASPRICE, "GASPRICE"},       {Handler::RETURNDATASIZE, "RETURNDATASIZE"},
+        {Handler::COINBASE, "COINBASE"},       {Handler::TIMESTAMP, "TIMESTAMP"},
+        {Handler::NUMBER, "NUMBER"},           {Handler::DIFFICULTY, "DIFFICULTY"},
+        {Handler::GASLIMIT, "GASLIMIT"},       {Handler::CHAINID, "CHAINID"},
+        {Handler::SELFBALANCE, "SELFBALANCE"}, {Handler::BASEFEE, "BASEFEE"},
+        {Handler::MSIZE, "MSIZE"},
+    };
+    return handlers;
+}
+
+class Emitter {
+  public:
+    Emitter(const Contract& contract, std::ostream& out)
+        : contract_(contract), analysis_(AnalyzeCode(contract.code)), out_(out) {}
+
+    bool Emit(std::string& error) {
+        const auto& instructions = analysis_->instructions;
+        ComputeOffsets();
+
+        // A PUSH straight before a JUMP or JUMPI is folded into a direct goto;
+        // any other jump goes through the dispatch switch
+        bool dynamic = false;
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            const Handler handler = instructions[i].handler;
+            if (handler != Handler::JUMP && handler != Handler::JUMPI) {
+                continue;
+            }
+            if (ConstantTarget(i - 1)) {
+                const Instruction* target = analysis_->FindJumpTarget(PushValue(i - 1));
+                if (target != nullptr) {
+                    labels_.insert(target - instructions.data());
+                }
+            } else {
+                dynamic = true;
+            }
+        }
+        if (dynamic) {
+            labels_.insert(analysis_->jumpdest_targets.begin(), analysis_->jumpdest_targets.end());
+        }
+
+        out_ << "// " << contract_.name << ": " << contract_.code.size() << " bytes, "
+             << analysis_->blocks.size()
+             << (analysis_->blocks.size() == 1 ? " block\n" : " blocks\n")
+             << "ExecResult Run_" << contract_.name << "(AotFrame& f, int64_t& gas_left) {\n"
+             << "    [[maybe_unused]] Word* const stack = f.Stack();\n"
+             << "    Word* sp = stack;\n"
+             << "    int64_t gas = gas_left;\n";
+        if (dynamic) {
+            out_ << "    uint64_t target = 0;\n";
+        }
+
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            if (!EmitInstruction(i, error)) {
+                return false;
+            }
+        }
+
+        if (dynamic) {
+            out_ << "\ndispatch:\n    switch (target) {\n";
+            for (size_t k = 0; k < analysis_->jumpdest_offsets.size(); ++k) {
+                out_ << "        case " << analysis_->jumpdest_offsets[k] << ":\n"
+                     << "            goto L" << analysis_->jumpdest_targets[k] << ";\n";
+            }
+            out_ << "        default:\n"
+                 << "            AOT_HALT(ExecResult::INVALID_JUMP);\n"
+                 << "    }\n";
+        }
+        out_ << "}\n\n";
+        return true;
+    }
+
+  private:
+    // Code offset of each instruction, as in VM::TraceLayout
+    void ComputeOffsets() {
+        const auto& instructions = analysis_->instructions;
+        const auto& code = contract_.code;
+        offsets_.resize(instructions.size());
+        size_t pc = 0;
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            offsets_[i] = std::min(pc, code.size());
+            if (instructions[i].handler == Handler::BEGIN_BLOCK) {
+                if (pc < code.size() && static_cast<Opcode>(code[pc]) == Opcode::JUMPDEST) {
+                    ++pc;
+                }
+                continue;
+            }
+            const Opcode op = static_cast<Opcode>(instructions[i].opcode);
+            pc += 1 + (IsPushOp(op) ? GetPushSize(op) : 0);
+        }
+    }
+
+    bool ConstantTarget(size_t index) const {
+        return index < analysis_->instructions.size() &&
+               analysis_->instructions[index].handler == Handler::PUSH;
+    }
+
+    const Word& PushValue(size_t index) const {
+        return analysis_->push_values[analysis_->instructions[index].arg];
+    }
+
+    bool Folded(size_t index) const {
+        const auto& instructions = analysis_->instructions;
+        return instructions[index].handler == Handler::PUSH && index + 1 < instructions.size() &&
+               (instructions[index + 1].handler == Handler::JUMP ||
+                instructions[index + 1].handler == Handler::JUMPI);
+    }
+
+    // goto for a constant jump to value, or the halt it would cause
+    std::string DirectJump(const Word& value) const {
+        const Instruction* target = analysis_->FindJumpTarget(value);
+        if (target == nullptr) {
+            return "AOT_HALT(ExecResult::INVALID_JUMP);";
+        }
+        return "goto L" + std::to_string(target - analysis_->instructions.data()) + ";";
+    }
+
+    bool EmitInstruction(size_t i, std::string& error) {
+        const Instruction& instruction = analysis_->instructions[i];
+        const Handler handler = instruction.handler;
+        if (handler == Handler::BEGIN_BLOCK) {
+            const BlockInfo& block = analysis_->blocks[instruction.arg];
+            out_ << "\n";
+            if (labels_.count(i) != 0) {
+                out_ << "L" << i << ":\n";
+            }
+            out_ << "    // block " << instruction.arg << " @" << offsets_[i] << "\n"
+                 << "    AOT_GAS(" << block.gas_cost << ");\n";
+            if (block.stack_required > 0) {
+                out_ << "    AOT_REQUIRE(" << block.stack_required << ");\n";
+            }
+            if (block.stack_max_growth > 0) {
+                out_ << "    AOT_GROW(" << block.stack_max_growth << ");\n";
+            }
+            return true;
+        }
+
+        out_ << "    ";
+        if (Folded(i)) {
+            out_ << "// " << GetOpcodeName(instruction.opcode) << " (folded into the jump)\n";
+            return true;
+        }
+        const bool constant = ConstantTarget(i - 1);
+        if (handler == Handler::JUMP) {
+            if (constant) {
+                out_ << DirectJump(PushValue(i - 1)) << "\n";
+            } else {
+                out_ << "--sp; AOT_JUMP(sp[0]);\n";
+            }
+        } else if (handler == Handler::JUMPI) {
+            if (constant) {
+                out_ << "if (!(*--sp).IsZero()) { " << DirectJump(PushValue(i - 1)) << " }\n";
+            } else {
+                out_ << "sp -= 2; if (!sp[0].IsZero()) { AOT_JUMP(sp[1]); }\n";
+            }
+        } else if (handler == Handler::PUSH) {
+            out_ << "*sp++ = " << WordLiteral(PushValue(i)) << ";\n";
+        } else if (handler == Handler::DUP) {
+            out_ << "*sp = sp[-" << instruction.arg << "]; ++sp;\n";
+        } else if (handler == Handler::SWAP) {
+            out_ << "std::swap(sp[-1], sp[-" << instruction.arg + 1 << "]);\n";
+        } else if (handler == Handler::PC) {
+            out_ << "*sp++ = Word(" << instruction.arg << ");\n";
+        } else if (handler == Handler::SSTORE) {
+            out_ << "AOT_CHECK(f.Sstore(sp, gas, " << instruction.arg << ")); sp -= 2;\n";
+        } else if (handler == Handler::LOG) {
+            out_ << "AOT_CHECK(f.Log(sp, gas, " << instruction.arg << ")); sp -= "
+                 << instruction.arg + 2 << ";\n";
+        } else if (EnvironmentHandlers().count(handler) != 0) {
+            out_ << "*sp++ = f.Environment(Handler::" << EnvironmentHandlers().at(handler)
+                 << ");\n";
+        } else if (InlineHandlers().count(handler) != 0) {
+            out_ << InlineHandlers().at(handler) << "\n";
+        } else {
+            error = "no translation for opcode " + std::string(GetOpcodeName(instruction.opcode));
+            return false;
+        }
+        return true;
+    }
+
+    const Contract& contract_;
+    std::shared_ptr<const CodeAnalysis> analysis_;
+    std::ostream& out_;
+    std::vector<size_t> offsets_;
+    std::set<size_t> labels_;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string table_namespace = "generated";
+    int first = 1;
+    if (argc > 2 && std::string(argv[1]) == "--namespace") {
+        table_namespace = argv[2];
+        first = 3;
+    }
+    if (argc <= first) {
+        std::cerr << "usage: evm_aotc [--namespace <name>] <output.cpp> <contract.hex>..."
+                  << std::endl;
+        return 1;
+    }
+    const char* output_path = argv[first];
+
+    std::vector<Contract> contracts;
+    for (int i = first + 1; i < argc; ++i) {
+        Contract contract;
+        contract.name = NameFromPath(argv[i]);
+        std::string error;
+        if (!ReadHexFile(argv[i], contract.code, error)) {
+            std::cerr << argv[i] << ": " << error << std::endl;
+            return 1;
+        }
+        contract.hash = crypto::SHA256::Hash256(contract.code);  // HashCode(), non-empty code
+        contracts.push_back(std::move(contract));
+    }
+    std::sort(contracts.begin(), contracts.end(),
+              [](const Contract& a, const Contract& b) { return a.hash < b.hash; });
+
+    std::ostringstream out;
+    out << "// Generated by evm_aotc. Do not edit.\n\n"
+        << "#include \"evm/aot.h\"\n\n"
+        << "#include <utility>\n\n"
+        << "namespace parthenon {\n"
+        << "namespace evm {\n\n"
+        << "namespace {\n\n"
+        << "#define AOT_HALT(r) \\\n"
+        << "    do { gas_left = gas; return (r); } while (0)\n"
+        << "#define AOT_CHECK(op) \\\n"
+        << "    do { const ExecResult status = (op); \\\n"
+        << "         if (status != ExecResult::SUCCESS) AOT_HALT(status); } while (0)\n"
+        << "#define AOT_GAS(cost) \\\n"
+        << "    do { gas -= (cost); if (gas < 0) AOT_HALT(ExecResult::OUT_OF_GAS); } while (0)\n"
+        << "#define AOT_REQUIRE(n) \\\n"
+        << "    do { if (sp - stack < (n)) AOT_HALT(ExecResult::STACK_UNDERFLOW); } while (0)\n"
+        << "#define AOT_GROW(n) \\\n"
+        << "    do { if (sp - stack + (n) > static_cast<ptrdiff_t>(FrameArena::STACK_SLOTS)) \\\n"
+        << "             AOT_HALT(ExecResult::STACK_OVERFLOW); } while (0)\n"
+        << "#define AOT_JUMP(word) \\\n"
+        << "    do { if (!(word).FitsUint64()) AOT_HALT(ExecResult::INVALID_JUMP); \\\n"
+        << "         target = (word).ToUint64(); goto dispatch; } while (0)\n\n";
+
+    for (const auto& contract : contracts) {
+        out << "const uint8_t kCode_" << contract.name << "[] = {";
+        for (size_t i = 0; i < contract.code.size(); ++i) {
+            out << (i % 16 == 0 ? "\n    " : " ") << static_cast<int>(contract.code[i]) << ",";
+        }
+        out << "\n};\n\n";
+
+        std::string error;
+        if (!Emitter(contract, out).Emit(error)) {
+            std::cerr << contract.name << ": " << error << std::endl;
+            return 1;
+        }
+    }
+
+    out << "#undef AOT_JUMP\n#undef AOT_GROW\n#undef AOT_REQUIRE\n#undef AOT_GAS\n"
+        << "#undef AOT_CHECK\n#undef AOT_HALT\n\n";
+    if (!contracts.empty()) {
+        out << "const CompiledContract kTable[] = {\n";
+        for (const auto& contract : contracts) {
+            out << "    {{";
+            for (size_t i = 0; i < contract.hash.size(); ++i) {
+                out << (i > 0 ? ", " : "") << static_cast<int>(contract.hash[i]);
+            }
+            out << "},\n     \"" << contract.name << "\", kCode_" << contract.name
+                << ", sizeof(kCode_" << contract.name << "), Run_" << contract.name << "},\n";
+        }
+        out << "};\n\n";
+    }
+    out << "}  // namespace\n\n"
+        << "namespace " << table_namespace << " {\n\n"
+        << "// extern: const would otherwise give these internal linkage\n";
+    if (contracts.empty()) {
+        out << "extern const CompiledContract* const kContracts = nullptr;\n"
+            << "extern const size_t kContractCount = 0;\n\n";
+    } else {
+        out << "extern const CompiledContract* const kContracts = kTable;\n"
+            << "extern const size_t kContractCount = sizeof(kTable) / sizeof(kTable[0]);\n\n";
+    }
+    out << "}  // namespace " << table_namespace << "\n\n"
+        << "}  // namespace evm\n"
+        << "}  // namespace parthenon\n";
+
+    std::ofstream file(output_path);
+    file << out.str();
+    return file ? 0 : 1;
+}
@@ -0,0 +1,438 @@
+// ParthenonChain - Obolos Block Execution Implementation
+
+#include "block_executor.h"
+
+#include "code_cache.h"
+#include "execution.h"
+#include "gas_pricing.h"
+#include "mpt.h"
+#include "opcodes.h"
+#include "precompiles.h"
+#include "uint256.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <set>
+#include <utility>
+
+namespace pantheon::obolos {
+
+using parthenon::evm::Address;
+using parthenon::evm::CodeHandle;
+using parthenon::evm::GasPricing;
+using parthenon::evm::StateAccess;
+using parthenon::evm::uint256_t;
+using parthenon::evm::Word;
+using parthenon::evm::WorldState;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t NanosSince(Clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+/**
+ * Passes everything through to a WorldState and remembers which accounts
+ * and slots were written, so the block's changes can be read back once it
+ * is done
+ */
+class RecordingState final : public StateAccess {
+  public:
+    explicit RecordingState(WorldState& state) : state_(state) {}
+
+    uint256_t GetBalance(const Address& addr) const override { return state_.GetBalance(addr); }
+
+    void SetBalance(const Address& addr, const uint256_t& balance) override {
+        accounts_.insert(addr);
+        state_.SetBalance(addr, balance);
+    }
+
+    uint64_t GetNonce(const Address& addr) const override { return state_.GetNonce(addr); }
+
+    void SetNonce(const Address& addr, uint64_t nonce) override {
+        accounts_.insert(addr);
+        state_.SetNonce(addr, nonce);
+    }
+
+    CodeHandle GetCode(const Address& addr) const override { return state_.GetCode(addr); }
+
+    uint256_t GetStorage(const Address& addr, const uint256_t& key) const override {
+        return state_.GetStorage(addr, key);
+    }
+
+    void SetStorage(const Address& addr, const uint256_t& key, const uint256_t& value) override {
+        slots_.emplace(addr, key);
+        state_.SetStorage(addr, key, value);
+    }
+
+    size_t Checkpoint() override { return state_.Checkpoint(); }
+    void RevertToCheckpoint(size_t checkpoint) override { state_.RevertToCheckpoint(checkpoint); }
+    void DiscardCheckpoint(size_t checkpoint) override { state_.DiscardCheckpoint(checkpoint); }
+
+    const std::set<Address>& Accounts() const { return accounts_; }
+    const std::set<std::pair<Address, uint256_t>>& Slots() const { return slots_; }
+
+  private:
+    WorldState& state_;
+    std::set<Address> accounts_;
+    std::set<std::pair<Address, uint256_t>> slots_;
+};
+
+uint64_t TransactionIntrinsicGas(const ObolosTransaction& tx) {
+    CallRequest call;
+    call.to = tx.to;
+    call.data = tx.data;
+    call.access_list = tx.access_list;
+    return IntrinsicGas(call);
+}
+
+/**
+ * @return Why tx cannot be included, or an empty string
+ */
+std::string CheckTransaction(const StateAccess& state, const ObolosBlock& block,
+                             uint64_t block_gas_used, const ObolosTransaction& tx,
+                             uint64_t intrinsic_gas) {
+    if (tx.gas_limit > block.gas_limit - block_gas_used) {
+        return "gas limit exceeds the block's remaining gas";
+    }
+    const uint64_t nonce = state.GetNonce(tx.from);
+    if (tx.nonce != nonce) {
+        return "nonce " + std::to_string(tx.nonce) + ", expected " + std::to_string(nonce);
+    }
+    if (nonce == UINT64_MAX) {
+        return "nonce overflow";
+    }
+    if (!parthenon::evm::ValidateTransactionFees(block.base_fee, tx.max_fee_per_gas,
+                                                 tx.max_priority_fee_per_gas)) {
+        return "fee cap below the base fee or priority fee above the fee cap";
+    }
+    if (intrinsic_gas > tx.gas_limit) {
+        return "gas limit below intrinsic gas";
+    }
+    const Word value = Word::FromBytes(tx.value);
+    const Word max_cost = Word(tx.gas_limit) * Word(tx.max_fee_per_gas) + value;
+    if (max_cost < value || Word::FromBytes(state.GetBalance(tx.from)) < max_cost) {
+        return "insufficient balance for gas and value";
+    }
+    return {};
+}
+
+void AddBalance(StateAccess& state, const Address& addr, const Word& amount) {
+    if (!amount.IsZero()) {
+        state.SetBalance(addr, (Word::FromBytes(state.GetBalance(addr)) + amount).ToBytes());
+    }
+}
+
+/**
+ * Run a transaction that passed CheckTransaction()
+ */
+ObolosReceipt ApplyTransaction(StateAccess& state, const ObolosBlock& block, uint64_t chain_id,
+                               const ObolosTransaction& tx, uint64_t intrinsic_gas) {
+    ObolosReceipt receipt;
+    const uint64_t price = parthenon::evm::CalculateEffectiveGasPrice(
+        block.base_fee, tx.max_fee_per_gas, tx.max_priority_fee_per_gas);
+    receipt.effective_gas_price = price;
+
+    // All the gas is bought up front; the nonce bump and fee stay even if the call fails
+    const Word sender_balance = Word::FromBytes(state.GetBalance(tx.from));
+    state.SetBalance(tx.from, (sender_balance - Word(tx.gas_limit) * Word(price)).ToBytes());
+    state.SetNonce(tx.from, tx.nonce + 1);
+
+    uint64_t gas_used = intrinsic_gas;
+    const uint64_t call_gas = tx.gas_limit - intrinsic_gas;
+    const size_t checkpoint = state.Checkpoint();
+    const Word value = Word::FromBytes(tx.value);
+    if (!value.IsZero()) {
+        // Covered: the balance check allowed for max_fee_per_gas >= price
+        state.SetBalance(tx.from, (Word::FromBytes(state.GetBalance(tx.from)) - value).ToBytes());
+        AddBalance(state, tx.to, value);
+    }
+
+    if (parthenon::evm::IsPrecompile(tx.to)) {
+        auto precompiled = parthenon::evm::RunPrecompile(tx.to, tx.data, call_gas);
+        receipt.result = precompiled.status;
+        receipt.output = std::move(precompiled.output);
+        gas_used += precompiled.gas_used;
+    } else if (const CodeHandle code = state.GetCode(tx.to); !code->Empty()) {
+        parthenon::evm::ExecutionContext ctx{};
+        ctx.origin = tx.from;
+        ctx.caller = tx.from;
+        ctx.address = tx.to;
+        ctx.value = tx.value;
+        ctx.input_data = tx.data;
+        ctx.gas_limit = call_gas;
+        ctx.gas_price = price;
+        ctx.block_number = block.number;
+        ctx.timestamp = block.timestamp;
+        ctx.coinbase = block.coinbase;
+        ctx.gas_limit_block = block.gas_limit;
+        ctx.chain_id = chain_id;
+        ctx.base_fee = block.base_fee;
+        ctx.access_list = tx.access_list;
+
+        parthenon::evm::VM vm(state, ctx);
+        auto [result, output] = vm.Execute(*code);
+        receipt.result = result;
+        receipt.output = std::move(output);
+        gas_used += vm.GetGasUsed();
+        if (receipt.Succeeded()) {
+            receipt.logs = vm.GetLogs();
+            gas_used -= std::min(vm.GetGasRefund(), gas_used / parthenon::evm::MAX_REFUND_QUOTIENT);
+        }
+    }
+
+    if (receipt.Succeeded()) {
+        state.DiscardCheckpoint(checkpoint);
+    } else {
+        state.RevertToCheckpoint(checkpoint);
+    }
+
+    // Unused gas back to the sender, the priority fee to the coinbase
+    AddBalance(state, tx.from, Word(tx.gas_limit - gas_used) * Word(price));
+    AddBalance(state, block.coinbase, Word(gas_used) * Word(price - block.base_fee));
+
+    receipt.gas_used = gas_used;
+    for (const auto& log : receipt.logs) {
+        receipt.bloom.AddLog(log.address, log.topics);
+    }
+    return receipt;
+}
+
+void AppendU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+/**
+ * Receipt trie value: status, cumulative gas, bloom, then each log's
+ * address, topics and data. Length-prefixed fields in place of RLP, as for
+ * the state trie's nodes (mpt.h).
+ */
+std::vector<uint8_t> EncodeReceipt(const ObolosReceipt& receipt) {
+    std::vector<uint8_t> out;
+    out.push_back(receipt.Succeeded() ? 1 : 0);
+    AppendU64(out, receipt.cumulative_gas_used);
+    const auto& bloom = receipt.bloom.Data();
+    out.insert(out.end(), bloom.begin(), bloom.end());
+    AppendU64(out, receipt.logs.size());
+    for (const auto& log : receipt.logs) {
+        out.insert(out.end(), log.address.begin(), log.address.end());
+        out.push_back(static_cast<uint8_t>(log.topics.size()));
+        for (const auto& topic : log.topics) {
+            out.insert(out.end(), topic.begin(), topic.end());
+        }
+        AppendU64(out, log.data.size());
+        out.insert(out.end(), log.data.begin(), log.data.end());
+    }
+    return out;
+}
+
+void AddTimings(BlockStageTimings& total, const BlockStageTimings& block) {
+    total.execute_ns += block.execute_ns;
+    total.collect_ns += block.collect_ns;
+    total.state_root_ns += block.state_root_ns;
+    total.receipts_root_ns += block.receipts_root_ns;
+}
+
+}  // namespace
+
+ObolosBlockExecutor::ObolosBlockExecutor(WorldState& state, uint64_t chain_id,
+                                         bool pipeline_roots)
+    : state_(state), chain_id_(chain_id) {
+    if (pipeline_roots) {
+        // The copy shares trie nodes with state_, and a node may only be
+        // hashed from one thread: hash them all before the worker starts
+        state_.CalculateStateRoot();
+        root_state_ = std::make_unique<WorldState>(state_);
+        worker_ = std::thread([this]() { WorkerLoop(); });
+    }
+}
+
+ObolosBlockExecutor::~ObolosBlockExecutor() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    worker_.join();
+}
+
+ExecutedBlock ObolosBlockExecutor::ExecuteBlock(const ObolosBlock& block) {
+    ExecutedBlock executed;
+    auto reject = [&](size_t index, std::string error) {
+        executed.failed_tx = index;
+        executed.error = std::move(error);
+        executed.receipts.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.rejected;
+        return executed;
+    };
+
+    const size_t header = block.transactions.size();
+    if (block.gas_limit > GasPricing::MAX_GAS_PER_BLOCK) {
+        return reject(header, "gas limit above " + std::to_string(GasPricing::MAX_GAS_PER_BLOCK));
+    }
+    if (block.base_fee < GasPricing::MIN_BASE_FEE) {
+        return reject(header, "base fee below the minimum");
+    }
+    if (parent_) {
+        if (block.number != parent_->number + 1) {
+            return reject(header, "block number " + std::to_string(block.number) +
+                                      ", expected " + std::to_string(parent_->number + 1));
+        }
+        const uint64_t base_fee = parthenon::evm::CalculateNextBaseFee(
+            parent_->base_fee, parent_->gas_used, parent_->gas_limit);
+        if (block.base_fee != base_fee) {
+            return reject(header, "base fee " + std::to_string(block.base_fee) + ", expected " +
+                                      std::to_string(base_fee));
+        }
+    }
+
+    // Execute
+    const auto execute_start = Clock::now();
+    RecordingState state(state_);
+    const size_t checkpoint = state_.Checkpoint();
+    Word burned;
+    Word tips;
+    executed.receipts.reserve(block.transactions.size());
+    for (size_t i = 0; i < block.transactions.size(); ++i) {
+        const ObolosTransaction& tx = block.transactions[i];
+        const uint64_t intrinsic_gas = TransactionIntrinsicGas(tx);
+        std::string error = CheckTransaction(state, block, executed.gas_used, tx, intrinsic_gas);
+        if (!error.empty()) {
+            state_.RevertToCheckpoint(checkpoint);
+            return reject(i, "transaction " + std::to_string(i) + ": " + error);
+        }
+        ObolosReceipt receipt = ApplyTransaction(state, block, chain_id_, tx, intrinsic_gas);
+        executed.gas_used += receipt.gas_used;
+        receipt.cumulative_gas_used = executed.gas_used;
+        executed.bloom.Merge(receipt.bloom);
+        burned = burned + Word(receipt.gas_used) * Word(block.base_fee);
+        tips = tips + Word(receipt.gas_used) * Word(receipt.effective_gas_price - block.base_fee);
+        executed.receipts.push_back(std::move(receipt));
+    }
+    state_.DiscardCheckpoint(checkpoint);
+    executed.valid = true;
+    executed.base_fee_burned = burned.ToBytes();
+    executed.priority_fees = tips.ToBytes();
+    executed.timings.execute_ns = NanosSince(execute_start);
+    parent_ = Parent{block.number, executed.gas_used, block.gas_limit, block.base_fee};
+
+    // Collect what the roots need, so hashing never reads state_
+    const auto collect_start = Clock::now();
+    RootTask task;
+    task.changes.block_number = block.number;
+    if (root_state_) {
+        for (const Address& addr : state.Accounts()) {
+            task.changes.accounts[addr] = state_.GetAccount(addr);
+        }
+        for (const auto& slot : state.Slots()) {
+            task.changes.storage[slot] = state_.GetStorage(slot.first, slot.second);
+        }
+    }
+    task.receipts.reserve(executed.receipts.size());
+    for (const auto& receipt : executed.receipts) {
+        task.receipts.push_back(EncodeReceipt(receipt));
+    }
+    executed.timings.collect_ns = NanosSince(collect_start);
+    task.timings = executed.timings;
+    executed.roots = task.promise.get_future().share();
+
+    if (root_state_) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.blocks;
+            stats_.transactions += block.transactions.size();
+            stats_.gas_used += executed.gas_used;
+            queue_.push_back(std::move(task));
+        }
+        work_cv_.notify_one();
+        return executed;
+    }
+
+    const BlockRoots roots = ComputeRoots(state_, task);
+    task.promise.set_value(roots);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.blocks;
+    stats_.transactions += block.transactions.size();
+    stats_.gas_used += executed.gas_used;
+    AddTimings(stats_.timings, roots.timings);
+    return executed;
+}
+
+BlockRoots ObolosBlockExecutor::ComputeRoots(WorldState& state, RootTask& task) {
+    BlockRoots roots;
+    roots.timings = task.timings;
+
+    const auto state_start = Clock::now();
+    for (const auto& [addr, account] : task.changes.accounts) {
+        if (account) {
+            state.SetAccount(addr, *account);
+        } else {
+            state.DeleteAccount(addr);
+        }
+    }
+    for (const auto& [slot, value] : task.changes.storage) {
+        state.SetStorage(slot.first, slot.second, value);
+    }
+    roots.state_root = state.CalculateStateRoot();
+    roots.timings.state_root_ns = NanosSince(state_start);
+
+    // Keyed by the big-endian transaction index
+    const auto receipts_start = Clock::now();
+    parthenon::evm::MerklePatriciaTrie trie;
+    for (size_t i = 0; i < task.receipts.size(); ++i) {
+        std::vector<uint8_t> key;
+        AppendU64(key, i);
+        trie.Put(key, task.receipts[i]);
+    }
+    roots.receipts_root = trie.GetRootHash();
+    roots.timings.receipts_root_ns = NanosSince(receipts_start);
+    return roots;
+}
+
+void ObolosBlockExecutor::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;  // Stopping, and every queued block is hashed
+        }
+        RootTask task = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        try {
+            const BlockRoots roots = ComputeRoots(*root_state_, task);
+            task.promise.set_value(roots);
+            lock.lock();
+            AddTimings(stats_.timings, roots.timings);
+        } catch (...) {
+            task.promise.set_exception(std::current_exception());
+            lock.lock();
+        }
+        busy_ = false;
+        idle_cv_.notify_all();
+    }
+}
+
+void ObolosBlockExecutor::WaitForRoots() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+}
+
+ObolosBlockExecutor::Stats ObolosBlockExecutor::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}  // namespace pantheon::obolos
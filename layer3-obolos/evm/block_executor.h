@@ -0,0 +1,197 @@
+// ParthenonChain - Obolos Block Execution
+// Ordered transactions through evm::VM with EIP-1559 fees, receipts and
+// blooms, and state/receipt roots hashed behind the next block's execution
+
+#pragma once
+
+#include "access_list.h"
+#include "bloom.h"
+#include "state.h"
+#include "vm.h"
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pantheon::obolos {
+
+/**
+ * A transaction as ordered in a block; signatures are checked before
+ * execution, so from is trusted here
+ */
+struct ObolosTransaction {
+    parthenon::evm::Address from{};
+    parthenon::evm::Address to{};  // The VM has no CREATE: every transaction is a call
+    uint64_t nonce = 0;
+    uint64_t gas_limit = 0;
+    uint64_t max_fee_per_gas = 0;
+    uint64_t max_priority_fee_per_gas = 0;
+    parthenon::evm::uint256_t value{};
+    std::vector<uint8_t> data;
+    parthenon::evm::AccessList access_list;
+};
+
+struct ObolosBlock {
+    uint64_t number = 0;
+    uint64_t timestamp = 0;
+    parthenon::evm::Address coinbase{};  // Receives the priority fees
+    uint64_t gas_limit = 0;
+    uint64_t base_fee = 0;
+    std::vector<ObolosTransaction> transactions;
+};
+
+struct ObolosReceipt {
+    parthenon::evm::ExecResult result = parthenon::evm::ExecResult::SUCCESS;
+    uint64_t gas_used = 0;             // Including intrinsic gas, after the refund
+    uint64_t cumulative_gas_used = 0;  // This and every earlier transaction in the block
+    uint64_t effective_gas_price = 0;
+    std::vector<uint8_t> output;
+    std::vector<parthenon::evm::LogEntry> logs;  // Empty unless the call succeeded
+    parthenon::evm::LogBloom bloom;
+
+    bool Succeeded() const {
+        return result == parthenon::evm::ExecResult::SUCCESS ||
+               result == parthenon::evm::ExecResult::RETURNED;
+    }
+};
+
+/**
+ * Wall time per stage of a block, in nanoseconds
+ */
+struct BlockStageTimings {
+    uint64_t execute_ns = 0;        // Checks, the VM and fee transfers
+    uint64_t collect_ns = 0;        // Gathering the block's state changes and receipts to hash
+    uint64_t state_root_ns = 0;     // Applying those changes and hashing the state trie
+    uint64_t receipts_root_ns = 0;  // Building and hashing the receipt trie
+};
+
+struct BlockRoots {
+    std::array<uint8_t, 32> state_root{};
+    std::array<uint8_t, 32> receipts_root{};
+    BlockStageTimings timings;  // All four stages
+};
+
+struct ExecutedBlock {
+    bool valid = false;
+    std::string error;      // Why the block was rejected
+    size_t failed_tx = 0;   // Offending transaction; transactions.size() for the header
+    std::vector<ObolosReceipt> receipts;
+    uint64_t gas_used = 0;
+    parthenon::evm::LogBloom bloom;          // Union of the receipts' blooms
+    parthenon::evm::uint256_t base_fee_burned{};
+    parthenon::evm::uint256_t priority_fees{};  // Paid to the coinbase
+    BlockStageTimings timings;               // execute_ns and collect_ns only
+
+    // Ready once the block's roots are hashed; invalid blocks have none
+    std::shared_future<BlockRoots> roots;
+};
+
+/**
+ * Executes Obolos blocks against a WorldState
+ *
+ * Transactions run in block order. Each must carry the sender's next
+ * nonce, a fee cap of at least the base fee, at least its intrinsic gas
+ * (IntrinsicGas() in execution.h) and a balance covering
+ * gas_limit * max_fee_per_gas + value; otherwise the whole block is
+ * rejected and the state is left as it was. The sender is charged
+ * gas_used * effective gas price: the base fee part is burned and the
+ * priority part is paid to the coinbase (gas_pricing.h). A failed call
+ * keeps its nonce bump and fee and discards everything else.
+ *
+ * With pipelining, the roots of block N are computed on a background
+ * thread while block N+1 executes. That thread keeps its own copy of the
+ * state, taken at construction, and applies each block's changes to it in
+ * order, so it never reads the state being executed. The copy costs a
+ * second set of the state's in-memory maps. Without pipelining, roots are
+ * hashed on the calling thread before ExecuteBlock() returns.
+ *
+ * After the first block, each block must have the next number and the base
+ * fee CalculateNextBaseFee() gives for its parent.
+ */
+class ObolosBlockExecutor {
+  public:
+    struct Stats {
+        uint64_t blocks = 0;    // Valid blocks executed
+        uint64_t rejected = 0;  // Invalid blocks
+        uint64_t transactions = 0;
+        uint64_t gas_used = 0;
+        BlockStageTimings timings;  // Summed over blocks whose roots are done
+    };
+
+    /**
+     * @param state Must outlive the executor; only this executor should
+     *        modify it meanwhile
+     * @param chain_id Passed to contracts through CHAINID
+     * @param pipeline_roots Hash roots in the background (see above)
+     */
+    explicit ObolosBlockExecutor(parthenon::evm::WorldState& state, uint64_t chain_id = 0,
+                                 bool pipeline_roots = true);
+
+    /**
+     * Waits for the roots of every executed block
+     */
+    ~ObolosBlockExecutor();
+
+    ObolosBlockExecutor(const ObolosBlockExecutor&) = delete;
+    ObolosBlockExecutor& operator=(const ObolosBlockExecutor&) = delete;
+
+    /**
+     * Execute a block and queue its roots
+     *
+     * Returns once the transactions have run; the roots follow in
+     * ExecutedBlock::roots.
+     */
+    ExecutedBlock ExecuteBlock(const ObolosBlock& block);
+
+    /**
+     * Wait until the roots of every executed block are ready
+     */
+    void WaitForRoots();
+
+    Stats GetStats() const;
+
+  private:
+    struct Parent {
+        uint64_t number;
+        uint64_t gas_used;
+        uint64_t gas_limit;
+        uint64_t base_fee;
+    };
+
+    struct RootTask {
+        parthenon::evm::StateDiffLayer changes;
+        std::vector<std::vector<uint8_t>> receipts;  // Encoded, in block order
+        BlockStageTimings timings;
+        std::promise<BlockRoots> promise;
+    };
+
+    BlockRoots ComputeRoots(parthenon::evm::WorldState& state, RootTask& task);
+    void WorkerLoop();
+
+    parthenon::evm::WorldState& state_;
+    const uint64_t chain_id_;
+    std::optional<Parent> parent_;
+
+    // Pipelined roots: the worker's copy of the state and its queue
+    std::unique_ptr<parthenon::evm::WorldState> root_state_;
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<RootTask> queue_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    Stats stats_;  // Guarded by mutex_
+};
+
+}  // namespace pantheon::obolos
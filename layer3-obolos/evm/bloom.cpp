@@ -0,0 +1,51 @@
+// ParthenonChain - EVM Log Bloom Implementation
+
+#include "bloom.h"
+
+#include "crypto/keccak.h"
+
+#include <algorithm>
+
+namespace parthenon {
+namespace evm {
+
+LogBloom::Positions LogBloom::BitPositions(const uint8_t* data, size_t size) {
+    const auto hash = crypto::Keccak256::Hash256(data, size);
+    Positions positions{};
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = static_cast<uint16_t>(((hash[2 * i] << 8) | hash[2 * i + 1]) % kBits);
+    }
+    return positions;
+}
+
+void LogBloom::Add(const Positions& positions) {
+    for (uint16_t bit : positions) {
+        bytes_[kBytes - 1 - bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+    }
+}
+
+void LogBloom::AddLog(const Address& address, const std::vector<uint256_t>& topics) {
+    Add(BitPositions(address));
+    for (const auto& topic : topics) {
+        Add(BitPositions(topic));
+    }
+}
+
+bool LogBloom::MayContain(const Positions& positions) const {
+    return std::all_of(positions.begin(), positions.end(), [&](uint16_t bit) {
+        return (bytes_[kBytes - 1 - bit / 8] & (1 << (bit % 8))) != 0;
+    });
+}
+
+void LogBloom::Merge(const LogBloom& other) {
+    for (size_t i = 0; i < kBytes; ++i) {
+        bytes_[i] |= other.bytes_[i];
+    }
+}
+
+bool LogBloom::Empty() const {
+    return std::all_of(bytes_.begin(), bytes_.end(), [](uint8_t byte) { return byte == 0; });
+}
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,62 @@
+// ParthenonChain - EVM Log Bloom
+// 2048-bit bloom filter over the addresses and topics of a block's logs
+
+#pragma once
+
+#include "state.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * Log bloom in the Ethereum layout: each address and topic sets three of
+ * 2048 bits, chosen by the first three 16-bit pairs of its hash modulo 2048.
+ * Bit b lives in byte 255 - b / 8. The hash is Keccak-256, as in Ethereum.
+ */
+class LogBloom {
+  public:
+    static constexpr size_t kBits = 2048;
+    static constexpr size_t kBytes = kBits / 8;
+
+    using Bytes = std::array<uint8_t, kBytes>;
+    using Positions = std::array<uint16_t, 3>;
+
+    LogBloom() : bytes_{} {}
+    explicit LogBloom(const Bytes& bytes) : bytes_(bytes) {}
+
+    /**
+     * Bits an address or topic sets
+     */
+    static Positions BitPositions(const uint8_t* data, size_t size);
+
+    template <size_t N>
+    static Positions BitPositions(const std::array<uint8_t, N>& value) {
+        return BitPositions(value.data(), value.size());
+    }
+
+    void Add(const Positions& positions);
+
+    /**
+     * Add a log's address and topics
+     */
+    void AddLog(const Address& address, const std::vector<uint256_t>& topics);
+
+    bool MayContain(const Positions& positions) const;
+
+    void Merge(const LogBloom& other);
+
+    bool Empty() const;
+
+    const Bytes& Data() const { return bytes_; }
+
+  private:
+    Bytes bytes_;
+};
+
+}  // namespace evm
+}  // namespace parthenon
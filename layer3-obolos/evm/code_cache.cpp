@@ -0,0 +1,130 @@
+// ParthenonChain - EVM Contract Code Cache Implementation
+
+#include "code_cache.h"
+
+#include "aot.h"
+
+#include "crypto/sha256.h"
+
+namespace parthenon {
+namespace evm {
+
+CodeHash HashCode(const std::vector<uint8_t>& code) {
+    if (code.empty()) {
+        return CodeHash{};
+    }
+    return crypto::SHA256::Hash256(code);
+}
+
+ContractCode::ContractCode(const CodeHash& hash, std::vector<uint8_t> bytes)
+    : hash_(hash),
+      bytes_(std::move(bytes)),
+      analysis_(AnalyzeCode(bytes_)),
+      compiled_(FindCompiledContract(hash_)) {}
+
+size_t ContractCode::MemoryUsage() const {
+    return sizeof(ContractCode) + bytes_.capacity() + sizeof(CodeAnalysis) +
+           analysis_->instructions.capacity() * sizeof(Instruction) +
+           analysis_->push_values.capacity() * sizeof(Word) +
+           analysis_->blocks.capacity() * sizeof(BlockInfo) +
+           analysis_->jumpdest_bitmap.capacity() * sizeof(uint64_t) +
+           (analysis_->jumpdest_offsets.capacity() + analysis_->jumpdest_targets.capacity()) *
+               sizeof(uint32_t) +
+           analysis_->storage_key_hints.capacity() * sizeof(StorageKeyHint);
+}
+
+const CodeHandle& EmptyCode() {
+    static const CodeHandle empty = std::make_shared<const ContractCode>(CodeHash{},
+                                                                         std::vector<uint8_t>());
+    return empty;
+}
+
+CodeCache::CodeCache(size_t max_bytes)
+    : max_bytes_(max_bytes), bytes_(0), hits_(0), misses_(0), evictions_(0) {}
+
+CodeCache& CodeCache::Global() {
+    static CodeCache cache;
+    return cache;
+}
+
+CodeHandle CodeCache::Get(const CodeHash& hash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(hash);
+    if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return *it->second;
+}
+
+CodeHandle CodeCache::GetOrInsert(const CodeHash& hash, const std::vector<uint8_t>& code) {
+    if (code.empty()) {
+        return EmptyCode();
+    }
+    if (auto cached = Get(hash)) {
+        return cached;
+    }
+
+    // Copy and analyse outside the lock; if another thread inserted the same
+    // code meanwhile, its entry wins and this one is dropped
+    auto created = std::make_shared<const ContractCode>(hash, code);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(hash);
+    if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return *it->second;
+    }
+    const size_t entry_bytes = created->MemoryUsage();
+    if (entry_bytes > max_bytes_) {
+        return created;  // Too large to cache; still usable by the caller
+    }
+    lru_.push_front(created);
+    index_.emplace(hash, lru_.begin());
+    bytes_ += entry_bytes;
+    EvictLocked();
+    return created;
+}
+
+CodeHandle CodeCache::Insert(const std::vector<uint8_t>& code) {
+    return GetOrInsert(HashCode(code), code);
+}
+
+void CodeCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+void CodeCache::Resize(size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_ = max_bytes;
+    EvictLocked();
+}
+
+CodeCache::Stats CodeCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.entries = lru_.size();
+    stats.bytes = bytes_;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    return stats;
+}
+
+void CodeCache::EvictLocked() {
+    while (!lru_.empty() && bytes_ > max_bytes_) {
+        const auto& victim = lru_.back();
+        bytes_ -= victim->MemoryUsage();
+        index_.erase(victim->Hash());
+        lru_.pop_back();
+        ++evictions_;
+    }
+}
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,143 @@
+// ParthenonChain - EVM Contract Code Cache
+// Shared immutable contract code and analysis keyed by code hash
+
+#pragma once
+
+#include "analysis.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+using CodeHash = std::array<uint8_t, 32>;
+
+struct CompiledContract;
+
+/**
+ * Hash of contract bytecode as stored in AccountState::code_hash
+ * (SHA-256; all zero for empty code)
+ */
+CodeHash HashCode(const std::vector<uint8_t>& code);
+
+/**
+ * Immutable contract bytecode with its analysis. Shared by every account
+ * and world state holding the same code, and safe to execute concurrently.
+ */
+class ContractCode {
+  public:
+    ContractCode(const CodeHash& hash, std::vector<uint8_t> bytes);
+
+    const CodeHash& Hash() const { return hash_; }
+    const std::vector<uint8_t>& Bytes() const { return bytes_; }
+    size_t Size() const { return bytes_.size(); }
+    bool Empty() const { return bytes_.empty(); }
+
+    const CodeAnalysis& Analysis() const { return *analysis_; }
+
+    /**
+     * Native code for this contract if it is one of the pinned contracts
+     * compiled ahead of time (aot.h), else nullptr
+     */
+    const CompiledContract* Compiled() const { return compiled_; }
+
+    /**
+     * Approximate heap footprint of code plus analysis
+     */
+    size_t MemoryUsage() const;
+
+  private:
+    CodeHash hash_;
+    std::vector<uint8_t> bytes_;
+    std::shared_ptr<const CodeAnalysis> analysis_;
+    const CompiledContract* compiled_;
+};
+
+/**
+ * Shared handle for empty code (accounts without a contract)
+ */
+const CodeHandle& EmptyCode();
+
+/**
+ * Process-wide LRU cache of contract code keyed by code hash, so popular
+ * contracts are stored and analysed once no matter how many accounts,
+ * world states or calls refer to them. Bounded by total MemoryUsage();
+ * evicted entries stay alive for as long as someone holds a handle.
+ */
+class CodeCache {
+  public:
+    static constexpr size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+    struct Stats {
+        size_t entries = 0;
+        size_t bytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    explicit CodeCache(size_t max_bytes = DEFAULT_MAX_BYTES);
+
+    /**
+     * Shared instance used by WorldState and the VM
+     */
+    static CodeCache& Global();
+
+    /**
+     * Look up code by hash
+     * @return Handle, or nullptr if not cached
+     */
+    CodeHandle Get(const CodeHash& hash);
+
+    /**
+     * Look up code by hash, analysing and inserting it on a miss
+     * @param hash Must equal HashCode(code)
+     */
+    CodeHandle GetOrInsert(const CodeHash& hash, const std::vector<uint8_t>& code);
+
+    /**
+     * Hash code and return its shared handle
+     */
+    CodeHandle Insert(const std::vector<uint8_t>& code);
+
+    void Clear();
+
+    /**
+     * Change the size limit, evicting as needed
+     */
+    void Resize(size_t max_bytes);
+
+    Stats GetStats() const;
+
+  private:
+    struct HashHasher {
+        size_t operator()(const CodeHash& hash) const {
+            size_t value;
+            std::memcpy(&value, hash.data(), sizeof(value));  // Already uniformly distributed
+            return value;
+        }
+    };
+
+    void EvictLocked();
+
+    size_t max_bytes_;
+    size_t bytes_;
+    uint64_t hits_;
+    uint64_t misses_;
+    uint64_t evictions_;
+
+    mutable std::mutex mutex_;
+    std::list<CodeHandle> lru_;  // Front = most recently used
+    std::unordered_map<CodeHash, std::list<CodeHandle>::iterator, HashHasher> index_;
+};
+
+}  // namespace evm
+}  // namespace parthenon
@@ -1,20 +1,370 @@
 #include "execution.h"
 
+#include "code_cache.h"
+#include "crypto/keccak.h"
+#include "opcodes.h"
+#include "precompiles.h"
+#include "uint256.h"
+
 #include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
 
 namespace pantheon::obolos {
 
+using parthenon::evm::AccessListGas;
+using parthenon::evm::Address;
+using parthenon::evm::CodeHandle;
+using parthenon::evm::ExecResult;
+using parthenon::evm::uint256_t;
+using parthenon::evm::Word;
+using parthenon::evm::WorldState;
+
+namespace {
+
+/**
+ * Read-only view of a WorldState: reads fall through to the base, writes
+ * stay in the view and are journaled for the VM's checkpoints
+ */
+class CallOverlay final : public parthenon::evm::StateAccess {
+  public:
+    explicit CallOverlay(const WorldState& base) : base_(base) {}
+
+    uint256_t GetBalance(const Address& addr) const override {
+        return Read(Key{Kind::BALANCE, addr, {}}, [&]() { return base_.GetBalance(addr); });
+    }
+
+    void SetBalance(const Address& addr, const uint256_t& balance) override {
+        Write(Key{Kind::BALANCE, addr, {}}, balance);
+    }
+
+    uint64_t GetNonce(const Address& addr) const override {
+        return parthenon::evm::ToUint64(Read(Key{Kind::NONCE, addr, {}}, [&]() {
+            return parthenon::evm::ToUint256(base_.GetNonce(addr));
+        }));
+    }
+
+    void SetNonce(const Address& addr, uint64_t nonce) override {
+        Write(Key{Kind::NONCE, addr, {}}, parthenon::evm::ToUint256(nonce));
+    }
+
+    CodeHandle GetCode(const Address& addr) const override { return base_.GetCode(addr); }
+
+    uint256_t GetStorage(const Address& addr, const uint256_t& key) const override {
+        return Read(Key{Kind::STORAGE, addr, key}, [&]() { return base_.GetStorage(addr, key); });
+    }
+
+    void SetStorage(const Address& addr, const uint256_t& key, const uint256_t& value) override {
+        Write(Key{Kind::STORAGE, addr, key}, value);
+    }
+
+    size_t Checkpoint() override {
+        checkpoints_.push_back(journal_.size());
+        return checkpoints_.size() - 1;
+    }
+
+    void RevertToCheckpoint(size_t checkpoint) override {
+        if (checkpoint >= checkpoints_.size()) {
+            return;
+        }
+        while (journal_.size() > checkpoints_[checkpoint]) {
+            auto& change = journal_.back();
+            if (change.previous) {
+                writes_[change.key] = *change.previous;
+            } else {
+                writes_.erase(change.key);
+            }
+            journal_.pop_back();
+        }
+        checkpoints_.resize(checkpoint);
+    }
+
+    void DiscardCheckpoint(size_t checkpoint) override {
+        if (checkpoint < checkpoints_.size()) {
+            checkpoints_.resize(checkpoint);
+        }
+        if (checkpoints_.empty()) {
+            journal_.clear();
+        }
+    }
+
+  private:
+    enum class Kind : uint8_t { BALANCE, NONCE, STORAGE };
+
+    struct Key {
+        Kind kind;
+        Address addr;
+        uint256_t slot;
+
+        bool operator<(const Key& other) const {
+            return std::tie(kind, addr, slot) < std::tie(other.kind, other.addr, other.slot);
+        }
+    };
+
+    struct Change {
+        Key key;
+        std::optional<uint256_t> previous;
+    };
+
+    template <typename Load>
+    uint256_t Read(const Key& key, Load load) const {
+        auto it = writes_.find(key);
+        return it != writes_.end() ? it->second : load();
+    }
+
+    void Write(const Key& key, const uint256_t& value) {
+        if (!checkpoints_.empty()) {
+            auto it = writes_.find(key);
+            journal_.push_back(Change{key, it != writes_.end()
+                                               ? std::optional<uint256_t>(it->second)
+                                               : std::nullopt});
+        }
+        writes_[key] = value;
+    }
+
+    const WorldState& base_;
+    std::map<Key, uint256_t> writes_;
+    std::vector<Change> journal_;
+    std::vector<size_t> checkpoints_;
+};
+
+}  // namespace
+
+uint64_t IntrinsicGas(const CallRequest& call) {
+    uint64_t gas = parthenon::evm::TX_BASE_GAS + AccessListGas(call.access_list);
+    if (!call.to) {
+        gas += parthenon::evm::TX_CREATE_GAS;
+    }
+    for (uint8_t byte : call.data) {
+        gas += byte == 0 ? parthenon::evm::TX_DATA_ZERO_GAS : parthenon::evm::TX_DATA_NONZERO_GAS;
+    }
+    return gas;
+}
+
+Address CreateAddress(const Address& sender, uint64_t nonce) {
+    // RLP of [sender, nonce]: the nonce as a minimal big-endian integer,
+    // with 0 encoded as the empty string
+    std::vector<uint8_t> nonce_bytes;
+    for (uint64_t n = nonce; n != 0; n >>= 8) {
+        nonce_bytes.insert(nonce_bytes.begin(), static_cast<uint8_t>(n));
+    }
+    std::vector<uint8_t> rlp = {0, static_cast<uint8_t>(0x80 + sender.size())};
+    rlp.insert(rlp.end(), sender.begin(), sender.end());
+    if (nonce_bytes.size() == 1 && nonce_bytes[0] < 0x80) {
+        rlp.push_back(nonce_bytes[0]);
+    } else {
+        rlp.push_back(static_cast<uint8_t>(0x80 + nonce_bytes.size()));
+        rlp.insert(rlp.end(), nonce_bytes.begin(), nonce_bytes.end());
+    }
+    rlp[0] = static_cast<uint8_t>(0xc0 + rlp.size() - 1);
+
+    const auto hash = parthenon::crypto::Keccak256::Hash256(rlp);
+    Address addr;
+    std::copy(hash.end() - addr.size(), hash.end(), addr.begin());
+    return addr;
+}
+
+CallResult ExecuteCall(const WorldState& state, const CallRequest& call,
+                       parthenon::evm::Tracer* tracer) {
+    CallResult result;
+    const uint64_t intrinsic_gas = IntrinsicGas(call);
+    if (intrinsic_gas > call.gas_limit) {
+        result.status = ExecResult::OUT_OF_GAS;
+        result.gas_used = result.gas_spent = call.gas_limit;
+        return result;
+    }
+    result.gas_used = result.gas_spent = intrinsic_gas;
+
+    CallOverlay view(state);
+    const Address target = call.to ? *call.to : CreateAddress(call.from, view.GetNonce(call.from));
+    if (!call.to) {
+        // Creating over an existing contract fails and consumes all gas
+        if (view.GetNonce(target) != 0 || !view.GetCode(target)->Empty()) {
+            result.status = ExecResult::REVERT;
+            result.gas_used = result.gas_spent = call.gas_limit;
+            return result;
+        }
+        result.created = target;
+        view.SetNonce(target, 1);  // EIP-161
+    }
+    const Word value = Word::FromBytes(call.value);
+    if (!value.IsZero()) {
+        const Word sender_balance = Word::FromBytes(view.GetBalance(call.from));
+        if (sender_balance < value) {
+            result.status = ExecResult::REVERT;
+            return result;
+        }
+        view.SetBalance(call.from, (sender_balance - value).ToBytes());
+        view.SetBalance(target,
+                        (Word::FromBytes(view.GetBalance(target)) + value).ToBytes());
+    }
+
+    if (call.to && parthenon::evm::IsPrecompile(*call.to)) {
+        auto precompiled = parthenon::evm::RunPrecompile(*call.to, call.data,
+                                                         call.gas_limit - intrinsic_gas);
+        result.status = precompiled.status;
+        result.output = std::move(precompiled.output);
+        result.gas_spent += precompiled.gas_used;
+        result.gas_used = result.gas_spent;
+        return result;
+    }
+
+    // Init code is analysed for this call only, not added to the CodeCache
+    const CodeHandle code =
+        call.to ? view.GetCode(*call.to)
+                : std::make_shared<const parthenon::evm::ContractCode>(
+                      parthenon::evm::HashCode(call.data), call.data);
+    if (code->Empty()) {
+        return result;
+    }
+
+    parthenon::evm::ExecutionContext ctx{};
+    ctx.origin = call.from;
+    ctx.caller = call.from;
+    ctx.address = target;
+    ctx.value = call.value;
+    if (call.to) {
+        ctx.input_data = call.data;
+    }
+    ctx.gas_limit = call.gas_limit - intrinsic_gas;
+    ctx.gas_price = call.gas_price;
+    ctx.block_number = call.block_number;
+    ctx.timestamp = call.timestamp;
+    ctx.access_list = call.access_list;
+
+    parthenon::evm::VM vm(view, ctx);
+    auto [status, output] = tracer != nullptr ? vm.Execute(*code, *tracer) : vm.Execute(*code);
+    result.status = status;
+    result.output = std::move(output);
+    result.gas_spent += vm.GetGasUsed();
+    if (!call.to && result.Succeeded()) {
+        // Storing the returned code; running short fails the create
+        const uint64_t deposit = parthenon::evm::CODE_DEPOSIT_GAS * result.output.size();
+        if (deposit > call.gas_limit - result.gas_spent) {
+            result.status = ExecResult::OUT_OF_GAS;
+            result.gas_spent = call.gas_limit;
+            result.output.clear();
+        } else {
+            result.gas_spent += deposit;
+        }
+    }
+    result.gas_used = result.gas_spent;
+    if (result.Succeeded()) {
+        result.logs = vm.GetLogs();
+        result.gas_used -= std::min(vm.GetGasRefund(),
+                                    result.gas_spent / parthenon::evm::MAX_REFUND_QUOTIENT);
+    } else {
+        result.created.reset();
+    }
+    return result;
+}
+
+GasEstimate EstimateGas(const WorldState& state, CallRequest call, uint64_t gas_cap) {
+    GasEstimate estimate;
+    uint64_t hi = call.gas_limit != 0 ? std::min(call.gas_limit, gas_cap) : gas_cap;
+    call.gas_limit = hi;
+    estimate.gas = hi;
+    estimate.result = ExecuteCall(state, call);
+    if (!estimate.result.Succeeded()) {
+        return estimate;
+    }
+    estimate.success = true;
+
+    // Less gas than was spent cannot be enough; exactly that usually is
+    uint64_t lo = estimate.result.gas_spent - 1;
+    if (estimate.result.gas_spent < hi) {
+        call.gas_limit = estimate.result.gas_spent;
+        CallResult attempt = ExecuteCall(state, call);
+        if (attempt.Succeeded()) {
+            estimate.gas = call.gas_limit;
+            estimate.result = std::move(attempt);
+            return estimate;
+        }
+        lo = call.gas_limit;
+    }
+
+    while (lo + 1 < hi) {
+        call.gas_limit = lo + (hi - lo) / 2;
+        CallResult attempt = ExecuteCall(state, call);
+        if (attempt.Succeeded()) {
+            hi = call.gas_limit;
+            estimate.result = std::move(attempt);
+        } else {
+            lo = call.gas_limit;
+        }
+    }
+    estimate.gas = hi;
+    return estimate;
+}
+
+void DryRunState::Publish(std::shared_ptr<const WorldState> state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = std::move(state);
+}
+
+std::shared_ptr<const WorldState> DryRunState::Get() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+bool DecodeHex(const std::string& hex, std::vector<uint8_t>& out) {
+    size_t start = 0;
+    if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        start = 2;
+    }
+    if ((hex.size() - start) % 2 != 0) {
+        return false;
+    }
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    std::vector<uint8_t> bytes;
+    bytes.reserve((hex.size() - start) / 2);
+    for (size_t i = start; i < hex.size(); i += 2) {
+        const int hi = nibble(hex[i]);
+        const int lo = nibble(hex[i + 1]);
+        if (hi < 0 || lo < 0) {
+            return false;
+        }
+        bytes.push_back(static_cast<uint8_t>((hi << 4) | lo));
+    }
+    out = std::move(bytes);
+    return true;
+}
+
+std::string EncodeHex(const std::vector<uint8_t>& bytes) {
+    static const char* kHex = "0123456789abcdef";
+    std::string out = "0x";
+    out.reserve(2 + bytes.size() * 2);
+    for (uint8_t byte : bytes) {
+        out.push_back(kHex[byte >> 4]);
+        out.push_back(kHex[byte & 0xF]);
+    }
+    return out;
+}
+
 ExecutionResult ExecuteEvmLikeCall(const std::string& payload, uint64_t gas_limit,
                                    uint64_t base_fee_per_gas) {
-    const uint64_t intrinsic_gas = 21000;
-    const uint64_t payload_gas = static_cast<uint64_t>(payload.size()) * 16;
-    const uint64_t total_gas = intrinsic_gas + payload_gas;
-
-    if (base_fee_per_gas == 0 || gas_limit < total_gas) {
-        return {false, std::min(gas_limit, total_gas), "out of gas"};
+    CallRequest call;
+    if (!DecodeHex(payload, call.data)) {
+        return {false, 0, "invalid payload"};
     }
+    if (base_fee_per_gas == 0) {
+        return {false, 0, "base fee must be non-zero"};
+    }
+    call.gas_limit = gas_limit;
+    call.gas_price = base_fee_per_gas;
 
-    return {true, total_gas, "0x"};
+    static const WorldState empty;
+    const CallResult result = ExecuteCall(empty, call);
+    if (!result.Succeeded()) {
+        return {false, result.gas_used, parthenon::evm::GetResultMessage(result.status)};
+    }
+    return {true, result.gas_used, EncodeHex(result.output)};
 }
 
 }  // namespace pantheon::obolos
@@ -1,7 +1,16 @@
 #pragma once
 
+#include "access_list.h"
+#include "state.h"
+#include "tracer.h"
+#include "vm.h"
+
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace pantheon::obolos {
 
@@ -11,6 +20,116 @@ struct ExecutionResult {
     std::string output;
 };
 
+/**
+ * A message call to run without committing it (eth_call, eth_estimateGas)
+ */
+struct CallRequest {
+    std::optional<parthenon::evm::Address> to;  // Unset: run data as init code
+    parthenon::evm::Address from{};
+    std::vector<uint8_t> data;
+    parthenon::evm::uint256_t value{};
+    uint64_t gas_limit = 0;
+    uint64_t gas_price = 0;
+    parthenon::evm::AccessList access_list;
+    uint64_t block_number = 0;
+    uint64_t timestamp = 0;
+};
+
+struct CallResult {
+    parthenon::evm::ExecResult status = parthenon::evm::ExecResult::SUCCESS;
+    uint64_t gas_used = 0;   // Including intrinsic gas, after the refund
+    uint64_t gas_spent = 0;  // Before the refund: the gas the call needs to have
+    std::vector<uint8_t> output;
+    std::vector<parthenon::evm::LogEntry> logs;
+    std::optional<parthenon::evm::Address> created;  // Creates only: the new contract
+
+    bool Succeeded() const {
+        return status == parthenon::evm::ExecResult::SUCCESS ||
+               status == parthenon::evm::ExecResult::RETURNED;
+    }
+};
+
+// Most gas a dry run may use unless the caller configures another cap
+constexpr uint64_t DEFAULT_CALL_GAS_CAP = 30000000;
+
+struct GasEstimate {
+    bool success = false;
+    uint64_t gas = 0;   // Lowest gas limit the call succeeds with
+    CallResult result;  // The call at that limit, or at the cap if it never succeeds
+};
+
+/**
+ * Base, calldata and access list gas charged before execution, plus
+ * TX_CREATE_GAS when call.to is unset
+ */
+uint64_t IntrinsicGas(const CallRequest& call);
+
+/**
+ * Address of the contract sender creates with nonce:
+ * keccak256(rlp([sender, nonce]))[12:], as in Ethereum
+ */
+parthenon::evm::Address CreateAddress(const parthenon::evm::Address& sender, uint64_t nonce);
+
+/**
+ * Run a call against state without modifying it
+ *
+ * Writes go to a private overlay, so any number of threads may run calls
+ * against the same WorldState at once provided nothing writes to it
+ * meanwhile (see DryRunState). The sender's nonce is not checked or bumped
+ * and gas is not paid for; value must be covered by the sender's balance.
+ * Without call.to, data runs as init code at CreateAddress(from, nonce) and
+ * the code it returns is charged CODE_DEPOSIT_GAS per byte.
+ * If tracer is set, the execution is reported to it.
+ */
+CallResult ExecuteCall(const parthenon::evm::WorldState& state, const CallRequest& call,
+                       parthenon::evm::Tracer* tracer = nullptr);
+
+/**
+ * Find the lowest gas limit a call succeeds with
+ *
+ * The call is first run with call.gas_limit, or gas_cap if that is zero or
+ * higher; the gas it spent is a lower bound, which is usually also enough,
+ * so most estimates take two runs. Otherwise the limit is binary searched
+ * between the two.
+ */
+GasEstimate EstimateGas(const parthenon::evm::WorldState& state, CallRequest call,
+                        uint64_t gas_cap = DEFAULT_CALL_GAS_CAP);
+
+/**
+ * The state dry runs execute against
+ *
+ * Block execution publishes an immutable copy after each block; RPC threads
+ * take a reference and run calls on it without holding any lock, so dry
+ * runs neither wait for nor delay the block being executed.
+ */
+class DryRunState {
+  public:
+    void Publish(std::shared_ptr<const parthenon::evm::WorldState> state);
+
+    /**
+     * Latest published state (null until the first Publish())
+     */
+    std::shared_ptr<const parthenon::evm::WorldState> Get() const;
+
+  private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<const parthenon::evm::WorldState> state_;
+};
+
+/**
+ * Decode hex with an optional 0x prefix
+ * @return false if input is not valid hex
+ */
+bool DecodeHex(const std::string& hex, std::vector<uint8_t>& out);
+
+/**
+ * Encode bytes as 0x-prefixed lowercase hex
+ */
+std::string EncodeHex(const std::vector<uint8_t>& bytes);
+
+/**
+ * Dry-run payload (hex) as init code against an empty state
+ */
 ExecutionResult ExecuteEvmLikeCall(const std::string& payload, uint64_t gas_limit,
                                    uint64_t base_fee_per_gas);
 
@@ -0,0 +1,199 @@
+// ParthenonChain - EVM Call Frame Arena Implementation
+
+#include "frame_arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace parthenon {
+namespace evm {
+
+namespace {
+
+// Commit in steps of at least this much to keep system calls off the
+// path of small, frequent memory expansions
+constexpr size_t kCommitStep = 64 * 1024;
+
+// Frames start on a cache line
+constexpr size_t kFrameAlign = 64;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t PageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    const long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<size_t>(size) : 4096;
+#endif
+}
+
+uint8_t* Reserve(size_t size) {
+#ifdef _WIN32
+    return static_cast<uint8_t*>(VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS));
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void* p = mmap(nullptr, size, PROT_NONE, flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : static_cast<uint8_t*>(p);
+#endif
+}
+
+void Unreserve(uint8_t* base, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, size);
+#endif
+}
+
+// Fresh pages read as zero on both platforms
+bool CommitPages(uint8_t* addr, size_t size) {
+#ifdef _WIN32
+    return VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(addr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+// Drop the pages' contents and make them inaccessible again. Mapping over
+// them (rather than madvise) guarantees zero pages on the next commit.
+void DecommitPages(uint8_t* addr, size_t size) {
+#ifdef _WIN32
+    VirtualFree(addr, size, MEM_DECOMMIT);
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    mmap(addr, size, PROT_NONE, flags, -1, 0);
+#endif
+}
+
+}  // namespace
+
+FrameArena& FrameArena::ForThread() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+FrameArena::FrameArena(size_t reserve_bytes) : page_size_(PageSize()) {
+    reserve_bytes = AlignUp(std::max(reserve_bytes, MIN_RESERVE), page_size_);
+    while (base_ == nullptr && reserve_bytes >= MIN_RESERVE) {
+        base_ = Reserve(reserve_bytes);
+        if (base_ == nullptr) {
+            reserve_bytes /= 2;
+        }
+    }
+    reserved_ = base_ != nullptr ? reserve_bytes : 0;
+}
+
+FrameArena::~FrameArena() {
+    assert(depth_ == 0);
+    if (base_ != nullptr) {
+        Unreserve(base_, reserved_);
+    }
+}
+
+FrameArena::Stats FrameArena::GetStats() const {
+    Stats stats;
+    stats.frames = frames_;
+    stats.commits = commits_;
+    stats.releases = releases_;
+    stats.reserved = reserved_;
+    stats.committed = committed_;
+    stats.high_water = high_water_;
+    return stats;
+}
+
+void FrameArena::Commit(size_t end) {
+    if (end <= committed_) {
+        return;
+    }
+    if (end > reserved_) {
+        throw std::bad_alloc();
+    }
+    const size_t target =
+        std::min(reserved_, AlignUp(std::max(end, committed_ + kCommitStep), page_size_));
+    if (!CommitPages(base_ + committed_, target - committed_)) {
+        throw std::bad_alloc();
+    }
+    committed_ = target;
+    ++commits_;
+}
+
+void FrameArena::Trim() {
+    const size_t keep = AlignUp(RETAIN_BYTES, page_size_);
+    if (committed_ <= keep) {
+        return;
+    }
+    DecommitPages(base_ + keep, committed_ - keep);
+    committed_ = keep;
+    dirty_ = std::min(dirty_, keep);
+    ++releases_;
+}
+
+FrameArena::Frame::Frame(FrameArena& arena) : arena_(arena), previous_top_(arena.top_) {
+    const size_t base = AlignUp(arena_.top_, kFrameAlign);
+    const size_t end = base + STACK_BYTES;
+    arena_.Commit(end);
+
+    // Stack slots are written before they are read, so need no zeroing
+    stack_ = reinterpret_cast<Word*>(arena_.base_ + base);
+    memory_ = arena_.base_ + end;
+    arena_.top_ = end;
+    arena_.dirty_ = std::max(arena_.dirty_, end);
+    arena_.high_water_ = std::max(arena_.high_water_, end);
+    ++arena_.depth_;
+    ++arena_.frames_;
+}
+
+FrameArena::Frame::~Frame() {
+    assert(arena_.top_ == static_cast<size_t>(memory_ - arena_.base_) + memory_size_);
+    arena_.top_ = previous_top_;
+    if (--arena_.depth_ == 0) {
+        arena_.Trim();
+    }
+}
+
+void FrameArena::Frame::GrowMemory(uint64_t size) {
+    assert(arena_.top_ == static_cast<size_t>(memory_ - arena_.base_) + memory_size_);
+    if (size <= memory_size_) {
+        return;
+    }
+    const size_t offset = static_cast<size_t>(memory_ - arena_.base_);
+    if (size > arena_.reserved_ - offset) {
+        throw std::bad_alloc();
+    }
+    const size_t end = offset + static_cast<size_t>(size);
+    arena_.Commit(end);
+
+    // Bytes an earlier frame used must be cleared; the rest are fresh pages
+    const size_t used = std::min(end, arena_.dirty_);
+    if (used > offset + memory_size_) {
+        std::memset(memory_ + memory_size_, 0, used - offset - memory_size_);
+    }
+    memory_size_ = size;
+    arena_.top_ = end;
+    arena_.dirty_ = std::max(arena_.dirty_, end);
+    arena_.high_water_ = std::max(arena_.high_water_, end);
+}
+
+}  // namespace evm
+}  // namespace parthenon
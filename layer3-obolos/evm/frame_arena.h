@@ -0,0 +1,126 @@
+// ParthenonChain - EVM Call Frame Arena
+// Stack and memory for nested call frames from one per-thread reservation
+
+#pragma once
+
+#include "uint256.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * Stack and memory regions for the call frames running on one thread
+ *
+ * Reserves a large range of address space once and commits it page by page
+ * as the high-water mark rises, so a frame in steady state allocates
+ * nothing: it takes STACK_BYTES of stack at the top of the arena and grows
+ * its memory in place behind it, and gives both back when it returns.
+ * Frames nest strictly (a caller is suspended while its callee runs), so
+ * only the innermost frame ever grows.
+ *
+ * Committed pages are kept across transactions, up to RETAIN_BYTES once
+ * the outermost frame returns. Not thread-safe; use ForThread().
+ */
+class FrameArena {
+  public:
+    static constexpr size_t STACK_SLOTS = 1024;
+    static constexpr size_t STACK_BYTES = STACK_SLOTS * sizeof(Word);
+    static constexpr size_t RETAIN_BYTES = 8 * 1024 * 1024;
+    static constexpr size_t DEFAULT_RESERVE =
+        sizeof(void*) >= 8 ? size_t{64} << 30 : size_t{512} << 20;
+    static constexpr size_t MIN_RESERVE = 64 * 1024 * 1024;  // 1024 stacks and some memory
+
+    struct Stats {
+        uint64_t frames = 0;    // Frames handed out
+        uint64_t commits = 0;   // Times the committed region grew
+        uint64_t releases = 0;  // Times pages above RETAIN_BYTES went back to the OS
+        size_t reserved = 0;
+        size_t committed = 0;
+        size_t high_water = 0;  // Most bytes in use at once
+    };
+
+    /**
+     * One call frame's regions, released on destruction. Frames must be
+     * destroyed in reverse order of construction.
+     */
+    class Frame {
+      public:
+        /**
+         * Push a frame; throws std::bad_alloc if its stack cannot be committed
+         */
+        explicit Frame(FrameArena& arena);
+        ~Frame();
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        // STACK_SLOTS uninitialised words
+        Word* Stack() const { return stack_; }
+
+        // Fixed for the life of the frame; valid up to MemorySize()
+        uint8_t* Memory() const { return memory_; }
+        uint64_t MemorySize() const { return memory_size_; }
+
+        /**
+         * Extend memory to size bytes, zero-filling the new part. Only the
+         * innermost frame may grow. Throws std::bad_alloc if the pages
+         * cannot be committed.
+         */
+        void GrowMemory(uint64_t size);
+
+      private:
+        FrameArena& arena_;
+        size_t previous_top_;
+        Word* stack_;
+        uint8_t* memory_;
+        uint64_t memory_size_ = 0;
+    };
+
+    /**
+     * Arena of the calling thread
+     */
+    static FrameArena& ForThread();
+
+    /**
+     * Reserve reserve_bytes of address space, or less (down to MIN_RESERVE)
+     * if the system refuses
+     */
+    explicit FrameArena(size_t reserve_bytes = DEFAULT_RESERVE);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Frames currently live
+     */
+    size_t Depth() const { return depth_; }
+
+    Stats GetStats() const;
+
+  private:
+    // Make [0, end) usable; throws std::bad_alloc
+    void Commit(size_t end);
+
+    // Return committed pages above RETAIN_BYTES (arena empty)
+    void Trim();
+
+    uint8_t* base_ = nullptr;
+    size_t reserved_ = 0;
+    size_t committed_ = 0;
+    size_t dirty_ = 0;  // Bytes past this have never been handed out since committed
+    size_t top_ = 0;
+    size_t depth_ = 0;
+    size_t page_size_ = 4096;
+
+    uint64_t frames_ = 0;
+    uint64_t commits_ = 0;
+    uint64_t releases_ = 0;
+    size_t high_water_ = 0;
+};
+
+}  // namespace evm
+}  // namespace parthenon
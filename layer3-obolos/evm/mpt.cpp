@@ -2,16 +2,22 @@
 
 #include "mpt.h"
 
-#include "crypto/sha256.h"
+#include "crypto/keccak.h"
 
 #include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 namespace parthenon {
 namespace evm {
 
-MerklePatriciaTrie::MerklePatriciaTrie() : root_(std::make_shared<Node>()) {
-    root_->type = NodeType::EMPTY;
+MerklePatriciaTrie::MerklePatriciaTrie() = default;
+
+MerklePatriciaTrie::MerklePatriciaTrie(const Hash& root, const TrieNodeStore* store)
+    : store_(store) {
+    if (root != Hash{}) {
+        root_ = MakeStub(root);
+    }
 }
 
 MerklePatriciaTrie::~MerklePatriciaTrie() = default;
@@ -34,16 +40,39 @@ std::optional<MerklePatriciaTrie::Value> MerklePatriciaTrie::Get(const Key& key)
 
 void MerklePatriciaTrie::Delete(const Key& key) {
     auto nibbles = ToNibbles(key);
-    root_ = Remove(root_, nibbles, 0);
+    bool removed = false;
+    auto updated = Remove(root_, nibbles, 0, removed);
+    if (removed) {
+        root_ = updated;
+    }
 }
 
 MerklePatriciaTrie::Hash MerklePatriciaTrie::GetRootHash() const {
+    HashDirtyNodes();
     return HashNode(root_);
 }
 
 void MerklePatriciaTrie::Clear() {
-    root_ = std::make_shared<Node>();
-    root_->type = NodeType::EMPTY;
+    root_.reset();
+}
+
+MerklePatriciaTrie::Hash MerklePatriciaTrie::Commit(const NodeSink& sink) {
+    HashDirtyNodes();
+    CommitNode(root_, sink);
+    return HashNode(root_);
+}
+
+void MerklePatriciaTrie::CommitNode(const NodePtr& node, const NodeSink& sink) const {
+    // Persisted nodes only ever have persisted children
+    if (!node || node->persisted) {
+        return;
+    }
+    for (const auto& child : node->children) {
+        CommitNode(child, sink);
+    }
+    const Hash hash = HashNode(node);
+    sink(hash, EncodeNode(node));
+    node->persisted = true;
 }
 
 std::vector<uint8_t> MerklePatriciaTrie::ToNibbles(const Key& key) {
@@ -83,251 +112,238 @@ size_t MerklePatriciaTrie::CommonPrefixLength(const std::vector<uint8_t>& a, siz
     return length;
 }
 
-MerklePatriciaTrie::NodePtr MerklePatriciaTrie::Insert(NodePtr node,
-                                                       const std::vector<uint8_t>& nibbles,
-                                                       size_t idx, const Value& value) {
-    // Base case: reached end of path
-    if (idx == nibbles.size()) {
-        if (node->type == NodeType::EMPTY) {
-            // Create new leaf
-            auto leaf = std::make_shared<Node>();
-            leaf->type = NodeType::LEAF;
-            leaf->path.clear();
-            leaf->value = value;
-            return leaf;
-        } else if (node->type == NodeType::BRANCH) {
-            // Update branch value
-            node->value = value;
-            return node;
-        } else {
-            // Convert to branch with value
-            auto branch = std::make_shared<Node>();
-            branch->type = NodeType::BRANCH;
-            branch->children.resize(17);
-            branch->value = value;
-            return branch;
+MerklePatriciaTrie::NodePtr MerklePatriciaTrie::MakeLeaf(std::vector<uint8_t> path,
+                                                         const Value& value) {
+    auto leaf = std::make_shared<Node>(NodeType::LEAF);
+    leaf->path = std::move(path);
+    leaf->value = value;
+    return leaf;
+}
+
+MerklePatriciaTrie::NodePtr MerklePatriciaTrie::CopyNode(const NodePtr& node) {
+    auto copy = std::make_shared<Node>(*node);
+    copy->dirty = true;
+    copy->persisted = false;
+    return copy;
+}
+
+MerklePatriciaTrie::NodePtr MerklePatriciaTrie::MakeStub(const Hash& hash) {
+    auto stub = std::make_shared<Node>(NodeType::EMPTY);
+    stub->hash = hash;
+    stub->dirty = false;
+    stub->persisted = true;
+    stub->resolved = false;
+    return stub;
+}
+
+const MerklePatriciaTrie::NodePtr& MerklePatriciaTrie::Resolve(const NodePtr& node) const {
+    if (node && !node->resolved) {
+        auto encoded = store_ ? store_->GetNode(node->hash) : std::nullopt;
+        if (!encoded || !DecodeNode(*encoded, *node)) {
+            throw std::runtime_error("Missing or corrupt trie node");
         }
+        node->resolved = true;
     }
+    return node;
+}
 
-    if (node->type == NodeType::EMPTY) {
-        // Create new leaf for remaining path
-        auto leaf = std::make_shared<Node>();
-        leaf->type = NodeType::LEAF;
-        leaf->path.assign(nibbles.begin() + idx, nibbles.end());
-        leaf->value = value;
-        return leaf;
+MerklePatriciaTrie::NodePtr MerklePatriciaTrie::WithPrefix(std::vector<uint8_t> prefix,
+                                                           const NodePtr& node) const {
+    if (prefix.empty()) {
+        return node;
     }
+    Resolve(node);
 
     if (node->type == NodeType::LEAF || node->type == NodeType::EXTENSION) {
-        size_t common = CommonPrefixLength(nibbles, idx, node->path, 0);
-
-        if (common == node->path.size()) {
-            // Path fully matches - continue down
-            if (node->type == NodeType::LEAF) {
-                // Convert leaf to extension+branch
-                if (idx + common == nibbles.size()) {
-                    // Exact match - update value
-                    node->value = value;
-                    return node;
-                } else {
-                    // Create branch
-                    auto branch = std::make_shared<Node>();
-                    branch->type = NodeType::BRANCH;
-                    branch->children.resize(17);
-                    branch->children[nibbles[idx + common]] =
-                        Insert(std::make_shared<Node>(), nibbles, idx + common + 1, value);
-                    branch->value = node->value;  // Old leaf value goes to branch
-
-                    if (common > 0) {
-                        // Create extension
-                        auto ext = std::make_shared<Node>();
-                        ext->type = NodeType::EXTENSION;
-                        ext->path = node->path;
-                        ext->children.resize(1);
-                        ext->children[0] = branch;
-                        return ext;
-                    }
-                    return branch;
-                }
-            } else {
-                // Extension - continue to child
-                node->children[0] = Insert(node->children[0], nibbles, idx + common, value);
-                return node;
-            }
-        } else {
-            // Partial match - need to split
-            auto branch = std::make_shared<Node>();
-            branch->type = NodeType::BRANCH;
-            branch->children.resize(17);
-
-            // Add old node's remaining path
-            if (common < node->path.size()) {
-                auto old_child = std::make_shared<Node>();
-                old_child->type = node->type;
-                old_child->path.assign(node->path.begin() + common + 1, node->path.end());
-                old_child->value = node->value;
-                old_child->children = node->children;
-                branch->children[node->path[common]] = old_child;
-            }
-
-            // Add new value's remaining path
-            if (idx + common < nibbles.size()) {
-                branch->children[nibbles[idx + common]] =
-                    Insert(std::make_shared<Node>(), nibbles, idx + common + 1, value);
-            } else {
-                branch->value = value;
-            }
-
-            // Add extension for common prefix if needed
-            if (common > 0) {
-                auto ext = std::make_shared<Node>();
-                ext->type = NodeType::EXTENSION;
-                ext->path.assign(node->path.begin(), node->path.begin() + common);
-                ext->children.resize(1);
-                ext->children[0] = branch;
-                return ext;
-            }
-
-            return branch;
+        auto merged = std::make_shared<Node>(node->type);
+        prefix.insert(prefix.end(), node->path.begin(), node->path.end());
+        merged->path = std::move(prefix);
+        merged->value = node->value;
+        merged->children = node->children;
+        return merged;
+    }
+
+    auto ext = std::make_shared<Node>(NodeType::EXTENSION);
+    ext->path = std::move(prefix);
+    ext->children[0] = node;
+    return ext;
+}
+
+MerklePatriciaTrie::NodePtr MerklePatriciaTrie::NormalizeBranch(const NodePtr& branch) const {
+    int remaining = 0;
+    int remaining_idx = -1;
+    for (int i = 0; i < 16; ++i) {
+        if (branch->children[i]) {
+            ++remaining;
+            remaining_idx = i;
         }
     }
 
+    if (remaining == 0) {
+        return branch->value.empty() ? nullptr : MakeLeaf({}, branch->value);
+    }
+    if (remaining == 1 && branch->value.empty()) {
+        // Collapse: merge the remaining child into a leaf/extension
+        return WithPrefix({static_cast<uint8_t>(remaining_idx)}, branch->children[remaining_idx]);
+    }
+    return branch;
+}
+
+MerklePatriciaTrie::NodePtr MerklePatriciaTrie::Insert(const NodePtr& node,
+                                                       const std::vector<uint8_t>& nibbles,
+                                                       size_t idx, const Value& value) {
+    if (!node) {
+        // Create new leaf for remaining path
+        return MakeLeaf(std::vector<uint8_t>(nibbles.begin() + idx, nibbles.end()), value);
+    }
+    Resolve(node);
+
     if (node->type == NodeType::BRANCH) {
-        uint8_t nibble = nibbles[idx];
-        node->children[nibble] =
-            Insert(node->children[nibble] ? node->children[nibble] : std::make_shared<Node>(),
-                   nibbles, idx + 1, value);
-        return node;
+        auto branch = CopyNode(node);
+        if (idx == nibbles.size()) {
+            branch->value = value;
+        } else {
+            uint8_t nibble = nibbles[idx];
+            branch->children[nibble] = Insert(node->children[nibble], nibbles, idx + 1, value);
+        }
+        return branch;
     }
 
-    return node;
+    // Leaf or extension
+    size_t common = CommonPrefixLength(nibbles, idx, node->path, 0);
+
+    if (common == node->path.size()) {
+        if (node->type == NodeType::EXTENSION) {
+            // Path fully matches - continue to child
+            auto ext = CopyNode(node);
+            ext->children[0] = Insert(node->children[0], nibbles, idx + common, value);
+            return ext;
+        }
+        if (idx + common == nibbles.size()) {
+            // Exact match - update value
+            return MakeLeaf(node->path, value);
+        }
+    }
+
+    // Split at the first differing nibble
+    auto branch = std::make_shared<Node>(NodeType::BRANCH);
+
+    // Old node's remaining path
+    if (common == node->path.size()) {
+        branch->value = node->value;  // Leaf key is a prefix of the new key
+    } else if (node->type == NodeType::LEAF) {
+        branch->children[node->path[common]] = MakeLeaf(
+            std::vector<uint8_t>(node->path.begin() + common + 1, node->path.end()), node->value);
+    } else {
+        branch->children[node->path[common]] = WithPrefix(
+            std::vector<uint8_t>(node->path.begin() + common + 1, node->path.end()),
+            node->children[0]);
+    }
+
+    // New value's remaining path
+    if (idx + common == nibbles.size()) {
+        branch->value = value;
+    } else {
+        branch->children[nibbles[idx + common]] = MakeLeaf(
+            std::vector<uint8_t>(nibbles.begin() + idx + common + 1, nibbles.end()), value);
+    }
+
+    // Extension for the common prefix if needed
+    return WithPrefix(std::vector<uint8_t>(node->path.begin(), node->path.begin() + common),
+                      branch);
 }
 
 std::optional<MerklePatriciaTrie::Value>
 MerklePatriciaTrie::Lookup(const NodePtr& node, const std::vector<uint8_t>& nibbles,
                            size_t idx) const {
-    if (!node || node->type == NodeType::EMPTY) {
-        return std::nullopt;
-    }
-
-    if (idx == nibbles.size()) {
-        if (node->type == NodeType::LEAF || node->type == NodeType::BRANCH) {
-            if (!node->value.empty()) {
-                return node->value;
-            }
-        }
+    if (!node) {
         return std::nullopt;
     }
+    Resolve(node);
 
     if (node->type == NodeType::LEAF) {
         // Check if path matches
-        if (idx + node->path.size() == nibbles.size()) {
-            if (std::equal(node->path.begin(), node->path.end(), nibbles.begin() + idx)) {
-                return node->value;
-            }
+        if (idx + node->path.size() == nibbles.size() &&
+            std::equal(node->path.begin(), node->path.end(), nibbles.begin() + idx)) {
+            return node->value;
         }
         return std::nullopt;
     }
 
     if (node->type == NodeType::EXTENSION) {
         // Check if path matches
-        if (idx + node->path.size() <= nibbles.size()) {
-            if (std::equal(node->path.begin(), node->path.end(), nibbles.begin() + idx)) {
-                return Lookup(node->children[0], nibbles, idx + node->path.size());
-            }
+        if (idx + node->path.size() <= nibbles.size() &&
+            std::equal(node->path.begin(), node->path.end(), nibbles.begin() + idx)) {
+            return Lookup(node->children[0], nibbles, idx + node->path.size());
         }
         return std::nullopt;
     }
 
-    if (node->type == NodeType::BRANCH) {
-        uint8_t nibble = nibbles[idx];
-        if (nibble < 16 && node->children[nibble]) {
-            return Lookup(node->children[nibble], nibbles, idx + 1);
+    // Branch
+    if (idx == nibbles.size()) {
+        if (!node->value.empty()) {
+            return node->value;
         }
         return std::nullopt;
     }
-
-    return std::nullopt;
+    return Lookup(node->children[nibbles[idx]], nibbles, idx + 1);
 }
 
-MerklePatriciaTrie::NodePtr
-MerklePatriciaTrie::Remove(NodePtr node, const std::vector<uint8_t>& nibbles, size_t idx) {
-    if (!node || node->type == NodeType::EMPTY) {
-        return node;
-    }
-
-    if (idx == nibbles.size()) {
-        // Clear the value at this node
-        node->value.clear();
-        // If a LEAF has no value, replace with EMPTY node
-        if (node->type == NodeType::LEAF) {
-            return std::make_shared<Node>();  // EMPTY
-        }
+MerklePatriciaTrie::NodePtr MerklePatriciaTrie::Remove(const NodePtr& node,
+                                                       const std::vector<uint8_t>& nibbles,
+                                                       size_t idx, bool& removed) {
+    if (!node) {
         return node;
     }
+    Resolve(node);
 
     if (node->type == NodeType::LEAF) {
         // Check if the remaining path matches this leaf
         if (node->path.size() == nibbles.size() - idx &&
             std::equal(node->path.begin(), node->path.end(), nibbles.begin() + idx)) {
-            node->value.clear();
-            return std::make_shared<Node>();  // EMPTY
+            removed = true;
+            return nullptr;
         }
         return node;  // Different path, no change
     }
 
-    if (node->type == NodeType::BRANCH) {
-        uint8_t nibble = nibbles[idx];
-        if (nibble < 16 && node->children[nibble]) {
-            node->children[nibble] = Remove(node->children[nibble], nibbles, idx + 1);
-        }
-        // Collapse branch with a single remaining child into extension/leaf
-        int remaining = 0;
-        int remaining_idx = -1;
-        for (int i = 0; i < 16; ++i) {
-            if (node->children[i] && node->children[i]->type != NodeType::EMPTY) {
-                ++remaining;
-                remaining_idx = i;
-            }
+    if (node->type == NodeType::EXTENSION) {
+        if (idx + node->path.size() > nibbles.size() ||
+            !std::equal(node->path.begin(), node->path.end(), nibbles.begin() + idx)) {
+            return node;
         }
-        if (remaining == 0 && node->value.empty()) {
-            return std::make_shared<Node>();  // EMPTY
+        auto child = Remove(node->children[0], nibbles, idx + node->path.size(), removed);
+        if (!removed) {
+            return node;
         }
-        if (remaining == 1 && node->value.empty()) {
-            // Collapse: merge remaining child into this node as extension
-            auto child = node->children[remaining_idx];
-            auto ext = std::make_shared<Node>();
-            ext->type = NodeType::EXTENSION;
-            ext->path.push_back(static_cast<uint8_t>(remaining_idx));
-            ext->path.insert(ext->path.end(), child->path.begin(), child->path.end());
-            ext->value = child->value;
-            ext->children = child->children;
-            return ext;
+        if (!child) {
+            return nullptr;
         }
-        return node;
+        return WithPrefix(node->path, child);
     }
 
-    if (node->type == NodeType::EXTENSION) {
-        if (idx + node->path.size() <= nibbles.size() &&
-            std::equal(node->path.begin(), node->path.end(), nibbles.begin() + idx)) {
-            node->children[0] = Remove(node->children[0], nibbles, idx + node->path.size());
-            if (!node->children[0] || node->children[0]->type == NodeType::EMPTY) {
-                return std::make_shared<Node>();  // EMPTY
-            }
+    // Branch
+    auto branch = CopyNode(node);
+    if (idx == nibbles.size()) {
+        if (node->value.empty()) {
+            return node;
         }
-        return node;
+        branch->value.clear();
+        removed = true;
+    } else {
+        uint8_t nibble = nibbles[idx];
+        auto child = Remove(node->children[nibble], nibbles, idx + 1, removed);
+        if (!removed) {
+            return node;
+        }
+        branch->children[nibble] = child;
     }
-
-    return node;
+    return NormalizeBranch(branch);
 }
 
 std::vector<uint8_t> MerklePatriciaTrie::EncodeNode(const NodePtr& node) const {
     std::vector<uint8_t> encoded;
 
-    if (!node || node->type == NodeType::EMPTY) {
-        return encoded;  // Empty encoding
-    }
-
     // Encode node type
     encoded.push_back(static_cast<uint8_t>(node->type));
 
@@ -338,53 +354,141 @@ std::vector<uint8_t> MerklePatriciaTrie::EncodeNode(const NodePtr& node) const {
     }
 
     // Encode value
-    if (!node->value.empty()) {
-        encoded.push_back(static_cast<uint8_t>(node->value.size() >> 8));
-        encoded.push_back(static_cast<uint8_t>(node->value.size() & 0xFF));
-        encoded.insert(encoded.end(), node->value.begin(), node->value.end());
-    } else {
-        encoded.push_back(0);
-        encoded.push_back(0);
-    }
+    encoded.push_back(static_cast<uint8_t>(node->value.size() >> 8));
+    encoded.push_back(static_cast<uint8_t>(node->value.size() & 0xFF));
+    encoded.insert(encoded.end(), node->value.begin(), node->value.end());
 
     // Encode children (for branch)
     if (node->type == NodeType::BRANCH) {
         for (size_t i = 0; i < 16; i++) {
-            if (node->children[i]) {
-                auto child_hash = HashNode(node->children[i]);
-                encoded.insert(encoded.end(), child_hash.begin(), child_hash.end());
-            } else {
-                // Empty child
-                std::array<uint8_t, 32> zero{};
-                encoded.insert(encoded.end(), zero.begin(), zero.end());
-            }
+            // Empty children encode as a zero hash
+            auto child_hash = HashNode(node->children[i]);
+            encoded.insert(encoded.end(), child_hash.begin(), child_hash.end());
         }
     } else if (node->type == NodeType::EXTENSION) {
         // Extension has one child
-        if (node->children.size() > 0 && node->children[0]) {
-            auto child_hash = HashNode(node->children[0]);
-            encoded.insert(encoded.end(), child_hash.begin(), child_hash.end());
-        }
+        auto child_hash = HashNode(node->children[0]);
+        encoded.insert(encoded.end(), child_hash.begin(), child_hash.end());
     }
 
     return encoded;
 }
 
+bool MerklePatriciaTrie::DecodeNode(const std::vector<uint8_t>& encoded, Node& node) {
+    size_t pos = 0;
+    auto take = [&](size_t n) {
+        if (encoded.size() - pos < n) {
+            return false;
+        }
+        pos += n;
+        return true;
+    };
+
+    if (!take(1)) {
+        return false;
+    }
+    node.type = static_cast<NodeType>(encoded[0]);
+    if (node.type != NodeType::LEAF && node.type != NodeType::EXTENSION &&
+        node.type != NodeType::BRANCH) {
+        return false;
+    }
+
+    if (node.type == NodeType::LEAF || node.type == NodeType::EXTENSION) {
+        if (!take(1)) {
+            return false;
+        }
+        const size_t path_size = encoded[pos - 1];
+        if (!take(path_size)) {
+            return false;
+        }
+        node.path.assign(encoded.begin() + (pos - path_size), encoded.begin() + pos);
+    }
+
+    if (!take(2)) {
+        return false;
+    }
+    const size_t value_size = (static_cast<size_t>(encoded[pos - 2]) << 8) | encoded[pos - 1];
+    if (!take(value_size)) {
+        return false;
+    }
+    node.value.assign(encoded.begin() + (pos - value_size), encoded.begin() + pos);
+
+    const size_t child_count = node.type == NodeType::BRANCH      ? 16
+                               : node.type == NodeType::EXTENSION ? 1
+                                                                  : 0;
+    for (size_t i = 0; i < child_count; ++i) {
+        if (!take(32)) {
+            return false;
+        }
+        Hash child_hash;
+        std::memcpy(child_hash.data(), encoded.data() + pos - 32, 32);
+        if (child_hash != Hash{}) {
+            node.children[i] = MakeStub(child_hash);
+        }
+    }
+    return pos == encoded.size();
+}
+
 MerklePatriciaTrie::Hash MerklePatriciaTrie::HashNode(const NodePtr& node) const {
-    if (!node || node->type == NodeType::EMPTY) {
+    if (!node) {
         // Empty node hash
         return Hash{};
     }
+    if (!node->dirty) {
+        return node->hash;
+    }
 
     auto encoded = EncodeNode(node);
+    node->hash = crypto::Keccak256::Hash256(encoded);
+    node->dirty = false;
+    ++hashed_nodes_;
+    return node->hash;
+}
 
-    crypto::SHA256 hasher;
-    hasher.Write(encoded.data(), encoded.size());
-    auto hash_result = hasher.Finalize();
+size_t MerklePatriciaTrie::CollectDirty(const NodePtr& node,
+                                        std::vector<std::vector<NodePtr>>& levels) {
+    size_t level = 0;
+    for (const auto& child : node->children) {
+        if (child && child->dirty) {
+            level = std::max(level, CollectDirty(child, levels) + 1);
+        }
+    }
+    if (levels.size() <= level) {
+        levels.resize(level + 1);
+    }
+    levels[level].push_back(node);
+    return level;
+}
 
-    Hash result;
-    std::memcpy(result.data(), hash_result.data(), 32);
-    return result;
+void MerklePatriciaTrie::HashDirtyNodes() const {
+    if (!root_ || !root_->dirty) {
+        return;
+    }
+    std::vector<std::vector<NodePtr>> levels;
+    CollectDirty(root_, levels);
+
+    std::vector<std::vector<uint8_t>> encoded;
+    std::vector<const uint8_t*> data;
+    std::vector<size_t> sizes;
+    std::vector<Hash> hashes;
+    for (const auto& level : levels) {
+        // Children are all hashed by now, so these encode without recursing
+        encoded.clear();
+        data.clear();
+        sizes.clear();
+        for (const auto& node : level) {
+            encoded.push_back(EncodeNode(node));
+            data.push_back(encoded.back().data());
+            sizes.push_back(encoded.back().size());
+        }
+        hashes.resize(level.size());
+        crypto::Keccak256::HashBatch(data.data(), sizes.data(), level.size(), hashes.data());
+        for (size_t i = 0; i < level.size(); ++i) {
+            level[i]->hash = hashes[i];
+            level[i]->dirty = false;
+        }
+        hashed_nodes_ += level.size();
+    }
 }
 
 }  // namespace evm
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -14,14 +15,40 @@
 namespace parthenon {
 namespace evm {
 
+/**
+ * Source of persisted trie nodes, keyed by node hash
+ */
+class TrieNodeStore {
+  public:
+    virtual ~TrieNodeStore() = default;
+
+    /**
+     * Get the encoding of a node previously committed with this hash
+     */
+    virtual std::optional<std::vector<uint8_t>>
+    GetNode(const std::array<uint8_t, 32>& hash) const = 0;
+};
+
 /**
  * Merkle Patricia Trie implementation for Ethereum-compatible state roots
  *
  * This implements a modified Merkle Patricia Trie as specified in the
- * Ethereum Yellow Paper, using RLP encoding and Keccak-256 hashing.
+ * Ethereum Yellow Paper, with Keccak-256 node hashes and a simplified
+ * node encoding in place of RLP.
+ *
+ * Nodes are immutable once linked into the trie: updates copy the path from
+ * the root to the modified leaf and share every other node. Each node caches
+ * its hash, so GetRootHash() only hashes nodes created since the last call,
+ * and copying a trie is O(1). Those nodes are hashed a level at a time,
+ * deepest first, through the multi-buffer Keccak256::HashBatch(). The structure is canonical, so the root hash
+ * depends only on the key/value set, not on the order of updates.
  *
- * For now, we use SHA-256 instead of Keccak-256 for simplicity while
- * maintaining the MPT structure.
+ * A trie opened from a root hash and a TrieNodeStore loads nodes from the
+ * store the first time a lookup or update reaches them; Commit() hands new
+ * nodes back for persisting. A missing node throws std::runtime_error.
+ *
+ * Copies share nodes and their hash caches; hashing copies of one trie
+ * concurrently from several threads is not supported.
  */
 class MerklePatriciaTrie {
   public:
@@ -29,11 +56,20 @@ class MerklePatriciaTrie {
     using Key = std::vector<uint8_t>;
     using Value = std::vector<uint8_t>;
 
+    using NodeSink = std::function<void(const Hash& hash, const std::vector<uint8_t>& encoded)>;
+
     MerklePatriciaTrie();
+
+    /**
+     * Open a persisted trie by root hash (a zero hash is the empty trie)
+     * @param store Node store; must outlive the trie and its copies
+     */
+    MerklePatriciaTrie(const Hash& root, const TrieNodeStore* store);
+
     ~MerklePatriciaTrie();
 
     /**
-     * Insert or update a key-value pair
+     * Insert or update a key-value pair (an empty value deletes the key)
      */
     void Put(const Key& key, const Value& value);
 
@@ -58,6 +94,18 @@ class MerklePatriciaTrie {
      */
     void Clear();
 
+    /**
+     * Pass every node created since the last commit to sink (children
+     * before parents) and mark them persisted
+     * @return Root hash
+     */
+    Hash Commit(const NodeSink& sink);
+
+    /**
+     * Number of nodes hashed by this trie so far (cached hashes excluded)
+     */
+    uint64_t GetHashedNodeCount() const { return hashed_nodes_; }
+
   private:
     struct Node;
     using NodePtr = std::shared_ptr<Node>;
@@ -74,25 +122,56 @@ class MerklePatriciaTrie {
 
     /**
      * MPT Node
+     *
+     * Invariants: the empty trie is a null root; extensions have a non-empty
+     * path and a branch child; branches hold at least two entries (children
+     * or value).
      */
     struct Node {
         NodeType type;
-        std::vector<uint8_t> path;      // Nibble path (for leaf/extension)
-        std::vector<uint8_t> value;     // Value (for leaf/branch)
-        std::vector<NodePtr> children;  // Children (for branch: 16 + 1 for value)
-
-        Node() : type(NodeType::EMPTY) {}
+        std::vector<uint8_t> path;              // Nibble path (for leaf/extension)
+        std::vector<uint8_t> value;             // Value (for leaf/branch)
+        std::array<NodePtr, 16> children;       // Branch children; extension uses [0]
+        mutable Hash hash{};                    // Cached hash, valid unless dirty
+        mutable bool dirty = true;
+        mutable bool persisted = false;         // Already in the node store
+        mutable bool resolved = true;           // False until loaded from the store
+
+        explicit Node(NodeType node_type) : type(node_type) {}
     };
 
-    // Root node
+    // Root node (null when empty)
     NodePtr root_;
+    const TrieNodeStore* store_ = nullptr;
+
+    mutable uint64_t hashed_nodes_ = 0;
 
     // Helper functions
-    NodePtr Insert(NodePtr node, const std::vector<uint8_t>& nibbles, size_t idx,
+    NodePtr Insert(const NodePtr& node, const std::vector<uint8_t>& nibbles, size_t idx,
                    const Value& value);
     std::optional<Value> Lookup(const NodePtr& node, const std::vector<uint8_t>& nibbles,
                                 size_t idx) const;
-    NodePtr Remove(NodePtr node, const std::vector<uint8_t>& nibbles, size_t idx);
+    NodePtr Remove(const NodePtr& node, const std::vector<uint8_t>& nibbles, size_t idx,
+                   bool& removed);
+
+    static NodePtr MakeLeaf(std::vector<uint8_t> path, const Value& value);
+
+    // Copy a node for modification (path copying)
+    static NodePtr CopyNode(const NodePtr& node);
+
+    // Placeholder for a persisted node that has not been loaded yet
+    static NodePtr MakeStub(const Hash& hash);
+
+    // Load a stub's contents from the store
+    const NodePtr& Resolve(const NodePtr& node) const;
+
+    // Prepend a nibble path to a node, merging into leaves and extensions
+    NodePtr WithPrefix(std::vector<uint8_t> prefix, const NodePtr& node) const;
+
+    // Restore branch invariants after a removal
+    NodePtr NormalizeBranch(const NodePtr& branch) const;
+
+    void CommitNode(const NodePtr& node, const NodeSink& sink) const;
 
     // Convert byte key to nibbles (hex digits)
     static std::vector<uint8_t> ToNibbles(const Key& key);
@@ -100,12 +179,21 @@ class MerklePatriciaTrie {
     // Convert nibbles back to bytes
     static Key FromNibbles(const std::vector<uint8_t>& nibbles);
 
-    // Hash a node
+    // Hash a node, reusing its cached hash when clean
     Hash HashNode(const NodePtr& node) const;
 
+    // Hash every dirty node in batches, one per level above the leaves
+    void HashDirtyNodes() const;
+
+    // Group dirty nodes by height above their deepest dirty descendant
+    static size_t CollectDirty(const NodePtr& node, std::vector<std::vector<NodePtr>>& levels);
+
     // Encode node to bytes (simplified RLP-like encoding)
     std::vector<uint8_t> EncodeNode(const NodePtr& node) const;
 
+    // Inverse of EncodeNode; children become stubs
+    static bool DecodeNode(const std::vector<uint8_t>& encoded, Node& node);
+
     // Find common prefix length
     static size_t CommonPrefixLength(const std::vector<uint8_t>& a, size_t a_start,
                                      const std::vector<uint8_t>& b, size_t b_start);
@@ -160,9 +160,9 @@ uint64_t GetOpcodeCost(Opcode op) {
 
         // Storage operations
         case Opcode::SLOAD:
-            return 800;  // Expensive
+            return WARM_STORAGE_READ_COST;  // Cold surcharge charged dynamically
         case Opcode::SSTORE:
-            return 20000;  // Very expensive base cost
+            return 0;  // Fully dynamic (EIP-2200/2929)
 
         // Copy operations
         case Opcode::CALLDATALOAD:
@@ -176,7 +176,7 @@ uint64_t GetOpcodeCost(Opcode op) {
 
         // External operations
         case Opcode::BALANCE:
-            return 700;
+            return WARM_STORAGE_READ_COST;  // Cold surcharge charged dynamically
         case Opcode::EXTCODESIZE:
         case Opcode::EXTCODEHASH:
             return 700;
@@ -203,7 +203,7 @@ uint64_t GetOpcodeCost(Opcode op) {
         case Opcode::CALLCODE:
         case Opcode::DELEGATECALL:
         case Opcode::STATICCALL:
-            return 700;  // Base cost, additional if value transfer
+            return WARM_STORAGE_READ_COST;  // Cold, value and new account charged dynamically
 
         // Return operations
         case Opcode::RETURN:
@@ -219,5 +219,297 @@ uint64_t GetOpcodeCost(Opcode op) {
     }
 }
 
+const char* GetOpcodeName(uint8_t opcode) {
+    switch (static_cast<Opcode>(opcode)) {
+        case Opcode::STOP:
+            return "STOP";
+        case Opcode::ADD:
+            return "ADD";
+        case Opcode::MUL:
+            return "MUL";
+        case Opcode::SUB:
+            return "SUB";
+        case Opcode::DIV:
+            return "DIV";
+        case Opcode::SDIV:
+            return "SDIV";
+        case Opcode::MOD:
+            return "MOD";
+        case Opcode::SMOD:
+            return "SMOD";
+        case Opcode::ADDMOD:
+            return "ADDMOD";
+        case Opcode::MULMOD:
+            return "MULMOD";
+        case Opcode::EXP:
+            return "EXP";
+        case Opcode::SIGNEXTEND:
+            return "SIGNEXTEND";
+        case Opcode::LT:
+            return "LT";
+        case Opcode::GT:
+            return "GT";
+        case Opcode::SLT:
+            return "SLT";
+        case Opcode::SGT:
+            return "SGT";
+        case Opcode::EQ:
+            return "EQ";
+        case Opcode::ISZERO:
+            return "ISZERO";
+        case Opcode::AND:
+            return "AND";
+        case Opcode::OR:
+            return "OR";
+        case Opcode::XOR:
+            return "XOR";
+        case Opcode::NOT:
+            return "NOT";
+        case Opcode::BYTE:
+            return "BYTE";
+        case Opcode::SHL:
+            return "SHL";
+        case Opcode::SHR:
+            return "SHR";
+        case Opcode::SAR:
+            return "SAR";
+        case Opcode::SHA3:
+            return "SHA3";
+        case Opcode::ADDRESS:
+            return "ADDRESS";
+        case Opcode::BALANCE:
+            return "BALANCE";
+        case Opcode::ORIGIN:
+            return "ORIGIN";
+        case Opcode::CALLER:
+            return "CALLER";
+        case Opcode::CALLVALUE:
+            return "CALLVALUE";
+        case Opcode::CALLDATALOAD:
+            return "CALLDATALOAD";
+        case Opcode::CALLDATASIZE:
+            return "CALLDATASIZE";
+        case Opcode::CALLDATACOPY:
+            return "CALLDATACOPY";
+        case Opcode::CODESIZE:
+            return "CODESIZE";
+        case Opcode::CODECOPY:
+            return "CODECOPY";
+        case Opcode::GASPRICE:
+            return "GASPRICE";
+        case Opcode::EXTCODESIZE:
+            return "EXTCODESIZE";
+        case Opcode::EXTCODECOPY:
+            return "EXTCODECOPY";
+        case Opcode::RETURNDATASIZE:
+            return "RETURNDATASIZE";
+        case Opcode::RETURNDATACOPY:
+            return "RETURNDATACOPY";
+        case Opcode::EXTCODEHASH:
+            return "EXTCODEHASH";
+        case Opcode::BLOCKHASH:
+            return "BLOCKHASH";
+        case Opcode::COINBASE:
+            return "COINBASE";
+        case Opcode::TIMESTAMP:
+            return "TIMESTAMP";
+        case Opcode::NUMBER:
+            return "NUMBER";
+        case Opcode::DIFFICULTY:
+            return "DIFFICULTY";
+        case Opcode::GASLIMIT:
+            return "GASLIMIT";
+        case Opcode::CHAINID:
+            return "CHAINID";
+        case Opcode::SELFBALANCE:
+            return "SELFBALANCE";
+        case Opcode::BASEFEE:
+            return "BASEFEE";
+        case Opcode::POP:
+            return "POP";
+        case Opcode::MLOAD:
+            return "MLOAD";
+        case Opcode::MSTORE:
+            return "MSTORE";
+        case Opcode::MSTORE8:
+            return "MSTORE8";
+        case Opcode::SLOAD:
+            return "SLOAD";
+        case Opcode::SSTORE:
+            return "SSTORE";
+        case Opcode::JUMP:
+            return "JUMP";
+        case Opcode::JUMPI:
+            return "JUMPI";
+        case Opcode::PC:
+            return "PC";
+        case Opcode::MSIZE:
+            return "MSIZE";
+        case Opcode::GAS:
+            return "GAS";
+        case Opcode::JUMPDEST:
+            return "JUMPDEST";
+        case Opcode::PUSH1:
+            return "PUSH1";
+        case Opcode::PUSH2:
+            return "PUSH2";
+        case Opcode::PUSH3:
+            return "PUSH3";
+        case Opcode::PUSH4:
+            return "PUSH4";
+        case Opcode::PUSH5:
+            return "PUSH5";
+        case Opcode::PUSH6:
+            return "PUSH6";
+        case Opcode::PUSH7:
+            return "PUSH7";
+        case Opcode::PUSH8:
+            return "PUSH8";
+        case Opcode::PUSH9:
+            return "PUSH9";
+        case Opcode::PUSH10:
+            return "PUSH10";
+        case Opcode::PUSH11:
+            return "PUSH11";
+        case Opcode::PUSH12:
+            return "PUSH12";
+        case Opcode::PUSH13:
+            return "PUSH13";
+        case Opcode::PUSH14:
+            return "PUSH14";
+        case Opcode::PUSH15:
+            return "PUSH15";
+        case Opcode::PUSH16:
+            return "PUSH16";
+        case Opcode::PUSH17:
+            return "PUSH17";
+        case Opcode::PUSH18:
+            return "PUSH18";
+        case Opcode::PUSH19:
+            return "PUSH19";
+        case Opcode::PUSH20:
+            return "PUSH20";
+        case Opcode::PUSH21:
+            return "PUSH21";
+        case Opcode::PUSH22:
+            return "PUSH22";
+        case Opcode::PUSH23:
+            return "PUSH23";
+        case Opcode::PUSH24:
+            return "PUSH24";
+        case Opcode::PUSH25:
+            return "PUSH25";
+        case Opcode::PUSH26:
+            return "PUSH26";
+        case Opcode::PUSH27:
+            return "PUSH27";
+        case Opcode::PUSH28:
+            return "PUSH28";
+        case Opcode::PUSH29:
+            return "PUSH29";
+        case Opcode::PUSH30:
+            return "PUSH30";
+        case Opcode::PUSH31:
+            return "PUSH31";
+        case Opcode::PUSH32:
+            return "PUSH32";
+        case Opcode::DUP1:
+            return "DUP1";
+        case Opcode::DUP2:
+            return "DUP2";
+        case Opcode::DUP3:
+            return "DUP3";
+        case Opcode::DUP4:
+            return "DUP4";
+        case Opcode::DUP5:
+            return "DUP5";
+        case Opcode::DUP6:
+            return "DUP6";
+        case Opcode::DUP7:
+            return "DUP7";
+        case Opcode::DUP8:
+            return "DUP8";
+        case Opcode::DUP9:
+            return "DUP9";
+        case Opcode::DUP10:
+            return "DUP10";
+        case Opcode::DUP11:
+            return "DUP11";
+        case Opcode::DUP12:
+            return "DUP12";
+        case Opcode::DUP13:
+            return "DUP13";
+        case Opcode::DUP14:
+            return "DUP14";
+        case Opcode::DUP15:
+            return "DUP15";
+        case Opcode::DUP16:
+            return "DUP16";
+        case Opcode::SWAP1:
+            return "SWAP1";
+        case Opcode::SWAP2:
+            return "SWAP2";
+        case Opcode::SWAP3:
+            return "SWAP3";
+        case Opcode::SWAP4:
+            return "SWAP4";
+        case Opcode::SWAP5:
+            return "SWAP5";
+        case Opcode::SWAP6:
+            return "SWAP6";
+        case Opcode::SWAP7:
+            return "SWAP7";
+        case Opcode::SWAP8:
+            return "SWAP8";
+        case Opcode::SWAP9:
+            return "SWAP9";
+        case Opcode::SWAP10:
+            return "SWAP10";
+        case Opcode::SWAP11:
+            return "SWAP11";
+        case Opcode::SWAP12:
+            return "SWAP12";
+        case Opcode::SWAP13:
+            return "SWAP13";
+        case Opcode::SWAP14:
+            return "SWAP14";
+        case Opcode::SWAP15:
+            return "SWAP15";
+        case Opcode::SWAP16:
+            return "SWAP16";
+        case Opcode::LOG0:
+            return "LOG0";
+        case Opcode::LOG1:
+            return "LOG1";
+        case Opcode::LOG2:
+            return "LOG2";
+        case Opcode::LOG3:
+            return "LOG3";
+        case Opcode::LOG4:
+            return "LOG4";
+        case Opcode::CREATE:
+            return "CREATE";
+        case Opcode::CALL:
+            return "CALL";
+        case Opcode::CALLCODE:
+            return "CALLCODE";
+        case Opcode::RETURN:
+            return "RETURN";
+        case Opcode::DELEGATECALL:
+            return "DELEGATECALL";
+        case Opcode::CREATE2:
+            return "CREATE2";
+        case Opcode::STATICCALL:
+            return "STATICCALL";
+        case Opcode::REVERT:
+            return "REVERT";
+        case Opcode::INVALID:
+            return "INVALID";
+        case Opcode::SELFDESTRUCT:
+            return "SELFDESTRUCT";
+    }
+    return "UNDEFINED";
+}
+
 }  // namespace evm
 }  // namespace parthenon
@@ -179,9 +179,49 @@ enum class Opcode : uint8_t {
 /**
  * Get gas cost for an opcode
  * OBL-only gas system
+ *
+ * This is the static part only. SLOAD, BALANCE and the calls are priced
+ * as warm accesses; the VM adds the cold surcharge, the calls' value
+ * transfer and memory costs, and the whole SSTORE cost as it executes them.
  */
 uint64_t GetOpcodeCost(Opcode op);
 
+// EIP-2929 access costs
+constexpr uint64_t COLD_SLOAD_COST = 2100;
+constexpr uint64_t COLD_ACCOUNT_ACCESS_COST = 2600;
+constexpr uint64_t WARM_STORAGE_READ_COST = 100;
+
+// EIP-2200 SSTORE net metering, with the EIP-3529 refund schedule
+constexpr uint64_t SSTORE_SET_GAS = 20000;
+constexpr uint64_t SSTORE_RESET_GAS = 5000 - COLD_SLOAD_COST;
+constexpr uint64_t SSTORE_SENTRY_GAS = 2300;
+constexpr uint64_t SSTORE_CLEARS_SCHEDULE = 4800;
+constexpr uint64_t MAX_REFUND_QUOTIENT = 5;  // Refund at most gas_used / 5
+
+// CALL family: sending value, and creating the recipient by sending it
+// value (EIP-161 empty accounts); the callee gets the stipend for free
+constexpr uint64_t CALL_VALUE_GAS = 9000;
+constexpr uint64_t CALL_NEW_ACCOUNT_GAS = 25000;
+constexpr uint64_t CALL_STIPEND = 2300;
+
+// EIP-2930 intrinsic cost of access list entries
+constexpr uint64_t ACCESS_LIST_ADDRESS_COST = 2400;
+constexpr uint64_t ACCESS_LIST_STORAGE_KEY_COST = 1900;
+
+/**
+ * Mnemonic of an opcode ("PUSH1", "SSTORE", ...; "UNDEFINED" if unassigned)
+ */
+const char* GetOpcodeName(uint8_t opcode);
+
+// Intrinsic cost of every transaction and of its calldata (EIP-2028)
+constexpr uint64_t TX_BASE_GAS = 21000;
+constexpr uint64_t TX_DATA_ZERO_GAS = 4;
+constexpr uint64_t TX_DATA_NONZERO_GAS = 16;
+
+// Contract creation: extra intrinsic gas, and gas per byte of deployed code
+constexpr uint64_t TX_CREATE_GAS = 32000;
+constexpr uint64_t CODE_DEPOSIT_GAS = 200;
+
 /**
  * Check if opcode is a PUSH operation
  */
@@ -0,0 +1,787 @@
+// ParthenonChain - Parallel Block Execution Implementation
+
+#include "parallel_executor.h"
+
+#include "code_cache.h"
+#include "precompiles.h"
+#include "prefetcher.h"
+#include "uint256.h"
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace parthenon {
+namespace evm {
+
+namespace {
+
+/**
+ * A location a transaction can read or write
+ */
+struct StateKey {
+    enum class Kind : uint8_t { BALANCE, NONCE, STORAGE };
+
+    Kind kind;
+    Address addr;
+    uint256_t slot{};  // Storage only
+
+    bool operator<(const StateKey& other) const {
+        return std::tie(kind, addr, slot) < std::tie(other.kind, other.addr, other.slot);
+    }
+};
+
+using WriteSet = std::map<StateKey, uint256_t>;
+
+/**
+ * Incarnation of a transaction that wrote a value
+ */
+struct Version {
+    size_t tx_index;
+    uint32_t incarnation;
+
+    bool operator==(const Version& other) const {
+        return tx_index == other.tx_index && incarnation == other.incarnation;
+    }
+    bool operator!=(const Version& other) const { return !(*this == other); }
+};
+
+/**
+ * A value a transaction read, and where it came from (nullopt = base state)
+ */
+struct ReadDescriptor {
+    StateKey key;
+    std::optional<Version> version;
+};
+
+/**
+ * Thrown out of a speculative execution that read an estimate: the result
+ * would likely be discarded, so wait for the blocking transaction instead
+ */
+struct ReadDependency {
+    size_t blocking_tx;
+};
+
+/**
+ * Multi-version memory: every transaction's latest writes, by location and
+ * block index
+ */
+class MVMemory {
+  public:
+    enum class ReadStatus { OK, NOT_FOUND, ESTIMATE };
+
+    struct ReadResult {
+        ReadStatus status = ReadStatus::NOT_FOUND;
+        Version version{0, 0};
+        uint256_t value{};
+    };
+
+    explicit MVMemory(size_t num_txs) : records_(num_txs) {}
+
+    /**
+     * Latest write to key by a transaction below tx_index
+     */
+    ReadResult Read(const StateKey& key, size_t tx_index) const {
+        ReadResult result;
+        const Shard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.data.find(key);
+        if (it == shard.data.end()) {
+            return result;
+        }
+        auto entry = it->second.lower_bound(tx_index);
+        if (entry == it->second.begin()) {
+            return result;
+        }
+        --entry;
+        result.version = Version{entry->first, entry->second.incarnation};
+        if (entry->second.estimate) {
+            result.status = ReadStatus::ESTIMATE;
+            return result;
+        }
+        result.status = ReadStatus::OK;
+        result.value = entry->second.value;
+        return result;
+    }
+
+    /**
+     * Replace a transaction's reads and writes with those of a new incarnation
+     * @return true if it wrote a location the previous incarnation did not
+     */
+    bool Record(const Version& version, std::vector<ReadDescriptor> reads, WriteSet writes) {
+        TxRecord& record = records_[version.tx_index];
+        std::lock_guard<std::mutex> record_lock(record.mutex);
+
+        bool wrote_new_location = false;
+        for (const auto& [key, value] : writes) {
+            Shard& shard = ShardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.data[key][version.tx_index] = Entry{version.incarnation, false, value};
+            wrote_new_location |= record.writes.count(key) == 0;
+        }
+        for (const auto& entry : record.writes) {
+            if (writes.count(entry.first) == 0) {
+                Shard& shard = ShardFor(entry.first);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.data[entry.first].erase(version.tx_index);
+            }
+        }
+        record.reads = std::move(reads);
+        record.writes = std::move(writes);
+        return wrote_new_location;
+    }
+
+    /**
+     * Mark an aborted transaction's writes so readers wait for it
+     */
+    void ConvertWritesToEstimates(size_t tx_index) {
+        TxRecord& record = records_[tx_index];
+        std::lock_guard<std::mutex> record_lock(record.mutex);
+        for (const auto& entry : record.writes) {
+            Shard& shard = ShardFor(entry.first);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.data[entry.first][tx_index].estimate = true;
+        }
+    }
+
+    /**
+     * Check that every read of the last incarnation would still see the
+     * same version
+     */
+    bool ValidateReadSet(size_t tx_index) const {
+        const TxRecord& record = records_[tx_index];
+        std::lock_guard<std::mutex> record_lock(record.mutex);
+        for (const auto& read : record.reads) {
+            const ReadResult current = Read(read.key, tx_index);
+            switch (current.status) {
+                case ReadStatus::ESTIMATE:
+                    return false;
+                case ReadStatus::NOT_FOUND:
+                    if (read.version) {
+                        return false;
+                    }
+                    break;
+                case ReadStatus::OK:
+                    if (!read.version || *read.version != current.version) {
+                        return false;
+                    }
+                    break;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Writes of a transaction's last incarnation (only once all are done)
+     */
+    const WriteSet& Writes(size_t tx_index) const { return records_[tx_index].writes; }
+
+  private:
+    static constexpr size_t kShards = 64;
+
+    struct Entry {
+        uint32_t incarnation = 0;
+        bool estimate = false;
+        uint256_t value{};
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::map<StateKey, std::map<size_t, Entry>> data;
+    };
+
+    struct TxRecord {
+        mutable std::mutex mutex;
+        std::vector<ReadDescriptor> reads;
+        WriteSet writes;
+    };
+
+    Shard& ShardFor(const StateKey& key) {
+        return shards_[ShardIndex(key)];
+    }
+    const Shard& ShardFor(const StateKey& key) const {
+        return shards_[ShardIndex(key)];
+    }
+    static size_t ShardIndex(const StateKey& key) {
+        // Addresses and hashed slots are well mixed in their low bytes
+        return (key.addr[19] ^ key.slot[31] ^ static_cast<uint8_t>(key.kind)) % kShards;
+    }
+
+    std::array<Shard, kShards> shards_;
+    std::vector<TxRecord> records_;
+};
+
+/**
+ * Block-STM collaborative scheduler
+ *
+ * Hands out execution and validation tasks, lowest transaction first, and
+ * tracks when the block is complete: both indices past the end with no task
+ * in flight.
+ */
+class Scheduler {
+  public:
+    enum class TaskKind { NONE, EXECUTE, VALIDATE };
+
+    struct Task {
+        TaskKind kind = TaskKind::NONE;
+        size_t tx_index = 0;
+        uint32_t incarnation = 0;
+    };
+
+    explicit Scheduler(size_t num_txs) : num_txs_(num_txs), txs_(num_txs) {}
+
+    bool Done() const { return done_.load(); }
+
+    /**
+     * Stop all workers (after an unexpected error)
+     */
+    void Halt() { done_ = true; }
+
+    Task NextTask() {
+        if (validation_idx_.load() < execution_idx_.load()) {
+            return NextVersionToValidate();
+        }
+        return NextVersionToExecute();
+    }
+
+    /**
+     * Suspend tx_index until blocking_tx finishes executing
+     * @return false if blocking_tx already finished (re-execute immediately)
+     */
+    bool AddDependency(size_t tx_index, size_t blocking_tx) {
+        {
+            // Lower index locked first throughout
+            std::lock_guard<std::mutex> blocking_lock(txs_[blocking_tx].mutex);
+            if (txs_[blocking_tx].status == Status::EXECUTED) {
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock(txs_[tx_index].mutex);
+                txs_[tx_index].status = Status::ABORTING;
+            }
+            txs_[blocking_tx].dependents.push_back(tx_index);
+        }
+        --num_active_;
+        return true;
+    }
+
+    Task FinishExecution(size_t tx_index, uint32_t incarnation, bool wrote_new_location) {
+        std::vector<size_t> dependents;
+        {
+            std::lock_guard<std::mutex> lock(txs_[tx_index].mutex);
+            txs_[tx_index].status = Status::EXECUTED;
+            dependents.swap(txs_[tx_index].dependents);
+        }
+        if (!dependents.empty()) {
+            for (size_t dependent : dependents) {
+                SetReady(dependent);
+            }
+            DecreaseIndex(execution_idx_,
+                          *std::min_element(dependents.begin(), dependents.end()));
+        }
+
+        if (validation_idx_.load() > tx_index) {
+            if (wrote_new_location) {
+                // Higher transactions may have missed the new location
+                DecreaseIndex(validation_idx_, tx_index);
+            } else {
+                return Task{TaskKind::VALIDATE, tx_index, incarnation};
+            }
+        }
+        --num_active_;
+        return Task{};
+    }
+
+    /**
+     * Claim the abort of an incarnation that failed validation
+     * @return false if another validation already aborted it
+     */
+    bool TryValidationAbort(size_t tx_index, uint32_t incarnation) {
+        std::lock_guard<std::mutex> lock(txs_[tx_index].mutex);
+        if (txs_[tx_index].incarnation == incarnation &&
+            txs_[tx_index].status == Status::EXECUTED) {
+            txs_[tx_index].status = Status::ABORTING;
+            return true;
+        }
+        return false;
+    }
+
+    Task FinishValidation(size_t tx_index, bool aborted) {
+        if (aborted) {
+            SetReady(tx_index);
+            DecreaseIndex(validation_idx_, tx_index + 1);
+            if (execution_idx_.load() > tx_index) {
+                return TryIncarnate(tx_index);
+            }
+        }
+        --num_active_;
+        return Task{};
+    }
+
+  private:
+    enum class Status { READY_TO_EXECUTE, EXECUTING, EXECUTED, ABORTING };
+
+    struct TxState {
+        std::mutex mutex;
+        uint32_t incarnation = 0;
+        Status status = Status::READY_TO_EXECUTE;
+        std::vector<size_t> dependents;  // Waiting on this transaction's writes
+    };
+
+    void DecreaseIndex(std::atomic<size_t>& index, size_t target) {
+        size_t current = index.load();
+        while (target < current && !index.compare_exchange_weak(current, target)) {
+        }
+        ++decrease_count_;
+    }
+
+    void CheckDone() {
+        const uint64_t observed = decrease_count_.load();
+        if (std::min(execution_idx_.load(), validation_idx_.load()) >= num_txs_ &&
+            num_active_.load() == 0 && observed == decrease_count_.load()) {
+            done_ = true;
+        }
+    }
+
+    // Takes over the caller's active task count; releases it on failure
+    Task TryIncarnate(size_t tx_index) {
+        if (tx_index < num_txs_) {
+            std::lock_guard<std::mutex> lock(txs_[tx_index].mutex);
+            if (txs_[tx_index].status == Status::READY_TO_EXECUTE) {
+                txs_[tx_index].status = Status::EXECUTING;
+                return Task{TaskKind::EXECUTE, tx_index, txs_[tx_index].incarnation};
+            }
+        }
+        --num_active_;
+        return Task{};
+    }
+
+    Task NextVersionToExecute() {
+        if (execution_idx_.load() >= num_txs_) {
+            CheckDone();
+            return Task{};
+        }
+        ++num_active_;
+        return TryIncarnate(execution_idx_.fetch_add(1));
+    }
+
+    Task NextVersionToValidate() {
+        if (validation_idx_.load() >= num_txs_) {
+            CheckDone();
+            return Task{};
+        }
+        ++num_active_;
+        const size_t tx_index = validation_idx_.fetch_add(1);
+        if (tx_index < num_txs_) {
+            std::lock_guard<std::mutex> lock(txs_[tx_index].mutex);
+            if (txs_[tx_index].status == Status::EXECUTED) {
+                return Task{TaskKind::VALIDATE, tx_index, txs_[tx_index].incarnation};
+            }
+        }
+        --num_active_;
+        return Task{};
+    }
+
+    void SetReady(size_t tx_index) {
+        std::lock_guard<std::mutex> lock(txs_[tx_index].mutex);
+        ++txs_[tx_index].incarnation;
+        txs_[tx_index].status = Status::READY_TO_EXECUTE;
+    }
+
+    const size_t num_txs_;
+    std::vector<TxState> txs_;
+    std::atomic<size_t> execution_idx_{0};
+    std::atomic<size_t> validation_idx_{0};
+    std::atomic<uint64_t> decrease_count_{0};
+    std::atomic<int64_t> num_active_{0};
+    std::atomic<bool> done_{false};
+};
+
+/**
+ * One transaction's view of the state: buffers its writes and records what
+ * it reads, from the multi-version memory when executing in parallel or
+ * straight from the base state otherwise
+ */
+class TransactionState final : public StateAccess {
+  public:
+    explicit TransactionState(const WorldState& base) : base_(base) {}
+
+    TransactionState(const WorldState& base, const MVMemory& memory, size_t tx_index)
+        : base_(base), memory_(&memory), tx_index_(tx_index) {}
+
+    uint256_t GetBalance(const Address& addr) const override {
+        return Read(StateKey{StateKey::Kind::BALANCE, addr});
+    }
+    void SetBalance(const Address& addr, const uint256_t& balance) override {
+        Write(StateKey{StateKey::Kind::BALANCE, addr}, balance);
+    }
+    uint64_t GetNonce(const Address& addr) const override {
+        return ToUint64(Read(StateKey{StateKey::Kind::NONCE, addr}));
+    }
+    void SetNonce(const Address& addr, uint64_t nonce) override {
+        Write(StateKey{StateKey::Kind::NONCE, addr}, ToUint256(nonce));
+    }
+    // Code is not written by block transactions, so it is read from the base
+    CodeHandle GetCode(const Address& addr) const override { return base_.GetCode(addr); }
+    uint256_t GetStorage(const Address& addr, const uint256_t& key) const override {
+        return Read(StateKey{StateKey::Kind::STORAGE, addr, key});
+    }
+    void SetStorage(const Address& addr, const uint256_t& key, const uint256_t& value) override {
+        Write(StateKey{StateKey::Kind::STORAGE, addr, key}, value);
+    }
+
+    size_t Checkpoint() override {
+        checkpoints_.push_back(journal_.size());
+        return checkpoints_.size() - 1;
+    }
+
+    void RevertToCheckpoint(size_t checkpoint) override {
+        if (checkpoint >= checkpoints_.size()) {
+            return;
+        }
+        while (journal_.size() > checkpoints_[checkpoint]) {
+            auto& [key, previous] = journal_.back();
+            if (previous) {
+                writes_[key] = *previous;
+            } else {
+                writes_.erase(key);
+            }
+            journal_.pop_back();
+        }
+        checkpoints_.resize(checkpoint);
+    }
+
+    void DiscardCheckpoint(size_t checkpoint) override {
+        if (checkpoint >= checkpoints_.size()) {
+            return;
+        }
+        checkpoints_.resize(checkpoint);
+        if (checkpoints_.empty()) {
+            journal_.clear();
+        }
+    }
+
+    WriteSet& Writes() { return writes_; }
+
+    std::vector<ReadDescriptor> TakeReads() {
+        read_values_.clear();
+        return std::move(reads_);
+    }
+
+  private:
+    void Write(const StateKey& key, const uint256_t& value) {
+        auto it = writes_.find(key);
+        if (!checkpoints_.empty()) {
+            journal_.emplace_back(key, it != writes_.end() ? std::optional<uint256_t>(it->second)
+                                                           : std::nullopt);
+        }
+        if (it != writes_.end()) {
+            it->second = value;
+        } else {
+            writes_.emplace(key, value);
+        }
+    }
+
+    uint256_t Read(const StateKey& key) const {
+        auto written = writes_.find(key);
+        if (written != writes_.end()) {
+            return written->second;
+        }
+        // Repeated reads return the first value seen
+        auto cached = read_values_.find(key);
+        if (cached != read_values_.end()) {
+            return cached->second;
+        }
+
+        uint256_t value{};
+        std::optional<Version> version;
+        MVMemory::ReadResult result;
+        if (memory_) {
+            result = memory_->Read(key, tx_index_);
+        }
+        if (result.status == MVMemory::ReadStatus::ESTIMATE) {
+            throw ReadDependency{result.version.tx_index};
+        }
+        if (result.status == MVMemory::ReadStatus::OK) {
+            value = result.value;
+            version = result.version;
+        } else {
+            value = ReadBase(key);
+        }
+        if (memory_) {
+            reads_.push_back(ReadDescriptor{key, version});
+        }
+        read_values_.emplace(key, value);
+        return value;
+    }
+
+    uint256_t ReadBase(const StateKey& key) const {
+        switch (key.kind) {
+            case StateKey::Kind::BALANCE:
+                return base_.GetBalance(key.addr);
+            case StateKey::Kind::NONCE:
+                return ToUint256(base_.GetNonce(key.addr));
+            case StateKey::Kind::STORAGE:
+                return base_.GetStorage(key.addr, key.slot);
+        }
+        return uint256_t{};
+    }
+
+    const WorldState& base_;
+    const MVMemory* memory_ = nullptr;
+    size_t tx_index_ = 0;
+
+    WriteSet writes_;
+    std::vector<std::pair<StateKey, std::optional<uint256_t>>> journal_;
+    std::vector<size_t> checkpoints_;
+    mutable std::map<StateKey, uint256_t> read_values_;
+    mutable std::vector<ReadDescriptor> reads_;
+};
+
+TransactionReceipt ApplyTransaction(TransactionState& state, const BlockTransaction& tx) {
+    TransactionReceipt receipt;
+    const ExecutionContext& ctx = tx.ctx;
+
+    state.SetNonce(ctx.origin, state.GetNonce(ctx.origin) + 1);
+
+    // EIP-2930: declared accesses are paid for up front
+    const uint64_t intrinsic_gas = AccessListGas(ctx.access_list);
+    if (intrinsic_gas > ctx.gas_limit) {
+        receipt.result = ExecResult::OUT_OF_GAS;
+        receipt.gas_used = ctx.gas_limit;
+        return receipt;
+    }
+    receipt.gas_used = intrinsic_gas;
+
+    const size_t checkpoint = state.Checkpoint();
+    const Word value = Word::FromBytes(ctx.value);
+    if (!value.IsZero()) {
+        const Word sender_balance = Word::FromBytes(state.GetBalance(ctx.caller));
+        if (sender_balance < value) {
+            state.RevertToCheckpoint(checkpoint);
+            receipt.result = ExecResult::REVERT;
+            return receipt;
+        }
+        state.SetBalance(ctx.caller, (sender_balance - value).ToBytes());
+        const Word recipient_balance = Word::FromBytes(state.GetBalance(ctx.address));
+        state.SetBalance(ctx.address, (recipient_balance + value).ToBytes());
+    }
+
+    if (IsPrecompile(ctx.address)) {
+        PrecompileResult precompiled =
+            RunPrecompile(ctx.address, ctx.input_data, ctx.gas_limit - intrinsic_gas);
+        receipt.result = precompiled.status;
+        receipt.output = std::move(precompiled.output);
+        receipt.gas_used += precompiled.gas_used;
+        if (precompiled.status == ExecResult::SUCCESS) {
+            state.DiscardCheckpoint(checkpoint);
+        } else {
+            state.RevertToCheckpoint(checkpoint);
+        }
+        return receipt;
+    }
+
+    const CodeHandle code = state.GetCode(ctx.address);
+    if (code->Empty()) {
+        state.DiscardCheckpoint(checkpoint);
+        return receipt;
+    }
+
+    ExecutionContext call_ctx = ctx;
+    call_ctx.gas_limit = ctx.gas_limit - intrinsic_gas;
+    VM vm(state, call_ctx);
+    auto [result, output] = vm.Execute(*code);
+    receipt.result = result;
+    receipt.output = std::move(output);
+    receipt.gas_used += vm.GetGasUsed();
+    if (result == ExecResult::SUCCESS || result == ExecResult::RETURNED) {
+        receipt.logs = vm.GetLogs();
+        receipt.gas_used -=
+            std::min(vm.GetGasRefund(), receipt.gas_used / MAX_REFUND_QUOTIENT);
+        state.DiscardCheckpoint(checkpoint);
+    } else {
+        state.RevertToCheckpoint(checkpoint);
+    }
+    return receipt;
+}
+
+void ApplyWrites(WorldState& state, const WriteSet& writes) {
+    for (const auto& [key, value] : writes) {
+        switch (key.kind) {
+            case StateKey::Kind::BALANCE:
+                state.SetBalance(key.addr, value);
+                break;
+            case StateKey::Kind::NONCE:
+                state.SetNonce(key.addr, ToUint64(value));
+                break;
+            case StateKey::Kind::STORAGE:
+                state.SetStorage(key.addr, key.slot, value);
+                break;
+        }
+    }
+}
+
+/**
+ * Prefetches for one block, cancelled when the block is done with
+ */
+class PrefetchScope {
+  public:
+    PrefetchScope(StatePrefetcher* prefetcher, const WorldState& state,
+                  const std::vector<BlockTransaction>& txs)
+        : prefetcher_(prefetcher) {
+        if (prefetcher_) {
+            prefetcher_->Schedule(state, txs);
+        }
+    }
+
+    ~PrefetchScope() {
+        if (prefetcher_) {
+            prefetcher_->Cancel();
+        }
+    }
+
+    PrefetchScope(const PrefetchScope&) = delete;
+    PrefetchScope& operator=(const PrefetchScope&) = delete;
+
+  private:
+    StatePrefetcher* prefetcher_;
+};
+
+}  // namespace
+
+std::vector<TransactionReceipt> ExecuteBlockSequential(WorldState& state,
+                                                       const std::vector<BlockTransaction>& txs,
+                                                       StatePrefetcher* prefetcher) {
+    PrefetchScope prefetch(prefetcher, state, txs);
+    std::vector<TransactionReceipt> receipts;
+    receipts.reserve(txs.size());
+    for (const auto& tx : txs) {
+        TransactionState tx_state(state);
+        receipts.push_back(ApplyTransaction(tx_state, tx));
+        ApplyWrites(state, tx_state.Writes());
+    }
+    return receipts;
+}
+
+ParallelExecutor::ParallelExecutor(size_t num_threads) : num_threads_(num_threads) {
+    if (num_threads_ == 0) {
+        num_threads_ = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+}
+
+std::vector<TransactionReceipt>
+ParallelExecutor::ExecuteBlock(WorldState& state, const std::vector<BlockTransaction>& txs,
+                               StatePrefetcher* prefetcher) {
+    ++blocks_;
+    transactions_ += txs.size();
+    if (txs.size() < 2 || num_threads_ < 2) {
+        executions_ += txs.size();
+        return ExecuteBlockSequential(state, txs, prefetcher);
+    }
+
+    PrefetchScope prefetch(prefetcher, state, txs);
+
+    MVMemory memory(txs.size());
+    Scheduler scheduler(txs.size());
+    std::vector<TransactionReceipt> receipts(txs.size());
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    auto try_execute = [&](const Scheduler::Task& task) -> Scheduler::Task {
+        while (true) {
+            ++executions_;
+            TransactionState tx_state(state, memory, task.tx_index);
+            TransactionReceipt receipt;
+            try {
+                receipt = ApplyTransaction(tx_state, txs[task.tx_index]);
+            } catch (const ReadDependency& dependency) {
+                ++dependencies_;
+                if (scheduler.AddDependency(task.tx_index, dependency.blocking_tx)) {
+                    return Scheduler::Task{};
+                }
+                continue;  // Dependency resolved meanwhile
+            }
+            // Only one incarnation of a transaction executes at a time
+            receipts[task.tx_index] = std::move(receipt);
+            const bool wrote_new_location =
+                memory.Record(Version{task.tx_index, task.incarnation}, tx_state.TakeReads(),
+                              std::move(tx_state.Writes()));
+            return scheduler.FinishExecution(task.tx_index, task.incarnation,
+                                             wrote_new_location);
+        }
+    };
+
+    auto validate = [&](const Scheduler::Task& task) -> Scheduler::Task {
+        ++validations_;
+        const bool valid = memory.ValidateReadSet(task.tx_index);
+        const bool aborted = !valid && scheduler.TryValidationAbort(task.tx_index, task.incarnation);
+        if (aborted) {
+            ++aborts_;
+            memory.ConvertWritesToEstimates(task.tx_index);
+        }
+        return scheduler.FinishValidation(task.tx_index, aborted);
+    };
+
+    auto worker = [&]() {
+        try {
+            Scheduler::Task task;
+            while (!scheduler.Done()) {
+                if (task.kind == Scheduler::TaskKind::EXECUTE) {
+                    task = try_execute(task);
+                }
+                if (task.kind == Scheduler::TaskKind::VALIDATE) {
+                    task = validate(task);
+                }
+                if (task.kind == Scheduler::TaskKind::NONE) {
+                    task = scheduler.NextTask();
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            scheduler.Halt();
+        }
+    };
+
+    // The calling thread is one of the workers
+    std::vector<std::thread> threads;
+    const size_t num_workers = std::min(num_threads_, txs.size());
+    threads.reserve(num_workers - 1);
+    for (size_t i = 1; i < num_workers; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    for (size_t i = 0; i < txs.size(); ++i) {
+        ApplyWrites(state, memory.Writes(i));
+    }
+    return receipts;
+}
+
+ParallelExecutor::Stats ParallelExecutor::GetStats() const {
+    Stats stats;
+    stats.blocks = blocks_.load();
+    stats.transactions = transactions_.load();
+    stats.executions = executions_.load();
+    stats.validations = validations_.load();
+    stats.aborts = aborts_.load();
+    stats.dependencies = dependencies_.load();
+    return stats;
+}
+
+}  // namespace evm
+}  // namespace parthenon
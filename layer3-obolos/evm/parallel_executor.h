@@ -0,0 +1,108 @@
+// ParthenonChain - Parallel Block Execution
+// Block-STM optimistic concurrency over a multi-version view of WorldState
+
+#pragma once
+
+#include "state.h"
+#include "vm.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+class StatePrefetcher;
+
+/**
+ * A transaction within a block
+ *
+ * Bumps the origin's nonce, moves ctx.value from ctx.caller to ctx.address
+ * and runs the code at ctx.address. A failed call keeps the nonce bump and
+ * discards everything else. ctx.access_list costs intrinsic gas (EIP-2930);
+ * gas_used is net of the capped SSTORE refund (EIP-3529).
+ */
+struct BlockTransaction {
+    ExecutionContext ctx;
+};
+
+/**
+ * Outcome of one block transaction
+ */
+struct TransactionReceipt {
+    ExecResult result = ExecResult::SUCCESS;
+    uint64_t gas_used = 0;  // Including intrinsic gas, after refunds
+    std::vector<uint8_t> output;
+    std::vector<LogEntry> logs;  // Empty unless the call succeeded
+};
+
+/**
+ * Execute a block's transactions one after another
+ *
+ * Reference semantics for ParallelExecutor. With a prefetcher (see
+ * prefetcher.h), the slots of later transactions are read from disk while
+ * earlier ones execute; queued prefetches are cancelled before returning.
+ */
+std::vector<TransactionReceipt> ExecuteBlockSequential(WorldState& state,
+                                                       const std::vector<BlockTransaction>& txs,
+                                                       StatePrefetcher* prefetcher = nullptr);
+
+/**
+ * Block-STM parallel executor
+ *
+ * Workers execute transactions speculatively against a multi-version memory
+ * holding each transaction's writes by block index. Every read records the
+ * version it saw (a lower transaction's write, or the base state); after
+ * executing, a transaction's read set is validated, and on conflict it is
+ * re-executed with its earlier writes marked as estimates so that later
+ * readers wait on it instead of reading stale values. Once every transaction
+ * is executed and validated, the final write sets are applied to the state
+ * in block order, so the result (receipts and state root) is identical to
+ * ExecuteBlockSequential().
+ */
+class ParallelExecutor {
+  public:
+    struct Stats {
+        uint64_t blocks = 0;
+        uint64_t transactions = 0;
+        uint64_t executions = 0;   // Including re-executions
+        uint64_t validations = 0;
+        uint64_t aborts = 0;       // Failed validations
+        uint64_t dependencies = 0; // Executions suspended on an estimate
+    };
+
+    /**
+     * @param num_threads Worker threads (0 = hardware concurrency)
+     */
+    explicit ParallelExecutor(size_t num_threads = 0);
+
+    /**
+     * Execute a block's transactions and apply their writes to state
+     *
+     * state is only read until all transactions have finished. Blocks with
+     * fewer than two transactions, or a single thread, run sequentially.
+     * prefetcher is used as by ExecuteBlockSequential().
+     */
+    std::vector<TransactionReceipt> ExecuteBlock(WorldState& state,
+                                                 const std::vector<BlockTransaction>& txs,
+                                                 StatePrefetcher* prefetcher = nullptr);
+
+    size_t ThreadCount() const { return num_threads_; }
+
+    Stats GetStats() const;
+
+  private:
+    size_t num_threads_;
+
+    std::atomic<uint64_t> blocks_{0};
+    std::atomic<uint64_t> transactions_{0};
+    std::atomic<uint64_t> executions_{0};
+    std::atomic<uint64_t> validations_{0};
+    std::atomic<uint64_t> aborts_{0};
+    std::atomic<uint64_t> dependencies_{0};
+};
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,397 @@
+// ParthenonChain - EVM Precompiled Contracts Implementation
+
+#include "precompiles.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/keccak.h"
+#include "crypto/ripemd160.h"
+#include "crypto/schnorr.h"
+#include "crypto/sha256.h"
+
+#include <openssl/bn.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace parthenon {
+namespace evm {
+
+namespace {
+
+constexpr uint64_t kSaturated = std::numeric_limits<uint64_t>::max();
+
+uint64_t SatAdd(uint64_t a, uint64_t b) {
+    return a > kSaturated - b ? kSaturated : a + b;
+}
+
+uint64_t SatMul(uint64_t a, uint64_t b) {
+    return a != 0 && b > kSaturated / a ? kSaturated : a * b;
+}
+
+uint64_t WordCount(size_t size) {
+    return (static_cast<uint64_t>(size) + 31) / 32;
+}
+
+// Copy size bytes of input from offset into out, zero-filling past the end
+// (precompile input is implicitly right-padded with zeros)
+void ReadPadded(const std::vector<uint8_t>& input, uint64_t offset, uint8_t* out, uint64_t size) {
+    uint64_t copied = 0;
+    if (offset < input.size()) {
+        copied = std::min<uint64_t>(size, input.size() - offset);
+        std::memcpy(out, input.data() + offset, copied);
+    }
+    std::memset(out + copied, 0, size - copied);
+}
+
+std::vector<uint8_t> ReadPadded(const std::vector<uint8_t>& input, uint64_t offset,
+                                uint64_t size) {
+    std::vector<uint8_t> out(size);
+    ReadPadded(input, offset, out.data(), size);
+    return out;
+}
+
+// Big-endian 32-byte length at offset, saturated to UINT64_MAX
+uint64_t ReadLength(const std::vector<uint8_t>& input, uint64_t offset) {
+    uint8_t word[32];
+    ReadPadded(input, offset, word, sizeof(word));
+    for (size_t i = 0; i < 24; ++i) {
+        if (word[i] != 0) {
+            return kSaturated;
+        }
+    }
+    uint64_t value = 0;
+    for (size_t i = 24; i < 32; ++i) {
+        value = (value << 8) | word[i];
+    }
+    return value;
+}
+
+// Index of the highest set bit plus one; 0 for zero
+uint64_t BitLength(const uint8_t* bytes, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        if (bytes[i] != 0) {
+            uint64_t bits = 8 * (size - i - 1);
+            for (uint8_t byte = bytes[i]; byte != 0; byte >>= 1) {
+                ++bits;
+            }
+            return bits;
+        }
+    }
+    return 0;
+}
+
+struct BnCtxDeleter {
+    void operator()(BN_CTX* ctx) const { BN_CTX_free(ctx); }
+};
+using BnCtxPtr = std::unique_ptr<BN_CTX, BnCtxDeleter>;
+
+// 0x01: signer address of (hash, v, r, s)
+uint64_t EcRecoverGas(const std::vector<uint8_t>&) {
+    return ECRECOVER_GAS;
+}
+
+void EcRecover(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+    uint8_t data[128];
+    ReadPadded(input, 0, data, sizeof(data));
+    const uint8_t* hash = data;
+    const uint8_t* v = data + 32;
+    if (std::any_of(v, v + 31, [](uint8_t byte) { return byte != 0; }) ||
+        (v[31] != 27 && v[31] != 28)) {
+        return;
+    }
+
+    crypto::ECDSA::Signature signature;
+    std::copy(data + 64, data + 128, signature.begin());
+    const auto pubkey = crypto::ECDSA::Recover(hash, signature, v[31] - 27);
+    if (!pubkey) {
+        return;
+    }
+
+    // Address: last 20 bytes of keccak(x || y), left-padded to a word
+    const auto key_hash = crypto::Keccak256::Hash256(pubkey->data(), pubkey->size());
+    output.assign(32, 0);
+    std::copy(key_hash.begin() + 12, key_hash.end(), output.begin() + 12);
+}
+
+// 0x02
+uint64_t Sha256Gas(const std::vector<uint8_t>& input) {
+    return SHA256_BASE_GAS + SHA256_WORD_GAS * WordCount(input.size());
+}
+
+void Sha256(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+    const auto hash = crypto::SHA256::Hash256(input);
+    output.assign(hash.begin(), hash.end());
+}
+
+// 0x03: 20-byte digest, left-padded to a word
+uint64_t Ripemd160Gas(const std::vector<uint8_t>& input) {
+    return RIPEMD160_BASE_GAS + RIPEMD160_WORD_GAS * WordCount(input.size());
+}
+
+void Ripemd160(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+    const auto hash = crypto::RIPEMD160::Hash160(input);
+    output.assign(32, 0);
+    std::copy(hash.begin(), hash.end(), output.begin() + 12);
+}
+
+// 0x04
+uint64_t IdentityGas(const std::vector<uint8_t>& input) {
+    return IDENTITY_BASE_GAS + IDENTITY_WORD_GAS * WordCount(input.size());
+}
+
+void Identity(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+    output = input;
+}
+
+// 0x05: base^exp % mod, with the lengths in the first three words
+void ModExp(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+    const uint64_t base_len = ReadLength(input, 0);
+    const uint64_t exp_len = ReadLength(input, 32);
+    const uint64_t mod_len = ReadLength(input, 64);
+    output.clear();
+    if (mod_len == 0) {
+        return;  // Nothing to compute; the operands may be arbitrarily long
+    }
+
+    // Paid for, so the lengths are bounded by the gas limit
+    const uint64_t exp_offset = 96 + base_len;
+    const auto base = ReadPadded(input, 96, base_len);
+    const auto exponent = ReadPadded(input, exp_offset, exp_len);
+    const auto modulus = ReadPadded(input, exp_offset + exp_len, mod_len);
+    output.assign(mod_len, 0);
+
+    BnCtxPtr ctx(BN_CTX_new());
+    if (!ctx) {
+        return;
+    }
+    BN_CTX_start(ctx.get());
+    BIGNUM* b = BN_CTX_get(ctx.get());
+    BIGNUM* e = BN_CTX_get(ctx.get());
+    BIGNUM* m = BN_CTX_get(ctx.get());
+    BIGNUM* result = BN_CTX_get(ctx.get());
+    if (result != nullptr && BN_bin2bn(base.data(), static_cast<int>(base.size()), b) &&
+        BN_bin2bn(exponent.data(), static_cast<int>(exponent.size()), e) &&
+        BN_bin2bn(modulus.data(), static_cast<int>(modulus.size()), m) && !BN_is_zero(m) &&
+        BN_mod_exp(result, b, e, m, ctx.get())) {
+        BN_bn2binpad(result, output.data(), static_cast<int>(output.size()));
+    }
+    BN_CTX_end(ctx.get());
+}
+
+// 0x09: the BLAKE2b compression function F (RFC 7693 section 3.2) with a
+// caller-chosen round count. Input: rounds (4 bytes, big-endian), h (8
+// words), m (16 words), t (2 words), final flag (1 byte); words are
+// little-endian. Anything else is malformed and fails like running out of gas.
+constexpr size_t kBlake2fInputSize = 4 + 64 + 128 + 16 + 1;
+
+constexpr uint64_t kBlake2bIv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+constexpr uint8_t kBlake2bSigma[10][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+};
+
+uint64_t LoadLe64(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (size_t i = 8; i-- > 0;) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+uint64_t Rotr64(uint64_t x, int n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+void Blake2bMix(uint64_t* v, int a, int b, int c, int d, uint64_t x, uint64_t y) {
+    v[a] = v[a] + v[b] + x;
+    v[d] = Rotr64(v[d] ^ v[a], 32);
+    v[c] = v[c] + v[d];
+    v[b] = Rotr64(v[b] ^ v[c], 24);
+    v[a] = v[a] + v[b] + y;
+    v[d] = Rotr64(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = Rotr64(v[b] ^ v[c], 63);
+}
+
+uint64_t Blake2fGas(const std::vector<uint8_t>& input) {
+    if (input.size() != kBlake2fInputSize || input.back() > 1) {
+        return kSaturated;
+    }
+    const uint64_t rounds = (uint64_t{input[0]} << 24) | (uint64_t{input[1]} << 16) |
+                            (uint64_t{input[2]} << 8) | input[3];
+    return BLAKE2F_ROUND_GAS * rounds;
+}
+
+void Blake2f(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+    // Validated by Blake2fGas
+    const uint8_t* data = input.data();
+    const uint32_t rounds = (uint32_t{data[0]} << 24) | (uint32_t{data[1]} << 16) |
+                            (uint32_t{data[2]} << 8) | data[3];
+    uint64_t h[8];
+    uint64_t m[16];
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = LoadLe64(data + 4 + 8 * i);
+    }
+    for (size_t i = 0; i < 16; ++i) {
+        m[i] = LoadLe64(data + 68 + 8 * i);
+    }
+
+    uint64_t v[16];
+    std::copy(h, h + 8, v);
+    std::copy(kBlake2bIv, kBlake2bIv + 8, v + 8);
+    v[12] ^= LoadLe64(data + 196);
+    v[13] ^= LoadLe64(data + 204);
+    if (data[212] != 0) {
+        v[14] = ~v[14];
+    }
+    for (uint32_t round = 0; round < rounds; ++round) {
+        const uint8_t* s = kBlake2bSigma[round % 10];
+        Blake2bMix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        Blake2bMix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        Blake2bMix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        Blake2bMix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        Blake2bMix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        Blake2bMix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        Blake2bMix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        Blake2bMix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+
+    output.resize(64);
+    for (size_t i = 0; i < 8; ++i) {
+        const uint64_t word = h[i] ^ v[i] ^ v[i + 8];
+        for (size_t j = 0; j < 8; ++j) {
+            output[8 * i + j] = static_cast<uint8_t>(word >> (8 * j));
+        }
+    }
+}
+
+// 0x0100: BIP-340 verify of (x-only pubkey, message hash, signature)
+uint64_t SchnorrVerifyGas(const std::vector<uint8_t>&) {
+    return SCHNORR_VERIFY_GAS;
+}
+
+void SchnorrVerify(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+    constexpr size_t kKeySize = crypto::Schnorr::PUBLIC_KEY_SIZE;
+    constexpr size_t kSigSize = crypto::Schnorr::SIGNATURE_SIZE;
+    if (input.size() != kKeySize + 32 + kSigSize) {
+        return;
+    }
+    crypto::Schnorr::PublicKey pubkey;
+    crypto::Schnorr::Signature signature;
+    std::copy_n(input.begin(), kKeySize, pubkey.begin());
+    std::copy_n(input.begin() + kKeySize + 32, kSigSize, signature.begin());
+    if (crypto::Schnorr::Verify(pubkey, input.data() + kKeySize, signature)) {
+        output.assign(32, 0);
+        output[31] = 1;
+    }
+}
+
+// Indexed by the address's last byte; entries without run are reserved
+constexpr Precompile kEthereumPrecompiles[PRECOMPILE_ETHEREUM_LAST + 1] = {
+    {nullptr, nullptr, nullptr},
+    {"ecrecover", EcRecoverGas, EcRecover},
+    {"sha256", Sha256Gas, Sha256},
+    {"ripemd160", Ripemd160Gas, Ripemd160},
+    {"identity", IdentityGas, Identity},
+    {"modexp", ModExpGas, ModExp},
+    {nullptr, nullptr, nullptr},
+    {nullptr, nullptr, nullptr},
+    {nullptr, nullptr, nullptr},
+    {"blake2f", Blake2fGas, Blake2f},
+};
+
+// Indexed from PRECOMPILE_PANTHEON_FIRST
+constexpr Precompile kPantheonPrecompiles[] = {
+    {"schnorr_verify", SchnorrVerifyGas, SchnorrVerify},
+};
+
+}  // namespace
+
+uint64_t ModExpGas(const std::vector<uint8_t>& input) {
+    const uint64_t base_len = ReadLength(input, 0);
+    const uint64_t exp_len = ReadLength(input, 32);
+    const uint64_t mod_len = ReadLength(input, 64);
+
+    // Multiplication complexity: the operand size in 64-bit words, squared
+    const uint64_t max_len = std::max(base_len, mod_len);
+    const uint64_t words = max_len / 8 + (max_len % 8 != 0);
+    const uint64_t complexity = SatMul(words, words);
+
+    // Iterations: bit length of the exponent, from its first 32 bytes
+    uint8_t head[32];
+    const uint64_t head_len = std::min<uint64_t>(exp_len, sizeof(head));
+    ReadPadded(input, SatAdd(96, base_len), head, head_len);
+    const uint64_t head_bits = BitLength(head, head_len);
+    uint64_t iterations = head_bits > 0 ? head_bits - 1 : 0;
+    if (exp_len > 32) {
+        iterations = SatAdd(SatMul(8, exp_len - 32), iterations);
+    }
+    iterations = std::max<uint64_t>(iterations, 1);
+
+    const uint64_t product = SatMul(complexity, iterations);
+    if (product == kSaturated) {
+        return kSaturated;
+    }
+    return std::max(MODEXP_MIN_GAS, product / 3);
+}
+
+const Precompile* FindPrecompile(const Address& addr) {
+    static constexpr uint8_t kZero[18] = {};
+    if (std::memcmp(addr.data(), kZero, sizeof(kZero)) != 0) {
+        return nullptr;
+    }
+    const uint16_t id = static_cast<uint16_t>((addr[18] << 8) | addr[19]);
+    if (id <= PRECOMPILE_ETHEREUM_LAST) {
+        const Precompile* precompile = &kEthereumPrecompiles[id];
+        return precompile->run != nullptr ? precompile : nullptr;
+    }
+    const size_t index = id - PRECOMPILE_PANTHEON_FIRST;
+    if (id >= PRECOMPILE_PANTHEON_FIRST && index < std::size(kPantheonPrecompiles)) {
+        return &kPantheonPrecompiles[index];
+    }
+    return nullptr;
+}
+
+Address PrecompileAddress(uint16_t id) {
+    Address addr{};
+    addr[18] = static_cast<uint8_t>(id >> 8);
+    addr[19] = static_cast<uint8_t>(id);
+    return addr;
+}
+
+PrecompileResult RunPrecompile(const Address& addr, const std::vector<uint8_t>& input,
+                               uint64_t gas_limit) {
+    PrecompileResult result;
+    const Precompile* precompile = FindPrecompile(addr);
+    if (precompile == nullptr) {
+        result.status = ExecResult::INVALID_OPCODE;
+        return result;
+    }
+    const uint64_t gas = precompile->gas(input);
+    if (gas > gas_limit) {
+        result.status = ExecResult::OUT_OF_GAS;
+        result.gas_used = gas_limit;
+        return result;
+    }
+    result.gas_used = gas;
+    precompile->run(input, result.output);
+    return result;
+}
+
+}  // namespace evm
+}  // namespace parthenon
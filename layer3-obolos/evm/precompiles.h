@@ -0,0 +1,100 @@
+// ParthenonChain - EVM Precompiled Contracts
+// Native implementations behind fixed low addresses
+
+#pragma once
+
+#include "state.h"
+#include "vm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * Precompile addresses: the last two bytes of an otherwise zero address
+ *
+ * 0x01-0x05 and 0x09 follow Ethereum. 0x06-0x08 (alt_bn128) and 0x0a
+ * (KZG) are reserved and not implemented; calls to them reach a plain
+ * account.
+ * 0x0100-0x01ff is reserved for Pantheon-specific precompiles.
+ */
+constexpr uint16_t PRECOMPILE_ECRECOVER = 0x01;
+constexpr uint16_t PRECOMPILE_SHA256 = 0x02;
+constexpr uint16_t PRECOMPILE_RIPEMD160 = 0x03;
+constexpr uint16_t PRECOMPILE_IDENTITY = 0x04;
+constexpr uint16_t PRECOMPILE_MODEXP = 0x05;
+constexpr uint16_t PRECOMPILE_BLAKE2F = 0x09;  // EIP-152
+constexpr uint16_t PRECOMPILE_ETHEREUM_LAST = 0x0a;
+constexpr uint16_t PRECOMPILE_PANTHEON_FIRST = 0x0100;
+constexpr uint16_t PRECOMPILE_PANTHEON_LAST = 0x01ff;
+constexpr uint16_t PRECOMPILE_SCHNORR_VERIFY = 0x0100;  // BIP-340, x-only keys
+
+// Gas schedule. Per-word costs are per 32 bytes of input, rounded up.
+// bench_precompiles measures each against ecrecover's time per gas.
+constexpr uint64_t ECRECOVER_GAS = 3000;
+constexpr uint64_t SHA256_BASE_GAS = 60;
+constexpr uint64_t SHA256_WORD_GAS = 12;
+constexpr uint64_t RIPEMD160_BASE_GAS = 600;
+constexpr uint64_t RIPEMD160_WORD_GAS = 120;
+constexpr uint64_t IDENTITY_BASE_GAS = 15;
+constexpr uint64_t IDENTITY_WORD_GAS = 3;
+constexpr uint64_t MODEXP_MIN_GAS = 200;  // EIP-2565
+constexpr uint64_t BLAKE2F_ROUND_GAS = 1;
+constexpr uint64_t SCHNORR_VERIFY_GAS = 2600;  // ~0.85x ecrecover, native verify
+
+/**
+ * Outcome of running a precompile
+ *
+ * A precompile only fails by running out of gas, which consumes all the
+ * gas it was given; malformed BLAKE2f input fails the same way. Invalid
+ * signatures are not failures: ecrecover and Schnorr verify succeed with
+ * empty output.
+ */
+struct PrecompileResult {
+    ExecResult status = ExecResult::SUCCESS;
+    uint64_t gas_used = 0;
+    std::vector<uint8_t> output;
+};
+
+/**
+ * Registered precompile: gas is charged before run is called
+ */
+struct Precompile {
+    const char* name;
+    uint64_t (*gas)(const std::vector<uint8_t>& input);
+    void (*run)(const std::vector<uint8_t>& input, std::vector<uint8_t>& output);
+};
+
+/**
+ * Precompile at addr, or nullptr; a few byte compares and a table index
+ */
+const Precompile* FindPrecompile(const Address& addr);
+
+inline bool IsPrecompile(const Address& addr) {
+    return FindPrecompile(addr) != nullptr;
+}
+
+/**
+ * Address of precompile id (e.g. PRECOMPILE_SHA256)
+ */
+Address PrecompileAddress(uint16_t id);
+
+/**
+ * Run the precompile at addr with gas_limit gas
+ *
+ * @return OUT_OF_GAS with gas_used = gas_limit if the input costs more;
+ *         INVALID_OPCODE if addr is not a precompile
+ */
+PrecompileResult RunPrecompile(const Address& addr, const std::vector<uint8_t>& input,
+                               uint64_t gas_limit);
+
+/**
+ * EIP-198 modexp gas with the EIP-2565 pricing; saturates at UINT64_MAX
+ */
+uint64_t ModExpGas(const std::vector<uint8_t>& input);
+
+}  // namespace evm
+}  // namespace parthenon
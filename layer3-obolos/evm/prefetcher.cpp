@@ -0,0 +1,156 @@
+// ParthenonChain - EVM State Prefetcher Implementation
+
+#include "prefetcher.h"
+
+#include "code_cache.h"
+#include "common/metrics/metrics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+
+namespace parthenon {
+namespace evm {
+
+namespace {
+
+uint256_t AddressWord(const Address& addr) {
+    uint256_t word{};
+    std::memcpy(word.data() + 12, addr.data(), addr.size());
+    return word;
+}
+
+}  // namespace
+
+StatePrefetcher::StatePrefetcher(std::shared_ptr<StateDatabase> db, size_t num_threads)
+    : db_(std::move(db)) {
+    workers_.reserve(std::max<size_t>(1, num_threads));
+    for (size_t i = 0; i < std::max<size_t>(1, num_threads); ++i) {
+        workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+StatePrefetcher::~StatePrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    work_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::vector<std::pair<Address, uint256_t>>
+StatePrefetcher::PredictSlots(const StateAccess& state, const ExecutionContext& ctx) {
+    std::set<std::pair<Address, uint256_t>> slots;
+    for (const auto& entry : ctx.access_list) {
+        for (const auto& key : entry.storage_keys) {
+            slots.emplace(entry.address, key);
+        }
+    }
+
+    const CodeHandle code = state.GetCode(ctx.address);
+    for (const auto& hint : code->Analysis().storage_key_hints) {
+        switch (hint.source) {
+            case StorageKeyHint::Source::CONSTANT:
+                slots.emplace(ctx.address, hint.key);
+                break;
+            case StorageKeyHint::Source::CALLER:
+                slots.emplace(ctx.address, AddressWord(ctx.caller));
+                break;
+            case StorageKeyHint::Source::ORIGIN:
+                slots.emplace(ctx.address, AddressWord(ctx.origin));
+                break;
+            case StorageKeyHint::Source::ADDRESS:
+                slots.emplace(ctx.address, AddressWord(ctx.address));
+                break;
+        }
+    }
+    return std::vector<std::pair<Address, uint256_t>>(slots.begin(), slots.end());
+}
+
+void StatePrefetcher::Schedule(const StateAccess& state,
+                               const std::vector<BlockTransaction>& txs) {
+    for (const auto& tx : txs) {
+        auto slots = PredictSlots(state, tx.ctx);
+        ++transactions_;
+        if (slots.empty()) {
+            continue;
+        }
+        requested_ += slots.size();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.insert(queue_.end(), slots.begin(), slots.end());
+        }
+        work_cv_.notify_all();
+    }
+}
+
+void StatePrefetcher::Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this]() { return queue_.empty() && active_ == 0; });
+}
+
+void StatePrefetcher::Cancel() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.clear();
+    idle_cv_.wait(lock, [this]() { return active_ == 0; });
+}
+
+void StatePrefetcher::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+        if (stopping_) {
+            return;
+        }
+        const auto slot = queue_.front();
+        queue_.pop_front();
+        ++active_;
+        lock.unlock();
+
+        if (db_->PrefetchStorage(slot.first, slot.second)) {
+            ++loaded_;
+        }
+
+        lock.lock();
+        --active_;
+        if (queue_.empty() && active_ == 0) {
+            idle_cv_.notify_all();
+        }
+    }
+}
+
+StatePrefetcher::Stats StatePrefetcher::GetStats() const {
+    const auto cache = db_->GetPrefetchStats();
+    Stats stats;
+    stats.transactions = transactions_;
+    stats.requested = requested_;
+    stats.loaded = loaded_;
+    stats.hits = cache.hits;
+    stats.misses = cache.misses;
+    return stats;
+}
+
+void StatePrefetcher::ReportMetrics(pantheon::common::MetricsRegistry& metrics) {
+    const Stats stats = GetStats();
+    Stats previous;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        previous = reported_;
+        reported_ = stats;
+    }
+    metrics.Increment("pantheon_evm_prefetch_transactions_total",
+                      stats.transactions - previous.transactions);
+    metrics.Increment("pantheon_evm_prefetch_requested_total",
+                      stats.requested - previous.requested);
+    metrics.Increment("pantheon_evm_prefetch_loaded_total", stats.loaded - previous.loaded);
+    metrics.Increment("pantheon_evm_prefetch_hits_total", stats.hits - previous.hits);
+    metrics.Increment("pantheon_evm_prefetch_misses_total", stats.misses - previous.misses);
+    metrics.SetGauge("pantheon_evm_prefetch_hit_rate", stats.HitRate());
+}
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,118 @@
+// ParthenonChain - EVM State Prefetcher
+// Reads the storage slots pending transactions will touch ahead of execution
+
+#pragma once
+
+#include "parallel_executor.h"
+#include "state.h"
+#include "state_db.h"
+#include "vm.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace pantheon::common {
+class MetricsRegistry;
+}
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * Background prefetch stage for disk-backed state
+ *
+ * For each transaction of a block, the slots it is expected to touch (its
+ * declared access list, plus the storage keys code analysis found for the
+ * called contract) are queued, in block order, for a pool of I/O threads
+ * that load them into the StateDatabase prefetch cache. The block executes
+ * meanwhile, so reads by later transactions find their slots already in
+ * memory. Prefetching never changes results; a wrong guess only wastes a
+ * read.
+ */
+class StatePrefetcher {
+  public:
+    struct Stats {
+        uint64_t transactions = 0;  // Transactions scheduled
+        uint64_t requested = 0;     // Slots queued
+        uint64_t loaded = 0;        // Slots read from disk into the cache
+        uint64_t hits = 0;          // Storage reads answered from the cache
+        uint64_t misses = 0;        // Storage reads that went to disk
+
+        double HitRate() const {
+            return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+        }
+    };
+
+    /**
+     * @param db State database the executing WorldState reads from
+     * @param num_threads I/O threads
+     */
+    explicit StatePrefetcher(std::shared_ptr<StateDatabase> db, size_t num_threads = 4);
+    ~StatePrefetcher();
+
+    StatePrefetcher(const StatePrefetcher&) = delete;
+    StatePrefetcher& operator=(const StatePrefetcher&) = delete;
+
+    /**
+     * Storage slots a call is expected to touch, without executing it
+     */
+    static std::vector<std::pair<Address, uint256_t>> PredictSlots(const StateAccess& state,
+                                                                   const ExecutionContext& ctx);
+
+    /**
+     * Queue the predicted slots of txs, in order, and return immediately
+     *
+     * Contract code is looked up in state on the calling thread; the I/O
+     * threads only touch the database.
+     */
+    void Schedule(const StateAccess& state, const std::vector<BlockTransaction>& txs);
+
+    /**
+     * Wait until every queued slot has been loaded
+     */
+    void Wait();
+
+    /**
+     * Drop queued slots and wait for loads in progress; call before the
+     * database is written to or closed
+     */
+    void Cancel();
+
+    Stats GetStats() const;
+
+    /**
+     * Publish stats to a metrics registry: counters advance by the change
+     * since the previous call, and the hit rate is a gauge
+     */
+    void ReportMetrics(pantheon::common::MetricsRegistry& metrics);
+
+  private:
+    void WorkerLoop();
+
+    std::shared_ptr<StateDatabase> db_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<std::pair<Address, uint256_t>> queue_;
+    size_t active_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+
+    std::atomic<uint64_t> transactions_{0};
+    std::atomic<uint64_t> requested_{0};
+    std::atomic<uint64_t> loaded_{0};
+
+    Stats reported_;  // As of the last ReportMetrics(), guarded by mutex_
+};
+
+}  // namespace evm
+}  // namespace parthenon
@@ -2,9 +2,9 @@
 
 #include "state.h"
 
-#include "crypto/sha256.h"
-
+#include "code_cache.h"
 #include "mpt.h"
+#include "state_db.h"
 
 #include <algorithm>
 #include <cstring>
@@ -12,144 +12,344 @@
 namespace parthenon {
 namespace evm {
 
+namespace {
+
+bool IsZero(const uint256_t& value) {
+    for (uint8_t byte : value) {
+        if (byte != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Offset of the storage root in an EncodeAccount() value
+constexpr size_t kStorageRootOffset = 8 + 32 + 32;
+
+}  // namespace
+
+WorldState::WorldState(std::shared_ptr<StateDatabase> db, size_t max_diff_layers)
+    : db_(std::move(db)), max_diff_layers_(max_diff_layers) {
+    if (auto head = db_->GetHead()) {
+        head_block_ = head->block_number;
+        has_head_ = true;
+        ResetTries(head->state_root);
+    } else {
+        ResetTries(std::array<uint8_t, 32>{});
+    }
+}
+
 void WorldState::MarkAccountDirty(const Address& addr) {
-    dirty_storage_roots_.insert(addr);
+    dirty_accounts_.insert(addr);
     state_root_dirty_ = true;
 }
 
+void WorldState::JournalAccount(const Address& addr) {
+    if (checkpoints_.empty()) {
+        return;
+    }
+    auto it = accounts_.find(addr);
+    journal_.push_back(AccountChange{
+        addr, it != accounts_.end() ? std::optional<AccountState>(it->second) : std::nullopt,
+        deleted_.count(addr) != 0});
+}
+
+void WorldState::JournalStorage(const Address& addr, const uint256_t& key) {
+    if (checkpoints_.empty()) {
+        return;
+    }
+    auto it = storage_.find(std::make_pair(addr, key));
+    journal_.push_back(StorageChange{
+        addr, key, it != storage_.end() ? std::optional<uint256_t>(it->second) : std::nullopt});
+}
+
+AccountState& WorldState::MutableAccount(const Address& addr) {
+    JournalAccount(addr);
+    auto it = accounts_.find(addr);
+    if (it != accounts_.end()) {
+        return it->second;
+    }
+    AccountState account;
+    if (db_ && deleted_.erase(addr) == 0) {
+        if (auto lower = LoadAccount(addr)) {
+            account = std::move(*lower);
+        }
+    }
+    return accounts_.emplace(addr, std::move(account)).first->second;
+}
+
+std::optional<AccountState> WorldState::LoadAccount(const Address& addr) const {
+    auto it = layer_accounts_.find(addr);
+    if (it != layer_accounts_.end()) {
+        return it->second.account;
+    }
+    return db_->GetAccount(addr);
+}
+
+uint256_t WorldState::LoadStorage(const Address& addr, const uint256_t& key) const {
+    auto slot = layer_storage_.find(std::make_pair(addr, key));
+    auto destruct = layer_destructs_.find(addr);
+    if (slot != layer_storage_.end() &&
+        (destruct == layer_destructs_.end() ||
+         slot->second.block_number >= destruct->second)) {
+        return slot->second.value;
+    }
+    if (destruct != layer_destructs_.end()) {
+        return uint256_t{};
+    }
+    return db_->GetStorage(addr, key);
+}
+
+MerklePatriciaTrie& WorldState::StorageTrie(const Address& addr) const {
+    auto it = storage_tries_.find(addr);
+    if (it != storage_tries_.end()) {
+        return it->second;
+    }
+    std::array<uint8_t, 32> storage_root{};
+    if (db_) {
+        // Open the committed trie from the root recorded in the account leaf
+        auto leaf = account_trie_.Get(std::vector<uint8_t>(addr.begin(), addr.end()));
+        if (leaf && leaf->size() >= kStorageRootOffset + 32) {
+            std::copy(leaf->begin() + kStorageRootOffset, leaf->begin() + kStorageRootOffset + 32,
+                      storage_root.begin());
+        }
+    }
+    return storage_tries_.emplace(addr, MerklePatriciaTrie(storage_root, db_.get())).first->second;
+}
+
 std::optional<AccountState> WorldState::GetAccount(const Address& addr) const {
     auto it = accounts_.find(addr);
-    if (it == accounts_.end()) {
+    if (it != accounts_.end()) {
+        return it->second;
+    }
+    if (!db_ || deleted_.count(addr) != 0) {
         return std::nullopt;
     }
-    return it->second;
+    return LoadAccount(addr);
 }
 
 void WorldState::SetAccount(const Address& addr, const AccountState& state) {
+    JournalAccount(addr);
     accounts_[addr] = state;
+    deleted_.erase(addr);
     MarkAccountDirty(addr);
 }
 
 bool WorldState::AccountExists(const Address& addr) const {
-    return accounts_.find(addr) != accounts_.end();
+    if (accounts_.find(addr) != accounts_.end()) {
+        return true;
+    }
+    return db_ && GetAccount(addr).has_value();
 }
 
 uint256_t WorldState::GetStorage(const Address& addr, const uint256_t& key) const {
     auto storage_key = std::make_pair(addr, key);
     auto it = storage_.find(storage_key);
-    if (it == storage_.end()) {
+    if (it != storage_.end()) {
+        return it->second;
+    }
+    if (!db_ || destructed_.count(addr) != 0) {
         return uint256_t{};  // Return zero if not set
     }
-    return it->second;
+    return LoadStorage(addr, key);
 }
 
 void WorldState::SetStorage(const Address& addr, const uint256_t& key, const uint256_t& value) {
+    JournalStorage(addr, key);
     auto storage_key = std::make_pair(addr, key);
 
-    // Check if value is zero - if so, delete the entry
-    bool is_zero = true;
-    for (uint8_t byte : value) {
-        if (byte != 0) {
-            is_zero = false;
-            break;
-        }
-    }
-
-    if (is_zero) {
+    // Zero deletes the entry, unless it has to shadow a lower layer
+    if (IsZero(value) && !db_) {
         storage_.erase(storage_key);
     } else {
         storage_[storage_key] = value;
     }
+    dirty_slots_[addr].insert(key);
     MarkAccountDirty(addr);
 }
 
-std::vector<uint8_t> WorldState::GetCode(const Address& addr) const {
+CodeHandle WorldState::GetCode(const Address& addr) const {
     auto it = accounts_.find(addr);
-    if (it == accounts_.end()) {
-        return std::vector<uint8_t>();
+    if (it != accounts_.end()) {
+        return it->second.code ? it->second.code : EmptyCode();
+    }
+    if (db_) {
+        auto account = GetAccount(addr);
+        if (account && account->code) {
+            return account->code;
+        }
     }
-    return it->second.code;
+    return EmptyCode();
 }
 
 void WorldState::SetCode(const Address& addr, const std::vector<uint8_t>& code) {
-    auto& account = accounts_[addr];
-    account.code = code;
+    SetCode(addr, CodeCache::Global().Insert(code));
+}
 
-    // Update code hash
-    if (code.empty()) {
-        account.code_hash = std::array<uint8_t, 32>{};
-    } else {
-        crypto::SHA256 hasher;
-        hasher.Write(code.data(), code.size());
-        auto hash = hasher.Finalize();
-        std::memcpy(account.code_hash.data(), hash.data(), 32);
+void WorldState::SetCode(const Address& addr, CodeHandle code) {
+    if (!code) {
+        code = EmptyCode();
     }
+    auto& account = MutableAccount(addr);
+    account.code_hash = code->Hash();
+    account.code = std::move(code);
     MarkAccountDirty(addr);
 }
 
 uint256_t WorldState::GetBalance(const Address& addr) const {
     auto it = accounts_.find(addr);
-    if (it == accounts_.end()) {
-        return uint256_t{};
+    if (it != accounts_.end()) {
+        return it->second.balance;
+    }
+    if (db_) {
+        auto account = GetAccount(addr);
+        if (account) {
+            return account->balance;
+        }
     }
-    return it->second.balance;
+    return uint256_t{};
 }
 
 void WorldState::SetBalance(const Address& addr, const uint256_t& balance) {
-    accounts_[addr].balance = balance;
-    state_root_dirty_ = true;
+    MutableAccount(addr).balance = balance;
+    MarkAccountDirty(addr);
 }
 
 uint64_t WorldState::GetNonce(const Address& addr) const {
     auto it = accounts_.find(addr);
-    if (it == accounts_.end()) {
-        return 0;
+    if (it != accounts_.end()) {
+        return it->second.nonce;
+    }
+    if (db_) {
+        auto account = GetAccount(addr);
+        if (account) {
+            return account->nonce;
+        }
     }
-    return it->second.nonce;
+    return 0;
 }
 
 void WorldState::SetNonce(const Address& addr, uint64_t nonce) {
-    accounts_[addr].nonce = nonce;
-    state_root_dirty_ = true;
+    MutableAccount(addr).nonce = nonce;
+    MarkAccountDirty(addr);
 }
 
 void WorldState::DeleteAccount(const Address& addr) {
     // Remove account
+    JournalAccount(addr);
     accounts_.erase(addr);
 
-    // Remove all storage entries for this account
-    auto it = storage_.begin();
-    while (it != storage_.end()) {
-        if (it->first.first == addr) {
-            it = storage_.erase(it);
+    // Remove all storage entries for this account (contiguous in the map)
+    auto it = storage_.lower_bound(std::make_pair(addr, uint256_t{}));
+    while (it != storage_.end() && it->first.first == addr) {
+        if (!checkpoints_.empty()) {
+            journal_.push_back(StorageChange{addr, it->first.second, it->second});
+        }
+        it = storage_.erase(it);
+    }
+
+    if (!checkpoints_.empty()) {
+        DestructChange change{addr, destructed_.count(addr) != 0, StorageTrie(addr), {}};
+        auto slots = dirty_slots_.find(addr);
+        if (slots != dirty_slots_.end()) {
+            change.dirty_slots = slots->second;
+        }
+        journal_.push_back(std::move(change));
+    }
+
+    if (db_) {
+        deleted_.insert(addr);
+        destructed_.insert(addr);
+    }
+    // Explicitly empty, so a backed state does not reopen the committed trie
+    storage_tries_[addr] = MerklePatriciaTrie();
+    dirty_slots_.erase(addr);
+    MarkAccountDirty(addr);
+}
+
+size_t WorldState::Checkpoint() {
+    checkpoints_.push_back(journal_.size());
+    return checkpoints_.size() - 1;
+}
+
+void WorldState::RevertToCheckpoint(size_t checkpoint) {
+    if (checkpoint >= checkpoints_.size()) {
+        return;
+    }
+
+    // Undo newest first; everything touched is marked dirty again, since the
+    // tries may already hold the reverted values
+    const size_t target = checkpoints_[checkpoint];
+    while (journal_.size() > target) {
+        JournalEntry& entry = journal_.back();
+        if (auto* account = std::get_if<AccountChange>(&entry)) {
+            if (account->previous) {
+                accounts_[account->addr] = std::move(*account->previous);
+            } else {
+                accounts_.erase(account->addr);
+            }
+            if (account->was_deleted) {
+                deleted_.insert(account->addr);
+            } else {
+                deleted_.erase(account->addr);
+            }
+            MarkAccountDirty(account->addr);
+        } else if (auto* slot = std::get_if<StorageChange>(&entry)) {
+            const auto storage_key = std::make_pair(slot->addr, slot->key);
+            if (slot->previous) {
+                storage_[storage_key] = *slot->previous;
+            } else {
+                storage_.erase(storage_key);
+            }
+            dirty_slots_[slot->addr].insert(slot->key);
+            MarkAccountDirty(slot->addr);
         } else {
-            ++it;
+            auto& destruct = std::get<DestructChange>(entry);
+            if (destruct.was_destructed) {
+                destructed_.insert(destruct.addr);
+            } else {
+                destructed_.erase(destruct.addr);
+            }
+            storage_tries_[destruct.addr] = std::move(destruct.storage_trie);
+            dirty_slots_[destruct.addr].insert(destruct.dirty_slots.begin(),
+                                               destruct.dirty_slots.end());
+            MarkAccountDirty(destruct.addr);
         }
+        journal_.pop_back();
     }
-    storage_roots_.erase(addr);
-    dirty_storage_roots_.erase(addr);
-    state_root_dirty_ = true;
+    checkpoints_.resize(checkpoint);
 }
 
-std::array<uint8_t, 32> WorldState::CalculateStorageRoot(const Address& addr) const {
-    auto cached = storage_roots_.find(addr);
-    if (cached != storage_roots_.end() && dirty_storage_roots_.count(addr) == 0) {
-        return cached->second;
+void WorldState::DiscardCheckpoint(size_t checkpoint) {
+    if (checkpoint >= checkpoints_.size()) {
+        return;
+    }
+    checkpoints_.resize(checkpoint);
+    if (checkpoints_.empty()) {
+        journal_.clear();
     }
+}
 
-    MerklePatriciaTrie storage_trie;
-    auto it = storage_.lower_bound(std::make_pair(addr, uint256_t{}));
-    while (it != storage_.end() && it->first.first == addr) {
-        std::vector<uint8_t> storage_key(it->first.second.begin(), it->first.second.end());
-        std::vector<uint8_t> storage_value(it->second.begin(), it->second.end());
-        storage_trie.Put(storage_key, storage_value);
-        ++it;
+std::vector<uint8_t> WorldState::EncodeAccount(const AccountState& account,
+                                               const std::array<uint8_t, 32>& storage_root) {
+    // Account value: nonce + balance + code_hash + storage_root
+    std::vector<uint8_t> account_value;
+    account_value.reserve(8 + 32 + 32 + 32);
+
+    // Nonce (8 bytes, little-endian)
+    for (int i = 0; i < 8; i++) {
+        account_value.push_back(static_cast<uint8_t>((account.nonce >> (i * 8)) & 0xFF));
     }
 
-    auto root = storage_trie.GetRootHash();
-    storage_roots_[addr] = root;
-    dirty_storage_roots_.erase(addr);
-    return root;
+    // Balance (32 bytes)
+    account_value.insert(account_value.end(), account.balance.begin(), account.balance.end());
+
+    // Code hash (32 bytes)
+    account_value.insert(account_value.end(), account.code_hash.begin(), account.code_hash.end());
+
+    // Storage root (32 bytes)
+    account_value.insert(account_value.end(), storage_root.begin(), storage_root.end());
+    return account_value;
 }
 
 std::array<uint8_t, 32> WorldState::CalculateStateRoot() const {
@@ -157,39 +357,42 @@ std::array<uint8_t, 32> WorldState::CalculateStateRoot() const {
         return *cached_state_root_;
     }
 
-    // Production-grade Merkle Patricia Trie state root calculation
-    // Implements Ethereum-compatible MPT structure
-    MerklePatriciaTrie trie;
+    // Write modified slots back into their storage tries
+    for (const auto& [addr, keys] : dirty_slots_) {
+        auto& storage_trie = StorageTrie(addr);
+        for (const auto& key : keys) {
+            std::vector<uint8_t> storage_key(key.begin(), key.end());
+            const uint256_t value = GetStorage(addr, key);
+            if (IsZero(value)) {
+                storage_trie.Delete(storage_key);
+            } else {
+                storage_trie.Put(storage_key, std::vector<uint8_t>(value.begin(), value.end()));
+            }
+        }
+    }
+    dirty_slots_.clear();
 
-    // Insert all accounts into the MPT
-    for (const auto& [addr, account] : accounts_) {
-        // Create account key (address as bytes)
+    // Re-insert modified accounts; only their paths in the trie are rehashed
+    for (const auto& addr : dirty_accounts_) {
         std::vector<uint8_t> account_key(addr.begin(), addr.end());
-
-        // Build account value (nonce + balance + code_hash + storage_root)
-        std::vector<uint8_t> account_value;
-
-        // Nonce (8 bytes, little-endian)
-        for (int i = 0; i < 8; i++) {
-            account_value.push_back(static_cast<uint8_t>((account.nonce >> (i * 8)) & 0xFF));
+        auto account = GetAccount(addr);
+        if (!account) {
+            account_trie_.Delete(account_key);
+            continue;
         }
 
-        // Balance (32 bytes)
-        account_value.insert(account_value.end(), account.balance.begin(), account.balance.end());
-
-        // Code hash (32 bytes)
-        account_value.insert(account_value.end(), account.code_hash.begin(),
-                             account.code_hash.end());
-
-        auto storage_root = CalculateStorageRoot(addr);
-        account_value.insert(account_value.end(), storage_root.begin(), storage_root.end());
-
-        // Insert account into main trie
-        trie.Put(account_key, account_value);
+        std::array<uint8_t, 32> storage_root{};
+        auto trie = storage_tries_.find(addr);
+        if (trie != storage_tries_.end()) {
+            storage_root = trie->second.GetRootHash();
+        } else if (db_) {
+            storage_root = StorageTrie(addr).GetRootHash();
+        }
+        account_trie_.Put(account_key, EncodeAccount(*account, storage_root));
     }
+    dirty_accounts_.clear();
 
-    // Return the root hash of the account trie
-    cached_state_root_ = trie.GetRootHash();
+    cached_state_root_ = account_trie_.GetRootHash();
     state_root_dirty_ = false;
     return *cached_state_root_;
 }
@@ -198,8 +401,12 @@ WorldState::Snapshot WorldState::CreateSnapshot() const {
     Snapshot snapshot;
     snapshot.accounts = accounts_;
     snapshot.storage = storage_;
-    snapshot.storage_roots = storage_roots_;
-    snapshot.dirty_storage_roots = dirty_storage_roots_;
+    snapshot.deleted = deleted_;
+    snapshot.destructed = destructed_;
+    snapshot.account_trie = account_trie_;
+    snapshot.storage_tries = storage_tries_;
+    snapshot.dirty_accounts = dirty_accounts_;
+    snapshot.dirty_slots = dirty_slots_;
     snapshot.state_root = cached_state_root_;
     snapshot.state_root_dirty = state_root_dirty_;
     return snapshot;
@@ -208,10 +415,183 @@ WorldState::Snapshot WorldState::CreateSnapshot() const {
 void WorldState::RestoreSnapshot(const Snapshot& snapshot) {
     accounts_ = snapshot.accounts;
     storage_ = snapshot.storage;
-    storage_roots_ = snapshot.storage_roots;
-    dirty_storage_roots_ = snapshot.dirty_storage_roots;
+    deleted_ = snapshot.deleted;
+    destructed_ = snapshot.destructed;
+    account_trie_ = snapshot.account_trie;
+    storage_tries_ = snapshot.storage_tries;
+    dirty_accounts_ = snapshot.dirty_accounts;
+    dirty_slots_ = snapshot.dirty_slots;
     cached_state_root_ = snapshot.state_root;
     state_root_dirty_ = snapshot.state_root_dirty;
+    journal_.clear();
+    checkpoints_.clear();
+}
+
+void WorldState::ResetTries(const std::array<uint8_t, 32>& root) {
+    // Drop loaded nodes; later reads load them from the store again
+    account_trie_ = MerklePatriciaTrie(root, db_.get());
+    storage_tries_.clear();
+    dirty_accounts_.clear();
+    dirty_slots_.clear();
+    cached_state_root_ = root;
+    state_root_dirty_ = false;
+}
+
+void WorldState::IndexLayer(const StateDiffLayer& layer) {
+    for (const auto& addr : layer.destructed) {
+        layer_destructs_[addr] = layer.block_number;
+    }
+    for (const auto& [addr, account] : layer.accounts) {
+        layer_accounts_[addr] = LayerAccount{layer.block_number, account};
+    }
+    for (const auto& [slot, value] : layer.storage) {
+        layer_storage_[slot] = LayerSlot{layer.block_number, value};
+    }
+}
+
+bool WorldState::FlattenOldestLayer() {
+    const StateDiffLayer& layer = diff_layers_.front();
+    if (!db_->WriteLayer(layer)) {
+        return false;
+    }
+
+    // Entries still pointing at this layer are now served by the snapshot
+    for (const auto& addr : layer.destructed) {
+        auto it = layer_destructs_.find(addr);
+        if (it != layer_destructs_.end() && it->second == layer.block_number) {
+            layer_destructs_.erase(it);
+        }
+    }
+    for (const auto& entry : layer.accounts) {
+        auto it = layer_accounts_.find(entry.first);
+        if (it != layer_accounts_.end() && it->second.block_number == layer.block_number) {
+            layer_accounts_.erase(it);
+        }
+    }
+    for (const auto& entry : layer.storage) {
+        auto it = layer_storage_.find(entry.first);
+        if (it != layer_storage_.end() && it->second.block_number == layer.block_number) {
+            layer_storage_.erase(it);
+        }
+    }
+    diff_layers_.pop_front();
+    return true;
+}
+
+bool WorldState::Commit(uint64_t block_number) {
+    if (!db_ || !checkpoints_.empty() || (has_head_ && block_number <= head_block_)) {
+        return false;
+    }
+
+    const auto root = CalculateStateRoot();
+
+    // Persist new trie nodes; their hashes are what later blocks load by
+    std::vector<std::pair<MerklePatriciaTrie::Hash, std::vector<uint8_t>>> nodes;
+    auto sink = [&nodes](const MerklePatriciaTrie::Hash& hash,
+                         const std::vector<uint8_t>& encoded) {
+        nodes.emplace_back(hash, encoded);
+    };
+    for (auto& entry : storage_tries_) {
+        entry.second.Commit(sink);
+    }
+    account_trie_.Commit(sink);
+    if (!db_->WriteNodes(nodes)) {
+        return false;
+    }
+
+    StateDiffLayer layer;
+    layer.block_number = block_number;
+    layer.state_root = root;
+    layer.storage = std::move(storage_);
+    layer.destructed = std::move(destructed_);
+
+    std::set<Address> touched = deleted_;
+    for (const auto& entry : accounts_) {
+        touched.insert(entry.first);
+    }
+    for (const auto& entry : layer.storage) {
+        touched.insert(entry.first.first);
+    }
+    for (const auto& addr : touched) {
+        auto account = GetAccount(addr);
+        if (account) {
+            // Record the storage root alongside the account in the snapshot
+            account->storage_root = StorageTrie(addr).GetRootHash();
+        } else if (deleted_.count(addr) == 0) {
+            continue;  // Storage written for an account that never existed
+        }
+        layer.accounts.emplace(addr, std::move(account));
+    }
+
+    accounts_.clear();
+    storage_.clear();
+    deleted_.clear();
+    destructed_.clear();
+
+    IndexLayer(layer);
+    diff_layers_.push_back(std::move(layer));
+    head_block_ = block_number;
+    has_head_ = true;
+    ResetTries(root);
+
+    while (diff_layers_.size() > max_diff_layers_) {
+        if (!FlattenOldestLayer()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WorldState::RevertToBlock(uint64_t block_number) {
+    if (!db_) {
+        return false;
+    }
+
+    std::array<uint8_t, 32> root{};
+    auto layer = std::find_if(diff_layers_.begin(), diff_layers_.end(),
+                              [&](const StateDiffLayer& l) { return l.block_number == block_number; });
+    if (layer != diff_layers_.end()) {
+        root = layer->state_root;
+        diff_layers_.erase(layer + 1, diff_layers_.end());
+    } else {
+        auto head = db_->GetHead();
+        if (!head || head->block_number != block_number) {
+            return false;
+        }
+        root = head->state_root;
+        diff_layers_.clear();
+    }
+
+    accounts_.clear();
+    storage_.clear();
+    deleted_.clear();
+    destructed_.clear();
+    journal_.clear();
+    checkpoints_.clear();
+
+    layer_accounts_.clear();
+    layer_storage_.clear();
+    layer_destructs_.clear();
+    for (const auto& l : diff_layers_) {
+        IndexLayer(l);
+    }
+
+    head_block_ = block_number;
+    has_head_ = true;
+    ResetTries(root);
+    return true;
+}
+
+bool WorldState::Flush() {
+    if (!db_) {
+        return false;
+    }
+    while (!diff_layers_.empty()) {
+        if (!FlattenOldestLayer()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 }  // namespace evm
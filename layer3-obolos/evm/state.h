@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include "mpt.h"
+
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <set>
 #include <map>
+#include <memory>
 #include <optional>
+#include <variant>
 #include <vector>
 
 namespace parthenon {
@@ -45,6 +51,13 @@ inline uint64_t ToUint64(const uint256_t& value) {
     return result;
 }
 
+class ContractCode;
+
+/**
+ * Shared, immutable contract code (see code_cache.h)
+ */
+using CodeHandle = std::shared_ptr<const ContractCode>;
+
 /**
  * Account state in the world state
  */
@@ -53,7 +66,7 @@ struct AccountState {
     uint256_t balance;  // OBL balance for gas
     std::array<uint8_t, 32> code_hash;
     std::array<uint8_t, 32> storage_root;
-    std::vector<uint8_t> code;  // Contract bytecode
+    CodeHandle code;  // Contract bytecode; null or empty for non-contract accounts
 
     AccountState() : nonce(0), balance{}, code_hash{}, storage_root{} {}
 };
@@ -66,13 +79,77 @@ struct StorageEntry {
     uint256_t value;
 };
 
+/**
+ * State changes made by one block, as committed by WorldState::Commit()
+ */
+struct StateDiffLayer {
+    uint64_t block_number = 0;
+    std::array<uint8_t, 32> state_root{};
+    std::map<Address, std::optional<AccountState>> accounts;  // nullopt = deleted
+    std::map<std::pair<Address, uint256_t>, uint256_t> storage;  // zero = cleared
+    std::set<Address> destructed;  // Storage wiped before this block's writes
+};
+
+class StateDatabase;
+
+/**
+ * State operations available to executing code
+ *
+ * Implemented by WorldState and by per-transaction views that buffer writes
+ * (see parallel_executor.h), so the VM runs unchanged against either.
+ */
+class StateAccess {
+  public:
+    virtual ~StateAccess() = default;
+
+    virtual uint256_t GetBalance(const Address& addr) const = 0;
+    virtual void SetBalance(const Address& addr, const uint256_t& balance) = 0;
+    virtual uint64_t GetNonce(const Address& addr) const = 0;
+    virtual void SetNonce(const Address& addr, uint64_t nonce) = 0;
+    virtual CodeHandle GetCode(const Address& addr) const = 0;
+    virtual uint256_t GetStorage(const Address& addr, const uint256_t& key) const = 0;
+    virtual void SetStorage(const Address& addr, const uint256_t& key,
+                            const uint256_t& value) = 0;
+
+    /**
+     * Open a checkpoint (e.g. on entering a call frame); checkpoints nest
+     * @return Id to pass to RevertToCheckpoint() or DiscardCheckpoint()
+     */
+    virtual size_t Checkpoint() = 0;
+
+    /**
+     * Undo every change made since the checkpoint and close it, along with
+     * any checkpoint opened after it
+     */
+    virtual void RevertToCheckpoint(size_t checkpoint) = 0;
+
+    /**
+     * Keep the changes made since the checkpoint and close it, along with
+     * any checkpoint opened after it
+     */
+    virtual void DiscardCheckpoint(size_t checkpoint) = 0;
+};
+
 /**
  * World state - maintains all account states
+ *
+ * A default-constructed WorldState keeps everything in memory. One opened on
+ * a StateDatabase only holds the current block's changes in memory; reads
+ * fall through to the diff layers of recent blocks and then to the flat
+ * snapshot on disk. Commit() seals the block into a new diff layer; once
+ * there are more than max_diff_layers, the oldest is written to the flat
+ * snapshot. RevertToBlock() drops layers for reorgs.
  */
-class WorldState {
+class WorldState : public StateAccess {
   public:
     WorldState() = default;
 
+    /**
+     * Open the state persisted in db at its head block
+     * @param max_diff_layers Recent blocks kept in memory for RevertToBlock()
+     */
+    explicit WorldState(std::shared_ptr<StateDatabase> db, size_t max_diff_layers = 128);
+
     /**
      * Get account state
      */
@@ -91,61 +168,86 @@ class WorldState {
     /**
      * Get contract storage value
      */
-    uint256_t GetStorage(const Address& addr, const uint256_t& key) const;
+    uint256_t GetStorage(const Address& addr, const uint256_t& key) const override;
 
     /**
      * Set contract storage value
      */
-    void SetStorage(const Address& addr, const uint256_t& key, const uint256_t& value);
+    void SetStorage(const Address& addr, const uint256_t& key, const uint256_t& value) override;
 
     /**
      * Get contract code
+     * @return Shared handle, never null (empty code for unknown accounts)
      */
-    std::vector<uint8_t> GetCode(const Address& addr) const;
+    CodeHandle GetCode(const Address& addr) const override;
 
     /**
-     * Set contract code
+     * Set contract code, deduplicated through the process-wide CodeCache
      */
     void SetCode(const Address& addr, const std::vector<uint8_t>& code);
 
+    /**
+     * Set contract code from an existing handle
+     */
+    void SetCode(const Address& addr, CodeHandle code);
+
     /**
      * Get OBL balance
      */
-    uint256_t GetBalance(const Address& addr) const;
+    uint256_t GetBalance(const Address& addr) const override;
 
     /**
      * Set OBL balance
      */
-    void SetBalance(const Address& addr, const uint256_t& balance);
+    void SetBalance(const Address& addr, const uint256_t& balance) override;
 
     /**
      * Get nonce
      */
-    uint64_t GetNonce(const Address& addr) const;
+    uint64_t GetNonce(const Address& addr) const override;
 
     /**
      * Set nonce
      */
-    void SetNonce(const Address& addr, uint64_t nonce);
+    void SetNonce(const Address& addr, uint64_t nonce) override;
 
     /**
      * Delete account
      */
     void DeleteAccount(const Address& addr);
 
+    /**
+     * Checkpoints are backed by a journal of old values, so reverting costs
+     * O(changes since the checkpoint) regardless of state size. Changes are
+     * only journaled while a checkpoint is open.
+     */
+    size_t Checkpoint() override;
+    void RevertToCheckpoint(size_t checkpoint) override;
+    void DiscardCheckpoint(size_t checkpoint) override;
+
     /**
      * Calculate state root (Merkle Patricia Trie root)
+     *
+     * Account and storage tries persist between calls; only accounts and
+     * slots modified since the previous call are written back and rehashed.
      */
     std::array<uint8_t, 32> CalculateStateRoot() const;
 
     /**
      * Create snapshot for reverting
+     *
+     * Copies the whole in-memory state; prefer Checkpoint() for rolling back
+     * calls and transactions. Restoring a snapshot closes all checkpoints.
      */
     struct Snapshot {
         std::map<Address, AccountState> accounts;
         std::map<std::pair<Address, uint256_t>, uint256_t> storage;
-        std::map<Address, std::array<uint8_t, 32>> storage_roots;
-        std::set<Address> dirty_storage_roots;
+        std::set<Address> deleted;
+        std::set<Address> destructed;
+        MerklePatriciaTrie account_trie;
+        std::map<Address, MerklePatriciaTrie> storage_tries;
+        std::set<Address> dirty_accounts;
+        std::map<Address, std::set<uint256_t>> dirty_slots;
         std::optional<std::array<uint8_t, 32>> state_root;
         bool state_root_dirty;
     };
@@ -153,16 +255,114 @@ class WorldState {
     Snapshot CreateSnapshot() const;
     void RestoreSnapshot(const Snapshot& snapshot);
 
+    /**
+     * Seal the changes made since the last commit as block block_number,
+     * persisting new trie nodes (database-backed state only)
+     * @return false if not backed, a checkpoint is open, block_number does
+     *         not advance the head, or a database write fails
+     */
+    bool Commit(uint64_t block_number);
+
+    /**
+     * Drop uncommitted changes and every diff layer above block_number
+     * @return false if block_number is neither a diff layer nor the flat
+     *         snapshot's block
+     */
+    bool RevertToBlock(uint64_t block_number);
+
+    /**
+     * Write all diff layers to the flat snapshot
+     */
+    bool Flush();
+
+    /**
+     * Last committed block (0 before the first commit)
+     */
+    uint64_t GetHeadBlock() const { return head_block_; }
+
+    /**
+     * Number of committed blocks not yet written to the flat snapshot
+     */
+    size_t GetDiffLayerCount() const { return diff_layers_.size(); }
+
   private:
+    // Changes since the last Commit(); everything when not database-backed.
+    // When backed, cleared slots are kept as explicit zeros so they shadow
+    // older layers.
     std::map<Address, AccountState> accounts_;
     std::map<std::pair<Address, uint256_t>, uint256_t> storage_;
-    mutable std::map<Address, std::array<uint8_t, 32>> storage_roots_;
-    mutable std::set<Address> dirty_storage_roots_;
+    std::set<Address> deleted_;     // Backed only: deleted and not recreated
+    std::set<Address> destructed_;  // Backed only: storage wiped this block
+
+    // Tries are brought up to date lazily by CalculateStateRoot(); copies
+    // share unchanged nodes, so snapshots of them are cheap
+    mutable MerklePatriciaTrie account_trie_;
+    mutable std::map<Address, MerklePatriciaTrie> storage_tries_;
+    mutable std::set<Address> dirty_accounts_;
+    mutable std::map<Address, std::set<uint256_t>> dirty_slots_;
     mutable std::optional<std::array<uint8_t, 32>> cached_state_root_;
     mutable bool state_root_dirty_ = true;
 
+    // Backing store and committed diff layers, oldest first
+    std::shared_ptr<StateDatabase> db_;
+    size_t max_diff_layers_ = 0;
+    std::deque<StateDiffLayer> diff_layers_;
+    uint64_t head_block_ = 0;
+    bool has_head_ = false;
+
+    // Newest value per key across diff_layers_, so a read below the current
+    // block costs one lookup instead of one per layer
+    struct LayerAccount {
+        uint64_t block_number;
+        std::optional<AccountState> account;
+    };
+    struct LayerSlot {
+        uint64_t block_number;
+        uint256_t value;
+    };
+    std::map<Address, LayerAccount> layer_accounts_;
+    std::map<std::pair<Address, uint256_t>, LayerSlot> layer_storage_;
+    std::map<Address, uint64_t> layer_destructs_;
+
+    // Old values recorded while a checkpoint is open, newest last
+    struct AccountChange {
+        Address addr;
+        std::optional<AccountState> previous;  // Entry in accounts_
+        bool was_deleted;
+    };
+    struct StorageChange {
+        Address addr;
+        uint256_t key;
+        std::optional<uint256_t> previous;  // Entry in storage_
+    };
+    struct DestructChange {
+        Address addr;
+        bool was_destructed;
+        MerklePatriciaTrie storage_trie;
+        std::set<uint256_t> dirty_slots;
+    };
+    using JournalEntry = std::variant<AccountChange, StorageChange, DestructChange>;
+
+    std::vector<JournalEntry> journal_;
+    std::vector<size_t> checkpoints_;  // journal_ size when each was opened
+
+    void JournalAccount(const Address& addr);
+    void JournalStorage(const Address& addr, const uint256_t& key);
+
     void MarkAccountDirty(const Address& addr);
-    std::array<uint8_t, 32> CalculateStorageRoot(const Address& addr) const;
+    AccountState& MutableAccount(const Address& addr);
+    MerklePatriciaTrie& StorageTrie(const Address& addr) const;
+
+    // Reads below the current block (backed only)
+    std::optional<AccountState> LoadAccount(const Address& addr) const;
+    uint256_t LoadStorage(const Address& addr, const uint256_t& key) const;
+
+    void IndexLayer(const StateDiffLayer& layer);
+    bool FlattenOldestLayer();
+    void ResetTries(const std::array<uint8_t, 32>& root);
+
+    static std::vector<uint8_t> EncodeAccount(const AccountState& account,
+                                              const std::array<uint8_t, 32>& storage_root);
 };
 
 /**
@@ -0,0 +1,375 @@
+// ParthenonChain - EVM State Database Implementation
+
+#include "state_db.h"
+
+#include "code_cache.h"
+#include "crypto/keccak.h"
+
+#include <cstring>
+#include <leveldb/write_batch.h>
+
+namespace parthenon {
+namespace evm {
+
+namespace {
+
+const char kHeadKey[] = "meta:head";
+
+void AppendUint32(std::string& out, uint32_t value) {
+    for (int i = 3; i >= 0; --i) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+void AppendUint64(std::string& out, uint64_t value) {
+    for (int i = 7; i >= 0; --i) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+uint64_t ReadUint(const std::string& data, size_t pos, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value = (value << 8) | static_cast<uint8_t>(data[pos + i]);
+    }
+    return value;
+}
+
+template <size_t N>
+void AppendBytes(std::string& out, const std::array<uint8_t, N>& bytes) {
+    out.append(reinterpret_cast<const char*>(bytes.data()), N);
+}
+
+template <size_t N>
+void ReadBytes(const std::string& data, size_t pos, std::array<uint8_t, N>& bytes) {
+    std::memcpy(bytes.data(), data.data() + pos, N);
+}
+
+template <size_t N>
+void AppendHash(std::string& out, const std::array<uint8_t, N>& bytes) {
+    AppendBytes(out, crypto::Keccak256::Hash256(bytes.data(), bytes.size()));
+}
+
+bool IsZero(const uint256_t& value) {
+    return value == uint256_t{};
+}
+
+// exists(1) + incarnation(4) + nonce(8) + balance(32) + code_hash(32) + storage_root(32)
+constexpr size_t kRecordSize = 1 + 4 + 8 + 32 + 32 + 32;
+
+}  // namespace
+
+StateDatabase::~StateDatabase() = default;
+
+bool StateDatabase::Open(const std::string& db_path) {
+    leveldb::Options options;
+    options.create_if_missing = true;
+
+    leveldb::DB* db_ptr;
+    leveldb::Status status = leveldb::DB::Open(options, db_path, &db_ptr);
+
+    if (!status.ok()) {
+        return false;
+    }
+
+    db_.reset(db_ptr);
+    return true;
+}
+
+void StateDatabase::Close() {
+    db_.reset();
+    {
+        std::lock_guard<std::mutex> lock(incarnation_mutex_);
+        incarnations_.clear();
+    }
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetched_.clear();
+    ++prefetch_generation_;
+}
+
+std::string StateDatabase::AccountKey(const Address& addr) {
+    std::string key = "a";
+    AppendHash(key, addr);
+    return key;
+}
+
+std::string StateDatabase::StorageKey(const Address& addr, uint32_t incarnation,
+                                      const uint256_t& key) {
+    std::string storage_key = "s";
+    storage_key.reserve(1 + 32 + 4 + 32);
+    AppendHash(storage_key, addr);
+    AppendUint32(storage_key, incarnation);
+    AppendHash(storage_key, key);
+    return storage_key;
+}
+
+std::string StateDatabase::EncodeRecord(const AccountRecord& record) {
+    std::string data;
+    data.reserve(kRecordSize);
+    data.push_back(record.exists ? 1 : 0);
+    AppendUint32(data, record.incarnation);
+    AppendUint64(data, record.account.nonce);
+    AppendBytes(data, record.account.balance);
+    AppendBytes(data, record.account.code_hash);
+    AppendBytes(data, record.account.storage_root);
+    return data;
+}
+
+std::optional<StateDatabase::AccountRecord> StateDatabase::DecodeRecord(const std::string& data) {
+    if (data.size() != kRecordSize) {
+        return std::nullopt;
+    }
+    AccountRecord record;
+    record.exists = data[0] != 0;
+    record.incarnation = static_cast<uint32_t>(ReadUint(data, 1, 4));
+    record.account.nonce = ReadUint(data, 5, 8);
+    ReadBytes(data, 13, record.account.balance);
+    ReadBytes(data, 45, record.account.code_hash);
+    ReadBytes(data, 77, record.account.storage_root);
+    return record;
+}
+
+std::optional<StateDatabase::Head> StateDatabase::GetHead() const {
+    if (!db_) {
+        return std::nullopt;
+    }
+    std::string data;
+    if (!db_->Get(leveldb::ReadOptions(), kHeadKey, &data).ok() || data.size() != 8 + 32) {
+        return std::nullopt;
+    }
+    Head head;
+    head.block_number = ReadUint(data, 0, 8);
+    ReadBytes(data, 8, head.state_root);
+    return head;
+}
+
+std::optional<StateDatabase::AccountRecord> StateDatabase::ReadRecord(const Address& addr) const {
+    if (!db_) {
+        return std::nullopt;
+    }
+    std::string data;
+    if (!db_->Get(leveldb::ReadOptions(), AccountKey(addr), &data).ok()) {
+        return std::nullopt;
+    }
+    return DecodeRecord(data);
+}
+
+uint32_t StateDatabase::GetIncarnation(const Address& addr) const {
+    {
+        std::lock_guard<std::mutex> lock(incarnation_mutex_);
+        auto it = incarnations_.find(addr);
+        if (it != incarnations_.end()) {
+            return it->second;
+        }
+    }
+    auto record = ReadRecord(addr);
+    const uint32_t incarnation = record ? record->incarnation : 0;
+    std::lock_guard<std::mutex> lock(incarnation_mutex_);
+    incarnations_[addr] = incarnation;
+    return incarnation;
+}
+
+std::optional<AccountState> StateDatabase::GetAccount(const Address& addr) const {
+    auto record = ReadRecord(addr);
+    if (!record || !record->exists) {
+        return std::nullopt;
+    }
+
+    AccountState account = record->account;
+    if (account.code_hash != CodeHash{}) {
+        account.code = CodeCache::Global().Get(account.code_hash);
+        if (!account.code) {
+            std::string code;
+            std::string code_key = "c";
+            AppendBytes(code_key, account.code_hash);
+            if (db_->Get(leveldb::ReadOptions(), code_key, &code).ok()) {
+                account.code = CodeCache::Global().GetOrInsert(
+                    account.code_hash, std::vector<uint8_t>(code.begin(), code.end()));
+            }
+        }
+    }
+    return account;
+}
+
+uint256_t StateDatabase::GetStorage(const Address& addr, const uint256_t& key) const {
+    {
+        std::lock_guard<std::mutex> lock(prefetch_mutex_);
+        auto it = prefetched_.find(std::make_pair(addr, key));
+        if (it != prefetched_.end()) {
+            ++prefetch_hits_;
+            return it->second;
+        }
+        ++prefetch_misses_;
+    }
+    return ReadStorage(addr, key);
+}
+
+bool StateDatabase::PrefetchStorage(const Address& addr, const uint256_t& key) {
+    const auto slot = std::make_pair(addr, key);
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(prefetch_mutex_);
+        if (prefetched_.count(slot) != 0) {
+            return false;
+        }
+        generation = prefetch_generation_;
+    }
+
+    const uint256_t value = ReadStorage(addr, key);
+
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    if (generation != prefetch_generation_) {
+        return true;  // The slot may have changed underneath the read
+    }
+    if (prefetched_.size() >= prefetch_capacity_) {
+        prefetched_.clear();
+    }
+    prefetched_.emplace(slot, value);
+    return true;
+}
+
+StateDatabase::PrefetchStats StateDatabase::GetPrefetchStats() const {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    PrefetchStats stats;
+    stats.entries = prefetched_.size();
+    stats.hits = prefetch_hits_;
+    stats.misses = prefetch_misses_;
+    return stats;
+}
+
+void StateDatabase::SetPrefetchCapacity(size_t max_entries) {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetch_capacity_ = max_entries;
+    if (prefetched_.size() > prefetch_capacity_) {
+        prefetched_.clear();
+    }
+}
+
+uint256_t StateDatabase::ReadStorage(const Address& addr, const uint256_t& key) const {
+    if (!db_) {
+        return uint256_t{};
+    }
+    std::string data;
+    if (!db_->Get(leveldb::ReadOptions(), StorageKey(addr, GetIncarnation(addr), key), &data)
+             .ok() ||
+        data.size() != 32) {
+        return uint256_t{};
+    }
+    uint256_t value;
+    ReadBytes(data, 0, value);
+    return value;
+}
+
+std::optional<std::vector<uint8_t>> StateDatabase::GetNode(const Hash& hash) const {
+    if (!db_) {
+        return std::nullopt;
+    }
+    std::string key = "n";
+    AppendBytes(key, hash);
+    std::string data;
+    if (!db_->Get(leveldb::ReadOptions(), key, &data).ok()) {
+        return std::nullopt;
+    }
+    return std::vector<uint8_t>(data.begin(), data.end());
+}
+
+bool StateDatabase::WriteNodes(const std::vector<std::pair<Hash, std::vector<uint8_t>>>& nodes) {
+    if (!db_) {
+        return false;
+    }
+    leveldb::WriteBatch batch;
+    for (const auto& [hash, encoded] : nodes) {
+        std::string key = "n";
+        AppendBytes(key, hash);
+        batch.Put(key, std::string(encoded.begin(), encoded.end()));
+    }
+    return db_->Write(leveldb::WriteOptions(), &batch).ok();
+}
+
+bool StateDatabase::WriteLayer(const StateDiffLayer& layer) {
+    if (!db_) {
+        return false;
+    }
+
+    leveldb::WriteBatch batch;
+    std::map<Address, uint32_t> incarnations;
+    auto incarnation_of = [&](const Address& addr) -> uint32_t& {
+        auto it = incarnations.find(addr);
+        if (it == incarnations.end()) {
+            it = incarnations.emplace(addr, GetIncarnation(addr)).first;
+        }
+        return it->second;
+    };
+
+    // Destructed accounts move to a fresh incarnation, orphaning old slots
+    for (const auto& addr : layer.destructed) {
+        ++incarnation_of(addr);
+    }
+
+    for (const auto& [addr, account] : layer.accounts) {
+        AccountRecord record;
+        record.exists = account.has_value();
+        record.incarnation = incarnation_of(addr);
+        if (account) {
+            record.account = *account;
+            if (account->code && !account->code->Empty()) {
+                std::string code_key = "c";
+                AppendBytes(code_key, account->code_hash);
+                const auto& code = account->code->Bytes();
+                batch.Put(code_key, std::string(code.begin(), code.end()));
+            }
+        }
+        batch.Put(AccountKey(addr), EncodeRecord(record));
+    }
+    // A destructed account always has an entry in layer.accounts, but keep
+    // the new incarnation on disk even if a caller built the layer by hand
+    for (const auto& addr : layer.destructed) {
+        if (layer.accounts.count(addr) == 0) {
+            AccountRecord record = ReadRecord(addr).value_or(AccountRecord{});
+            record.incarnation = incarnation_of(addr);
+            batch.Put(AccountKey(addr), EncodeRecord(record));
+        }
+    }
+
+    for (const auto& [slot, value] : layer.storage) {
+        const std::string key = StorageKey(slot.first, incarnation_of(slot.first), slot.second);
+        if (IsZero(value)) {
+            batch.Delete(key);
+        } else {
+            batch.Put(key, std::string(reinterpret_cast<const char*>(value.data()), 32));
+        }
+    }
+
+    std::string head;
+    AppendUint64(head, layer.block_number);
+    AppendBytes(head, layer.state_root);
+    batch.Put(kHeadKey, head);
+
+    if (!db_->Write(leveldb::WriteOptions(), &batch).ok()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(incarnation_mutex_);
+        for (const auto& [addr, incarnation] : incarnations) {
+            incarnations_[addr] = incarnation;
+        }
+    }
+    // Drop prefetched copies of what changed; prefetches still in flight
+    // may have read the old values, so the generation bump discards them
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    ++prefetch_generation_;
+    for (const auto& addr : layer.destructed) {
+        auto it = prefetched_.lower_bound(std::make_pair(addr, uint256_t{}));
+        while (it != prefetched_.end() && it->first.first == addr) {
+            it = prefetched_.erase(it);
+        }
+    }
+    for (const auto& entry : layer.storage) {
+        prefetched_.erase(entry.first);
+    }
+    return true;
+}
+
+}  // namespace evm
+}  // namespace parthenon
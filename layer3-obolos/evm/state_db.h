@@ -0,0 +1,150 @@
+// ParthenonChain - EVM State Database
+// LevelDB-backed trie node store and flat account/storage snapshot
+
+#pragma once
+
+#include "mpt.h"
+#include "state.h"
+
+#include <leveldb/db.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * StateDatabase persists Obolos world state in LevelDB
+ *
+ * Storage layout:
+ * - "n{node_hash}" -> encoded trie node (account and storage tries)
+ * - "a{H(address)}" -> flat account record (tombstone once deleted)
+ * - "s{H(address)}{incarnation}{H(slot)}" -> 32-byte slot value
+ * - "c{code_hash}" -> contract bytecode
+ * - "meta:head" -> block number and state root of the flat snapshot
+ *
+ * H is Keccak-256, as in Ethereum snapshots. The flat entries answer
+ * GetAccount/GetStorage with a single read instead of a trie walk. Deleting an account bumps its incarnation,
+ * which orphans all of its old slots without a range delete.
+ */
+class StateDatabase : public TrieNodeStore {
+  public:
+    using Hash = std::array<uint8_t, 32>;
+
+    struct Head {
+        uint64_t block_number = 0;
+        Hash state_root{};
+    };
+
+    StateDatabase() = default;
+    ~StateDatabase() override;
+
+    /**
+     * Open state database
+     * @param db_path Path to LevelDB database directory
+     * @return true if opened successfully
+     */
+    bool Open(const std::string& db_path);
+
+    /**
+     * Close the database
+     */
+    void Close();
+
+    /**
+     * Check if database is open
+     */
+    bool IsOpen() const { return db_ != nullptr; }
+
+    /**
+     * Block and state root the flat snapshot corresponds to, if any
+     */
+    std::optional<Head> GetHead() const;
+
+    /**
+     * Read an account from the flat snapshot (code resolved via CodeCache)
+     */
+    std::optional<AccountState> GetAccount(const Address& addr) const;
+
+    /**
+     * Read a storage slot from the flat snapshot (zero if unset)
+     */
+    uint256_t GetStorage(const Address& addr, const uint256_t& key) const;
+
+    /**
+     * Read a storage slot ahead of execution into the prefetch cache, so that
+     * the next GetStorage() of it does not go to disk. Safe to call from any
+     * thread while others read; entries are dropped when WriteLayer() changes
+     * the slot, and the whole cache is cleared when it reaches capacity.
+     * @return true if the slot was read from disk
+     */
+    bool PrefetchStorage(const Address& addr, const uint256_t& key);
+
+    struct PrefetchStats {
+        size_t entries = 0;
+        uint64_t hits = 0;    // GetStorage() answered from the prefetch cache
+        uint64_t misses = 0;  // GetStorage() that went to disk
+    };
+
+    PrefetchStats GetPrefetchStats() const;
+
+    /**
+     * Maximum number of prefetched slots held (default 1M)
+     */
+    void SetPrefetchCapacity(size_t max_entries);
+
+    /**
+     * TrieNodeStore: read a committed trie node
+     */
+    std::optional<std::vector<uint8_t>> GetNode(const Hash& hash) const override;
+
+    /**
+     * Persist trie nodes produced by MerklePatriciaTrie::Commit
+     */
+    bool WriteNodes(const std::vector<std::pair<Hash, std::vector<uint8_t>>>& nodes);
+
+    /**
+     * Apply one block's state changes to the flat snapshot atomically and
+     * advance the head to (layer.block_number, layer.state_root)
+     */
+    bool WriteLayer(const StateDiffLayer& layer);
+
+  private:
+    struct AccountRecord {
+        bool exists = false;
+        uint32_t incarnation = 0;
+        AccountState account;
+    };
+
+    std::optional<AccountRecord> ReadRecord(const Address& addr) const;
+    uint256_t ReadStorage(const Address& addr, const uint256_t& key) const;
+    uint32_t GetIncarnation(const Address& addr) const;
+
+    static std::string AccountKey(const Address& addr);
+    static std::string StorageKey(const Address& addr, uint32_t incarnation, const uint256_t& key);
+    static std::string EncodeRecord(const AccountRecord& record);
+    static std::optional<AccountRecord> DecodeRecord(const std::string& data);
+
+    std::unique_ptr<leveldb::DB> db_;
+
+    // Incarnations of accounts read so far; avoids a record read per SLOAD
+    mutable std::mutex incarnation_mutex_;
+    mutable std::map<Address, uint32_t> incarnations_;
+
+    // Slots read ahead by PrefetchStorage(). The generation advances on every
+    // WriteLayer() so a load that raced with a write is not cached.
+    mutable std::mutex prefetch_mutex_;
+    std::map<std::pair<Address, uint256_t>, uint256_t> prefetched_;
+    size_t prefetch_capacity_ = 1 << 20;
+    uint64_t prefetch_generation_ = 0;
+    mutable uint64_t prefetch_hits_ = 0;
+    mutable uint64_t prefetch_misses_ = 0;
+};
+
+}  // namespace evm
+}  // namespace parthenon
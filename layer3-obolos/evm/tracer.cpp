@@ -0,0 +1,256 @@
+// ParthenonChain - EVM Execution Tracing Implementation
+
+#include "tracer.h"
+
+#include "opcodes.h"
+#include "vm.h"
+
+namespace parthenon {
+namespace evm {
+
+namespace {
+
+const char* kHexDigits = "0123456789abcdef";
+
+void AppendHex(std::string& out, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        out.push_back(kHexDigits[data[i] >> 4]);
+        out.push_back(kHexDigits[data[i] & 0xF]);
+    }
+}
+
+// 0x-prefixed, no leading zeros ("0x0" for zero)
+void AppendQuantity(std::string& out, const uint256_t& value) {
+    out += "0x";
+    size_t nibble = 0;
+    while (nibble < 63 && ((value[nibble / 2] >> (nibble % 2 == 0 ? 4 : 0)) & 0xF) == 0) {
+        ++nibble;
+    }
+    for (; nibble < 64; ++nibble) {
+        out.push_back(kHexDigits[(value[nibble / 2] >> (nibble % 2 == 0 ? 4 : 0)) & 0xF]);
+    }
+}
+
+void AppendQuantity(std::string& out, uint64_t value) {
+    AppendQuantity(out, Word(value).ToBytes());
+}
+
+void AppendData(std::string& out, const std::vector<uint8_t>& data) {
+    out += "\"0x";
+    AppendHex(out, data.data(), data.size());
+    out.push_back('"');
+}
+
+void AppendAddress(std::string& out, const Address& addr) {
+    out += "\"0x";
+    AppendHex(out, addr.data(), addr.size());
+    out.push_back('"');
+}
+
+bool Failed(ExecResult result) {
+    return result != ExecResult::SUCCESS && result != ExecResult::RETURNED;
+}
+
+}  // namespace
+
+void StreamingTracer::Flush() {
+    if (!buffer_.empty()) {
+        sink_(buffer_);
+        buffer_.clear();
+    }
+}
+
+StructLogger::StructLogger(TraceSink sink, Options options)
+    : StreamingTracer(std::move(sink)), options_(options) {}
+
+void StructLogger::OnEnter(const TraceFrame& frame) {
+    if (open_frames_++ > 0) {
+        return;
+    }
+    frame_gas_ = frame.gas;
+    first_step_ = true;
+    has_pending_ = false;
+    storage_.clear();
+    Out() += "{\"structLogs\":[";
+}
+
+void StructLogger::OnStep(const TraceStep& step) {
+    if (has_pending_) {
+        FinishPending(step.gas, nullptr);
+    }
+
+    pending_head_ = "{\"pc\":" + std::to_string(step.pc) + ",\"op\":\"" +
+                    GetOpcodeName(step.opcode) + "\",\"gas\":" + std::to_string(step.gas) +
+                    ",\"gasCost\":";
+    pending_tail_ = ",\"depth\":" + std::to_string(step.depth + 1);
+
+    if (!options_.disable_stack) {
+        pending_tail_ += ",\"stack\":[";
+        for (size_t i = 0; i < step.stack_size; ++i) {
+            if (i > 0) {
+                pending_tail_.push_back(',');
+            }
+            pending_tail_.push_back('"');
+            AppendQuantity(pending_tail_, step.stack[i].ToBytes());
+            pending_tail_.push_back('"');
+        }
+        pending_tail_.push_back(']');
+    }
+
+    if (options_.enable_memory) {
+        pending_tail_ += ",\"memory\":[";
+        for (size_t offset = 0; offset < step.memory_size; offset += 32) {
+            if (offset > 0) {
+                pending_tail_.push_back(',');
+            }
+            pending_tail_.push_back('"');
+            AppendHex(pending_tail_, step.memory + offset, 32);
+            pending_tail_.push_back('"');
+        }
+        pending_tail_.push_back(']');
+    }
+
+    const Opcode op = static_cast<Opcode>(step.opcode);
+    if (!options_.disable_storage && step.stack_size >= 1 &&
+        (op == Opcode::SLOAD || (op == Opcode::SSTORE && step.stack_size >= 2))) {
+        auto& slots = storage_[step.address];
+        const uint256_t key = step.stack[step.stack_size - 1].ToBytes();
+        slots[key] = op == Opcode::SLOAD ? step.state.GetStorage(step.address, key)
+                                         : step.stack[step.stack_size - 2].ToBytes();
+        pending_tail_ += ",\"storage\":{";
+        bool first = true;
+        for (const auto& [slot, value] : slots) {
+            pending_tail_ += first ? "\"" : ",\"";
+            first = false;
+            AppendHex(pending_tail_, slot.data(), slot.size());
+            pending_tail_ += "\":\"";
+            AppendHex(pending_tail_, value.data(), value.size());
+            pending_tail_.push_back('"');
+        }
+        pending_tail_.push_back('}');
+    }
+
+    has_pending_ = true;
+    pending_pc_ = step.pc;
+    pending_gas_ = step.gas;
+}
+
+void StructLogger::OnFault(const TraceStep& step, ExecResult error) {
+    // A block that fails its gas or stack check faults before its first
+    // instruction was reported
+    if (!has_pending_ || pending_pc_ != step.pc) {
+        OnStep(step);
+    }
+    FinishPending(0, GetResultMessage(error));
+}
+
+void StructLogger::OnExit(const TraceExit& exit) {
+    if (--open_frames_ > 0) {
+        return;
+    }
+    if (has_pending_) {
+        FinishPending(frame_gas_ - exit.gas_used, nullptr);
+    }
+    std::string& out = Out();
+    out += "],\"gas\":" + std::to_string(exit.gas_used) +
+           ",\"failed\":" + (Failed(exit.result) ? "true" : "false") + ",\"returnValue\":\"";
+    AppendHex(out, exit.output.data(), exit.output.size());
+    out += "\"}";
+    Flush();
+}
+
+void StructLogger::FinishPending(uint64_t gas_after, const char* error) {
+    std::string& out = Out();
+    if (!first_step_) {
+        out.push_back(',');
+    }
+    first_step_ = false;
+    out += pending_head_;
+    out += std::to_string(pending_gas_ > gas_after ? pending_gas_ - gas_after : 0);
+    out += pending_tail_;
+    if (error != nullptr) {
+        out += ",\"error\":\"";
+        out += error;
+        out.push_back('"');
+    }
+    out.push_back('}');
+    has_pending_ = false;
+    MaybeFlush();
+}
+
+void CallTracer::OnEnter(const TraceFrame& frame) {
+    std::string& out = Out();
+    if (!child_counts_.empty()) {
+        out += child_counts_.back()++ == 0 ? ",\"calls\":[" : ",";
+    }
+    child_counts_.push_back(0);
+
+    out += frame.is_static ? "{\"type\":\"STATICCALL\",\"from\":" : "{\"type\":\"CALL\",\"from\":";
+    AppendAddress(out, frame.from);
+    out += ",\"to\":";
+    AppendAddress(out, frame.to);
+    out += ",\"value\":\"";
+    AppendQuantity(out, frame.value);
+    out += "\",\"gas\":\"";
+    AppendQuantity(out, frame.gas);
+    out += "\",\"input\":";
+    AppendData(out, frame.input);
+    MaybeFlush();
+}
+
+void CallTracer::OnExit(const TraceExit& exit) {
+    std::string& out = Out();
+    if (child_counts_.back() > 0) {
+        out.push_back(']');
+    }
+    child_counts_.pop_back();
+
+    out += ",\"gasUsed\":\"";
+    AppendQuantity(out, exit.gas_used);
+    out += "\",\"output\":";
+    AppendData(out, exit.output);
+    if (Failed(exit.result)) {
+        out += ",\"error\":\"";
+        out += GetResultMessage(exit.result);
+        out.push_back('"');
+    }
+    out.push_back('}');
+
+    if (child_counts_.empty()) {
+        Flush();
+    } else {
+        MaybeFlush();
+    }
+}
+
+void FourByteTracer::OnEnter(const TraceFrame& frame) {
+    ++open_frames_;
+    if (frame.input.size() < 4) {
+        return;
+    }
+    std::string key = "0x";
+    AppendHex(key, frame.input.data(), 4);
+    key += "-" + std::to_string(frame.input.size() - 4);
+    ++counts_[key];
+}
+
+void FourByteTracer::OnExit(const TraceExit& exit) {
+    (void)exit;
+    if (--open_frames_ > 0) {
+        return;
+    }
+    std::string& out = Out();
+    out.push_back('{');
+    bool first = true;
+    for (const auto& [key, count] : counts_) {
+        out += first ? "\"" : ",\"";
+        first = false;
+        out += key + "\":" + std::to_string(count);
+    }
+    out.push_back('}');
+    counts_.clear();
+    Flush();
+}
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,204 @@
+// ParthenonChain - EVM Execution Tracing
+// Hooks observed by the interpreter, and tracers that stream JSON
+
+#pragma once
+
+#include "state.h"
+#include "uint256.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace parthenon {
+namespace evm {
+
+enum class ExecResult;
+
+/**
+ * A call frame being entered
+ */
+struct TraceFrame {
+    uint32_t depth;
+    const Address& from;
+    const Address& to;
+    const uint256_t& value;
+    const std::vector<uint8_t>& input;
+    uint64_t gas;
+    bool is_static;
+};
+
+/**
+ * Interpreter state just before an instruction executes. Only valid for
+ * the duration of the callback; nothing is copied.
+ */
+struct TraceStep {
+    uint64_t pc;
+    uint8_t opcode;
+    uint64_t gas;    // Remaining before the instruction
+    uint32_t depth;  // 0 for the outermost frame
+    const Address& address;
+    const Word* stack;  // Bottom first
+    size_t stack_size;
+    const uint8_t* memory;
+    size_t memory_size;
+    const StateAccess& state;
+};
+
+/**
+ * A call frame returning
+ */
+struct TraceExit {
+    uint32_t depth;
+    ExecResult result;
+    uint64_t gas_used;
+    const std::vector<uint8_t>& output;
+};
+
+/**
+ * Execution observer
+ *
+ * Pass one to VM::Execute() to trace that execution. The interpreter is
+ * compiled separately for tracing (see NullTracer), so untraced execution
+ * pays nothing for these hooks. Steps are reported per instruction with
+ * exact gas, although the VM charges static gas per basic block; a block
+ * that cannot be paid for or would underflow the stack faults at its first
+ * instruction.
+ */
+class Tracer {
+  public:
+    static constexpr bool kEnabled = true;
+
+    virtual ~Tracer() = default;
+
+    virtual void OnEnter(const TraceFrame& frame) { (void)frame; }
+    virtual void OnStep(const TraceStep& step) { (void)step; }
+
+    /**
+     * Exceptional halt (not REVERT) at the instruction described by step
+     */
+    virtual void OnFault(const TraceStep& step, ExecResult error) {
+        (void)step;
+        (void)error;
+    }
+
+    virtual void OnExit(const TraceExit& exit) { (void)exit; }
+};
+
+/**
+ * Interpreter policy for untraced execution: every hook compiles away
+ */
+struct NullTracer {
+    static constexpr bool kEnabled = false;
+};
+
+/**
+ * Receives JSON output in chunks, in order
+ */
+using TraceSink = std::function<void(const std::string& chunk)>;
+
+/**
+ * Base for tracers that write JSON to a sink as they go, so the memory a
+ * trace needs does not grow with its length
+ */
+class StreamingTracer : public Tracer {
+  protected:
+    static constexpr size_t kFlushBytes = 64 * 1024;
+
+    explicit StreamingTracer(TraceSink sink) : sink_(std::move(sink)) {}
+
+    std::string& Out() { return buffer_; }
+
+    // Hand buffered output to the sink once enough has accumulated
+    void MaybeFlush() {
+        if (buffer_.size() >= kFlushBytes) {
+            Flush();
+        }
+    }
+
+    void Flush();
+
+  private:
+    TraceSink sink_;
+    std::string buffer_;
+};
+
+/**
+ * Opcode-level trace in the geth struct logger format:
+ * {"structLogs":[{"pc","op","gas","gasCost","depth","stack","memory",
+ *  "storage","error"}...],"gas","failed","returnValue"}
+ *
+ * Storage lists the slots read or written so far by the executing contract
+ * and is only included on SLOAD and SSTORE steps.
+ */
+class StructLogger : public StreamingTracer {
+  public:
+    struct Options {
+        bool disable_stack = false;
+        bool enable_memory = false;
+        bool disable_storage = false;
+    };
+
+    explicit StructLogger(TraceSink sink) : StructLogger(std::move(sink), Options{}) {}
+    StructLogger(TraceSink sink, Options options);
+
+    void OnEnter(const TraceFrame& frame) override;
+    void OnStep(const TraceStep& step) override;
+    void OnFault(const TraceStep& step, ExecResult error) override;
+    void OnExit(const TraceExit& exit) override;
+
+  private:
+    // Each step is written once the next one shows what it cost
+    void FinishPending(uint64_t gas_after, const char* error);
+
+    Options options_;
+    uint32_t open_frames_ = 0;
+    uint64_t frame_gas_ = 0;
+    bool first_step_ = true;
+
+    bool has_pending_ = false;
+    uint64_t pending_pc_ = 0;
+    uint64_t pending_gas_ = 0;
+    std::string pending_head_;  // Up to "gasCost":
+    std::string pending_tail_;  // From "depth" on, without the closing brace
+
+    std::map<Address, std::map<uint256_t, uint256_t>> storage_;
+};
+
+/**
+ * Call tree in the geth call tracer format: nested
+ * {"type","from","to","value","gas","input","calls","gasUsed","output","error"}
+ * objects, each written as its frame enters and exits
+ */
+class CallTracer : public StreamingTracer {
+  public:
+    explicit CallTracer(TraceSink sink) : StreamingTracer(std::move(sink)) {}
+
+    void OnEnter(const TraceFrame& frame) override;
+    void OnExit(const TraceExit& exit) override;
+
+  private:
+    std::vector<size_t> child_counts_;  // Per open frame
+};
+
+/**
+ * Count of calls by 4-byte selector and argument size, written as
+ * {"0xa9059cbb-64": 1, ...} when the outermost frame exits
+ */
+class FourByteTracer : public StreamingTracer {
+  public:
+    explicit FourByteTracer(TraceSink sink) : StreamingTracer(std::move(sink)) {}
+
+    void OnEnter(const TraceFrame& frame) override;
+    void OnExit(const TraceExit& exit) override;
+
+  private:
+    uint32_t open_frames_ = 0;
+    std::map<std::string, uint64_t> counts_;
+};
+
+}  // namespace evm
+}  // namespace parthenon
@@ -0,0 +1,608 @@
+// ParthenonChain - EVM 256-bit Word Arithmetic
+// Native 4x64-bit limb integers for the interpreter hot path
+
+#pragma once
+
+#include "state.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace parthenon {
+namespace evm {
+
+/**
+ * 256-bit EVM machine word
+ *
+ * Stored as four 64-bit limbs, least significant first, so arithmetic maps
+ * onto native add-with-carry and 64x64->128 multiplies. uint256_t (32
+ * big-endian bytes) remains the format for storage, RLP and state roots;
+ * convert with FromBytes()/ToBytes() at those boundaries only.
+ *
+ * All operations wrap modulo 2^256 as the EVM requires and are constexpr.
+ */
+struct Word {
+    uint64_t limbs[4] = {0, 0, 0, 0};
+
+    constexpr Word() = default;
+    constexpr Word(uint64_t value) : limbs{value, 0, 0, 0} {}  // NOLINT: implicit by design
+    constexpr Word(uint64_t l0, uint64_t l1, uint64_t l2, uint64_t l3) : limbs{l0, l1, l2, l3} {}
+
+    /**
+     * Decode 32 big-endian bytes
+     */
+    static constexpr Word FromBytes(const uint256_t& bytes) {
+        Word result;
+        for (size_t i = 0; i < 32; ++i) {
+            result.limbs[3 - i / 8] |= static_cast<uint64_t>(bytes[i]) << (56 - 8 * (i % 8));
+        }
+        return result;
+    }
+
+    /**
+     * Decode up to 32 big-endian bytes (e.g. PUSH immediates)
+     */
+    static constexpr Word FromBytes(const uint8_t* data, size_t size) {
+        Word result;
+        for (size_t i = 0; i < size && i < 32; ++i) {
+            const size_t bit = 8 * (size - 1 - i);
+            result.limbs[bit / 64] |= static_cast<uint64_t>(data[i]) << (bit % 64);
+        }
+        return result;
+    }
+
+    /**
+     * Encode as 32 big-endian bytes
+     */
+    constexpr uint256_t ToBytes() const {
+        uint256_t bytes{};
+        for (size_t i = 0; i < 32; ++i) {
+            bytes[i] = static_cast<uint8_t>(limbs[3 - i / 8] >> (56 - 8 * (i % 8)));
+        }
+        return bytes;
+    }
+
+    /**
+     * Low 64 bits (truncating)
+     */
+    constexpr uint64_t ToUint64() const { return limbs[0]; }
+
+    /**
+     * True if the value is < 2^64
+     */
+    constexpr bool FitsUint64() const { return (limbs[1] | limbs[2] | limbs[3]) == 0; }
+
+    constexpr bool IsZero() const { return (limbs[0] | limbs[1] | limbs[2] | limbs[3]) == 0; }
+
+    constexpr bool IsNegative() const { return (limbs[3] >> 63) != 0; }
+};
+
+// ---------------------------------------------------------------------------
+// Limb primitives
+// ---------------------------------------------------------------------------
+
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128;  // Quiet -Wpedantic in strict targets
+#endif
+
+constexpr uint64_t AddCarry(uint64_t a, uint64_t b, uint64_t& carry) {
+    const uint64_t s = a + b;
+    const uint64_t c1 = s < a;
+    const uint64_t r = s + carry;
+    carry = c1 | (r < s);
+    return r;
+}
+
+constexpr uint64_t SubBorrow(uint64_t a, uint64_t b, uint64_t& borrow) {
+    const uint64_t d = a - b;
+    const uint64_t b1 = a < b;
+    const uint64_t r = d - borrow;
+    borrow = b1 | (d < borrow);
+    return r;
+}
+
+// 64x64 -> 128 multiply, returns low half and stores the high half
+constexpr uint64_t MulWide(uint64_t a, uint64_t b, uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+    const uint128 p = static_cast<uint128>(a) * b;
+    hi = static_cast<uint64_t>(p >> 64);
+    return static_cast<uint64_t>(p);
+#else
+    const uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    const uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    const uint64_t ll = a_lo * b_lo;
+    const uint64_t lh = a_lo * b_hi;
+    const uint64_t hl = a_hi * b_lo;
+    const uint64_t hh = a_hi * b_hi;
+    const uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    return (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+}
+
+constexpr unsigned CountLeadingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return x == 0 ? 64 : static_cast<unsigned>(__builtin_clzll(x));
+#else
+    unsigned n = 0;
+    if (x == 0) {
+        return 64;
+    }
+    while ((x & (uint64_t{1} << 63)) == 0) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Number of significant limbs in a little-endian limb array
+constexpr int SignificantLimbs(const uint64_t* x, int n) {
+    while (n > 0 && x[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+/**
+ * Unsigned division of an m-limb dividend by an n-limb divisor (n <= m <= 8,
+ * v[n-1] != 0). Writes m - n + 1 quotient limbs and n remainder limbs.
+ *
+ * Knuth, TAOCP vol. 2, 4.3.1 Algorithm D with 64-bit digits when 128-bit
+ * integers are available; shift-subtract otherwise.
+ */
+constexpr void DivModLimbs(const uint64_t* u, int m, const uint64_t* v, int n, uint64_t* q,
+                           uint64_t* r) {
+    for (int i = 0; i <= m - n; ++i) {
+        q[i] = 0;
+    }
+#if defined(__SIZEOF_INT128__)
+    using u128 = uint128;
+    if (n == 1) {
+        uint64_t rem = 0;
+        for (int i = m - 1; i >= 0; --i) {
+            const u128 cur = (static_cast<u128>(rem) << 64) | u[i];
+            q[i] = static_cast<uint64_t>(cur / v[0]);
+            rem = static_cast<uint64_t>(cur % v[0]);
+        }
+        r[0] = rem;
+        return;
+    }
+
+    // D1: normalize so the divisor's top bit is set
+    const unsigned s = CountLeadingZeros(v[n - 1]);
+    uint64_t vn[8] = {};
+    uint64_t un[9] = {};
+    for (int i = n - 1; i > 0; --i) {
+        vn[i] = (v[i] << s) | (s ? v[i - 1] >> (64 - s) : 0);
+    }
+    vn[0] = v[0] << s;
+    un[m] = s ? u[m - 1] >> (64 - s) : 0;
+    for (int i = m - 1; i > 0; --i) {
+        un[i] = (u[i] << s) | (s ? u[i - 1] >> (64 - s) : 0);
+    }
+    un[0] = u[0] << s;
+
+    for (int j = m - n; j >= 0; --j) {
+        // D3: estimate the quotient digit from the top two dividend limbs
+        const u128 num = (static_cast<u128>(un[j + n]) << 64) | un[j + n - 1];
+        u128 qhat = num / vn[n - 1];
+        u128 rhat = num % vn[n - 1];
+        while (qhat >> 64 || qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+            --qhat;
+            rhat += vn[n - 1];
+            if (rhat >> 64) {
+                break;
+            }
+        }
+
+        // D4: multiply and subtract
+        uint64_t borrow = 0;
+        uint64_t carry = 0;
+        for (int i = 0; i < n; ++i) {
+            const u128 p = qhat * vn[i] + carry;
+            carry = static_cast<uint64_t>(p >> 64);
+            un[i + j] = SubBorrow(un[i + j], static_cast<uint64_t>(p), borrow);
+        }
+        un[j + n] = SubBorrow(un[j + n], carry, borrow);
+
+        // D6: add back if the estimate was one too large
+        if (borrow) {
+            --qhat;
+            uint64_t c = 0;
+            for (int i = 0; i < n; ++i) {
+                un[i + j] = AddCarry(un[i + j], vn[i], c);
+            }
+            un[j + n] += c;
+        }
+        q[j] = static_cast<uint64_t>(qhat);
+    }
+
+    // D8: unnormalize the remainder
+    for (int i = 0; i < n - 1; ++i) {
+        r[i] = (un[i] >> s) | (s ? un[i + 1] << (64 - s) : 0);
+    }
+    r[n - 1] = un[n - 1] >> s;
+#else
+    uint64_t rem[9] = {};
+    for (int bit = m * 64 - 1; bit >= 0; --bit) {
+        // rem = (rem << 1) | bit
+        for (int i = n; i > 0; --i) {
+            rem[i] = (rem[i] << 1) | (rem[i - 1] >> 63);
+        }
+        rem[0] = (rem[0] << 1) | ((u[bit / 64] >> (bit % 64)) & 1);
+
+        // rem >= v ?
+        bool ge = rem[n] != 0;
+        if (!ge) {
+            ge = true;
+            for (int i = n - 1; i >= 0; --i) {
+                if (rem[i] != v[i]) {
+                    ge = rem[i] > v[i];
+                    break;
+                }
+            }
+        }
+        if (ge) {
+            uint64_t borrow = 0;
+            for (int i = 0; i < n; ++i) {
+                rem[i] = SubBorrow(rem[i], v[i], borrow);
+            }
+            rem[n] -= borrow;
+            q[bit / 64] |= uint64_t{1} << (bit % 64);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        r[i] = rem[i];
+    }
+#endif
+}
+
+}  // namespace detail
+
+// ---------------------------------------------------------------------------
+// Comparison
+// ---------------------------------------------------------------------------
+
+constexpr bool operator==(const Word& a, const Word& b) {
+    return ((a.limbs[0] ^ b.limbs[0]) | (a.limbs[1] ^ b.limbs[1]) | (a.limbs[2] ^ b.limbs[2]) |
+            (a.limbs[3] ^ b.limbs[3])) == 0;
+}
+
+constexpr bool operator!=(const Word& a, const Word& b) {
+    return !(a == b);
+}
+
+constexpr bool operator<(const Word& a, const Word& b) {
+    // Borrow out of a - b
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        detail::SubBorrow(a.limbs[i], b.limbs[i], borrow);
+    }
+    return borrow != 0;
+}
+
+constexpr bool operator>(const Word& a, const Word& b) {
+    return b < a;
+}
+
+constexpr bool operator<=(const Word& a, const Word& b) {
+    return !(b < a);
+}
+
+constexpr bool operator>=(const Word& a, const Word& b) {
+    return !(a < b);
+}
+
+/**
+ * Signed (two's complement) less-than
+ */
+constexpr bool SignedLess(const Word& a, const Word& b) {
+    const bool a_neg = a.IsNegative();
+    const bool b_neg = b.IsNegative();
+    return a_neg != b_neg ? a_neg : a < b;
+}
+
+// ---------------------------------------------------------------------------
+// Bitwise
+// ---------------------------------------------------------------------------
+
+constexpr Word operator&(const Word& a, const Word& b) {
+    return Word(a.limbs[0] & b.limbs[0], a.limbs[1] & b.limbs[1], a.limbs[2] & b.limbs[2],
+                a.limbs[3] & b.limbs[3]);
+}
+
+constexpr Word operator|(const Word& a, const Word& b) {
+    return Word(a.limbs[0] | b.limbs[0], a.limbs[1] | b.limbs[1], a.limbs[2] | b.limbs[2],
+                a.limbs[3] | b.limbs[3]);
+}
+
+constexpr Word operator^(const Word& a, const Word& b) {
+    return Word(a.limbs[0] ^ b.limbs[0], a.limbs[1] ^ b.limbs[1], a.limbs[2] ^ b.limbs[2],
+                a.limbs[3] ^ b.limbs[3]);
+}
+
+constexpr Word operator~(const Word& a) {
+    return Word(~a.limbs[0], ~a.limbs[1], ~a.limbs[2], ~a.limbs[3]);
+}
+
+constexpr Word operator<<(const Word& a, uint64_t shift) {
+    if (shift >= 256) {
+        return Word();
+    }
+    Word result;
+    const unsigned limb_shift = static_cast<unsigned>(shift / 64);
+    const unsigned bit_shift = static_cast<unsigned>(shift % 64);
+    for (int i = 3; i >= static_cast<int>(limb_shift); --i) {
+        const int src = i - static_cast<int>(limb_shift);
+        uint64_t v = a.limbs[src] << bit_shift;
+        if (bit_shift && src > 0) {
+            v |= a.limbs[src - 1] >> (64 - bit_shift);
+        }
+        result.limbs[i] = v;
+    }
+    return result;
+}
+
+constexpr Word operator>>(const Word& a, uint64_t shift) {
+    if (shift >= 256) {
+        return Word();
+    }
+    Word result;
+    const unsigned limb_shift = static_cast<unsigned>(shift / 64);
+    const unsigned bit_shift = static_cast<unsigned>(shift % 64);
+    for (int i = 0; i + static_cast<int>(limb_shift) < 4; ++i) {
+        const int src = i + static_cast<int>(limb_shift);
+        uint64_t v = a.limbs[src] >> bit_shift;
+        if (bit_shift && src < 3) {
+            v |= a.limbs[src + 1] << (64 - bit_shift);
+        }
+        result.limbs[i] = v;
+    }
+    return result;
+}
+
+/**
+ * Shift amount operand of SHL/SHR/SAR: anything >= 256 saturates
+ */
+constexpr uint64_t ShiftAmount(const Word& shift) {
+    return shift.FitsUint64() && shift.limbs[0] < 256 ? shift.limbs[0] : 256;
+}
+
+/**
+ * Arithmetic (sign-filling) right shift
+ */
+constexpr Word Sar(const Word& a, uint64_t shift) {
+    if (!a.IsNegative()) {
+        return a >> shift;
+    }
+    if (shift >= 256) {
+        return ~Word();
+    }
+    return ~((~a) >> shift);
+}
+
+/**
+ * BYTE: i-th byte counting from the most significant end
+ */
+constexpr Word Byte(const Word& index, const Word& value) {
+    if (!index.FitsUint64() || index.limbs[0] >= 32) {
+        return Word();
+    }
+    const uint64_t bit = 8 * (31 - index.limbs[0]);
+    return Word((value.limbs[bit / 64] >> (bit % 64)) & 0xFF);
+}
+
+/**
+ * SIGNEXTEND: extend the sign of the (b+1)-byte value x
+ */
+constexpr Word SignExtend(const Word& b, const Word& x) {
+    if (!b.FitsUint64() || b.limbs[0] >= 31) {
+        return x;
+    }
+    const uint64_t sign_bit = 8 * b.limbs[0] + 7;
+    const Word mask = ~(~Word() << (sign_bit + 1));
+    const bool negative = ((x >> sign_bit).limbs[0] & 1) != 0;
+    return negative ? (x | ~mask) : (x & mask);
+}
+
+// ---------------------------------------------------------------------------
+// Arithmetic
+// ---------------------------------------------------------------------------
+
+constexpr Word operator+(const Word& a, const Word& b) {
+    Word result;
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        result.limbs[i] = detail::AddCarry(a.limbs[i], b.limbs[i], carry);
+    }
+    return result;
+}
+
+constexpr Word operator-(const Word& a, const Word& b) {
+    Word result;
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        result.limbs[i] = detail::SubBorrow(a.limbs[i], b.limbs[i], borrow);
+    }
+    return result;
+}
+
+constexpr Word operator-(const Word& a) {
+    return Word() - a;
+}
+
+constexpr Word operator*(const Word& a, const Word& b) {
+    // Schoolbook product truncated to the low four limbs
+    Word result;
+    for (int i = 0; i < 4; ++i) {
+        uint64_t carry = 0;
+        for (int j = 0; i + j < 4; ++j) {
+            uint64_t hi = 0;
+            const uint64_t lo = detail::MulWide(a.limbs[i], b.limbs[j], hi);
+            uint64_t c = 0;
+            uint64_t sum = detail::AddCarry(result.limbs[i + j], lo, c);
+            hi += c;
+            c = 0;
+            sum = detail::AddCarry(sum, carry, c);
+            result.limbs[i + j] = sum;
+            carry = hi + c;
+        }
+    }
+    return result;
+}
+
+/**
+ * Quotient and remainder of unsigned division
+ */
+struct DivResult {
+    Word quot;
+    Word rem;
+};
+
+/**
+ * Unsigned division; division by zero yields {0, 0} as the EVM requires
+ */
+constexpr DivResult DivMod(const Word& a, const Word& b) {
+    const int n = detail::SignificantLimbs(b.limbs, 4);
+    if (n == 0) {
+        return DivResult{};
+    }
+    if (a < b) {
+        return DivResult{Word(), a};
+    }
+    if (n == 1 && a.FitsUint64()) {
+        return DivResult{Word(a.limbs[0] / b.limbs[0]), Word(a.limbs[0] % b.limbs[0])};
+    }
+    const int m = detail::SignificantLimbs(a.limbs, 4);
+    DivResult result;
+    detail::DivModLimbs(a.limbs, m, b.limbs, n, result.quot.limbs, result.rem.limbs);
+    return result;
+}
+
+constexpr Word operator/(const Word& a, const Word& b) {
+    return DivMod(a, b).quot;
+}
+
+constexpr Word operator%(const Word& a, const Word& b) {
+    return DivMod(a, b).rem;
+}
+
+/**
+ * SDIV: signed division truncating toward zero (-2^255 / -1 = -2^255)
+ */
+constexpr Word SignedDiv(const Word& a, const Word& b) {
+    const bool a_neg = a.IsNegative();
+    const bool b_neg = b.IsNegative();
+    const Word q = (a_neg ? -a : a) / (b_neg ? -b : b);
+    return a_neg != b_neg ? -q : q;
+}
+
+/**
+ * SMOD: signed remainder taking the sign of the dividend
+ */
+constexpr Word SignedMod(const Word& a, const Word& b) {
+    const bool a_neg = a.IsNegative();
+    const Word r = (a_neg ? -a : a) % (b.IsNegative() ? -b : b);
+    return a_neg ? -r : r;
+}
+
+/**
+ * ADDMOD: (a + b) % m with the intermediate sum in 257 bits
+ */
+constexpr Word AddMod(const Word& a, const Word& b, const Word& m) {
+    if (m.IsZero()) {
+        return Word();
+    }
+    uint64_t sum[5] = {};
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        sum[i] = detail::AddCarry(a.limbs[i], b.limbs[i], carry);
+    }
+    sum[4] = carry;
+
+    const int n = detail::SignificantLimbs(m.limbs, 4);
+    const int len = detail::SignificantLimbs(sum, 5);
+    if (len < n) {
+        return Word(sum[0], sum[1], sum[2], sum[3]);
+    }
+    uint64_t q[5] = {};
+    Word r;
+    detail::DivModLimbs(sum, len, m.limbs, n, q, r.limbs);
+    return r;
+}
+
+/**
+ * MULMOD: (a * b) % m with the full 512-bit intermediate product
+ */
+constexpr Word MulMod(const Word& a, const Word& b, const Word& m) {
+    if (m.IsZero()) {
+        return Word();
+    }
+    uint64_t prod[8] = {};
+    for (int i = 0; i < 4; ++i) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 4; ++j) {
+            uint64_t hi = 0;
+            const uint64_t lo = detail::MulWide(a.limbs[i], b.limbs[j], hi);
+            uint64_t c = 0;
+            uint64_t sum = detail::AddCarry(prod[i + j], lo, c);
+            hi += c;
+            c = 0;
+            sum = detail::AddCarry(sum, carry, c);
+            prod[i + j] = sum;
+            carry = hi + c;
+        }
+        prod[i + 4] = carry;
+    }
+
+    const int n = detail::SignificantLimbs(m.limbs, 4);
+    const int len = detail::SignificantLimbs(prod, 8);
+    if (len < n) {
+        return Word(prod[0], prod[1], prod[2], prod[3]);
+    }
+    uint64_t q[8] = {};
+    Word r;
+    detail::DivModLimbs(prod, len, m.limbs, n, q, r.limbs);
+    return r;
+}
+
+/**
+ * EXP: base^exponent mod 2^256 by square-and-multiply
+ */
+constexpr Word Exp(Word base, const Word& exponent) {
+    Word result(1);
+    const int limbs = detail::SignificantLimbs(exponent.limbs, 4);
+    for (int limb = 0; limb < limbs; ++limb) {
+        uint64_t bits = exponent.limbs[limb];
+        for (int i = 0; i < 64; ++i) {
+            if (bits & 1) {
+                result = result * base;
+            }
+            bits >>= 1;
+            if (limb == limbs - 1 && bits == 0) {
+                return result;
+            }
+            base = base * base;
+        }
+    }
+    return result;
+}
+
+/**
+ * Number of significant bytes in the exponent (EXP dynamic gas)
+ */
+constexpr unsigned ByteLength(const Word& value) {
+    for (int i = 3; i >= 0; --i) {
+        if (value.limbs[i] != 0) {
+            return static_cast<unsigned>(i * 8) +
+                   (64 - detail::CountLeadingZeros(value.limbs[i]) + 7) / 8;
+        }
+    }
+    return 0;
+}
+
+}  // namespace evm
+}  // namespace parthenon
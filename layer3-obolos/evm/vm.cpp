@@ -2,754 +2,1039 @@
 
 #include "vm.h"
 
-#include "crypto/sha256.h"
+#include "aot.h"
+#include "precompiles.h"
+
+#include "crypto/keccak.h"
 
 #include <algorithm>
 #include <cstring>
-#include <stdexcept>
+#include <limits>
+
+// Threaded dispatch through a table of label addresses (GCC/Clang "labels as
+// values"). Other compilers, or -DPARTHENON_EVM_COMPUTED_GOTO=0, fall back to
+// a switch that jumps to the same handler labels.
+#ifndef PARTHENON_EVM_COMPUTED_GOTO
+#if defined(__GNUC__) || defined(__clang__)
+#define PARTHENON_EVM_COMPUTED_GOTO 1
+#else
+#define PARTHENON_EVM_COMPUTED_GOTO 0
+#endif
+#endif
 
 namespace parthenon {
 namespace evm {
 
-VM::VM(WorldState& state, const ExecutionContext& ctx) : state_(state), ctx_(ctx), gas_used_(0) {
-    stack_.reserve(MAX_STACK_SIZE);
-}
+namespace {
 
-void VM::Push(const uint256_t& value) {
-    if (stack_.size() >= MAX_STACK_SIZE) {
-        throw std::runtime_error("Stack overflow");
-    }
-    stack_.push_back(value);
+Word AddressToWord(const Address& address) {
+    return Word::FromBytes(address.data(), address.size());
 }
 
-uint256_t VM::Pop() {
-    if (stack_.empty()) {
-        throw std::runtime_error("Stack underflow");
-    }
-    uint256_t value = stack_.back();
-    stack_.pop_back();
-    return value;
+Address WordToAddress(const Word& value) {
+    const uint256_t bytes = value.ToBytes();
+    Address address;
+    std::memcpy(address.data(), bytes.data() + 12, address.size());
+    return address;
 }
 
-uint256_t VM::Peek(size_t depth) const {
-    if (depth >= stack_.size()) {
-        throw std::runtime_error("Stack underflow");
+// Copy size bytes of source starting at offset into dest, zero-filling past
+// the end of source (CALLDATALOAD / CALLDATACOPY / CODECOPY semantics)
+void CopyPadded(uint8_t* dest, const std::vector<uint8_t>& source, const Word& offset,
+                uint64_t size) {
+    uint64_t copied = 0;
+    if (offset.FitsUint64() && offset.ToUint64() < source.size()) {
+        const uint64_t start = offset.ToUint64();
+        copied = std::min<uint64_t>(size, source.size() - start);
+        std::memcpy(dest, source.data() + start, copied);
     }
-    return stack_[stack_.size() - 1 - depth];
+    std::memset(dest + copied, 0, size - copied);
 }
 
-void VM::Dup(uint8_t depth) {
-    if (depth == 0 || depth > stack_.size()) {
-        throw std::runtime_error("Invalid DUP depth");
+// EIP-2200 net gas metering for SSTORE (warm part; EIP-2929/3529 values)
+uint64_t SstoreGas(const uint256_t& original, const uint256_t& current, const uint256_t& value,
+                   int64_t& refund) {
+    const uint256_t zero{};
+    if (current == value) {
+        return WARM_STORAGE_READ_COST;  // No-op
     }
-    Push(Peek(depth - 1));
-}
-
-void VM::Swap(uint8_t depth) {
-    if (depth == 0 || depth >= stack_.size()) {
-        throw std::runtime_error("Invalid SWAP depth");
+    if (original == current) {
+        // First change to this slot in the transaction
+        if (original == zero) {
+            return SSTORE_SET_GAS;
+        }
+        if (value == zero) {
+            refund += SSTORE_CLEARS_SCHEDULE;
+        }
+        return SSTORE_RESET_GAS;
     }
-    size_t top_idx = stack_.size() - 1;
-    size_t swap_idx = stack_.size() - 1 - depth;
-    std::swap(stack_[top_idx], stack_[swap_idx]);
-}
 
-void VM::ExpandMemory(uint64_t size) {
-    if (size > memory_.size()) {
-        // Calculate gas cost for memory expansion
-        uint64_t old_words = (memory_.size() + 31) / 32;
-        uint64_t new_words = (size + 31) / 32;
-        uint64_t expansion_cost = (new_words - old_words) * 3;
-
-        if (!UseGas(expansion_cost)) {
-            throw std::runtime_error("Out of gas during memory expansion");
+    // Already dirty: undo or redo earlier refunds
+    if (original != zero) {
+        if (current == zero) {
+            refund -= SSTORE_CLEARS_SCHEDULE;
+        } else if (value == zero) {
+            refund += SSTORE_CLEARS_SCHEDULE;
         }
-
-        memory_.resize(size, 0);
     }
+    if (original == value) {
+        refund += static_cast<int64_t>(
+            (original == zero ? SSTORE_SET_GAS : SSTORE_RESET_GAS) - WARM_STORAGE_READ_COST);
+    }
+    return WARM_STORAGE_READ_COST;
 }
 
-void VM::MemoryStore(uint64_t offset, const uint256_t& value) {
-    ExpandMemory(offset + 32);
-    std::memcpy(&memory_[offset], value.data(), 32);
+// EIP-161: no balance, nonce or code
+bool IsEmptyAccount(const StateAccess& state, const Address& addr) {
+    return state.GetNonce(addr) == 0 && Word::FromBytes(state.GetBalance(addr)).IsZero() &&
+           state.GetCode(addr)->Empty();
 }
 
-void VM::MemoryStore8(uint64_t offset, uint8_t value) {
-    ExpandMemory(offset + 1);
-    memory_[offset] = value;
+}  // namespace
+
+const char* GetResultMessage(ExecResult result) {
+    switch (result) {
+        case ExecResult::SUCCESS:
+        case ExecResult::RETURNED:
+            return "ok";
+        case ExecResult::REVERT:
+            return "revert";
+        case ExecResult::OUT_OF_GAS:
+            return "out of gas";
+        case ExecResult::STACK_UNDERFLOW:
+            return "stack underflow";
+        case ExecResult::STACK_OVERFLOW:
+            return "stack overflow";
+        case ExecResult::INVALID_JUMP:
+            return "invalid jump";
+        case ExecResult::INVALID_OPCODE:
+            return "invalid opcode";
+        case ExecResult::STATIC_CALL_VIOLATION:
+            return "static call violation";
+        case ExecResult::RETURN_DATA_OUT_OF_BOUNDS:
+            return "return data out of bounds";
+        case ExecResult::DEPTH_EXCEEDED:
+            return "call depth exceeded";
+    }
+    return "error";
 }
 
-uint256_t VM::MemoryLoad(uint64_t offset) {
-    ExpandMemory(offset + 32);
-    uint256_t result;
-    std::memcpy(result.data(), &memory_[offset], 32);
-    return result;
+VM::VM(StateAccess& state, const ExecutionContext& ctx) : state_(state), ctx_(ctx), gas_used_(0) {
+    // EIP-2929: the sender and the called contract start warm
+    accessed_.AddAddress(ctx_.origin);
+    accessed_.AddAddress(ctx_.address);
+    accessed_.AddAccessList(ctx_.access_list);
 }
 
-bool VM::UseGas(uint64_t amount) {
-    if (gas_used_ + amount > ctx_.gas_limit) {
+bool VM::ExpandMemory(const Word& offset, const Word& size, int64_t& gas_left, uint64_t& start) {
+    start = 0;
+    if (size.IsZero()) {
+        return true;  // Zero-length accesses never expand memory
+    }
+    if (!offset.FitsUint64() || !size.FitsUint64() || offset.ToUint64() > MAX_MEMORY_SIZE ||
+        size.ToUint64() > MAX_MEMORY_SIZE) {
         return false;
     }
-    gas_used_ += amount;
+
+    start = offset.ToUint64();
+    const uint64_t end = start + size.ToUint64();
+    if (end > frame_->MemorySize()) {
+        const uint64_t old_words = frame_->MemorySize() / 32;
+        const uint64_t new_words = (end + 31) / 32;
+        gas_left -= static_cast<int64_t>((new_words - old_words) * 3);
+        if (gas_left < 0) {
+            return false;
+        }
+        frame_->GrowMemory(new_words * 32);
+    }
     return true;
 }
 
-uint64_t VM::GetGasRemaining() const {
-    return ctx_.gas_limit - gas_used_;
+Word VM::Environment(Handler handler, const std::vector<uint8_t>& code) const {
+    switch (handler) {
+        case Handler::ADDRESS:
+            return AddressToWord(ctx_.address);
+        case Handler::ORIGIN:
+            return AddressToWord(ctx_.origin);
+        case Handler::CALLER:
+            return AddressToWord(ctx_.caller);
+        case Handler::CALLVALUE:
+            return Word::FromBytes(ctx_.value);
+        case Handler::CALLDATASIZE:
+            return Word(ctx_.input_data.size());
+        case Handler::CODESIZE:
+            return Word(code.size());
+        case Handler::GASPRICE:
+            return Word(ctx_.gas_price);
+        case Handler::RETURNDATASIZE:
+            return Word(return_data_.size());
+        case Handler::COINBASE:
+            return AddressToWord(ctx_.coinbase);
+        case Handler::TIMESTAMP:
+            return Word(ctx_.timestamp);
+        case Handler::NUMBER:
+            return Word(ctx_.block_number);
+        case Handler::DIFFICULTY:
+            return Word(ctx_.difficulty);
+        case Handler::GASLIMIT:
+            return Word(ctx_.gas_limit_block);
+        case Handler::CHAINID:
+            return Word(ctx_.chain_id);
+        case Handler::SELFBALANCE:
+            return Word::FromBytes(state_.GetBalance(ctx_.address));
+        case Handler::BASEFEE:
+            return Word(ctx_.base_fee);
+        case Handler::MSIZE:
+            return Word(frame_->MemorySize());
+        default:
+            return Word();
+    }
 }
 
-// Arithmetic operations - Full 256-bit implementation
-// All operations use big-endian byte arrays for 256-bit integers
-// Implements proper carry/borrow propagation for EVM compatibility
-
-uint256_t VM::Add(const uint256_t& a, const uint256_t& b) const {
-    uint256_t result{};
-    uint16_t carry = 0;
-
-    // Process bytes from least significant (index 31) to most significant (index 0)
-    for (int i = 31; i >= 0; i--) {
-        uint16_t sum = static_cast<uint16_t>(a[i]) + static_cast<uint16_t>(b[i]) + carry;
-        result[i] = static_cast<uint8_t>(sum & 0xFF);
-        carry = sum >> 8;
+ExecResult VM::OpSha3(Word* sp, int64_t& gas_left) {
+    // Stack: offset, size
+    uint64_t start = 0;
+    if (!ExpandMemory(sp[-1], sp[-2], gas_left, start)) {
+        return ExecResult::OUT_OF_GAS;
     }
-
-    // Note: Overflow is allowed in EVM (wraps around modulo 2^256)
-    return result;
+    const uint64_t length = sp[-2].ToUint64();
+    gas_left -= static_cast<int64_t>((length + 31) / 32 * 6);  // Per word hashed
+    if (gas_left < 0) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    const auto hash = crypto::Keccak256::Hash256(memory_ + start, length);
+    sp[-2] = Word::FromBytes(hash.data(), hash.size());
+    return ExecResult::SUCCESS;
 }
 
-uint256_t VM::Sub(const uint256_t& a, const uint256_t& b) const {
-    uint256_t result{};
-    int16_t borrow = 0;
-
-    // Process bytes from least significant (index 31) to most significant (index 0)
-    for (int i = 31; i >= 0; i--) {
-        int16_t diff = static_cast<int16_t>(a[i]) - static_cast<int16_t>(b[i]) - borrow;
-        if (diff < 0) {
-            diff += 256;
-            borrow = 1;
-        } else {
-            borrow = 0;
+ExecResult VM::OpBalance(Word* sp, int64_t& gas_left) {
+    const Address addr = WordToAddress(sp[-1]);
+    // Precompiles are always warm (EIP-2929)
+    if (!IsPrecompile(addr) && accessed_.AddAddress(addr)) {
+        gas_left -= static_cast<int64_t>(COLD_ACCOUNT_ACCESS_COST - WARM_STORAGE_READ_COST);
+        if (gas_left < 0) {
+            return ExecResult::OUT_OF_GAS;
         }
-        result[i] = static_cast<uint8_t>(diff);
     }
-
-    // Note: Underflow wraps around modulo 2^256 (two's complement)
-    return result;
+    sp[-1] = Word::FromBytes(state_.GetBalance(addr));
+    return ExecResult::SUCCESS;
 }
 
-uint256_t VM::Mul(const uint256_t& a, const uint256_t& b) const {
-    // Use long multiplication algorithm for 256-bit values
-    uint256_t result{};
-
-    // For each byte in b (multiplier)
-    for (int i = 31; i >= 0; i--) {
-        if (b[i] == 0)
-            continue;
-
-        uint16_t carry = 0;
-        // Multiply each byte of a by b[i]
-        for (int j = 31; j >= 0; j--) {
-            int result_idx = j + (31 - i);
-            if (result_idx >= 32)
-                continue;  // Skip overflow
+void VM::OpCallDataLoad(Word* sp) const {
+    uint8_t buffer[32];
+    CopyPadded(buffer, ctx_.input_data, sp[-1], sizeof(buffer));
+    sp[-1] = Word::FromBytes(buffer, sizeof(buffer));
+}
 
-            uint32_t product = static_cast<uint32_t>(a[j]) * static_cast<uint32_t>(b[i]) +
-                               static_cast<uint32_t>(result[result_idx]) + carry;
-            result[result_idx] = static_cast<uint8_t>(product & 0xFF);
-            carry = static_cast<uint16_t>(product >> 8);
-        }
+ExecResult VM::OpCopy(Word* sp, int64_t& gas_left, const std::vector<uint8_t>& source) {
+    // Stack: destination offset, source offset, size
+    uint64_t start = 0;
+    if (!ExpandMemory(sp[-1], sp[-3], gas_left, start)) {
+        return ExecResult::OUT_OF_GAS;
     }
-
-    return result;
+    const uint64_t length = sp[-3].ToUint64();
+    gas_left -= static_cast<int64_t>((length + 31) / 32 * 3);  // Copy cost per word
+    if (gas_left < 0) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    if (length > 0) {
+        CopyPadded(memory_ + start, source, sp[-2], length);
+    }
+    return ExecResult::SUCCESS;
 }
 
-uint256_t VM::Div(const uint256_t& a, const uint256_t& b) const {
-    if (IsZero(b))
-        return uint256_t{};  // Division by zero returns 0 in EVM
-
-    // Use long division algorithm for 256-bit values
-    uint256_t quotient{};
-    uint256_t remainder{};
-
-    // Process bits from most significant to least significant
-    for (int i = 0; i < 256; i++) {
-        // Shift remainder left by 1
-        uint16_t carry = 0;
-        for (int j = 31; j >= 0; j--) {
-            uint16_t shifted = (static_cast<uint16_t>(remainder[j]) << 1) | carry;
-            remainder[j] = static_cast<uint8_t>(shifted & 0xFF);
-            carry = shifted >> 8;
-        }
-
-        // Add current bit of dividend to remainder
-        int byte_idx = i / 8;
-        int bit_idx = 7 - (i % 8);
-        if ((a[byte_idx] >> bit_idx) & 1) {
-            remainder[31] |= 1;
-        }
-
-        // Check if remainder >= divisor
-        bool ge = !Lt(remainder, b);
-        if (ge) {
-            // Subtract divisor from remainder
-            remainder = Sub(remainder, b);
-
-            // Set bit in quotient
-            int quot_byte = i / 8;
-            int quot_bit = 7 - (i % 8);
-            quotient[quot_byte] |= (1 << quot_bit);
-        }
+ExecResult VM::OpMload(Word* sp, int64_t& gas_left) {
+    uint64_t start = 0;
+    if (!ExpandMemory(sp[-1], Word(32), gas_left, start)) {
+        return ExecResult::OUT_OF_GAS;
     }
-
-    return quotient;
+    sp[-1] = Word::FromBytes(memory_ + start, 32);
+    return ExecResult::SUCCESS;
 }
 
-uint256_t VM::Mod(const uint256_t& a, const uint256_t& b) const {
-    if (IsZero(b))
-        return uint256_t{};  // Modulo by zero returns 0 in EVM
-
-    // Use long division to get remainder
-    uint256_t remainder{};
-
-    // Process bits from most significant to least significant
-    for (int i = 0; i < 256; i++) {
-        // Shift remainder left by 1
-        uint16_t carry = 0;
-        for (int j = 31; j >= 0; j--) {
-            uint16_t shifted = (static_cast<uint16_t>(remainder[j]) << 1) | carry;
-            remainder[j] = static_cast<uint8_t>(shifted & 0xFF);
-            carry = shifted >> 8;
-        }
-
-        // Add current bit of dividend to remainder
-        int byte_idx = i / 8;
-        int bit_idx = 7 - (i % 8);
-        if ((a[byte_idx] >> bit_idx) & 1) {
-            remainder[31] |= 1;
-        }
-
-        // Check if remainder >= divisor
-        bool ge = !Lt(remainder, b);
-        if (ge) {
-            // Subtract divisor from remainder
-            remainder = Sub(remainder, b);
-        }
+ExecResult VM::OpMstore(Word* sp, int64_t& gas_left) {
+    uint64_t start = 0;
+    if (!ExpandMemory(sp[-1], Word(32), gas_left, start)) {
+        return ExecResult::OUT_OF_GAS;
     }
-
-    return remainder;
+    const uint256_t bytes = sp[-2].ToBytes();
+    std::memcpy(memory_ + start, bytes.data(), bytes.size());
+    return ExecResult::SUCCESS;
 }
 
-uint256_t VM::Exp(const uint256_t& base, const uint256_t& exponent) const {
-    // Exponentiation by squaring (binary method)
-    if (IsZero(exponent))
-        return ToUint256(1);
-    if (IsZero(base))
-        return uint256_t{};
-
-    uint256_t result = ToUint256(1);
-    uint256_t current_base = base;
-    uint256_t exp = exponent;
+ExecResult VM::OpMstore8(Word* sp, int64_t& gas_left) {
+    uint64_t start = 0;
+    if (!ExpandMemory(sp[-1], Word(1), gas_left, start)) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    memory_[start] = static_cast<uint8_t>(sp[-2].ToUint64() & 0xFF);
+    return ExecResult::SUCCESS;
+}
 
-    // Process exponent bits from least to most significant
-    for (int i = 0; i < 256; i++) {
-        // Check if current bit of exponent is set
-        int byte_idx = 31 - (i / 8);
-        int bit_idx = i % 8;
-        if ((exp[byte_idx] >> bit_idx) & 1) {
-            result = Mul(result, current_base);
+ExecResult VM::OpSload(Word* sp, int64_t& gas_left) {
+    const uint256_t key = sp[-1].ToBytes();
+    if (accessed_.AddSlot(ctx_.address, key)) {
+        gas_left -= static_cast<int64_t>(COLD_SLOAD_COST - WARM_STORAGE_READ_COST);
+        if (gas_left < 0) {
+            return ExecResult::OUT_OF_GAS;
         }
-
-        // Square the base for next iteration
-        current_base = Mul(current_base, current_base);
-
-        // Early exit if base becomes 0 or 1
-        if (IsZero(current_base))
-            break;
-        uint256_t one = ToUint256(1);
-        if (Eq(current_base, one) && !Eq(result, one))
-            break;
     }
-
-    return result;
+    sp[-1] = Word::FromBytes(state_.GetStorage(ctx_.address, key));
+    return ExecResult::SUCCESS;
 }
 
-bool VM::Lt(const uint256_t& a, const uint256_t& b) const {
-    for (int i = 0; i < 32; i++) {
-        if (a[i] < b[i])
-            return true;
-        if (a[i] > b[i])
-            return false;
+ExecResult VM::OpSstore(Word* sp, int64_t& gas_left, uint32_t later_gas) {
+    if (ctx_.is_static) {
+        return ExecResult::STATIC_CALL_VIOLATION;
+    }
+    // EIP-2200: never leave a caller with less than the call stipend. The
+    // rest of this block's static gas (later_gas) is already deducted, so
+    // add it back to test the gas left at this instruction.
+    if (gas_left + later_gas <= static_cast<int64_t>(SSTORE_SENTRY_GAS)) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    const uint256_t key = sp[-1].ToBytes();
+    const uint256_t value = sp[-2].ToBytes();
+    uint64_t cost = accessed_.AddSlot(ctx_.address, key) ? COLD_SLOAD_COST : 0;
+    const uint256_t current = state_.GetStorage(ctx_.address, key);
+    const uint256_t& original =
+        original_storage_.try_emplace(std::make_pair(ctx_.address, key), current).first->second;
+    cost += SstoreGas(original, current, value, gas_refund_);
+    gas_left -= static_cast<int64_t>(cost);
+    if (gas_left < 0) {
+        return ExecResult::OUT_OF_GAS;
     }
-    return false;
+    state_.SetStorage(ctx_.address, key, value);
+    return ExecResult::SUCCESS;
 }
 
-bool VM::Gt(const uint256_t& a, const uint256_t& b) const {
-    return Lt(b, a);
+ExecResult VM::OpLog(Word* sp, int64_t& gas_left, uint32_t topics) {
+    // Stack: offset, size, topic0..topicN
+    if (ctx_.is_static) {
+        return ExecResult::STATIC_CALL_VIOLATION;
+    }
+    uint64_t start = 0;
+    if (!ExpandMemory(sp[-1], sp[-2], gas_left, start)) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    const uint64_t length = sp[-2].ToUint64();
+    gas_left -= static_cast<int64_t>(375 * topics + 8 * length);  // Per topic and data byte
+    if (gas_left < 0) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    LogEntry entry;
+    entry.address = ctx_.address;
+    for (uint32_t i = 0; i < topics; ++i) {
+        entry.topics.push_back(sp[-3 - static_cast<ptrdiff_t>(i)].ToBytes());
+    }
+    if (length > 0) {
+        entry.data.assign(memory_ + start, memory_ + start + length);
+    }
+    logs_.push_back(std::move(entry));
+    return ExecResult::SUCCESS;
 }
 
-bool VM::Eq(const uint256_t& a, const uint256_t& b) const {
-    return std::memcmp(a.data(), b.data(), 32) == 0;
+ExecResult VM::OpReturn(Word* sp, int64_t& gas_left) {
+    uint64_t start = 0;
+    if (!ExpandMemory(sp[-1], sp[-2], gas_left, start)) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    const uint64_t length = sp[-2].ToUint64();
+    return_data_.assign(memory_ + start, memory_ + start + length);
+    return ExecResult::SUCCESS;
 }
 
-bool VM::IsZero(const uint256_t& a) const {
-    for (uint8_t byte : a) {
-        if (byte != 0)
-            return false;
+ExecResult VM::OpReturnDataCopy(Word* sp, int64_t& gas_left) {
+    // Stack: destination offset, source offset, size. Unlike the other
+    // copies, reading past the end of the source is an exceptional halt.
+    const Word& offset = sp[-2];
+    const Word& size = sp[-3];
+    if (!offset.FitsUint64() || !size.FitsUint64() || offset.ToUint64() > return_data_.size() ||
+        size.ToUint64() > return_data_.size() - offset.ToUint64()) {
+        return ExecResult::RETURN_DATA_OUT_OF_BOUNDS;
     }
-    return true;
+    return OpCopy(sp, gas_left, return_data_);
 }
 
-uint256_t VM::And(const uint256_t& a, const uint256_t& b) const {
-    uint256_t result;
-    for (size_t i = 0; i < 32; i++) {
-        result[i] = a[i] & b[i];
+ExecResult VM::OpCall(Word* sp, int64_t& gas_left, Handler handler, Tracer* tracer) {
+    // Stack: gas, address, value (CALL and CALLCODE only), input offset,
+    // input size, output offset, output size
+    const bool has_value = handler == Handler::CALL || handler == Handler::CALLCODE;
+    const ptrdiff_t args = has_value ? 4 : 3;
+    const Word value = has_value ? sp[-3] : Word();
+    if (handler == Handler::CALL && ctx_.is_static && !value.IsZero()) {
+        return ExecResult::STATIC_CALL_VIOLATION;
+    }
+    uint64_t input_start = 0;
+    uint64_t output_start = 0;
+    if (!ExpandMemory(sp[-args], sp[-args - 1], gas_left, input_start) ||
+        !ExpandMemory(sp[-args - 2], sp[-args - 3], gas_left, output_start)) {
+        return ExecResult::OUT_OF_GAS;
+    }
+    const uint64_t input_size = sp[-args - 1].IsZero() ? 0 : sp[-args - 1].ToUint64();
+    const uint64_t output_size = sp[-args - 3].IsZero() ? 0 : sp[-args - 3].ToUint64();
+
+    // Precompiles are always warm (EIP-2929)
+    const Address target = WordToAddress(sp[-2]);
+    uint64_t cost = 0;
+    if (!IsPrecompile(target) && accessed_.AddAddress(target)) {
+        cost += COLD_ACCOUNT_ACCESS_COST - WARM_STORAGE_READ_COST;
+    }
+    if (!value.IsZero()) {
+        cost += CALL_VALUE_GAS;
+        if (handler == Handler::CALL && IsEmptyAccount(state_, target)) {
+            cost += CALL_NEW_ACCOUNT_GAS;
+        }
+    }
+    gas_left -= static_cast<int64_t>(cost);
+    if (gas_left < 0) {
+        return ExecResult::OUT_OF_GAS;
     }
-    return result;
-}
 
-uint256_t VM::Or(const uint256_t& a, const uint256_t& b) const {
-    uint256_t result;
-    for (size_t i = 0; i < 32; i++) {
-        result[i] = a[i] | b[i];
+    // EIP-150: the callee gets at most all but one 64th of what is left
+    const uint64_t available = static_cast<uint64_t>(gas_left - gas_left / 64);
+    uint64_t callee_gas =
+        sp[-1].FitsUint64() ? std::min(sp[-1].ToUint64(), available) : available;
+    gas_left -= static_cast<int64_t>(callee_gas);
+    if (!value.IsZero()) {
+        callee_gas += CALL_STIPEND;
     }
-    return result;
-}
 
-uint256_t VM::Xor(const uint256_t& a, const uint256_t& b) const {
-    uint256_t result;
-    for (size_t i = 0; i < 32; i++) {
-        result[i] = a[i] ^ b[i];
+    Word& success = sp[-args - 3];
+    return_data_.clear();
+    if (ctx_.depth >= MAX_CALL_DEPTH ||
+        (!value.IsZero() && Word::FromBytes(state_.GetBalance(ctx_.address)) < value)) {
+        // Fails without running, and the callee's gas comes back
+        gas_left += static_cast<int64_t>(callee_gas);
+        success = Word();
+        return ExecResult::SUCCESS;
     }
-    return result;
-}
 
-uint256_t VM::Not(const uint256_t& a) const {
-    uint256_t result;
-    for (size_t i = 0; i < 32; i++) {
-        result[i] = ~a[i];
+    ExecutionContext child{};
+    child.origin = ctx_.origin;
+    child.caller = handler == Handler::DELEGATECALL ? ctx_.caller : ctx_.address;
+    child.address =
+        handler == Handler::CALL || handler == Handler::STATICCALL ? target : ctx_.address;
+    child.value = handler == Handler::DELEGATECALL ? ctx_.value : value.ToBytes();
+    child.input_data.assign(memory_ + input_start, memory_ + input_start + input_size);
+    child.gas_limit = callee_gas;
+    child.gas_price = ctx_.gas_price;
+    child.block_number = ctx_.block_number;
+    child.timestamp = ctx_.timestamp;
+    child.coinbase = ctx_.coinbase;
+    child.difficulty = ctx_.difficulty;
+    child.gas_limit_block = ctx_.gas_limit_block;
+    child.chain_id = ctx_.chain_id;
+    child.base_fee = ctx_.base_fee;
+    child.is_static = ctx_.is_static || handler == Handler::STATICCALL;
+    child.depth = ctx_.depth + 1;
+
+    uint64_t callee_used = 0;
+    auto [result, output] = Call(child, target, !value.IsZero(), tracer, callee_used);
+    gas_left += static_cast<int64_t>(callee_gas - callee_used);
+    if (!output.empty()) {
+        std::memcpy(memory_ + output_start, output.data(),
+                    std::min<uint64_t>(output_size, output.size()));
     }
-    return result;
+    return_data_ = std::move(output);
+    success = Word(result == ExecResult::SUCCESS || result == ExecResult::RETURNED ? 1 : 0);
+    return ExecResult::SUCCESS;
 }
 
-uint256_t VM::Shl(const uint256_t& shift, const uint256_t& value) const {
-    uint64_t shift_amount = ToUint64(shift);
-    if (shift_amount >= 256)
-        return uint256_t{};
+std::pair<ExecResult, std::vector<uint8_t>> VM::Call(const ExecutionContext& child,
+                                                     const Address& code_address, bool transfer,
+                                                     Tracer* tracer, uint64_t& gas_used) {
+    const size_t checkpoint = state_.Checkpoint();
+    if (transfer) {
+        const Word value = Word::FromBytes(child.value);
+        state_.SetBalance(child.caller,
+                          (Word::FromBytes(state_.GetBalance(child.caller)) - value).ToBytes());
+        state_.SetBalance(child.address,
+                          (Word::FromBytes(state_.GetBalance(child.address)) + value).ToBytes());
+    }
 
-    uint256_t result = value;
-    // Whole-byte shift followed by sub-byte shift for efficiency
-    size_t byte_shift = shift_amount / 8;
-    size_t bit_shift = shift_amount % 8;
-    if (byte_shift > 0) {
-        for (int j = 0; j + static_cast<int>(byte_shift) < 32; ++j) {
-            result[j] = result[j + byte_shift];
+    std::pair<ExecResult, std::vector<uint8_t>> result{ExecResult::SUCCESS, {}};
+    gas_used = 0;
+    const CodeHandle code = IsPrecompile(code_address) ? nullptr : state_.GetCode(code_address);
+    if (code != nullptr && !code->Empty()) {
+        // The callee shares the transaction's access set, original values
+        // and refund counter; the access set only survives its success
+        VM callee(state_, child);
+        callee.accessed_ = accessed_;
+        callee.original_storage_ = std::move(original_storage_);
+        callee.gas_refund_ = gas_refund_;
+        result = tracer != nullptr ? callee.Execute(*code, *tracer) : callee.Execute(*code);
+        gas_used = callee.gas_used_;
+        original_storage_ = std::move(callee.original_storage_);
+        gas_refund_ = callee.gas_refund_;
+        if (result.first == ExecResult::SUCCESS || result.first == ExecResult::RETURNED) {
+            accessed_ = std::move(callee.accessed_);
+            logs_.insert(logs_.end(), std::make_move_iterator(callee.logs_.begin()),
+                         std::make_move_iterator(callee.logs_.end()));
         }
-        for (size_t j = 32 - byte_shift; j < 32; ++j) {
-            result[j] = 0;
+    } else {
+        if (tracer != nullptr) {
+            tracer->OnEnter(TraceFrame{child.depth, child.caller, child.address, child.value,
+                                       child.input_data, child.gas_limit, child.is_static});
         }
-    }
-    if (bit_shift > 0) {
-        uint8_t carry = 0;
-        for (int j = 31; j >= 0; --j) {
-            uint8_t new_carry = (result[j] & 0xFFu) >> (8 - bit_shift);
-            result[j] = static_cast<uint8_t>((result[j] << bit_shift) | carry);
-            carry = new_carry;
-        }
-    }
-    return result;
-}
-
-uint256_t VM::Shr(const uint256_t& shift, const uint256_t& value) const {
-    uint64_t shift_amount = ToUint64(shift);
-    if (shift_amount >= 256)
-        return uint256_t{};
-
-    uint256_t result = value;
-    // Whole-byte shift followed by sub-byte shift for efficiency
-    size_t byte_shift = shift_amount / 8;
-    size_t bit_shift = shift_amount % 8;
-    if (byte_shift > 0) {
-        for (int j = 31; j >= static_cast<int>(byte_shift); --j) {
-            result[j] = result[j - byte_shift];
+        if (code == nullptr) {
+            PrecompileResult run = RunPrecompile(code_address, child.input_data, child.gas_limit);
+            result = {run.status, std::move(run.output)};
+            gas_used = run.gas_used;
         }
-        for (size_t j = 0; j < byte_shift; ++j) {
-            result[j] = 0;
+        if (tracer != nullptr) {
+            tracer->OnExit(TraceExit{child.depth, result.first, gas_used, result.second});
         }
     }
-    if (bit_shift > 0) {
-        uint8_t carry = 0;
-        for (int j = 0; j < 32; ++j) {
-            uint8_t new_carry = static_cast<uint8_t>(result[j] << (8 - bit_shift));
-            result[j] = static_cast<uint8_t>((result[j] >> bit_shift) | carry);
-            carry = new_carry;
-        }
+
+    if (result.first == ExecResult::SUCCESS || result.first == ExecResult::RETURNED) {
+        state_.DiscardCheckpoint(checkpoint);
+    } else {
+        state_.RevertToCheckpoint(checkpoint);
     }
     return result;
 }
 
 std::pair<ExecResult, std::vector<uint8_t>> VM::Execute(const std::vector<uint8_t>& code) {
-    size_t pc = 0;  // Program counter
-    std::vector<bool> jump_dests(code.size(), false);
+    auto shared = CodeCache::Global().Insert(code);
+    return Execute(*shared);
+}
 
-    // Pre-scan for JUMPDEST
-    for (size_t i = 0; i < code.size(); i++) {
-        if (static_cast<Opcode>(code[i]) == Opcode::JUMPDEST) {
-            jump_dests[i] = true;
-        }
-        // Skip PUSH data
-        if (IsPushOp(static_cast<Opcode>(code[i]))) {
-            i += GetPushSize(static_cast<Opcode>(code[i]));
-        }
-    }
+std::pair<ExecResult, std::vector<uint8_t>> VM::Execute(const ContractCode& code) {
+    NullTracer tracer;
+    const CompiledContract* compiled = AotEnabled() ? code.Compiled() : nullptr;
+    return ExecuteFrame(code.Bytes(), code.Analysis(), tracer, nullptr, compiled);
+}
 
-    // Execute bytecode
-    while (pc < code.size()) {
-        Opcode op = static_cast<Opcode>(code[pc]);
+std::pair<ExecResult, std::vector<uint8_t>> VM::Execute(const ContractCode& code,
+                                                        const CompiledContract& compiled) {
+    NullTracer tracer;
+    return ExecuteFrame(code.Bytes(), code.Analysis(), tracer, nullptr, &compiled);
+}
 
-        // Charge gas for opcode
-        if (!UseGas(GetOpcodeCost(op))) {
-            return {ExecResult::OUT_OF_GAS, {}};
+struct VM::TraceLayout {
+    std::vector<uint32_t> offsets;  // BEGIN_BLOCK: offset of the block's first instruction
+    std::vector<uint64_t> pending;  // Static gas of this and later instructions in the block
+    std::vector<bool> jumpdest;     // BEGIN_BLOCK stands for a JUMPDEST
+
+    // Replays AnalyzeCode() over the instruction stream
+    TraceLayout(const std::vector<uint8_t>& code, const CodeAnalysis& analysis) {
+        const auto& instructions = analysis.instructions;
+        offsets.resize(instructions.size());
+        pending.resize(instructions.size());
+        jumpdest.resize(instructions.size());
+
+        size_t pc = 0;
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            offsets[i] = static_cast<uint32_t>(std::min(pc, code.size()));
+            if (instructions[i].handler == Handler::BEGIN_BLOCK) {
+                if (pc < code.size() && static_cast<Opcode>(code[pc]) == Opcode::JUMPDEST) {
+                    jumpdest[i] = true;
+                    ++pc;
+                }
+                continue;
+            }
+            const Opcode op = static_cast<Opcode>(instructions[i].opcode);
+            pc += 1 + (IsPushOp(op) ? GetPushSize(op) : 0);
         }
 
-        try {
-            ExecResult result = ExecuteOpcode(op, code, pc);
-
-            if (result == ExecResult::SUCCESS) {
-                // Continue execution
-                pc++;
+        uint64_t block_gas = 0;
+        for (size_t i = instructions.size(); i-- > 0;) {
+            if (instructions[i].handler == Handler::BEGIN_BLOCK) {
+                pending[i] = block_gas + (jumpdest[i] ? GetOpcodeCost(Opcode::JUMPDEST) : 0);
+                block_gas = 0;
             } else {
-                // Execution ended (RETURN, REVERT, etc.)
-                return {result, return_data_};
+                block_gas += GetOpcodeCost(static_cast<Opcode>(instructions[i].opcode));
+                pending[i] = block_gas;
             }
-        } catch (const std::exception&) {
-            return {ExecResult::INVALID_OPCODE, {}};
         }
     }
+};
 
-    // Reached end of code without explicit return
-    return {ExecResult::SUCCESS, {}};
+std::pair<ExecResult, std::vector<uint8_t>> VM::Execute(const std::vector<uint8_t>& code,
+                                                        const CodeAnalysis& analysis) {
+    NullTracer tracer;
+    return ExecuteFrame(code, analysis, tracer, nullptr, nullptr);
 }
 
-ExecResult VM::ExecuteOpcode(Opcode op, const std::vector<uint8_t>& code, size_t& pc) {
-    switch (op) {
-        case Opcode::STOP:
-            return ExecResult::SUCCESS;
-
-        case Opcode::ADD: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Add(a, b));
-            break;
-        }
-
-        case Opcode::MUL: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Mul(a, b));
-            break;
-        }
-
-        case Opcode::SUB: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Sub(a, b));
-            break;
-        }
-
-        case Opcode::DIV: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Div(a, b));
-            break;
-        }
-
-        case Opcode::MOD: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Mod(a, b));
-            break;
-        }
-
-        case Opcode::EXP: {
-            auto exponent = Pop();
-            auto base = Pop();
-            Push(Exp(base, exponent));
-            break;
-        }
-
-        case Opcode::LT: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Lt(a, b) ? ToUint256(1) : ToUint256(0));
-            break;
-        }
-
-        case Opcode::GT: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Gt(a, b) ? ToUint256(1) : ToUint256(0));
-            break;
-        }
-
-        case Opcode::EQ: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Eq(a, b) ? ToUint256(1) : ToUint256(0));
-            break;
-        }
-
-        case Opcode::ISZERO: {
-            auto a = Pop();
-            Push(IsZero(a) ? ToUint256(1) : ToUint256(0));
-            break;
-        }
-
-        case Opcode::AND: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(And(a, b));
-            break;
-        }
-
-        case Opcode::OR: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Or(a, b));
-            break;
-        }
-
-        case Opcode::XOR: {
-            auto b = Pop();
-            auto a = Pop();
-            Push(Xor(a, b));
-            break;
-        }
-
-        case Opcode::NOT: {
-            auto a = Pop();
-            Push(Not(a));
-            break;
-        }
-
-        case Opcode::SHL: {
-            auto value = Pop();
-            auto shift = Pop();
-            Push(Shl(shift, value));
-            break;
-        }
-
-        case Opcode::SHR: {
-            auto value = Pop();
-            auto shift = Pop();
-            Push(Shr(shift, value));
-            break;
-        }
+std::pair<ExecResult, std::vector<uint8_t>> VM::Execute(const ContractCode& code, Tracer& tracer) {
+    const TraceLayout layout(code.Bytes(), code.Analysis());
+    return ExecuteFrame(code.Bytes(), code.Analysis(), tracer, &layout, nullptr);
+}
 
-        // Memory operations
-        case Opcode::MLOAD: {
-            auto offset = ToUint64(Pop());
-            Push(MemoryLoad(offset));
-            break;
-        }
+template <typename TracerPolicy>
+std::pair<ExecResult, std::vector<uint8_t>> VM::ExecuteFrame(const std::vector<uint8_t>& code,
+                                                             const CodeAnalysis& analysis,
+                                                             TracerPolicy& tracer,
+                                                             const TraceLayout* layout,
+                                                             const CompiledContract* compiled) {
+    const uint64_t gas_before = gas_used_;
+    if constexpr (TracerPolicy::kEnabled) {
+        tracer.OnEnter(TraceFrame{ctx_.depth, ctx_.caller, ctx_.address, ctx_.value,
+                                  ctx_.input_data, ctx_.gas_limit - gas_used_, ctx_.is_static});
+    }
 
-        case Opcode::MSTORE: {
-            auto offset = ToUint64(Pop());
-            auto value = Pop();
-            MemoryStore(offset, value);
-            break;
-        }
+    // A failed frame leaves no state changes or logs behind
+    return_data_.clear();
+    const size_t checkpoint = state_.Checkpoint();
+    const size_t log_count = logs_.size();
+    const int64_t refund = gas_refund_;
+    ExecResult result;
+    {
+        // Stack and memory live only as long as the frame runs
+        FrameArena::Frame frame(FrameArena::ForThread());
+        frame_ = &frame;
+        stack_ = frame.Stack();
+        memory_ = frame.Memory();
+        result = compiled != nullptr ? RunCompiled(*compiled, code)
+                                     : Run(code, analysis, tracer, layout);
+        frame_ = nullptr;
+        stack_ = nullptr;
+        memory_ = nullptr;
+    }
+    if (result == ExecResult::SUCCESS || result == ExecResult::RETURNED) {
+        state_.DiscardCheckpoint(checkpoint);
+    } else {
+        state_.RevertToCheckpoint(checkpoint);
+        logs_.resize(log_count);
+        gas_refund_ = refund;
+    }
 
-        case Opcode::MSTORE8: {
-            auto offset = ToUint64(Pop());
-            auto value = Pop();
-            MemoryStore8(offset, static_cast<uint8_t>(ToUint64(value) & 0xFF));
+    std::vector<uint8_t> output;
+    switch (result) {
+        case ExecResult::SUCCESS:
             break;
-        }
-
-        // Storage operations
-        case Opcode::SLOAD: {
-            auto key = Pop();
-            auto value = state_.GetStorage(ctx_.address, key);
-            Push(value);
+        case ExecResult::RETURNED:
+        case ExecResult::REVERT:
+            output = return_data_;
             break;
-        }
-
-        case Opcode::SSTORE: {
-            if (ctx_.is_static) {
-                return ExecResult::STATIC_CALL_VIOLATION;
-            }
-            auto key = Pop();
-            auto value = Pop();
-            state_.SetStorage(ctx_.address, key, value);
-            break;
-        }
-
-        // Stack operations
-        case Opcode::POP:
-            Pop();
+        default:
+            // Exceptional halts consume all gas
+            gas_used_ = ctx_.gas_limit;
             break;
+    }
 
-        case Opcode::PUSH1:
-        case Opcode::PUSH2:
-        case Opcode::PUSH3:
-        case Opcode::PUSH4:
-        case Opcode::PUSH5:
-        case Opcode::PUSH6:
-        case Opcode::PUSH7:
-        case Opcode::PUSH8:
-        case Opcode::PUSH9:
-        case Opcode::PUSH10:
-        case Opcode::PUSH11:
-        case Opcode::PUSH12:
-        case Opcode::PUSH13:
-        case Opcode::PUSH14:
-        case Opcode::PUSH15:
-        case Opcode::PUSH16:
-        case Opcode::PUSH17:
-        case Opcode::PUSH18:
-        case Opcode::PUSH19:
-        case Opcode::PUSH20:
-        case Opcode::PUSH21:
-        case Opcode::PUSH22:
-        case Opcode::PUSH23:
-        case Opcode::PUSH24:
-        case Opcode::PUSH25:
-        case Opcode::PUSH26:
-        case Opcode::PUSH27:
-        case Opcode::PUSH28:
-        case Opcode::PUSH29:
-        case Opcode::PUSH30:
-        case Opcode::PUSH31:
-        case Opcode::PUSH32: {
-            uint8_t size = GetPushSize(op);
-            uint256_t value{};
-            for (uint8_t i = 0; i < size && pc + 1 + i < code.size(); i++) {
-                value[32 - size + i] = code[pc + 1 + i];
-            }
-            Push(value);
-            pc += size;  // Skip pushed bytes
-            break;
-        }
+    if constexpr (TracerPolicy::kEnabled) {
+        tracer.OnExit(TraceExit{ctx_.depth, result, gas_used_ - gas_before, output});
+    }
+    return {result, std::move(output)};
+}
 
-        // DUP operations
-        case Opcode::DUP1:
-        case Opcode::DUP2:
-        case Opcode::DUP3:
-        case Opcode::DUP4:
-        case Opcode::DUP5:
-        case Opcode::DUP6:
-        case Opcode::DUP7:
-        case Opcode::DUP8:
-        case Opcode::DUP9:
-        case Opcode::DUP10:
-        case Opcode::DUP11:
-        case Opcode::DUP12:
-        case Opcode::DUP13:
-        case Opcode::DUP14:
-        case Opcode::DUP15:
-        case Opcode::DUP16:
-            Dup(GetDupDepth(op));
-            break;
+ExecResult VM::RunCompiled(const CompiledContract& compiled, const std::vector<uint8_t>& code) {
+    int64_t gas_left = static_cast<int64_t>(std::min<uint64_t>(
+        ctx_.gas_limit - gas_used_, static_cast<uint64_t>(std::numeric_limits<int64_t>::max())));
+    AotFrame frame(*this, code);
+    const ExecResult result = compiled.run(frame, gas_left);
+    gas_used_ = ctx_.gas_limit - static_cast<uint64_t>(std::max<int64_t>(gas_left, 0));
+    return result;
+}
 
-        // SWAP operations
-        case Opcode::SWAP1:
-        case Opcode::SWAP2:
-        case Opcode::SWAP3:
-        case Opcode::SWAP4:
-        case Opcode::SWAP5:
-        case Opcode::SWAP6:
-        case Opcode::SWAP7:
-        case Opcode::SWAP8:
-        case Opcode::SWAP9:
-        case Opcode::SWAP10:
-        case Opcode::SWAP11:
-        case Opcode::SWAP12:
-        case Opcode::SWAP13:
-        case Opcode::SWAP14:
-        case Opcode::SWAP15:
-        case Opcode::SWAP16:
-            Swap(GetSwapDepth(op));
-            break;
+TraceStep VM::StepAt(const CodeAnalysis& analysis, const TraceLayout& layout, size_t index,
+                     const Word* sp, int64_t gas_left) const {
+    // A block reports its JUMPDEST, or else its first instruction
+    uint8_t opcode = analysis.instructions[index].opcode;
+    if (analysis.instructions[index].handler == Handler::BEGIN_BLOCK) {
+        opcode = layout.jumpdest[index] ? static_cast<uint8_t>(Opcode::JUMPDEST)
+                                        : analysis.instructions[index + 1].opcode;
+    }
+    const int64_t gas = gas_left + static_cast<int64_t>(layout.pending[index]);
+    return TraceStep{layout.offsets[index],
+                     opcode,
+                     static_cast<uint64_t>(std::max<int64_t>(gas, 0)),
+                     ctx_.depth,
+                     ctx_.address,
+                     stack_,
+                     static_cast<size_t>(sp - stack_),
+                     memory_,
+                     frame_->MemorySize(),
+                     state_};
+}
 
-        // Context operations
-        case Opcode::ADDRESS: {
-            // Load 20-byte contract address into a uint256 (right-aligned)
-            uint256_t addr_val{};
-            std::copy(ctx_.address.begin(), ctx_.address.end(), addr_val.begin() + 12);
-            Push(addr_val);
-            break;
-        }
-        case Opcode::CALLER: {
-            // Load 20-byte caller address into a uint256 (right-aligned)
-            uint256_t caller_val{};
-            std::copy(ctx_.caller.begin(), ctx_.caller.end(), caller_val.begin() + 12);
-            Push(caller_val);
-            break;
+template <typename TracerPolicy>
+ExecResult VM::Run(const std::vector<uint8_t>& code, const CodeAnalysis& analysis,
+                   TracerPolicy& tracer, const TraceLayout* layout) {
+    const Instruction* ip = analysis.instructions.data();
+    Word* const stack_bottom = stack_;
+    Word* sp = stack_bottom;  // One past the top element
+    int64_t gas_left = static_cast<int64_t>(std::min<uint64_t>(
+        ctx_.gas_limit - gas_used_, static_cast<uint64_t>(std::numeric_limits<int64_t>::max())));
+    ExecResult result = ExecResult::SUCCESS;
+
+    // Static gas and stack bounds are checked once per block by BEGIN_BLOCK,
+    // so the handlers below index sp[-n] without further checks.
+#if PARTHENON_EVM_COMPUTED_GOTO
+#define PARTHENON_EVM_LABEL_ADDRESS(name) &&op_##name,
+    static const void* const kDispatch[] = {PARTHENON_EVM_HANDLERS(PARTHENON_EVM_LABEL_ADDRESS)};
+#undef PARTHENON_EVM_LABEL_ADDRESS
+#define PARTHENON_EVM_JUMP() goto* kDispatch[static_cast<size_t>(ip->handler)]
+#else
+#define PARTHENON_EVM_JUMP() goto dispatch
+#endif
+    // Blocks report their JUMPDEST, if any, from BEGIN_BLOCK once charged
+#define DISPATCH()                                                                     \
+    do {                                                                               \
+        if constexpr (TracerPolicy::kEnabled) {                                        \
+            if (ip->handler != Handler::BEGIN_BLOCK) {                                 \
+                tracer.OnStep(StepAt(analysis, *layout, ip - analysis.instructions.data(), \
+                                     sp, gas_left));                                   \
+            }                                                                          \
+        }                                                                              \
+        PARTHENON_EVM_JUMP();                                                          \
+    } while (0)
+#define NEXT()      \
+    do {            \
+        ++ip;       \
+        DISPATCH(); \
+    } while (0)
+#define HALT(r)       \
+    do {              \
+        result = (r); \
+        goto halt;    \
+    } while (0)
+#define CHECK(op)                                   \
+    do {                                            \
+        const ExecResult status = (op);             \
+        if (status != ExecResult::SUCCESS) {        \
+            HALT(status);                           \
+        }                                           \
+    } while (0)
+
+#if PARTHENON_EVM_COMPUTED_GOTO
+    DISPATCH();
+#else
+dispatch:
+    switch (ip->handler) {
+#define PARTHENON_EVM_SWITCH_CASE(name) \
+    case Handler::name:                 \
+        goto op_##name;
+        PARTHENON_EVM_HANDLERS(PARTHENON_EVM_SWITCH_CASE)
+#undef PARTHENON_EVM_SWITCH_CASE
+    }
+    HALT(ExecResult::INVALID_OPCODE);
+#endif
+
+op_BEGIN_BLOCK: {
+    const BlockInfo& block = analysis.blocks[ip->arg];
+    gas_left -= static_cast<int64_t>(block.gas_cost);
+    if (gas_left < 0) {
+        HALT(ExecResult::OUT_OF_GAS);
+    }
+    const ptrdiff_t height = sp - stack_bottom;
+    if (height < block.stack_required) {
+        HALT(ExecResult::STACK_UNDERFLOW);
+    }
+    if (height + block.stack_max_growth > static_cast<ptrdiff_t>(MAX_STACK_SIZE)) {
+        HALT(ExecResult::STACK_OVERFLOW);
+    }
+    if constexpr (TracerPolicy::kEnabled) {
+        const size_t index = ip - analysis.instructions.data();
+        if (layout->jumpdest[index]) {
+            tracer.OnStep(StepAt(analysis, *layout, index, sp, gas_left));
         }
+    }
+    NEXT();
+}
 
-        case Opcode::CALLVALUE:
-            Push(ctx_.value);
-            break;
-
-        case Opcode::GAS:
-            Push(ToUint256(GetGasRemaining()));
-            break;
-
-        case Opcode::GASPRICE:
-            Push(ToUint256(ctx_.gas_price));
-            break;
-
-        case Opcode::TIMESTAMP:
-            Push(ToUint256(ctx_.timestamp));
-            break;
-
-        case Opcode::NUMBER:
-            Push(ToUint256(ctx_.block_number));
-            break;
-
-        case Opcode::DIFFICULTY:
-            Push(ToUint256(ctx_.difficulty));
-            break;
-
-        case Opcode::GASLIMIT:
-            Push(ToUint256(ctx_.gas_limit_block));
-            break;
-
-        case Opcode::CHAINID:
-            Push(ToUint256(ctx_.chain_id));
-            break;
+op_STOP:
+    HALT(ExecResult::SUCCESS);
+
+    // Arithmetic: binary operators take the top of the stack as their left operand
+op_ADD:
+    sp[-2] = sp[-1] + sp[-2];
+    --sp;
+    NEXT();
+
+op_MUL:
+    sp[-2] = sp[-1] * sp[-2];
+    --sp;
+    NEXT();
+
+op_SUB:
+    sp[-2] = sp[-1] - sp[-2];
+    --sp;
+    NEXT();
+
+op_DIV:
+    sp[-2] = sp[-1] / sp[-2];  // Division by zero yields 0
+    --sp;
+    NEXT();
+
+op_SDIV:
+    sp[-2] = SignedDiv(sp[-1], sp[-2]);
+    --sp;
+    NEXT();
+
+op_MOD:
+    sp[-2] = sp[-1] % sp[-2];
+    --sp;
+    NEXT();
+
+op_SMOD:
+    sp[-2] = SignedMod(sp[-1], sp[-2]);
+    --sp;
+    NEXT();
+
+op_ADDMOD:
+    sp[-3] = AddMod(sp[-1], sp[-2], sp[-3]);
+    sp -= 2;
+    NEXT();
+
+op_MULMOD:
+    sp[-3] = MulMod(sp[-1], sp[-2], sp[-3]);
+    sp -= 2;
+    NEXT();
+
+op_EXP:
+    sp[-2] = Exp(sp[-1], sp[-2]);
+    --sp;
+    NEXT();
+
+op_SIGNEXTEND:
+    sp[-2] = SignExtend(sp[-1], sp[-2]);
+    --sp;
+    NEXT();
+
+    // Comparison and bitwise
+op_LT:
+    sp[-2] = Word(sp[-1] < sp[-2] ? 1 : 0);
+    --sp;
+    NEXT();
+
+op_GT:
+    sp[-2] = Word(sp[-1] > sp[-2] ? 1 : 0);
+    --sp;
+    NEXT();
+
+op_SLT:
+    sp[-2] = Word(SignedLess(sp[-1], sp[-2]) ? 1 : 0);
+    --sp;
+    NEXT();
+
+op_SGT:
+    sp[-2] = Word(SignedLess(sp[-2], sp[-1]) ? 1 : 0);
+    --sp;
+    NEXT();
+
+op_EQ:
+    sp[-2] = Word(sp[-1] == sp[-2] ? 1 : 0);
+    --sp;
+    NEXT();
+
+op_ISZERO:
+    sp[-1] = Word(sp[-1].IsZero() ? 1 : 0);
+    NEXT();
+
+op_AND:
+    sp[-2] = sp[-1] & sp[-2];
+    --sp;
+    NEXT();
+
+op_OR:
+    sp[-2] = sp[-1] | sp[-2];
+    --sp;
+    NEXT();
+
+op_XOR:
+    sp[-2] = sp[-1] ^ sp[-2];
+    --sp;
+    NEXT();
+
+op_NOT:
+    sp[-1] = ~sp[-1];
+    NEXT();
+
+op_BYTE:
+    sp[-2] = Byte(sp[-1], sp[-2]);
+    --sp;
+    NEXT();
+
+op_SHL:
+    sp[-2] = sp[-2] << ShiftAmount(sp[-1]);
+    --sp;
+    NEXT();
+
+op_SHR:
+    sp[-2] = sp[-2] >> ShiftAmount(sp[-1]);
+    --sp;
+    NEXT();
+
+op_SAR:
+    sp[-2] = Sar(sp[-2], ShiftAmount(sp[-1]));
+    --sp;
+    NEXT();
+
+op_SHA3:
+    CHECK(OpSha3(sp, gas_left));
+    --sp;
+    NEXT();
+
+    // Environment
+op_ADDRESS:
+op_ORIGIN:
+op_CALLER:
+op_CALLVALUE:
+op_CALLDATASIZE:
+op_CODESIZE:
+op_GASPRICE:
+op_RETURNDATASIZE:
+op_COINBASE:
+op_TIMESTAMP:
+op_NUMBER:
+op_DIFFICULTY:
+op_GASLIMIT:
+op_CHAINID:
+op_SELFBALANCE:
+op_BASEFEE:
+op_MSIZE:
+    *sp++ = Environment(ip->handler, code);
+    NEXT();
+
+op_BALANCE:
+    CHECK(OpBalance(sp, gas_left));
+    NEXT();
+
+op_CALLDATALOAD:
+    OpCallDataLoad(sp);
+    NEXT();
+
+op_CALLDATACOPY:
+    CHECK(OpCopy(sp, gas_left, ctx_.input_data));
+    sp -= 3;
+    NEXT();
+
+op_CODECOPY:
+    CHECK(OpCopy(sp, gas_left, code));
+    sp -= 3;
+    NEXT();
+
+op_RETURNDATACOPY:
+    CHECK(OpReturnDataCopy(sp, gas_left));
+    sp -= 3;
+    NEXT();
+
+    // Stack, memory and storage
+op_POP:
+    --sp;
+    NEXT();
+
+op_MLOAD:
+    CHECK(OpMload(sp, gas_left));
+    NEXT();
+
+op_MSTORE:
+    CHECK(OpMstore(sp, gas_left));
+    sp -= 2;
+    NEXT();
+
+op_MSTORE8:
+    CHECK(OpMstore8(sp, gas_left));
+    sp -= 2;
+    NEXT();
+
+op_SLOAD:
+    CHECK(OpSload(sp, gas_left));
+    NEXT();
+
+op_SSTORE:
+    CHECK(OpSstore(sp, gas_left, ip->arg));
+    sp -= 2;
+    NEXT();
+
+    // Control flow: jumps land on the BEGIN_BLOCK of the destination block
+op_JUMP: {
+    const Instruction* target = analysis.FindJumpTarget(sp[-1]);
+    --sp;
+    if (target == nullptr) {
+        HALT(ExecResult::INVALID_JUMP);
+    }
+    ip = target;
+    DISPATCH();
+}
 
-        case Opcode::BASEFEE:
-            Push(ToUint256(ctx_.base_fee));
-            break;
+op_JUMPI: {
+    const bool taken = !sp[-2].IsZero();
+    const Instruction* target = taken ? analysis.FindJumpTarget(sp[-1]) : nullptr;
+    sp -= 2;
+    if (!taken) {
+        NEXT();
+    }
+    if (target == nullptr) {
+        HALT(ExecResult::INVALID_JUMP);
+    }
+    ip = target;
+    DISPATCH();
+}
 
-        // Return operations
-        case Opcode::RETURN: {
-            auto offset = ToUint64(Pop());
-            auto length = ToUint64(Pop());
-            ExpandMemory(offset + length);
-            return_data_.assign(memory_.begin() + offset, memory_.begin() + offset + length);
-            return ExecResult::RETURNED;
-        }
+op_PC:
+    *sp++ = Word(ip->arg);
+    NEXT();
+
+op_GAS:
+    // GAS ends its block, so later instructions have not been charged yet
+    *sp++ = Word(static_cast<uint64_t>(gas_left));
+    NEXT();
+
+op_PUSH:
+    *sp++ = analysis.push_values[ip->arg];
+    NEXT();
+
+op_DUP:
+    *sp = sp[-static_cast<ptrdiff_t>(ip->arg)];
+    ++sp;
+    NEXT();
+
+op_SWAP:
+    std::swap(sp[-1], sp[-1 - static_cast<ptrdiff_t>(ip->arg)]);
+    NEXT();
+
+op_LOG:
+    CHECK(OpLog(sp, gas_left, ip->arg));
+    sp -= 2 + ip->arg;
+    NEXT();
+
+    // Calls end their block, so the callee's share is of the exact gas left
+op_CALL:
+op_CALLCODE:
+op_DELEGATECALL:
+op_STATICCALL: {
+    Tracer* call_tracer = nullptr;
+    if constexpr (TracerPolicy::kEnabled) {
+        call_tracer = &tracer;
+    }
+    CHECK(OpCall(sp, gas_left, ip->handler, call_tracer));
+    sp -= ip->handler == Handler::CALL || ip->handler == Handler::CALLCODE ? 6 : 5;
+    NEXT();
+}
 
-        case Opcode::REVERT: {
-            auto offset = ToUint64(Pop());
-            auto length = ToUint64(Pop());
-            ExpandMemory(offset + length);
-            return_data_.assign(memory_.begin() + offset, memory_.begin() + offset + length);
-            return ExecResult::REVERT;
+op_RETURN:
+    CHECK(OpReturn(sp, gas_left));
+    HALT(ExecResult::RETURNED);
+
+op_REVERT:
+    CHECK(OpReturn(sp, gas_left));
+    HALT(ExecResult::REVERT);
+
+op_INVALID:
+    HALT(ExecResult::INVALID_OPCODE);
+
+halt:
+    if constexpr (TracerPolicy::kEnabled) {
+        if (result != ExecResult::SUCCESS && result != ExecResult::RETURNED &&
+            result != ExecResult::REVERT) {
+            // A block that failed its checks reports its first instruction
+            // with the gas it started with
+            tracer.OnFault(
+                StepAt(analysis, *layout, ip - analysis.instructions.data(), sp, gas_left), result);
         }
-
-        case Opcode::JUMPDEST:
-            // Valid jump destination, just continue
-            break;
-
-        default:
-            // Unsupported opcode
-            return ExecResult::INVALID_OPCODE;
     }
+    gas_used_ = ctx_.gas_limit - static_cast<uint64_t>(std::max<int64_t>(gas_left, 0));
+    return result;
 
-    return ExecResult::SUCCESS;  // Continue execution
+#undef CHECK
+#undef HALT
+#undef NEXT
+#undef DISPATCH
+#undef PARTHENON_EVM_JUMP
 }
 
 }  // namespace evm
@@ -3,10 +3,18 @@
 
 #pragma once
 
+#include "access_list.h"
+#include "analysis.h"
+#include "code_cache.h"
+#include "frame_arena.h"
 #include "opcodes.h"
 #include "state.h"
+#include "tracer.h"
+#include "uint256.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <optional>
 #include <stack>
@@ -15,6 +23,9 @@
 namespace parthenon {
 namespace evm {
 
+class AotFrame;
+struct CompiledContract;
+
 /**
  * Execution result
  */
@@ -28,9 +39,15 @@ enum class ExecResult {
     INVALID_JUMP,
     INVALID_OPCODE,
     STATIC_CALL_VIOLATION,
+    RETURN_DATA_OUT_OF_BOUNDS,  // RETURNDATACOPY past the end (EIP-211)
     DEPTH_EXCEEDED,
 };
 
+/**
+ * Short description of a result: "ok", "revert", "out of gas", ...
+ */
+const char* GetResultMessage(ExecResult result);
+
 /**
  * Execution context for VM
  */
@@ -51,6 +68,7 @@ struct ExecutionContext {
     uint64_t base_fee;                // EIP-1559 base fee
     bool is_static;                   // Static call flag
     uint32_t depth;                   // Call depth
+    AccessList access_list;           // EIP-2930 declared accesses (pre-warmed)
 };
 
 /**
@@ -58,87 +76,157 @@ struct ExecutionContext {
  */
 class VM {
   public:
-    VM(WorldState& state, const ExecutionContext& ctx);
+    VM(StateAccess& state, const ExecutionContext& ctx);
 
     /**
      * Execute contract code
      *
+     * The code is hashed and resolved through the process-wide CodeCache,
+     * so repeated calls skip analysis, and runs compiled if it is one of
+     * the pinned contracts (aot.h).
+     *
      * @param code Contract bytecode
      * @return Execution result and return data
      */
     std::pair<ExecResult, std::vector<uint8_t>> Execute(const std::vector<uint8_t>& code);
 
+    /**
+     * Execute shared contract code (e.g. from WorldState::GetCode), compiled
+     * if ContractCode::Compiled() and AotEnabled()
+     */
+    std::pair<ExecResult, std::vector<uint8_t>> Execute(const ContractCode& code);
+
+    /**
+     * Execute shared contract code with a given translation of it, whether
+     * or not it is pinned (differential tests, benchmarks)
+     *
+     * @param compiled Must have been generated from code.Bytes()
+     */
+    std::pair<ExecResult, std::vector<uint8_t>> Execute(const ContractCode& code,
+                                                        const CompiledContract& compiled);
+
+    /**
+     * Execute contract code with a caller-supplied analysis of that code,
+     * always in the interpreter
+     */
+    std::pair<ExecResult, std::vector<uint8_t>> Execute(const std::vector<uint8_t>& code,
+                                                        const CodeAnalysis& analysis);
+
+    /**
+     * Execute shared contract code, reporting each step to tracer
+     *
+     * Runs a separately compiled copy of the interpreter, so the hooks cost
+     * nothing in the overloads above. Results and gas are identical.
+     */
+    std::pair<ExecResult, std::vector<uint8_t>> Execute(const ContractCode& code, Tracer& tracer);
+
     /**
      * Get gas used
      */
     uint64_t GetGasUsed() const { return gas_used_; }
 
+    /**
+     * Gas refund earned by SSTORE clears (EIP-3529), before the
+     * MAX_REFUND_QUOTIENT cap; zero unless execution succeeded
+     */
+    uint64_t GetGasRefund() const { return static_cast<uint64_t>(std::max<int64_t>(gas_refund_, 0)); }
+
+    /**
+     * Addresses and slots accessed so far (EIP-2929)
+     */
+    const AccessedSet& GetAccessedSet() const { return accessed_; }
+
     /**
      * Get logs generated
      */
     const std::vector<LogEntry>& GetLogs() const { return logs_; }
 
   private:
-    // Stack operations
-    void Push(const uint256_t& value);
-    uint256_t Pop();
-    uint256_t Peek(size_t depth = 0) const;
-    void Dup(uint8_t depth);
-    void Swap(uint8_t depth);
-
-    // Memory operations
-    void MemoryStore(uint64_t offset, const uint256_t& value);
-    void MemoryStore8(uint64_t offset, uint8_t value);
-    uint256_t MemoryLoad(uint64_t offset);
-    void ExpandMemory(uint64_t size);
-    uint64_t GetMemorySize() const { return memory_.size(); }
-
-    // Gas operations
-    bool UseGas(uint64_t amount);
-    uint64_t GetGasRemaining() const;
-
-    // Arithmetic operations
-    uint256_t Add(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Sub(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Mul(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Div(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Mod(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Exp(const uint256_t& base, const uint256_t& exponent) const;
-
-    // Comparison operations
-    bool Lt(const uint256_t& a, const uint256_t& b) const;
-    bool Gt(const uint256_t& a, const uint256_t& b) const;
-    bool Eq(const uint256_t& a, const uint256_t& b) const;
-    bool IsZero(const uint256_t& a) const;
-
-    // Bitwise operations
-    uint256_t And(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Or(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Xor(const uint256_t& a, const uint256_t& b) const;
-    uint256_t Not(const uint256_t& a) const;
-    uint256_t Shl(const uint256_t& shift, const uint256_t& value) const;
-    uint256_t Shr(const uint256_t& shift, const uint256_t& value) const;
-
-    // Execute single opcode
-    ExecResult ExecuteOpcode(Opcode op, const std::vector<uint8_t>& code, size_t& pc);
-
-    // Call operations
-    std::pair<ExecResult, std::vector<uint8_t>> Call(const Address& target, const uint256_t& value,
-                                                     const std::vector<uint8_t>& input,
-                                                     uint64_t gas, bool is_static);
-
-    WorldState& state_;
+    friend class AotFrame;
+
+    // Code offset and not yet charged block gas of each instruction, built
+    // only when tracing (vm.cpp)
+    struct TraceLayout;
+
+    // Checkpointed execution of one frame, by compiled if not null and
+    // otherwise by the interpreter
+    template <typename TracerPolicy>
+    std::pair<ExecResult, std::vector<uint8_t>> ExecuteFrame(const std::vector<uint8_t>& code,
+                                                             const CodeAnalysis& analysis,
+                                                             TracerPolicy& tracer,
+                                                             const TraceLayout* layout,
+                                                             const CompiledContract* compiled);
+
+    // Interpreter loop over an analysed instruction stream. TracerPolicy is
+    // Tracer or NullTracer; layout is only used when tracing.
+    template <typename TracerPolicy>
+    ExecResult Run(const std::vector<uint8_t>& code, const CodeAnalysis& analysis,
+                   TracerPolicy& tracer, const TraceLayout* layout);
+
+    // Run a pinned contract's native code in place of Run()
+    ExecResult RunCompiled(const CompiledContract& compiled, const std::vector<uint8_t>& code);
+
+    // Interpreter state before the instruction at index, given the gas left
+    // after its block was charged
+    TraceStep StepAt(const CodeAnalysis& analysis, const TraceLayout& layout, size_t index,
+                     const Word* sp, int64_t gas_left) const;
+
+    // Charge for and perform memory expansion to cover [offset, offset + size).
+    // Returns false if out of gas or the range is unaddressable.
+    bool ExpandMemory(const Word& offset, const Word& size, int64_t& gas_left, uint64_t& start);
+
+    // Instruction bodies shared by Run() and compiled contracts. sp is one
+    // past the top of the stack and is left for the caller to move; each
+    // returns SUCCESS to continue or the result to halt with.
+    Word Environment(Handler handler, const std::vector<uint8_t>& code) const;  // Push-only ops
+    ExecResult OpSha3(Word* sp, int64_t& gas_left);
+    ExecResult OpBalance(Word* sp, int64_t& gas_left);
+    void OpCallDataLoad(Word* sp) const;
+    ExecResult OpCopy(Word* sp, int64_t& gas_left, const std::vector<uint8_t>& source);
+    ExecResult OpMload(Word* sp, int64_t& gas_left);
+    ExecResult OpMstore(Word* sp, int64_t& gas_left);
+    ExecResult OpMstore8(Word* sp, int64_t& gas_left);
+    ExecResult OpSload(Word* sp, int64_t& gas_left);
+    ExecResult OpSstore(Word* sp, int64_t& gas_left, uint32_t later_gas);
+    ExecResult OpLog(Word* sp, int64_t& gas_left, uint32_t topics);
+    ExecResult OpReturn(Word* sp, int64_t& gas_left);  // Sets return_data_ for RETURN/REVERT
+    ExecResult OpReturnDataCopy(Word* sp, int64_t& gas_left);
+
+    // CALL, CALLCODE, DELEGATECALL or STATICCALL (by handler): charges the
+    // call, runs it through Call() and writes the success flag, leaving
+    // the callee's output in return_data_. tracer is null when untraced.
+    ExecResult OpCall(Word* sp, int64_t& gas_left, Handler handler, Tracer* tracer);
+
+    // Run a nested frame with child's context and code_address's code: a
+    // precompile, a contract in a new VM at child.depth, or nothing for an
+    // account without code. Moves child.value from child.caller to
+    // child.address first if transfer is set; a failed call undoes it and
+    // every other state change. Sets gas_used to the gas the callee consumed.
+    std::pair<ExecResult, std::vector<uint8_t>> Call(const ExecutionContext& child,
+                                                     const Address& code_address, bool transfer,
+                                                     Tracer* tracer, uint64_t& gas_used);
+
+    StateAccess& state_;
     ExecutionContext ctx_;
 
-    std::vector<uint256_t> stack_;
-    std::vector<uint8_t> memory_;
+    // Regions of the running frame in the thread's FrameArena, set by
+    // ExecuteFrame(); the stack's height is tracked by Run()
+    FrameArena::Frame* frame_ = nullptr;
+    Word* stack_ = nullptr;
+    uint8_t* memory_ = nullptr;
     std::vector<uint8_t> return_data_;
     std::vector<LogEntry> logs_;
 
     uint64_t gas_used_;
+    int64_t gas_refund_ = 0;
+
+    AccessedSet accessed_;
+    // Value of each slot before its first SSTORE (EIP-2200 original value)
+    std::map<std::pair<Address, uint256_t>, uint256_t> original_storage_;
 
-    static constexpr size_t MAX_STACK_SIZE = 1024;
+    static constexpr size_t MAX_STACK_SIZE = FrameArena::STACK_SLOTS;
     static constexpr size_t MAX_CALL_DEPTH = 1024;
+    static constexpr uint64_t MAX_MEMORY_SIZE = uint64_t{1} << 32;
 };
 
 }  // namespace evm
@@ -0,0 +1,152 @@
+// ParthenonChain - Obolos Block Executor Benchmark
+// Blocks of token transfers from many senders, with state and receipt roots
+// hashed inline or pipelined behind the next block, broken down by stage
+
+#include "evm/aot.h"
+#include "evm/block_executor.h"
+#include "evm/gas_pricing.h"
+#include "evm/state.h"
+#include "evm/uint256.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace parthenon::evm;
+using pantheon::obolos::ExecutedBlock;
+using pantheon::obolos::ObolosBlock;
+using pantheon::obolos::ObolosBlockExecutor;
+using pantheon::obolos::ObolosTransaction;
+
+namespace {
+
+constexpr size_t kAccounts = 10000;
+
+Address Account(size_t index) {
+    Address addr{};
+    addr[0] = 0x11;
+    for (int i = 0; i < 8; ++i) {
+        addr[19 - i] = static_cast<uint8_t>(index >> (8 * i));
+    }
+    return addr;
+}
+
+const Address kToken = [] {
+    Address addr{};
+    addr[19] = 0xc0;
+    return addr;
+}();
+
+std::vector<uint8_t> TokenCode() {
+    for (const CompiledContract* compiled : ListCompiledContracts()) {
+        if (std::string(compiled->name) == "token_transfer") {
+            return std::vector<uint8_t>(compiled->code, compiled->code + compiled->code_size);
+        }
+    }
+    return {};
+}
+
+uint256_t Word32(const Address& addr) {
+    uint256_t word{};
+    std::copy(addr.begin(), addr.end(), word.begin() + 12);
+    return word;
+}
+
+WorldState MakeState() {
+    WorldState state;
+    state.SetCode(kToken, TokenCode());
+    for (size_t i = 0; i < kAccounts; ++i) {
+        state.SetBalance(Account(i), ToUint256(1000000000000ULL));
+        state.SetStorage(kToken, Word32(Account(i)), ToUint256(1000000));
+    }
+    return state;
+}
+
+// Blocks of txs_per_block transfers between random accounts; base fees
+// follow from a dry run, so both modes see the same valid chain
+std::vector<ObolosBlock> MakeChain(size_t blocks, size_t txs_per_block) {
+    WorldState scratch = MakeState();
+    ObolosBlockExecutor executor(scratch, 1, false);
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> nonces(kAccounts, 0);
+    std::vector<ObolosBlock> chain;
+    uint64_t base_fee = GasPricing::INITIAL_BASE_FEE;
+    for (size_t b = 0; b < blocks; ++b) {
+        ObolosBlock block;
+        block.number = b + 1;
+        block.timestamp = 1700000000 + b;
+        block.coinbase = Account(0);
+        block.gas_limit = GasPricing::MAX_GAS_PER_BLOCK;
+        block.base_fee = base_fee;
+        for (size_t t = 0; t < txs_per_block; ++t) {
+            const size_t from = rng() % kAccounts;
+            ObolosTransaction tx;
+            tx.from = Account(from);
+            tx.to = kToken;
+            tx.nonce = nonces[from]++;
+            tx.gas_limit = 100000;
+            tx.max_fee_per_gas = 1000;
+            tx.max_priority_fee_per_gas = 1;
+            const uint256_t to = Word32(Account(rng() % kAccounts));
+            const uint256_t amount = ToUint256(1);
+            tx.data.insert(tx.data.end(), to.begin(), to.end());
+            tx.data.insert(tx.data.end(), amount.begin(), amount.end());
+            block.transactions.push_back(tx);
+        }
+        const ExecutedBlock executed = executor.ExecuteBlock(block);
+        if (!executed.valid) {
+            std::cerr << "invalid block: " << executed.error << std::endl;
+            std::exit(1);
+        }
+        base_fee = CalculateNextBaseFee(base_fee, executed.gas_used, block.gas_limit);
+        chain.push_back(std::move(block));
+    }
+    return chain;
+}
+
+void Run(const std::vector<ObolosBlock>& chain, bool pipeline) {
+    WorldState state = MakeState();
+    const auto start = std::chrono::steady_clock::now();
+    ObolosBlockExecutor executor(state, 1, pipeline);
+    for (const auto& block : chain) {
+        executor.ExecuteBlock(block);
+    }
+    executor.WaitForRoots();
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto stats = executor.GetStats();
+    auto ms = [](uint64_t ns) { return ns / 1e6; };
+    std::cout << std::left << std::setw(11) << (pipeline ? "pipelined" : "inline") << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10) << seconds * 1e3
+              << std::setw(10) << ms(stats.timings.execute_ns) << std::setw(10)
+              << ms(stats.timings.collect_ns) << std::setw(12) << ms(stats.timings.state_root_ns)
+              << std::setw(14) << ms(stats.timings.receipts_root_ns) << std::setw(10)
+              << stats.gas_used / seconds / 1e6 << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t blocks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50;
+    const size_t txs = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 500;
+
+    std::cout << "=== Obolos Block Executor Benchmark ===" << std::endl;
+    std::cout << blocks << " blocks of " << txs << " token transfers, " << kAccounts
+              << " accounts" << std::endl;
+    const auto chain = MakeChain(blocks, txs);
+
+    std::cout << std::left << std::setw(11) << "roots" << std::right << std::setw(10)
+              << "wall ms" << std::setw(10) << "execute" << std::setw(10) << "collect"
+              << std::setw(12) << "state root" << std::setw(14) << "receipts root"
+              << std::setw(10) << "Mgas/s" << std::endl;
+    Run(chain, false);
+    Run(chain, true);
+    return 0;
+}
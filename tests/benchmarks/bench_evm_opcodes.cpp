@@ -0,0 +1,392 @@
+// ParthenonChain - EVM Opcode Benchmark
+// Per-opcode throughput of the interpreter and of 256-bit word arithmetic,
+// plus dispatch cost on a jump-heavy loop and the pinned contracts compiled
+// ahead of time against the interpreter
+
+#include "evm/analysis.h"
+#include "evm/aot.h"
+#include "evm/frame_arena.h"
+#include "evm/opcodes.h"
+#include "evm/state.h"
+#include "evm/tracer.h"
+#include "evm/uint256.h"
+#include "evm/vm.h"
+#include "crypto/keccak.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace parthenon::evm;
+
+namespace {
+
+// Byte-array arithmetic as implemented before the limb representation, kept
+// here so the two can be compared on the same host.
+namespace bytewise {
+
+uint256_t Add(const uint256_t& a, const uint256_t& b) {
+    uint256_t result{};
+    uint16_t carry = 0;
+    for (int i = 31; i >= 0; i--) {
+        uint16_t sum = static_cast<uint16_t>(a[i]) + static_cast<uint16_t>(b[i]) + carry;
+        result[i] = static_cast<uint8_t>(sum & 0xFF);
+        carry = sum >> 8;
+    }
+    return result;
+}
+
+uint256_t Sub(const uint256_t& a, const uint256_t& b) {
+    uint256_t result{};
+    int16_t borrow = 0;
+    for (int i = 31; i >= 0; i--) {
+        int16_t diff = static_cast<int16_t>(a[i]) - static_cast<int16_t>(b[i]) - borrow;
+        borrow = diff < 0;
+        result[i] = static_cast<uint8_t>(diff < 0 ? diff + 256 : diff);
+    }
+    return result;
+}
+
+bool Lt(const uint256_t& a, const uint256_t& b) {
+    for (int i = 0; i < 32; i++) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i];
+        }
+    }
+    return false;
+}
+
+uint256_t Mul(const uint256_t& a, const uint256_t& b) {
+    uint256_t result{};
+    for (int i = 31; i >= 0; i--) {
+        if (b[i] == 0) {
+            continue;
+        }
+        uint16_t carry = 0;
+        for (int j = 31; j >= 0; j--) {
+            int idx = j + (31 - i);
+            if (idx >= 32) {
+                continue;
+            }
+            uint32_t product = static_cast<uint32_t>(a[j]) * b[i] + result[idx] + carry;
+            result[idx] = static_cast<uint8_t>(product & 0xFF);
+            carry = static_cast<uint16_t>(product >> 8);
+        }
+    }
+    return result;
+}
+
+uint256_t DivMod(const uint256_t& a, const uint256_t& b, bool want_rem) {
+    uint256_t quotient{};
+    uint256_t remainder{};
+    for (int i = 0; i < 256; i++) {
+        uint16_t carry = 0;
+        for (int j = 31; j >= 0; j--) {
+            uint16_t shifted = (static_cast<uint16_t>(remainder[j]) << 1) | carry;
+            remainder[j] = static_cast<uint8_t>(shifted & 0xFF);
+            carry = shifted >> 8;
+        }
+        if ((a[i / 8] >> (7 - i % 8)) & 1) {
+            remainder[31] |= 1;
+        }
+        if (!Lt(remainder, b)) {
+            remainder = Sub(remainder, b);
+            quotient[i / 8] |= static_cast<uint8_t>(1 << (7 - i % 8));
+        }
+    }
+    return want_rem ? remainder : quotient;
+}
+
+uint256_t Exp(const uint256_t& base, const uint256_t& exponent) {
+    uint256_t result = ToUint256(1);
+    uint256_t current = base;
+    for (int i = 0; i < 256; i++) {
+        if ((exponent[31 - i / 8] >> (i % 8)) & 1) {
+            result = Mul(result, current);
+        }
+        current = Mul(current, current);
+    }
+    return result;
+}
+
+uint256_t Shl(uint64_t shift, const uint256_t& value) {
+    uint256_t result{};
+    if (shift >= 256) {
+        return result;
+    }
+    for (int bit = 0; bit + static_cast<int>(shift) < 256; ++bit) {
+        if ((value[31 - bit / 8] >> (bit % 8)) & 1) {
+            const int dst = bit + static_cast<int>(shift);
+            result[31 - dst / 8] |= static_cast<uint8_t>(1 << (dst % 8));
+        }
+    }
+    return result;
+}
+
+}  // namespace bytewise
+
+template <typename Fn>
+double NanosPerOp(size_t iterations, Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+// Keeps results alive without a data dependency between iterations
+volatile uint64_t sink;
+
+void BenchArithmetic(size_t iterations) {
+    const Word a(0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL, 0x0F1E2D3C4B5A6978ULL,
+                 0x1122334455667788ULL);
+    const Word b(0x1111111111111111ULL, 0x2222222222222222ULL, 0x3333333333333333ULL, 0);
+    const Word e(65537);
+    const uint256_t ab = a.ToBytes();
+    const uint256_t bb = b.ToBytes();
+    const uint256_t eb = e.ToBytes();
+
+    struct Case {
+        const char* name;
+        std::function<void(size_t)> limbs;
+        std::function<void(size_t)> bytes;
+    };
+    const std::vector<Case> cases = {
+        {"ADD", [&](size_t i) { sink = (a + Word(i)).limbs[0]; },
+         [&](size_t i) { sink = bytewise::Add(ab, ToUint256(i))[31]; }},
+        {"SUB", [&](size_t i) { sink = (a - Word(i)).limbs[0]; },
+         [&](size_t i) { sink = bytewise::Sub(ab, ToUint256(i))[31]; }},
+        {"MUL", [&](size_t i) { sink = (a * (b + Word(i))).limbs[0]; },
+         [&](size_t i) { sink = bytewise::Mul(ab, bytewise::Add(bb, ToUint256(i)))[31]; }},
+        {"DIV", [&](size_t i) { sink = (a / (b + Word(i))).limbs[0]; },
+         [&](size_t i) { sink = bytewise::DivMod(ab, bytewise::Add(bb, ToUint256(i)), false)[31]; }},
+        {"MOD", [&](size_t i) { sink = (a % (b + Word(i))).limbs[0]; },
+         [&](size_t i) { sink = bytewise::DivMod(ab, bytewise::Add(bb, ToUint256(i)), true)[31]; }},
+        {"EXP", [&](size_t i) { sink = Exp(a + Word(i), e).limbs[0]; },
+         [&](size_t i) { sink = bytewise::Exp(bytewise::Add(ab, ToUint256(i)), eb)[31]; }},
+        {"LT", [&](size_t i) { sink = (a + Word(i)) < b; },
+         [&](size_t i) { sink = bytewise::Lt(bytewise::Add(ab, ToUint256(i)), bb); }},
+        {"SHL", [&](size_t i) { sink = (a << (i & 255)).limbs[0]; },
+         [&](size_t i) { sink = bytewise::Shl(i & 255, ab)[31]; }},
+    };
+
+    std::cout << std::left << std::setw(8) << "op" << std::setw(16) << "limbs ns/op"
+              << std::setw(16) << "bytes ns/op" << "speedup" << std::endl;
+    for (const auto& c : cases) {
+        // Bytewise DIV/MOD/EXP are slow; scale their iteration count down
+        const size_t n = iterations;
+        const size_t slow_n = std::max<size_t>(1, iterations / 20);
+        const double limbs = NanosPerOp(n, c.limbs);
+        const double bytes = NanosPerOp(slow_n, c.bytes);
+        std::cout << std::left << std::setw(8) << c.name << std::setw(16) << std::fixed
+                  << std::setprecision(1) << limbs << std::setw(16) << bytes << std::setprecision(1)
+                  << bytes / limbs << "x" << std::endl;
+    }
+}
+
+// Runs `PUSH32 x, PUSH32 y, <op>, POP` blocks through the interpreter and
+// compares them with `PUSH32 x, PUSH32 y, POP, POP` blocks, so the delta is
+// the opcode's cost over a POP (dispatch + stack traffic cancel out).
+void BenchInterpreter(size_t repetitions) {
+    const std::vector<std::pair<const char*, Opcode>> ops = {
+        {"ADD", Opcode::ADD}, {"SUB", Opcode::SUB},   {"MUL", Opcode::MUL},
+        {"DIV", Opcode::DIV}, {"SDIV", Opcode::SDIV}, {"MOD", Opcode::MOD},
+        {"EXP", Opcode::EXP}, {"LT", Opcode::LT},     {"SLT", Opcode::SLT},
+        {"EQ", Opcode::EQ},   {"AND", Opcode::AND},   {"SHL", Opcode::SHL},
+        {"SHR", Opcode::SHR}, {"SAR", Opcode::SAR},   {"BYTE", Opcode::BYTE},
+    };
+
+    const size_t kBlocks = 200;  // Per program, stays well inside the stack limit
+    auto make_program = [&](Opcode op, bool baseline) {
+        std::vector<uint8_t> code;
+        for (size_t i = 0; i < kBlocks; ++i) {
+            for (int operand = 0; operand < 2; ++operand) {
+                code.push_back(static_cast<uint8_t>(Opcode::PUSH32));
+                for (int byte = 0; byte < 32; ++byte) {
+                    code.push_back(static_cast<uint8_t>(0x11 * (operand + 1) + byte + i));
+                }
+            }
+            code.push_back(static_cast<uint8_t>(baseline ? Opcode::POP : op));
+            code.push_back(static_cast<uint8_t>(Opcode::POP));
+        }
+        return code;
+    };
+
+    auto run = [&](const std::vector<uint8_t>& code) {
+        ExecutionContext ctx{};
+        ctx.gas_limit = UINT64_MAX / 2;
+        WorldState state;
+        return NanosPerOp(repetitions, [&](size_t) {
+            VM vm(state, ctx);
+            vm.Execute(code);
+        });
+    };
+
+    std::cout << std::endl
+              << std::left << std::setw(8) << "op" << std::setw(16) << "block ns"
+              << "op - POP ns" << std::endl;
+    const double baseline = run(make_program(Opcode::POP, true)) / kBlocks;
+    for (const auto& [name, op] : ops) {
+        const double block = run(make_program(op, false)) / kBlocks;
+        std::cout << std::left << std::setw(8) << name << std::fixed << std::setprecision(1)
+                  << std::setw(16) << block << block - baseline << std::endl;
+    }
+}
+
+// Counts a loop down from kIterations (10 instructions per pass), so most of
+// the work is dispatch and block entry. Compares a cached analysis with
+// re-analysing the code on every call, and with tracing to hooks that do
+// nothing (the interpreter's tracing overhead).
+void BenchDispatch(size_t repetitions) {
+    const uint16_t kIterations = 1000;
+    const std::vector<uint8_t> code = {
+        static_cast<uint8_t>(Opcode::PUSH2), kIterations >> 8, kIterations & 0xFF,
+        static_cast<uint8_t>(Opcode::JUMPDEST),  // 3: loop
+        static_cast<uint8_t>(Opcode::PUSH1), 0x01,
+        static_cast<uint8_t>(Opcode::SWAP1),
+        static_cast<uint8_t>(Opcode::SUB),
+        static_cast<uint8_t>(Opcode::DUP1),
+        static_cast<uint8_t>(Opcode::ISZERO),
+        static_cast<uint8_t>(Opcode::ISZERO),
+        static_cast<uint8_t>(Opcode::PUSH1), 0x03,
+        static_cast<uint8_t>(Opcode::JUMPI),
+        static_cast<uint8_t>(Opcode::STOP),
+    };
+    const double instructions = kIterations * 10.0;
+
+    ExecutionContext ctx{};
+    ctx.gas_limit = UINT64_MAX / 2;
+    WorldState state;
+
+    const double cached = NanosPerOp(repetitions, [&](size_t) {
+        VM vm(state, ctx);
+        vm.Execute(code);
+    });
+    const double uncached = NanosPerOp(repetitions, [&](size_t) {
+        auto analysis = AnalyzeCode(code);
+        VM vm(state, ctx);
+        vm.Execute(code, *analysis);
+    });
+    const ContractCode shared(HashCode(code), code);
+    Tracer no_op;
+    const double traced = NanosPerOp(repetitions, [&](size_t) {
+        VM vm(state, ctx);
+        vm.Execute(shared, no_op);
+    });
+
+    std::cout << std::endl
+              << "loop (" << kIterations << " passes): cached " << std::fixed
+              << std::setprecision(2) << cached / instructions << " ns/instr, re-analysed "
+              << uncached / instructions << " ns/instr, traced "
+              << traced / instructions << " ns/instr" << std::endl;
+}
+
+// Short frames that touch a little memory and return a word: the per-call
+// overhead of a VM, including its stack and memory from the FrameArena
+void BenchFrames(size_t repetitions) {
+    const std::vector<uint8_t> code = {
+        static_cast<uint8_t>(Opcode::CALLVALUE),
+        static_cast<uint8_t>(Opcode::PUSH2), 0x01, 0x00,
+        static_cast<uint8_t>(Opcode::MSTORE),
+        static_cast<uint8_t>(Opcode::PUSH1), 0x20,
+        static_cast<uint8_t>(Opcode::PUSH2), 0x01, 0x00,
+        static_cast<uint8_t>(Opcode::RETURN),
+    };
+
+    ExecutionContext ctx{};
+    ctx.gas_limit = 100000;
+    WorldState state;
+    const ContractCode shared(HashCode(code), code);
+
+    auto& arena = FrameArena::ForThread();
+    const auto before = arena.GetStats();
+    const double per_frame = NanosPerOp(repetitions, [&](size_t) {
+        VM vm(state, ctx);
+        sink = vm.Execute(shared).second.size();
+    });
+    const auto after = arena.GetStats();
+
+    std::cout << std::endl
+              << "frame (MSTORE + RETURN): " << std::fixed << std::setprecision(1) << per_frame
+              << " ns/frame, arena commits " << after.commits - before.commits << " over "
+              << after.frames - before.frames << " frames" << std::endl;
+}
+
+// Each pinned contract (aot.h) on a typical call, interpreted and compiled.
+// Token calls run against a pre-minted balance and succeed every time.
+void BenchCompiled(size_t repetitions) {
+    Address contract{};
+    contract[19] = 0xc0;
+    Address holder{};
+    holder[19] = 0x11;
+    uint256_t holder_word{};
+    std::copy(holder.begin(), holder.end(), holder_word.begin() + 12);
+
+    std::cout << std::endl
+              << std::left << std::setw(16) << "contract" << std::setw(16) << "interpreted ns"
+              << std::setw(16) << "compiled ns" << "speedup" << std::endl;
+    for (const CompiledContract* compiled : ListCompiledContracts()) {
+        const std::string name = compiled->name;
+        const std::vector<uint8_t> code(compiled->code, compiled->code + compiled->code_size);
+        const ContractCode shared(HashCode(code), code);
+
+        ExecutionContext ctx{};
+        ctx.gas_limit = 10000000;
+        ctx.caller = holder;
+        ctx.origin = holder;
+        ctx.address = contract;
+        auto append = [&](const uint256_t& word) {
+            ctx.input_data.insert(ctx.input_data.end(), word.begin(), word.end());
+        };
+        WorldState state;
+        if (name == "erc20") {
+            ctx.input_data = {0xa9, 0x05, 0x9c, 0xbb};  // transfer(holder, 1)
+            append(holder_word);
+            append(ToUint256(1));
+            std::vector<uint8_t> key(holder_word.begin(), holder_word.end());
+            key.resize(64);  // Balance slot: keccak(holder . 0)
+            state.SetStorage(contract, parthenon::crypto::Keccak256::Hash256(key),
+                             ToUint256(1000000));
+        } else if (name == "hash_chain") {
+            append(ToUint256(7));  // 100 hashes of a seed
+            append(ToUint256(100));
+        } else {
+            append(holder_word);  // token_transfer to self
+            append(ToUint256(1));
+            state.SetStorage(contract, holder_word, ToUint256(1000000));
+        }
+
+        const double interpreted = NanosPerOp(repetitions, [&](size_t) {
+            VM vm(state, ctx);
+            sink = vm.Execute(shared.Bytes(), shared.Analysis()).second.size();
+        });
+        const double native = NanosPerOp(repetitions, [&](size_t) {
+            VM vm(state, ctx);
+            sink = vm.Execute(shared, *compiled).second.size();
+        });
+        std::cout << std::left << std::setw(16) << name << std::fixed << std::setprecision(1)
+                  << std::setw(16) << interpreted << std::setw(16) << native
+                  << std::setprecision(2) << interpreted / native << "x" << std::endl;
+    }
+}
+
+}  // namespace
+
+
+int main(int argc, char* argv[]) {
+    const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    std::cout << "=== EVM Opcode Benchmark ===" << std::endl;
+    BenchArithmetic(iterations);
+    BenchInterpreter(std::max<size_t>(1, iterations / 200));
+    BenchDispatch(std::max<size_t>(1, iterations / 200));
+    BenchFrames(std::max<size_t>(1, iterations / 2));
+    BenchCompiled(std::max<size_t>(1, iterations / 20));
+    return 0;
+}
@@ -0,0 +1,251 @@
+// ParthenonChain - EVM State-Test Workload Benchmark
+// Whole transactions against persistent state, reported as Mgas/s: ERC-20
+// transfers, a constant-product (Uniswap-style) swap, a SHA3 loop and a
+// memory copy loop. Pinned contracts are also run compiled ahead of time.
+
+#include "evm/aot.h"
+#include "evm/code_cache.h"
+#include "evm/opcodes.h"
+#include "evm/state.h"
+#include "evm/uint256.h"
+#include "evm/vm.h"
+#include "crypto/keccak.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace parthenon::evm;
+
+namespace {
+
+// Swap amount_in (calldata word 0) of token 0 for token 1 at 0.3% fee against
+// reserves in slots 0 and 1, credit the caller's token 1 balance at
+// keccak(caller . 2), log Swap(amount_in, amount_out) and return amount_out.
+const std::vector<uint8_t> kSwap = {
+    0x60, 0x00,        // PUSH1 0
+    0x35,              // CALLDATALOAD           in
+    0x80,              // DUP1
+    0x61, 0x03, 0xe5,  // PUSH2 997
+    0x02,              // MUL                    in*997 in
+    0x60, 0x00,        // PUSH1 0
+    0x54,              // SLOAD                  r0 in*997 in
+    0x61, 0x03, 0xe8,  // PUSH2 1000
+    0x02,              // MUL
+    0x81,              // DUP2
+    0x01,              // ADD                    denominator in*997 in
+    0x60, 0x01,        // PUSH1 1
+    0x54,              // SLOAD                  r1 denominator in*997 in
+    0x82,              // DUP3
+    0x02,              // MUL
+    0x04,              // DIV                    out in*997 in
+    0x90,              // SWAP1
+    0x50,              // POP                    out in
+    0x81,              // DUP2
+    0x60, 0x00,        // PUSH1 0
+    0x54,              // SLOAD
+    0x01,              // ADD
+    0x60, 0x00,        // PUSH1 0
+    0x55,              // SSTORE                 r0 += in
+    0x80,              // DUP1
+    0x60, 0x01,        // PUSH1 1
+    0x54,              // SLOAD
+    0x03,              // SUB
+    0x60, 0x01,        // PUSH1 1
+    0x55,              // SSTORE                 r1 -= out
+    0x33,              // CALLER
+    0x60, 0x00,        // PUSH1 0
+    0x52,              // MSTORE
+    0x60, 0x02,        // PUSH1 2
+    0x60, 0x20,        // PUSH1 32
+    0x52,              // MSTORE
+    0x60, 0x40,        // PUSH1 64
+    0x60, 0x00,        // PUSH1 0
+    0x20,              // SHA3                   slot out in
+    0x80,              // DUP1
+    0x54,              // SLOAD
+    0x82,              // DUP3
+    0x01,              // ADD
+    0x90,              // SWAP1
+    0x55,              // SSTORE                 balance += out
+    0x81,              // DUP2
+    0x60, 0x00,        // PUSH1 0
+    0x52,              // MSTORE
+    0x80,              // DUP1
+    0x60, 0x20,        // PUSH1 32
+    0x52,              // MSTORE
+    0x63, 0xd7, 0x8a, 0xd9, 0x5f,  // PUSH4 Swap topic
+    0x60, 0x40,        // PUSH1 64
+    0x60, 0x00,        // PUSH1 0
+    0xa1,              // LOG1
+    0x60, 0x00,        // PUSH1 0
+    0x52,              // MSTORE
+    0x60, 0x20,        // PUSH1 32
+    0x60, 0x00,        // PUSH1 0
+    0xf3,              // RETURN                 out
+};
+
+// Copy calldata into memory, then copy calldata word 0 words of it, one
+// MLOAD/MSTORE at a time, to just past the source.
+const std::vector<uint8_t> kMemoryCopy = {
+    0x36,              // 0000 CALLDATASIZE
+    0x60, 0x00,        // 0001 PUSH1 0
+    0x60, 0x00,        // 0003 PUSH1 0
+    0x37,              // 0005 CALLDATACOPY
+    0x60, 0x00,        // 0006 PUSH1 0
+    0x35,              // 0008 CALLDATALOAD      n
+    0x60, 0x00,        // 0009 PUSH1 0           i n
+    0x5b,              // 000b JUMPDEST
+    0x81,              // 000c DUP2
+    0x81,              // 000d DUP2
+    0x10,              // 000e LT
+    0x15,              // 000f ISZERO
+    0x61, 0x00, 0x29,  // 0010 PUSH2 0x0029
+    0x57,              // 0013 JUMPI
+    0x80,              // 0014 DUP1
+    0x60, 0x05,        // 0015 PUSH1 5
+    0x1b,              // 0017 SHL               i*32 i n
+    0x80,              // 0018 DUP1
+    0x51,              // 0019 MLOAD
+    0x83,              // 001a DUP4
+    0x60, 0x05,        // 001b PUSH1 5
+    0x1b,              // 001d SHL
+    0x82,              // 001e DUP3
+    0x01,              // 001f ADD               n*32+i*32 word i*32 i n
+    0x52,              // 0020 MSTORE
+    0x50,              // 0021 POP
+    0x60, 0x01,        // 0022 PUSH1 1
+    0x01,              // 0024 ADD
+    0x61, 0x00, 0x0b,  // 0025 PUSH2 0x000b
+    0x56,              // 0028 JUMP
+    0x5b,              // 0029 JUMPDEST
+    0x00,              // 002a STOP
+};
+
+struct Workload {
+    std::string name;
+    std::vector<uint8_t> code;
+    ExecutionContext ctx;
+    WorldState state;
+};
+
+void Append(std::vector<uint8_t>& data, const uint256_t& word) {
+    data.insert(data.end(), word.begin(), word.end());
+}
+
+std::vector<uint8_t> PinnedCode(const std::string& name) {
+    for (const CompiledContract* compiled : ListCompiledContracts()) {
+        if (compiled->name == name) {
+            return std::vector<uint8_t>(compiled->code, compiled->code + compiled->code_size);
+        }
+    }
+    return {};
+}
+
+std::vector<Workload> MakeWorkloads() {
+    Address contract{};
+    contract[19] = 0xc0;
+    Address holder{};
+    holder[19] = 0x11;
+    uint256_t holder_word{};
+    std::copy(holder.begin(), holder.end(), holder_word.begin() + 12);
+
+    ExecutionContext ctx{};
+    ctx.gas_limit = 10000000;
+    ctx.caller = holder;
+    ctx.origin = holder;
+    ctx.address = contract;
+
+    std::vector<Workload> workloads;
+
+    Workload erc20{"erc20 transfer", PinnedCode("erc20"), ctx, {}};
+    erc20.ctx.input_data = {0xa9, 0x05, 0x9c, 0xbb};  // transfer(holder, 1)
+    Append(erc20.ctx.input_data, holder_word);
+    Append(erc20.ctx.input_data, ToUint256(1));
+    std::vector<uint8_t> key(holder_word.begin(), holder_word.end());
+    key.resize(64);  // Balance slot: keccak(holder . 0)
+    erc20.state.SetStorage(contract, parthenon::crypto::Keccak256::Hash256(key),
+                           ToUint256(1000000));
+    workloads.push_back(erc20);
+
+    Workload swap{"uniswap swap", kSwap, ctx, {}};
+    Append(swap.ctx.input_data, ToUint256(1000));
+    swap.state.SetStorage(contract, ToUint256(0), ToUint256(1000000000000000ULL));
+    swap.state.SetStorage(contract, ToUint256(1), ToUint256(2000000000000000ULL));
+    workloads.push_back(swap);
+
+    Workload sha3{"sha3 loop", PinnedCode("hash_chain"), ctx, {}};
+    Append(sha3.ctx.input_data, ToUint256(7));  // 100 hashes of a seed
+    Append(sha3.ctx.input_data, ToUint256(100));
+    workloads.push_back(sha3);
+
+    Workload copy{"memory copy", kMemoryCopy, ctx, {}};
+    Append(copy.ctx.input_data, ToUint256(256));  // 8 KB source
+    copy.ctx.input_data.resize(256 * 32, 0x5a);
+    workloads.push_back(copy);
+
+    return workloads;
+}
+
+struct Rate {
+    uint64_t gas_per_tx = 0;
+    double seconds = 0;
+    bool ok = true;
+};
+
+// Runs txs transactions one after another against the workload's state
+template <typename Fn>
+Rate Measure(Workload& workload, size_t txs, Fn&& execute) {
+    Rate rate;
+    uint64_t gas = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < txs; ++i) {
+        VM vm(workload.state, workload.ctx);
+        const ExecResult result = execute(vm);
+        rate.ok = rate.ok && (result == ExecResult::SUCCESS || result == ExecResult::RETURNED);
+        gas += vm.GetGasUsed();
+    }
+    rate.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    rate.gas_per_tx = gas / txs;
+    return rate;
+}
+
+void Report(const std::string& name, const char* mode, size_t txs, const Rate& rate) {
+    const double gas = static_cast<double>(rate.gas_per_tx) * txs;
+    std::cout << std::left << std::setw(18) << name << std::setw(13) << mode << std::right
+              << std::setw(10) << rate.gas_per_tx << std::fixed << std::setprecision(0)
+              << std::setw(12) << txs / rate.seconds << std::setprecision(1) << std::setw(10)
+              << gas / rate.seconds / 1e6 << (rate.ok ? "" : "  (FAILED)") << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t txs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+
+    std::cout << "=== EVM State-Test Workload Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(18) << "workload" << std::setw(13) << "mode"
+              << std::right << std::setw(10) << "gas/tx" << std::setw(12) << "tx/s"
+              << std::setw(10) << "Mgas/s" << std::endl;
+
+    for (Workload& workload : MakeWorkloads()) {
+        const ContractCode shared(HashCode(workload.code), workload.code);
+        const Rate interpreted = Measure(workload, txs, [&](VM& vm) {
+            return vm.Execute(shared.Bytes(), shared.Analysis()).first;
+        });
+        Report(workload.name, "interpreted", txs, interpreted);
+
+        const CompiledContract* compiled = FindCompiledContract(shared.Hash());
+        if (compiled != nullptr) {
+            const Rate native = Measure(
+                workload, txs, [&](VM& vm) { return vm.Execute(shared, *compiled).first; });
+            Report(workload.name, "compiled", txs, native);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+// ParthenonChain - Keccak-256 Benchmark
+// Scalar Keccak-256 against SHA-256 by message size, and batched hashing of
+// trie-node-sized messages one at a time against HashBatch()
+
+#include "crypto/keccak.h"
+#include "crypto/sha256.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace parthenon::crypto;
+
+namespace {
+
+double NanosSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Best of several runs of fn, in ns per call of `calls`
+template <typename Fn>
+double BestNanos(size_t calls, Fn&& fn) {
+    double best = 1e30;
+    for (int run = 0; run < 5; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, NanosSince(start) / static_cast<double>(calls));
+    }
+    return best;
+}
+
+uint8_t sink = 0;
+
+void BenchSingle(size_t size) {
+    constexpr size_t kCalls = 20000;
+    std::vector<uint8_t> message(size, 0x5A);
+    const double keccak_ns = BestNanos(kCalls, [&]() {
+        for (size_t i = 0; i < kCalls; ++i) {
+            message[0] = static_cast<uint8_t>(i);
+            sink ^= Keccak256::Hash256(message)[0];
+        }
+    });
+    const double sha_ns = BestNanos(kCalls, [&]() {
+        for (size_t i = 0; i < kCalls; ++i) {
+            message[0] = static_cast<uint8_t>(i);
+            sink ^= SHA256::Hash256(message)[0];
+        }
+    });
+    std::cout << std::left << std::setw(10) << size << std::setw(16) << std::fixed
+              << std::setprecision(1) << keccak_ns << std::setw(16) << sha_ns
+              << std::setprecision(0) << size * 1000.0 / keccak_ns << std::endl;
+}
+
+// Messages sized like branch (~530 bytes), extension and leaf nodes
+void BenchBatch(size_t count) {
+    std::mt19937 rng(7);
+    std::vector<std::vector<uint8_t>> messages(count);
+    for (auto& message : messages) {
+        const uint32_t kind = rng() % 4;
+        message.assign(kind == 0 ? 530 : kind == 1 ? 70 : 40 + rng() % 60, 0);
+        for (auto& byte : message) {
+            byte = static_cast<uint8_t>(rng());
+        }
+    }
+    std::vector<const uint8_t*> data;
+    std::vector<size_t> sizes;
+    for (const auto& message : messages) {
+        data.push_back(message.data());
+        sizes.push_back(message.size());
+    }
+    std::vector<Keccak256::Hash> hashes(count);
+
+    const double single_ns = BestNanos(count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            hashes[i] = Keccak256::Hash256(data[i], sizes[i]);
+        }
+    });
+    const double batch_ns = BestNanos(count, [&]() {
+        Keccak256::HashBatch(data.data(), sizes.data(), count, hashes.data());
+    });
+    std::cout << std::left << std::setw(10) << count << std::setw(16) << std::fixed
+              << std::setprecision(1) << single_ns << std::setw(16) << batch_ns
+              << std::setprecision(2) << single_ns / batch_ns << "x" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t batch = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+
+    std::cout << "=== Keccak-256 Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "bytes" << std::setw(16) << "keccak ns"
+              << std::setw(16) << "sha256 ns"
+              << "keccak MB/s" << std::endl;
+    for (size_t size : {32, 64, 136, 532, 4096}) {
+        BenchSingle(size);
+    }
+
+    std::cout << std::endl
+              << "Trie node batch (multi-buffer: "
+              << (Keccak256::HasMultiBuffer() ? "AVX2" : "unavailable") << ")" << std::endl;
+    std::cout << std::left << std::setw(10) << "nodes" << std::setw(16) << "single ns"
+              << std::setw(16) << "batch ns"
+              << "speedup" << std::endl;
+    BenchBatch(batch);
+    return sink == 0xFF ? 1 : 0;
+}
@@ -0,0 +1,124 @@
+// ParthenonChain - Parallel Block Execution Benchmark
+// Block-STM throughput on token transfers by worker count, for independent
+// transfers and for transfers that all credit one account
+
+#include "evm/opcodes.h"
+#include "evm/parallel_executor.h"
+#include "evm/state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace parthenon::evm;
+
+namespace {
+
+Address Token() {
+    Address addr{};
+    addr[19] = 0x70;
+    return addr;
+}
+
+Address User(uint32_t i) {
+    Address addr{};
+    addr[0] = 0x11;
+    addr[16] = static_cast<uint8_t>(i >> 24);
+    addr[17] = static_cast<uint8_t>(i >> 16);
+    addr[18] = static_cast<uint8_t>(i >> 8);
+    addr[19] = static_cast<uint8_t>(i);
+    return addr;
+}
+
+uint256_t AddressWord(const Address& addr) {
+    uint256_t word{};
+    std::memcpy(word.data() + 12, addr.data(), addr.size());
+    return word;
+}
+
+// calldata = recipient | amount; balances live in storage keyed by address
+std::vector<uint8_t> TransferCode() {
+    auto op = [](Opcode o) { return static_cast<uint8_t>(o); };
+    return {
+        op(Opcode::CALLER), op(Opcode::SLOAD), op(Opcode::PUSH1), 0x20,
+        op(Opcode::CALLDATALOAD), op(Opcode::SWAP1), op(Opcode::SUB), op(Opcode::CALLER),
+        op(Opcode::SSTORE), op(Opcode::PUSH1), 0x00, op(Opcode::CALLDATALOAD), op(Opcode::DUP1),
+        op(Opcode::SLOAD), op(Opcode::PUSH1), 0x20, op(Opcode::CALLDATALOAD), op(Opcode::ADD),
+        op(Opcode::SWAP1), op(Opcode::SSTORE), op(Opcode::STOP),
+    };
+}
+
+BlockTransaction Transfer(uint32_t from, uint32_t to) {
+    BlockTransaction tx;
+    tx.ctx = ExecutionContext{};
+    tx.ctx.origin = User(from);
+    tx.ctx.caller = User(from);
+    tx.ctx.address = Token();
+    tx.ctx.gas_limit = 100000;
+    const auto recipient = AddressWord(User(to));
+    const auto amount = ToUint256(1);
+    tx.ctx.input_data.assign(recipient.begin(), recipient.end());
+    tx.ctx.input_data.insert(tx.ctx.input_data.end(), amount.begin(), amount.end());
+    return tx;
+}
+
+void Bench(const char* name, const WorldState& base, const std::vector<BlockTransaction>& txs,
+           const std::vector<size_t>& thread_counts) {
+    std::cout << std::endl << name << " (" << txs.size() << " txs)" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads" << std::setw(12) << "ms"
+              << std::setw(12) << "tx/s" << std::setw(14) << "executions"
+              << "aborts" << std::endl;
+
+    for (size_t threads : thread_counts) {
+        WorldState state = base;
+        ParallelExecutor executor(threads);
+        const auto start = std::chrono::steady_clock::now();
+        executor.ExecuteBlock(state, txs);
+        const double ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                .count();
+        const auto stats = executor.GetStats();
+        std::cout << std::left << std::setw(10) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(12) << ms << std::setw(12) << std::setprecision(0)
+                  << txs.size() / (ms / 1000.0) << std::setw(14) << stats.executions
+                  << stats.aborts << std::endl;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const uint32_t num_txs = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+
+    std::vector<size_t> thread_counts = {1};
+    const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const size_t max_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : hardware;
+    for (size_t threads = 2; threads <= max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+
+    std::cout << "=== Parallel Block Execution Benchmark ===" << std::endl;
+    std::cout << "hardware threads: " << hardware << std::endl;
+
+    WorldState base;
+    base.SetCode(Token(), TransferCode());
+    for (uint32_t i = 0; i < 2 * num_txs; ++i) {
+        base.SetStorage(Token(), AddressWord(User(i)), ToUint256(1000));
+    }
+    base.CalculateStateRoot();
+
+    std::vector<BlockTransaction> independent;
+    std::vector<BlockTransaction> hot;
+    for (uint32_t i = 0; i < num_txs; ++i) {
+        independent.push_back(Transfer(i, num_txs + i));
+        hot.push_back(Transfer(i, num_txs));
+    }
+    Bench("independent transfers", base, independent, thread_counts);
+    Bench("single recipient", base, hot, thread_counts);
+    return 0;
+}
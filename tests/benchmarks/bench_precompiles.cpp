@@ -0,0 +1,172 @@
+// ParthenonChain - Precompile Gas Schedule Benchmark
+// Time per call and per gas of each precompile across input sizes. The gas
+// schedule is sound when nothing runs much slower per gas than ecrecover,
+// whose 3000 gas is the reference price of a signature check.
+//
+// The schnorr_verify row times whatever secp256k1 is linked, which may be a
+// stand-in; its price is set from the native BIP-340 row, which runs on the
+// same field and point code as ecrecover.
+
+#include "evm/precompiles.h"
+
+#include "crypto/ecdsa.h"
+#include "crypto/schnorr.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace parthenon::evm;
+
+namespace {
+
+double NanosSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Best of several runs of fn, in ns per call of `calls`
+template <typename Fn>
+double BestNanos(size_t calls, Fn&& fn) {
+    double best = 1e30;
+    for (int run = 0; run < 5; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, NanosSince(start) / static_cast<double>(calls));
+    }
+    return best;
+}
+
+size_t sink = 0;
+double reference_ns_per_gas = 0;
+
+void Report(const std::string& label, uint64_t gas, double ns) {
+    const double ns_per_gas = ns / static_cast<double>(gas);
+    if (reference_ns_per_gas == 0) {
+        reference_ns_per_gas = ns_per_gas;
+    }
+    std::cout << std::left << std::setw(26) << label << std::setw(10) << gas << std::setw(14)
+              << std::fixed << std::setprecision(0) << ns << std::setw(12)
+              << std::setprecision(2) << ns_per_gas << ns_per_gas / reference_ns_per_gas
+              << std::endl;
+}
+
+void Bench(const std::string& label, uint16_t id, const std::vector<uint8_t>& input,
+           size_t calls) {
+    const Address addr = PrecompileAddress(id);
+    uint64_t gas = 0;
+    const double ns = BestNanos(calls, [&]() {
+        for (size_t i = 0; i < calls; ++i) {
+            auto result = RunPrecompile(addr, input, 30000000);
+            gas = result.gas_used;
+            sink += result.output.size();
+        }
+    });
+    Report(label, gas, ns);
+}
+
+std::vector<uint8_t> FromHex(const std::string& hex) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+std::vector<uint8_t> WordOf(uint64_t value) {
+    std::vector<uint8_t> word(32, 0);
+    for (size_t i = 0; i < 8; ++i) {
+        word[31 - i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    return word;
+}
+
+// Odd modulus, all-ones exponent: the worst case for its length
+std::vector<uint8_t> ModExpInput(size_t len) {
+    std::vector<uint8_t> input;
+    for (int field = 0; field < 3; ++field) {
+        const auto word = WordOf(len);
+        input.insert(input.end(), word.begin(), word.end());
+    }
+    for (size_t i = 0; i < len; ++i) {
+        input.push_back(static_cast<uint8_t>(0x5A + i));
+    }
+    input.insert(input.end(), len, 0xFF);
+    for (size_t i = 0; i < len; ++i) {
+        input.push_back(static_cast<uint8_t>(i == len - 1 ? 0x01 : 0xC3 + i));
+    }
+    return input;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== Precompile Gas Schedule Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(26) << "precompile" << std::setw(10) << "gas"
+              << std::setw(14) << "ns/call" << std::setw(12) << "ns/gas"
+              << "vs ecrecover" << std::endl;
+
+    // Reference first: a mainnet-style signature
+    const auto ecrecover_input = FromHex(
+        "18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c"
+        "000000000000000000000000000000000000000000000000000000000000001c"
+        "73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9aa6a5a75f"
+        "eeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549");
+    Bench("ecrecover", PRECOMPILE_ECRECOVER, ecrecover_input, 2000);
+
+    for (size_t size : {0, 32, 1024, 65536}) {
+        const std::vector<uint8_t> data(size, 0xA5);
+        const size_t calls = 65536 / (size + 32) + 100;
+        Bench("sha256 " + std::to_string(size) + "B", PRECOMPILE_SHA256, data, calls);
+        Bench("ripemd160 " + std::to_string(size) + "B", PRECOMPILE_RIPEMD160, data, calls);
+        Bench("identity " + std::to_string(size) + "B", PRECOMPILE_IDENTITY, data, calls);
+    }
+
+    for (size_t len : {32, 64, 128, 256, 512}) {
+        Bench("modexp " + std::to_string(len * 8) + "-bit", PRECOMPILE_MODEXP, ModExpInput(len),
+              len <= 64 ? 500 : 20);
+    }
+
+    for (uint32_t rounds : {12, 1024, 65536}) {
+        std::vector<uint8_t> blake_input(213, 0x3C);
+        for (size_t i = 0; i < 4; ++i) {
+            blake_input[i] = static_cast<uint8_t>(rounds >> (24 - 8 * i));
+        }
+        blake_input.back() = 1;
+        Bench("blake2f " + std::to_string(rounds) + " rounds", PRECOMPILE_BLAKE2F, blake_input,
+              rounds <= 1024 ? 2000 : 50);
+    }
+
+    const std::vector<uint8_t> hash(ecrecover_input.begin(), ecrecover_input.begin() + 32);
+    parthenon::crypto::Schnorr::PrivateKey key{};
+    key[31] = 7;
+    const auto pubkey = parthenon::crypto::Schnorr::GetPublicKey(key);
+    const auto signature = parthenon::crypto::Schnorr::Sign(key, hash.data());
+    if (!pubkey || !signature) {
+        std::cerr << "Cannot sign the Schnorr input" << std::endl;
+        return 1;
+    }
+    std::vector<uint8_t> schnorr_input(pubkey->begin(), pubkey->end());
+    schnorr_input.insert(schnorr_input.end(), hash.begin(), hash.end());
+    schnorr_input.insert(schnorr_input.end(), signature->begin(), signature->end());
+    Bench("schnorr_verify", PRECOMPILE_SCHNORR_VERIFY, schnorr_input, 2000);
+
+    // BIP-340 test vector 1 on the native curve code, at the precompile's price
+    const auto bip340 = FromHex(
+        "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659"
+        "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89"
+        "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+        "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a");
+    const double native_ns = BestNanos(2000, [&]() {
+        for (size_t i = 0; i < 2000; ++i) {
+            sink += parthenon::crypto::ECDSA::VerifySchnorr(bip340.data(), bip340.data() + 32,
+                                                            bip340.data() + 64);
+        }
+    });
+    Report("schnorr_verify native", SCHNORR_VERIFY_GAS, native_ns);
+
+    return sink == 1 ? 1 : 0;
+}
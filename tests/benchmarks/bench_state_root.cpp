@@ -0,0 +1,121 @@
+// ParthenonChain - EVM State Root Benchmark
+// State root time after a block, by total state size and slots modified, and
+// the cost of rolling back a transaction's writes
+
+#include "evm/state.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace parthenon::evm;
+
+namespace {
+
+constexpr size_t kContracts = 100;
+
+Address ContractAddress(size_t i) {
+    Address addr{};
+    addr[0] = 0xC0;
+    addr[18] = static_cast<uint8_t>(i >> 8);
+    addr[19] = static_cast<uint8_t>(i);
+    return addr;
+}
+
+double MillisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Fills `slots` storage slots spread over kContracts contracts, then times
+// the root after modifying `modified` of them, as a block would.
+void Bench(size_t slots, const std::vector<size_t>& modified_counts) {
+    WorldState state;
+    for (size_t i = 0; i < slots; ++i) {
+        state.SetStorage(ContractAddress(i % kContracts), ToUint256(i), ToUint256(i + 1));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    state.CalculateStateRoot();
+    const double full_ms = MillisSince(start);
+
+    std::cout << std::left << std::setw(12) << slots << std::setw(16) << std::fixed
+              << std::setprecision(2) << full_ms;
+    uint64_t round = 0;
+    for (size_t modified : modified_counts) {
+        ++round;
+        for (size_t i = 0; i < modified; ++i) {
+            const size_t slot = (i * 7919 + round) % slots;
+            state.SetStorage(ContractAddress(slot % kContracts), ToUint256(slot),
+                             ToUint256(slot + round * 1000003));
+        }
+        start = std::chrono::steady_clock::now();
+        state.CalculateStateRoot();
+        std::cout << std::setw(14) << MillisSince(start);
+    }
+    std::cout << std::endl;
+}
+
+// Rolls back `kRevertWrites` slot writes, with a full snapshot and with a
+// journal checkpoint
+void BenchRevert(size_t slots) {
+    constexpr size_t kRevertWrites = 10;
+    WorldState state;
+    for (size_t i = 0; i < slots; ++i) {
+        state.SetStorage(ContractAddress(i % kContracts), ToUint256(i), ToUint256(i + 1));
+    }
+
+    // Best of several runs; the first ones pay for the previous table's frees
+    double snapshot_ms = 1e9;
+    double journal_ms = 1e9;
+    for (int run = 0; run < 5; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        auto snapshot = state.CreateSnapshot();
+        for (size_t i = 0; i < kRevertWrites; ++i) {
+            state.SetStorage(ContractAddress(i), ToUint256(i), ToUint256(7));
+        }
+        state.RestoreSnapshot(snapshot);
+        snapshot_ms = std::min(snapshot_ms, MillisSince(start));
+
+        start = std::chrono::steady_clock::now();
+        const size_t checkpoint = state.Checkpoint();
+        for (size_t i = 0; i < kRevertWrites; ++i) {
+            state.SetStorage(ContractAddress(i), ToUint256(i), ToUint256(7));
+        }
+        state.RevertToCheckpoint(checkpoint);
+        journal_ms = std::min(journal_ms, MillisSince(start));
+    }
+
+    std::cout << std::left << std::setw(12) << slots << std::setw(16) << std::fixed
+              << std::setprecision(3) << snapshot_ms << journal_ms << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t max_slots = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    const std::vector<size_t> modified = {1, 100, 1000};
+
+    std::cout << "=== EVM State Root Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(12) << "slots" << std::setw(16) << "full root ms";
+    for (size_t m : modified) {
+        std::cout << std::setw(14) << ("+" + std::to_string(m) + " ms");
+    }
+    std::cout << std::endl;
+
+    for (size_t slots = 1000; slots <= max_slots; slots *= 10) {
+        Bench(slots, modified);
+    }
+
+    std::cout << std::endl
+              << std::left << std::setw(12) << "slots" << std::setw(16) << "snapshot ms"
+              << "journal ms" << std::endl;
+    for (size_t slots = 1000; slots <= max_slots; slots *= 10) {
+        BenchRevert(slots);
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+// ParthenonChain - EVM SLOAD Benchmark
+// SLOAD cost on a disk-backed state, by where the slot is found: the current
+// block's changes, a recent diff layer, the flat snapshot (read on demand or
+// prefetched), or nowhere
+
+#include "evm/code_cache.h"
+#include "evm/opcodes.h"
+#include "evm/prefetcher.h"
+#include "evm/state.h"
+#include "evm/state_db.h"
+#include "evm/vm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace parthenon::evm;
+
+namespace {
+
+constexpr size_t kChunk = 100000;
+constexpr size_t kLoads = 20000;
+
+Address Contract() {
+    Address addr{};
+    addr[0] = 0xC0;
+    addr[19] = 0x01;
+    return addr;
+}
+
+// Spreads slot numbers over the key space, as keccak'd mapping keys would be
+uint256_t SlotKey(uint64_t i) {
+    uint256_t key = ToUint256(i * 0x9E3779B97F4A7C15ull);
+    key[0] = static_cast<uint8_t>(i);
+    return key;
+}
+
+// PUSH32 key, SLOAD, POP for each key
+std::vector<uint8_t> LoadProgram(const std::vector<uint256_t>& keys) {
+    std::vector<uint8_t> code;
+    code.reserve(keys.size() * 35 + 1);
+    for (const auto& key : keys) {
+        code.push_back(static_cast<uint8_t>(Opcode::PUSH32));
+        code.insert(code.end(), key.begin(), key.end());
+        code.push_back(static_cast<uint8_t>(Opcode::SLOAD));
+        code.push_back(static_cast<uint8_t>(Opcode::POP));
+    }
+    code.push_back(static_cast<uint8_t>(Opcode::STOP));
+    return code;
+}
+
+double NanosPerLoad(WorldState& state, const std::vector<uint256_t>& keys) {
+    // Analyse up front so only execution is timed
+    const auto code = CodeCache::Global().Insert(LoadProgram(keys));
+    ExecutionContext ctx{};
+    ctx.address = Contract();
+    ctx.gas_limit = UINT64_MAX / 2;
+
+    const auto start = std::chrono::steady_clock::now();
+    VM vm(state, ctx);
+    vm.Execute(*code);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / keys.size();
+}
+
+std::vector<uint256_t> Keys(uint64_t first, uint64_t count, uint64_t stride) {
+    std::vector<uint256_t> keys;
+    keys.reserve(kLoads);
+    for (size_t i = 0; i < kLoads; ++i) {
+        keys.push_back(SlotKey(first + (i * stride) % count));
+    }
+    return keys;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const uint64_t slots = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::cout << "=== EVM SLOAD Benchmark ===" << std::endl;
+    std::cout << "slots: " << slots << std::endl;
+
+    auto db = std::make_shared<StateDatabase>();
+    if (!db->Open("/tmp/parthenon_bench_state_sload")) {
+        std::cerr << "failed to open state database" << std::endl;
+        return 1;
+    }
+
+    // Populate the flat snapshot directly, one layer per chunk. This skips
+    // the trie, so the state root is not meaningful; only reads are timed.
+    const auto populate_start = std::chrono::steady_clock::now();
+    uint64_t block = 0;
+    for (uint64_t first = 0; first < slots; first += kChunk) {
+        StateDiffLayer layer;
+        layer.block_number = ++block;
+        if (first == 0) {
+            AccountState account;
+            account.balance = ToUint256(1);
+            layer.accounts.emplace(Contract(), account);
+        }
+        for (uint64_t i = first; i < std::min<uint64_t>(slots, first + kChunk); ++i) {
+            layer.storage.emplace(std::make_pair(Contract(), SlotKey(i)), ToUint256(i + 1));
+        }
+        db->WriteLayer(layer);
+    }
+    std::cout << "populate: "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - populate_start)
+                     .count()
+              << " s" << std::endl;
+
+    WorldState state(db, 128);
+
+    // Recent blocks: a few thousand slots rewritten across the diff layers
+    const uint64_t recent = std::min<uint64_t>(slots, 128 * 32);
+    for (uint64_t i = 0; i < recent; ++i) {
+        state.SetStorage(Contract(), SlotKey(i), ToUint256(i + 2));
+        if (i % 32 == 31) {
+            state.Commit(++block);
+        }
+    }
+    state.Commit(++block);
+
+    // Current block: slots modified but not yet committed
+    for (uint64_t i = 0; i < kLoads; ++i) {
+        state.SetStorage(Contract(), SlotKey(slots + i), ToUint256(1));
+    }
+
+    std::cout << std::left << std::setw(16) << "source" << "ns/SLOAD" << std::endl;
+    auto report = [&](const char* name, const std::vector<uint256_t>& keys) {
+        std::cout << std::left << std::setw(16) << name << std::fixed << std::setprecision(1)
+                  << NanosPerLoad(state, keys) << std::endl;
+    };
+    report("dirty", Keys(slots, kLoads, 1));
+    report("diff layer", Keys(0, recent, 7919));
+    const auto flat_keys = Keys(recent, slots > recent ? slots - recent : 1, 7919);
+    report("flat", flat_keys);
+
+    // The same slots, declared in an access list and loaded ahead
+    StatePrefetcher prefetcher(db);
+    BlockTransaction tx;
+    tx.ctx.address = Contract();
+    tx.ctx.access_list = {AccessListEntry{Contract(), flat_keys}};
+    prefetcher.Schedule(state, {tx});
+    prefetcher.Wait();
+    report("flat prefetched", flat_keys);
+    report("absent", Keys(slots + kLoads, slots, 7919));
+    std::cout << "prefetch hit rate: " << std::setprecision(3)
+              << prefetcher.GetStats().HitRate() << std::endl;
+    return 0;
+}
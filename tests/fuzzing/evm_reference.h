@@ -0,0 +1,1061 @@
+#pragma once
+// evm_reference.h — Reference model of evm::VM for differential fuzzing.
+//
+// A deliberately plain EVM: it walks the raw bytecode one instruction at a
+// time, charges gas per instruction, keeps 256-bit words as 32-bit limbs
+// with schoolbook arithmetic, and shares no code with the interpreter
+// beyond the static gas table (GetOpcodeCost), Keccak and the precompiles.
+// Speed does not matter; being obviously right does.
+//
+// It models the chain's gas schedule as the VM documents it: EIP-2929
+// access costs, EIP-2200/3529 SSTORE metering, memory at 3 gas per word
+// with no quadratic term and no per-byte EXP charge, and memory offsets
+// and sizes capped at 2^32. Calls are modelled for callees without code,
+// which is all the fuzzed state holds: precompiles and plain accounts,
+// with EIP-150 gas forwarding and value transfers. Creates are not
+// implemented, so their opcodes halt like undefined ones.
+
+#include "evm/opcodes.h"
+#include "evm/precompiles.h"
+#include "evm/state.h"
+#include "evm/vm.h"
+#include "crypto/keccak.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace evm_reference {
+
+using parthenon::evm::Address;
+using parthenon::evm::ExecResult;
+using parthenon::evm::ExecutionContext;
+using parthenon::evm::LogEntry;
+using parthenon::evm::Opcode;
+using parthenon::evm::uint256_t;
+
+// N little-endian 32-bit limbs
+template <size_t N>
+struct Limbs {
+    std::array<uint32_t, N> v{};
+};
+
+using U256 = Limbs<8>;
+using U512 = Limbs<16>;
+
+template <size_t N>
+bool IsZero(const Limbs<N>& a) {
+    for (uint32_t limb : a.v) {
+        if (limb != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t N>
+int Compare(const Limbs<N>& a, const Limbs<N>& b) {
+    for (size_t i = N; i-- > 0;) {
+        if (a.v[i] != b.v[i]) {
+            return a.v[i] < b.v[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+template <size_t N>
+Limbs<N> Add(const Limbs<N>& a, const Limbs<N>& b) {
+    Limbs<N> r;
+    uint64_t carry = 0;
+    for (size_t i = 0; i < N; ++i) {
+        const uint64_t sum = uint64_t{a.v[i]} + b.v[i] + carry;
+        r.v[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    return r;
+}
+
+template <size_t N>
+Limbs<N> Sub(const Limbs<N>& a, const Limbs<N>& b) {
+    Limbs<N> r;
+    int64_t borrow = 0;
+    for (size_t i = 0; i < N; ++i) {
+        int64_t diff = int64_t{a.v[i]} - b.v[i] - borrow;
+        borrow = diff < 0 ? 1 : 0;
+        r.v[i] = static_cast<uint32_t>(diff + (borrow << 32));
+    }
+    return r;
+}
+
+// Product modulo 2^(32 M)
+template <size_t M, size_t N>
+Limbs<M> Mul(const Limbs<N>& a, const Limbs<N>& b) {
+    Limbs<M> r;
+    for (size_t i = 0; i < N && i < M; ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; i + j < M; ++j) {
+            const uint64_t bj = j < N ? b.v[j] : 0;
+            const uint64_t t = uint64_t{a.v[i]} * bj + r.v[i + j] + carry;
+            r.v[i + j] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+    return r;
+}
+
+template <size_t N>
+bool Bit(const Limbs<N>& a, size_t bit) {
+    return ((a.v[bit / 32] >> (bit % 32)) & 1) != 0;
+}
+
+template <size_t N>
+Limbs<N> Shl(const Limbs<N>& a, size_t shift) {
+    Limbs<N> r;
+    const size_t limbs = shift / 32;
+    const size_t bits = shift % 32;
+    for (size_t i = limbs; i < N; ++i) {
+        r.v[i] = a.v[i - limbs] << bits;
+        if (bits != 0 && i > limbs) {
+            r.v[i] |= a.v[i - limbs - 1] >> (32 - bits);
+        }
+    }
+    return r;
+}
+
+template <size_t N>
+Limbs<N> Shr(const Limbs<N>& a, size_t shift) {
+    Limbs<N> r;
+    const size_t limbs = shift / 32;
+    const size_t bits = shift % 32;
+    for (size_t i = 0; i + limbs < N; ++i) {
+        r.v[i] = a.v[i + limbs] >> bits;
+        if (bits != 0 && i + limbs + 1 < N) {
+            r.v[i] |= a.v[i + limbs + 1] << (32 - bits);
+        }
+    }
+    return r;
+}
+
+// Restoring binary long division; quotient and remainder are 0 for b == 0
+template <size_t N>
+void DivMod(const Limbs<N>& a, const Limbs<N>& b, Limbs<N>& quotient, Limbs<N>& remainder) {
+    quotient = Limbs<N>();
+    remainder = Limbs<N>();
+    if (IsZero(b)) {
+        return;
+    }
+    for (size_t bit = 32 * N; bit-- > 0;) {
+        const bool carry = Bit(remainder, 32 * N - 1);  // Shifted out, so above b
+        remainder = Shl(remainder, 1);
+        remainder.v[0] |= Bit(a, bit) ? 1 : 0;
+        if (carry || Compare(remainder, b) >= 0) {
+            remainder = Sub(remainder, b);
+            quotient.v[bit / 32] |= uint32_t{1} << (bit % 32);
+        }
+    }
+}
+
+inline U512 Widen(const U256& a) {
+    U512 r;
+    std::copy(a.v.begin(), a.v.end(), r.v.begin());
+    return r;
+}
+
+inline U256 Narrow(const U512& a) {
+    U256 r;
+    std::copy(a.v.begin(), a.v.begin() + 8, r.v.begin());
+    return r;
+}
+
+inline U256 FromU64(uint64_t value) {
+    U256 r;
+    r.v[0] = static_cast<uint32_t>(value);
+    r.v[1] = static_cast<uint32_t>(value >> 32);
+    return r;
+}
+
+inline bool FitsU64(const U256& a) {
+    for (size_t i = 2; i < 8; ++i) {
+        if (a.v[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline uint64_t ToU64(const U256& a) {
+    return uint64_t{a.v[0]} | (uint64_t{a.v[1]} << 32);
+}
+
+// Big-endian bytes, as on the stack and in memory
+inline U256 FromBytes(const uint8_t* bytes) {
+    U256 r;
+    for (size_t i = 0; i < 32; ++i) {
+        r.v[(31 - i) / 4] |= uint32_t{bytes[i]} << (8 * ((31 - i) % 4));
+    }
+    return r;
+}
+
+inline uint256_t ToBytes(const U256& a) {
+    uint256_t bytes{};
+    for (size_t i = 0; i < 32; ++i) {
+        bytes[i] = static_cast<uint8_t>(a.v[(31 - i) / 4] >> (8 * ((31 - i) % 4)));
+    }
+    return bytes;
+}
+
+inline U256 FromAddress(const Address& addr) {
+    uint8_t bytes[32] = {};
+    std::memcpy(bytes + 12, addr.data(), addr.size());
+    return FromBytes(bytes);
+}
+
+inline Address ToAddress(const U256& a) {
+    const uint256_t bytes = ToBytes(a);
+    Address addr;
+    std::memcpy(addr.data(), bytes.data() + 12, addr.size());
+    return addr;
+}
+
+inline bool Negative(const U256& a) {
+    return Bit(a, 255);
+}
+
+inline U256 Negate(const U256& a) {
+    return Sub(U256(), a);
+}
+
+inline U256 Abs(const U256& a) {
+    return Negative(a) ? Negate(a) : a;
+}
+
+inline U256 Bool(bool value) {
+    return FromU64(value ? 1 : 0);
+}
+
+// Arithmetic and logic instructions, with a the top of the stack
+inline U256 Div(const U256& a, const U256& b) {
+    U256 q, r;
+    DivMod(a, b, q, r);
+    return q;
+}
+
+inline U256 Mod(const U256& a, const U256& b) {
+    U256 q, r;
+    DivMod(a, b, q, r);
+    return r;
+}
+
+inline U256 SDiv(const U256& a, const U256& b) {
+    const U256 q = Div(Abs(a), Abs(b));
+    return Negative(a) != Negative(b) ? Negate(q) : q;
+}
+
+inline U256 SMod(const U256& a, const U256& b) {
+    const U256 r = Mod(Abs(a), Abs(b));
+    return Negative(a) ? Negate(r) : r;
+}
+
+inline U256 AddMod(const U256& a, const U256& b, const U256& n) {
+    U512 q, r;
+    DivMod(Add(Widen(a), Widen(b)), Widen(n), q, r);
+    return Narrow(r);
+}
+
+inline U256 MulMod(const U256& a, const U256& b, const U256& n) {
+    U512 q, r;
+    DivMod(Mul<16>(Widen(a), Widen(b)), Widen(n), q, r);
+    return Narrow(r);
+}
+
+inline U256 Exp(const U256& base, const U256& exponent) {
+    U256 result = FromU64(1);
+    for (size_t bit = 256; bit-- > 0;) {
+        result = Mul<8>(result, result);
+        if (Bit(exponent, bit)) {
+            result = Mul<8>(result, base);
+        }
+    }
+    return result;
+}
+
+inline U256 SignExtend(const U256& byte_index, const U256& value) {
+    if (!FitsU64(byte_index) || ToU64(byte_index) >= 31) {
+        return value;
+    }
+    const size_t sign_bit = 8 * ToU64(byte_index) + 7;
+    U256 r = value;
+    for (size_t bit = sign_bit + 1; bit < 256; ++bit) {
+        const uint32_t mask = uint32_t{1} << (bit % 32);
+        r.v[bit / 32] = Bit(value, sign_bit) ? (r.v[bit / 32] | mask) : (r.v[bit / 32] & ~mask);
+    }
+    return r;
+}
+
+inline bool SignedLess(const U256& a, const U256& b) {
+    if (Negative(a) != Negative(b)) {
+        return Negative(a);
+    }
+    return Compare(a, b) < 0;
+}
+
+inline U256 Byte(const U256& index, const U256& value) {
+    if (!FitsU64(index) || ToU64(index) >= 32) {
+        return U256();
+    }
+    return FromU64(ToBytes(value)[ToU64(index)]);
+}
+
+inline U256 ShiftLeft(const U256& shift, const U256& value) {
+    return FitsU64(shift) && ToU64(shift) < 256 ? Shl(value, ToU64(shift)) : U256();
+}
+
+inline U256 ShiftRight(const U256& shift, const U256& value) {
+    return FitsU64(shift) && ToU64(shift) < 256 ? Shr(value, ToU64(shift)) : U256();
+}
+
+inline U256 ShiftArithmetic(const U256& shift, const U256& value) {
+    if (!Negative(value)) {
+        return ShiftRight(shift, value);
+    }
+    // -1 - ((-1 - value) >> shift) rounds towards negative infinity
+    const U256 ones = Negate(FromU64(1));
+    return Sub(ones, ShiftRight(shift, Sub(ones, value)));
+}
+
+inline U256 Not(const U256& a) {
+    U256 r;
+    for (size_t i = 0; i < 8; ++i) {
+        r.v[i] = ~a.v[i];
+    }
+    return r;
+}
+
+template <typename F>
+U256 Bitwise(const U256& a, const U256& b, F f) {
+    U256 r;
+    for (size_t i = 0; i < 8; ++i) {
+        r.v[i] = f(a.v[i], b.v[i]);
+    }
+    return r;
+}
+
+/**
+ * Machine state before an instruction, as the VM's Tracer sees it
+ */
+struct Step {
+    uint64_t pc;
+    uint8_t opcode;
+    uint64_t gas;
+    const std::vector<U256>& stack;  // Bottom first
+    const std::vector<uint8_t>& memory;
+};
+
+struct Outcome {
+    ExecResult result = ExecResult::SUCCESS;
+    std::vector<uint8_t> output;
+    uint64_t gas_used = 0;
+    uint64_t gas_refund = 0;
+    std::vector<LogEntry> logs;
+    std::map<uint256_t, uint256_t> storage_writes;  // Final value of each written slot
+    std::map<Address, uint256_t> balance_writes;    // Final balance of each account paid or paying
+};
+
+inline bool IsExceptional(ExecResult result) {
+    return result != ExecResult::SUCCESS && result != ExecResult::RETURNED &&
+           result != ExecResult::REVERT;
+}
+
+/**
+ * One call frame of code at ctx.address, reading balances and storage
+ * from state, which it never modifies; calls to accounts with code are
+ * not modelled and halt as INVALID_OPCODE
+ */
+class Interpreter {
+  public:
+    static constexpr size_t kStackLimit = 1024;
+    static constexpr uint64_t kMaxMemory = uint64_t{1} << 32;
+
+    Interpreter(const parthenon::evm::StateAccess& state, const ExecutionContext& ctx,
+                const std::vector<uint8_t>& code)
+        : state_(state), ctx_(ctx), code_(code), jumpdest_(code.size(), false) {
+        for (size_t pc = 0; pc < code.size(); ++pc) {
+            const uint8_t op = code[pc];
+            if (op == static_cast<uint8_t>(Opcode::JUMPDEST)) {
+                jumpdest_[pc] = true;
+            } else if (op >= 0x60 && op <= 0x7f) {
+                pc += op - 0x5f;  // Skip push data
+            }
+        }
+        warm_addresses_.insert(ctx.origin);
+        warm_addresses_.insert(ctx.address);
+    }
+
+    /**
+     * Run to completion, calling on_step before each instruction
+     */
+    template <typename OnStep>
+    Outcome Run(OnStep on_step) {
+        gas_ = static_cast<int64_t>(std::min<uint64_t>(
+            ctx_.gas_limit, static_cast<uint64_t>(std::numeric_limits<int64_t>::max())));
+        Outcome outcome;
+        outcome.result = Execute(on_step);
+        if (outcome.result == ExecResult::RETURNED || outcome.result == ExecResult::REVERT) {
+            outcome.output = output_;
+        }
+        if (IsExceptional(outcome.result)) {
+            outcome.gas_used = ctx_.gas_limit;
+        } else {
+            outcome.gas_used = ctx_.gas_limit - static_cast<uint64_t>(gas_);
+        }
+        if (outcome.result == ExecResult::SUCCESS || outcome.result == ExecResult::RETURNED) {
+            outcome.gas_refund = refund_ > 0 ? static_cast<uint64_t>(refund_) : 0;
+            outcome.logs = logs_;
+            outcome.storage_writes = storage_;
+            outcome.balance_writes = balances_;
+        }
+        return outcome;
+    }
+
+  private:
+    U256 Pop() {
+        const U256 top = stack_.back();
+        stack_.pop_back();
+        return top;
+    }
+
+    void Push(const U256& value) { stack_.push_back(value); }
+
+    bool Charge(uint64_t cost) {
+        gas_ -= static_cast<int64_t>(cost);
+        return gas_ >= 0;
+    }
+
+    // Grow memory to cover [offset, offset + size) and charge for it
+    bool Expand(const U256& offset, const U256& size) {
+        if (IsZero(size)) {
+            return true;
+        }
+        if (!FitsU64(offset) || !FitsU64(size) || ToU64(offset) > kMaxMemory ||
+            ToU64(size) > kMaxMemory) {
+            return false;
+        }
+        const uint64_t end = ToU64(offset) + ToU64(size);
+        if (end <= memory_.size()) {
+            return true;
+        }
+        const uint64_t words = (end + 31) / 32;
+        if (!Charge((words - memory_.size() / 32) * 3)) {
+            return false;
+        }
+        memory_.resize(words * 32, 0);
+        return true;
+    }
+
+    // Bytes [offset, offset + size) of source, zero past its end
+    static std::vector<uint8_t> Slice(const std::vector<uint8_t>& source, const U256& offset,
+                                      uint64_t size) {
+        std::vector<uint8_t> out(size, 0);
+        if (FitsU64(offset) && ToU64(offset) < source.size()) {
+            const uint64_t start = ToU64(offset);
+            const uint64_t count = std::min<uint64_t>(size, source.size() - start);
+            std::copy(source.begin() + start, source.begin() + start + count, out.begin());
+        }
+        return out;
+    }
+
+    uint256_t Balance(const Address& addr) const {
+        auto it = balances_.find(addr);
+        return it != balances_.end() ? it->second : state_.GetBalance(addr);
+    }
+
+    bool EmptyAccount(const Address& addr) const {
+        return IsZero(FromBytes(Balance(addr).data())) && state_.GetNonce(addr) == 0 &&
+               state_.GetCode(addr)->Empty();
+    }
+
+    uint256_t Storage(const uint256_t& key) const {
+        auto it = storage_.find(key);
+        return it != storage_.end() ? it->second : state_.GetStorage(ctx_.address, key);
+    }
+
+    // EIP-2200 net metering with EIP-3529 refunds, after the cold surcharge
+    uint64_t StoreCost(const uint256_t& key, const uint256_t& value) {
+        using namespace parthenon::evm;
+        const uint256_t zero{};
+        const uint256_t original = state_.GetStorage(ctx_.address, key);
+        const uint256_t current = Storage(key);
+        if (current == value) {
+            return WARM_STORAGE_READ_COST;
+        }
+        if (original == current) {
+            if (original == zero) {
+                return SSTORE_SET_GAS;
+            }
+            if (value == zero) {
+                refund_ += SSTORE_CLEARS_SCHEDULE;
+            }
+            return SSTORE_RESET_GAS;
+        }
+        if (original != zero) {
+            if (current == zero) {
+                refund_ -= SSTORE_CLEARS_SCHEDULE;
+            } else if (value == zero) {
+                refund_ += SSTORE_CLEARS_SCHEDULE;
+            }
+        }
+        if (original == value) {
+            refund_ += static_cast<int64_t>((original == zero ? SSTORE_SET_GAS : SSTORE_RESET_GAS) -
+                                            WARM_STORAGE_READ_COST);
+        }
+        return WARM_STORAGE_READ_COST;
+    }
+
+    template <typename OnStep>
+    ExecResult Execute(OnStep& on_step) {
+        using namespace parthenon::evm;
+        uint64_t pc = 0;
+        while (true) {
+            const uint8_t op = pc < code_.size() ? code_[pc] : 0x00;  // Implicit STOP
+            on_step(Step{std::min<uint64_t>(pc, code_.size()), op,
+                         static_cast<uint64_t>(gas_), stack_, memory_});
+
+            int pops = 0;
+            int pushes = 0;
+            if (!Arity(op, pops, pushes)) {
+                return ExecResult::INVALID_OPCODE;
+            }
+            if (stack_.size() < static_cast<size_t>(pops)) {
+                return ExecResult::STACK_UNDERFLOW;
+            }
+            if (stack_.size() - pops + pushes > kStackLimit) {
+                return ExecResult::STACK_OVERFLOW;
+            }
+            if (!Charge(GetOpcodeCost(static_cast<Opcode>(op)))) {
+                return ExecResult::OUT_OF_GAS;
+            }
+
+            uint64_t next = pc + 1;
+            if (op >= 0x60 && op <= 0x7f) {  // PUSH1..PUSH32
+                const size_t size = op - 0x5f;
+                uint8_t bytes[32] = {};
+                for (size_t i = 0; i < size; ++i) {
+                    const uint64_t at = pc + 1 + i;
+                    bytes[32 - size + i] = at < code_.size() ? code_[at] : 0;
+                }
+                Push(FromBytes(bytes));
+                next = pc + 1 + size;
+            } else if (op >= 0x80 && op <= 0x8f) {  // DUP1..DUP16
+                Push(stack_[stack_.size() - (op - 0x7f)]);
+            } else if (op >= 0x90 && op <= 0x9f) {  // SWAP1..SWAP16
+                std::swap(stack_.back(), stack_[stack_.size() - 1 - (op - 0x8f)]);
+            } else if (op >= 0xa0 && op <= 0xa4) {  // LOG0..LOG4
+                if (ctx_.is_static) {
+                    return ExecResult::STATIC_CALL_VIOLATION;
+                }
+                const U256 offset = Pop();
+                const U256 size = Pop();
+                if (!Expand(offset, size)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const uint64_t length = IsZero(size) ? 0 : ToU64(size);
+                if (!Charge(375 * (op - 0xa0) + 8 * length)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                LogEntry entry;
+                entry.address = ctx_.address;
+                for (int i = 0; i < op - 0xa0; ++i) {
+                    entry.topics.push_back(ToBytes(Pop()));
+                }
+                entry.data = Slice(memory_, offset, length);
+                logs_.push_back(std::move(entry));
+            } else {
+                const ExecResult result = Other(op, pc, next);
+                if (result != ExecResult::SUCCESS) {
+                    return result;
+                }
+                if (op == 0x00) {
+                    return ExecResult::SUCCESS;
+                }
+                if (op == 0xf3) {
+                    return ExecResult::RETURNED;
+                }
+                if (op == 0xfd) {
+                    return ExecResult::REVERT;
+                }
+            }
+            pc = next;
+        }
+    }
+
+    // Stack items taken and left by each implemented opcode
+    static bool Arity(uint8_t op, int& pops, int& pushes) {
+        if (op >= 0x60 && op <= 0x7f) {
+            pops = 0, pushes = 1;
+        } else if (op >= 0x80 && op <= 0x8f) {
+            pops = op - 0x7f, pushes = op - 0x7f + 1;
+        } else if (op >= 0x90 && op <= 0x9f) {
+            pops = op - 0x8f + 1, pushes = op - 0x8f + 1;
+        } else if (op >= 0xa0 && op <= 0xa4) {
+            pops = op - 0xa0 + 2, pushes = 0;
+        } else if (op == 0x00 || op == 0x5b) {
+            pops = 0, pushes = 0;
+        } else if ((op >= 0x01 && op <= 0x07) || op == 0x0a || op == 0x0b ||
+                   (op >= 0x10 && op <= 0x14) || (op >= 0x16 && op <= 0x18) ||
+                   (op >= 0x1a && op <= 0x1d) || op == 0x20) {
+            pops = 2, pushes = 1;
+        } else if (op == 0x08 || op == 0x09) {
+            pops = 3, pushes = 1;
+        } else if (op == 0x15 || op == 0x19 || op == 0x31 || op == 0x35 || op == 0x51 ||
+                   op == 0x54) {
+            pops = 1, pushes = 1;
+        } else if (op == 0x30 || (op >= 0x32 && op <= 0x34) || op == 0x36 || op == 0x38 ||
+                   op == 0x3a || op == 0x3d || (op >= 0x41 && op <= 0x48) ||
+                   (op >= 0x58 && op <= 0x5a)) {
+            pops = 0, pushes = 1;
+        } else if (op == 0x37 || op == 0x39 || op == 0x3e) {
+            pops = 3, pushes = 0;
+        } else if (op == 0xf1 || op == 0xf2) {
+            pops = 7, pushes = 1;
+        } else if (op == 0xf4 || op == 0xfa) {
+            pops = 6, pushes = 1;
+        } else if (op == 0x52 || op == 0x53 || op == 0x55 || op == 0x57 || op == 0xf3 ||
+                   op == 0xfd) {
+            pops = 2, pushes = 0;
+        } else if (op == 0x50 || op == 0x56) {
+            pops = 1, pushes = 0;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    bool ValidJump(const U256& target) const {
+        return FitsU64(target) && ToU64(target) < code_.size() && jumpdest_[ToU64(target)];
+    }
+
+    // Everything but PUSH, DUP, SWAP and LOG; Arity() has checked the stack
+    ExecResult Other(uint8_t op, uint64_t pc, uint64_t& next) {
+        using namespace parthenon::evm;
+        switch (op) {
+            case 0x00:  // STOP
+            case 0x5b:  // JUMPDEST
+                return ExecResult::SUCCESS;
+            case 0x01: {
+                const U256 a = Pop(), b = Pop();
+                Push(Add(a, b));
+                break;
+            }
+            case 0x02: {
+                const U256 a = Pop(), b = Pop();
+                Push(Mul<8>(a, b));
+                break;
+            }
+            case 0x03: {
+                const U256 a = Pop(), b = Pop();
+                Push(Sub(a, b));
+                break;
+            }
+            case 0x04: {
+                const U256 a = Pop(), b = Pop();
+                Push(Div(a, b));
+                break;
+            }
+            case 0x05: {
+                const U256 a = Pop(), b = Pop();
+                Push(SDiv(a, b));
+                break;
+            }
+            case 0x06: {
+                const U256 a = Pop(), b = Pop();
+                Push(Mod(a, b));
+                break;
+            }
+            case 0x07: {
+                const U256 a = Pop(), b = Pop();
+                Push(SMod(a, b));
+                break;
+            }
+            case 0x08: {
+                const U256 a = Pop(), b = Pop(), n = Pop();
+                Push(AddMod(a, b, n));
+                break;
+            }
+            case 0x09: {
+                const U256 a = Pop(), b = Pop(), n = Pop();
+                Push(MulMod(a, b, n));
+                break;
+            }
+            case 0x0a: {
+                const U256 a = Pop(), b = Pop();
+                Push(Exp(a, b));
+                break;
+            }
+            case 0x0b: {
+                const U256 a = Pop(), b = Pop();
+                Push(SignExtend(a, b));
+                break;
+            }
+            case 0x10: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bool(Compare(a, b) < 0));
+                break;
+            }
+            case 0x11: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bool(Compare(a, b) > 0));
+                break;
+            }
+            case 0x12: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bool(SignedLess(a, b)));
+                break;
+            }
+            case 0x13: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bool(SignedLess(b, a)));
+                break;
+            }
+            case 0x14: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bool(Compare(a, b) == 0));
+                break;
+            }
+            case 0x15:
+                Push(Bool(IsZero(Pop())));
+                break;
+            case 0x16: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bitwise(a, b, [](uint32_t x, uint32_t y) { return x & y; }));
+                break;
+            }
+            case 0x17: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bitwise(a, b, [](uint32_t x, uint32_t y) { return x | y; }));
+                break;
+            }
+            case 0x18: {
+                const U256 a = Pop(), b = Pop();
+                Push(Bitwise(a, b, [](uint32_t x, uint32_t y) { return x ^ y; }));
+                break;
+            }
+            case 0x19:
+                Push(Not(Pop()));
+                break;
+            case 0x1a: {
+                const U256 a = Pop(), b = Pop();
+                Push(Byte(a, b));
+                break;
+            }
+            case 0x1b: {
+                const U256 a = Pop(), b = Pop();
+                Push(ShiftLeft(a, b));
+                break;
+            }
+            case 0x1c: {
+                const U256 a = Pop(), b = Pop();
+                Push(ShiftRight(a, b));
+                break;
+            }
+            case 0x1d: {
+                const U256 a = Pop(), b = Pop();
+                Push(ShiftArithmetic(a, b));
+                break;
+            }
+            case 0x20: {  // SHA3
+                const U256 offset = Pop(), size = Pop();
+                if (!Expand(offset, size)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const uint64_t length = IsZero(size) ? 0 : ToU64(size);
+                if (!Charge((length + 31) / 32 * 6)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const auto data = Slice(memory_, offset, length);
+                const auto hash = parthenon::crypto::Keccak256::Hash256(data);
+                Push(FromBytes(hash.data()));
+                break;
+            }
+            case 0x30:
+                Push(FromAddress(ctx_.address));
+                break;
+            case 0x31: {  // BALANCE
+                const Address addr = ToAddress(Pop());
+                if (!IsPrecompile(addr) && warm_addresses_.insert(addr).second &&
+                    !Charge(COLD_ACCOUNT_ACCESS_COST - WARM_STORAGE_READ_COST)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const uint256_t balance = Balance(addr);
+                Push(FromBytes(balance.data()));
+                break;
+            }
+            case 0x32:
+                Push(FromAddress(ctx_.origin));
+                break;
+            case 0x33:
+                Push(FromAddress(ctx_.caller));
+                break;
+            case 0x34:
+                Push(FromBytes(ctx_.value.data()));
+                break;
+            case 0x35: {
+                const auto word = Slice(ctx_.input_data, Pop(), 32);
+                Push(FromBytes(word.data()));
+                break;
+            }
+            case 0x36:
+                Push(FromU64(ctx_.input_data.size()));
+                break;
+            case 0x37:    // CALLDATACOPY
+            case 0x39:    // CODECOPY
+            case 0x3e: {  // RETURNDATACOPY
+                const U256 dest = Pop(), offset = Pop(), size = Pop();
+                if (op == 0x3e && (!FitsU64(offset) || !FitsU64(size) ||
+                                   ToU64(offset) + ToU64(size) < ToU64(offset) ||
+                                   ToU64(offset) + ToU64(size) > return_data_.size())) {
+                    return ExecResult::RETURN_DATA_OUT_OF_BOUNDS;
+                }
+                if (!Expand(dest, size)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const uint64_t length = IsZero(size) ? 0 : ToU64(size);
+                if (!Charge((length + 31) / 32 * 3)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const auto& source =
+                    op == 0x37 ? ctx_.input_data : op == 0x39 ? code_ : return_data_;
+                const auto data = Slice(source, offset, length);
+                std::copy(data.begin(), data.end(), memory_.begin() + (length ? ToU64(dest) : 0));
+                break;
+            }
+            case 0x38:
+                Push(FromU64(code_.size()));
+                break;
+            case 0x3a:
+                Push(FromU64(ctx_.gas_price));
+                break;
+            case 0x3d:
+                Push(FromU64(return_data_.size()));
+                break;
+            case 0x41:
+                Push(FromAddress(ctx_.coinbase));
+                break;
+            case 0x42:
+                Push(FromU64(ctx_.timestamp));
+                break;
+            case 0x43:
+                Push(FromU64(ctx_.block_number));
+                break;
+            case 0x44:
+                Push(FromU64(ctx_.difficulty));
+                break;
+            case 0x45:
+                Push(FromU64(ctx_.gas_limit_block));
+                break;
+            case 0x46:
+                Push(FromU64(ctx_.chain_id));
+                break;
+            case 0x47: {
+                const uint256_t balance = Balance(ctx_.address);
+                Push(FromBytes(balance.data()));
+                break;
+            }
+            case 0x48:
+                Push(FromU64(ctx_.base_fee));
+                break;
+            case 0x50:
+                Pop();
+                break;
+            case 0x51: {  // MLOAD
+                const U256 offset = Pop();
+                if (!Expand(offset, FromU64(32))) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                Push(FromBytes(memory_.data() + ToU64(offset)));
+                break;
+            }
+            case 0x52: {  // MSTORE
+                const U256 offset = Pop(), value = Pop();
+                if (!Expand(offset, FromU64(32))) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const uint256_t bytes = ToBytes(value);
+                std::copy(bytes.begin(), bytes.end(), memory_.begin() + ToU64(offset));
+                break;
+            }
+            case 0x53: {  // MSTORE8
+                const U256 offset = Pop(), value = Pop();
+                if (!Expand(offset, FromU64(1))) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                memory_[ToU64(offset)] = static_cast<uint8_t>(value.v[0]);
+                break;
+            }
+            case 0x54: {  // SLOAD
+                const uint256_t key = ToBytes(Pop());
+                if (warm_slots_.insert(key).second &&
+                    !Charge(COLD_SLOAD_COST - WARM_STORAGE_READ_COST)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const uint256_t value = Storage(key);
+                Push(FromBytes(value.data()));
+                break;
+            }
+            case 0x55: {  // SSTORE
+                if (ctx_.is_static) {
+                    return ExecResult::STATIC_CALL_VIOLATION;
+                }
+                if (gas_ <= static_cast<int64_t>(SSTORE_SENTRY_GAS)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                const uint256_t key = ToBytes(Pop());
+                const uint256_t value = ToBytes(Pop());
+                uint64_t cost = warm_slots_.insert(key).second ? COLD_SLOAD_COST : 0;
+                cost += StoreCost(key, value);
+                if (!Charge(cost)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                storage_[key] = value;
+                break;
+            }
+            case 0x56: {  // JUMP
+                const U256 target = Pop();
+                if (!ValidJump(target)) {
+                    return ExecResult::INVALID_JUMP;
+                }
+                next = ToU64(target);
+                break;
+            }
+            case 0x57: {  // JUMPI
+                const U256 target = Pop(), condition = Pop();
+                if (!IsZero(condition)) {
+                    if (!ValidJump(target)) {
+                        return ExecResult::INVALID_JUMP;
+                    }
+                    next = ToU64(target);
+                }
+                break;
+            }
+            case 0x58:
+                Push(FromU64(pc));
+                break;
+            case 0x59:
+                Push(FromU64(memory_.size()));
+                break;
+            case 0x5a:
+                Push(FromU64(static_cast<uint64_t>(gas_)));
+                break;
+            case 0xf3:    // RETURN
+            case 0xfd: {  // REVERT
+                const U256 offset = Pop(), size = Pop();
+                if (!Expand(offset, size)) {
+                    return ExecResult::OUT_OF_GAS;
+                }
+                output_ = Slice(memory_, offset, IsZero(size) ? 0 : ToU64(size));
+                break;
+            }
+            case 0xf1:    // CALL
+            case 0xf2:    // CALLCODE
+            case 0xf4:    // DELEGATECALL
+            case 0xfa: {  // STATICCALL
+                return Call(op);
+            }
+            default:
+                return ExecResult::INVALID_OPCODE;
+        }
+        return ExecResult::SUCCESS;
+    }
+
+    ExecResult Call(uint8_t op) {
+        using namespace parthenon::evm;
+        const bool has_value = op == 0xf1 || op == 0xf2;
+        const U256 gas = Pop();
+        const Address to = ToAddress(Pop());
+        const U256 value = has_value ? Pop() : U256();
+        const U256 in_offset = Pop(), in_size = Pop(), out_offset = Pop(), out_size = Pop();
+        if (op == 0xf1 && ctx_.is_static && !IsZero(value)) {
+            return ExecResult::STATIC_CALL_VIOLATION;
+        }
+        if (!Expand(in_offset, in_size) || !Expand(out_offset, out_size)) {
+            return ExecResult::OUT_OF_GAS;
+        }
+        uint64_t cost = 0;
+        if (!IsPrecompile(to) && warm_addresses_.insert(to).second) {
+            cost += COLD_ACCOUNT_ACCESS_COST - WARM_STORAGE_READ_COST;
+        }
+        if (!IsZero(value)) {
+            cost += CALL_VALUE_GAS;
+            if (op == 0xf1 && EmptyAccount(to)) {
+                cost += CALL_NEW_ACCOUNT_GAS;
+            }
+        }
+        if (!Charge(cost)) {
+            return ExecResult::OUT_OF_GAS;
+        }
+
+        // All but one 64th of the gas left, plus a stipend with value
+        const int64_t available = gas_ - gas_ / 64;
+        int64_t callee_gas = FitsU64(gas) && ToU64(gas) < static_cast<uint64_t>(available)
+                                 ? static_cast<int64_t>(ToU64(gas))
+                                 : available;
+        gas_ -= callee_gas;
+        if (!IsZero(value)) {
+            callee_gas += CALL_STIPEND;
+        }
+
+        return_data_.clear();
+        const U256 balance = FromBytes(Balance(ctx_.address).data());
+        if (ctx_.depth >= 1024 || (!IsZero(value) && Compare(balance, value) < 0)) {
+            gas_ += callee_gas;
+            Push(U256());
+            return ExecResult::SUCCESS;
+        }
+        if (!IsPrecompile(to) && !state_.GetCode(to)->Empty()) {
+            return ExecResult::INVALID_OPCODE;  // Not modelled
+        }
+
+        bool ok = true;
+        if (IsPrecompile(to)) {
+            const auto input = Slice(memory_, in_offset, IsZero(in_size) ? 0 : ToU64(in_size));
+            auto run = RunPrecompile(to, input, static_cast<uint64_t>(callee_gas));
+            ok = run.status == ExecResult::SUCCESS;
+            callee_gas -= static_cast<int64_t>(run.gas_used);
+            return_data_ = std::move(run.output);
+        }
+        gas_ += callee_gas;
+        if (ok && op == 0xf1 && !IsZero(value)) {  // CALLCODE pays itself
+            balances_[ctx_.address] = ToBytes(Sub(balance, value));
+            balances_[to] = ToBytes(Add(FromBytes(Balance(to).data()), value));
+        }
+        const uint64_t copied =
+            std::min<uint64_t>(IsZero(out_size) ? 0 : ToU64(out_size), return_data_.size());
+        std::copy(return_data_.begin(), return_data_.begin() + copied,
+                  memory_.begin() + (copied ? ToU64(out_offset) : 0));
+        Push(Bool(ok));
+        return ExecResult::SUCCESS;
+    }
+
+    const parthenon::evm::StateAccess& state_;
+    const ExecutionContext& ctx_;
+    const std::vector<uint8_t>& code_;
+    std::vector<bool> jumpdest_;
+
+    int64_t gas_ = 0;
+    int64_t refund_ = 0;
+    std::vector<U256> stack_;
+    std::vector<uint8_t> memory_;
+    std::vector<uint8_t> output_;
+    std::vector<uint8_t> return_data_;
+    std::vector<LogEntry> logs_;
+    std::map<uint256_t, uint256_t> storage_;
+    std::map<Address, uint256_t> balances_;
+    std::set<Address> warm_addresses_;
+    std::set<uint256_t> warm_slots_;
+};
+
+}  // namespace evm_reference
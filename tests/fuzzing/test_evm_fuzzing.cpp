@@ -0,0 +1,449 @@
+// ParthenonChain - EVM Differential Fuzzing
+// Random bytecode through evm::VM and the reference model in evm_reference.h,
+// comparing result, gas, refund, output, logs, state and every step's stack
+// and memory
+//
+// The same check runs two ways:
+//  - test_evm_fuzzing (CTest): a seeded generator of mostly well-formed
+//    programs. Arguments: [iterations] [seed]
+//  - fuzz_evm, with -DPARTHENON_LIBFUZZER=ON and Clang: the libFuzzer entry
+//    point below, fed raw inputs in the layout Decode() describes
+
+#include "evm_reference.h"
+
+#include "evm/code_cache.h"
+#include "evm/state.h"
+#include "evm/tracer.h"
+#include "evm/uint256.h"
+#include "evm/vm.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace parthenon::evm;
+
+namespace {
+
+// Steps whose whole stack and memory are compared; later steps compare
+// pc, opcode, gas and sizes only, to keep long loops affordable
+constexpr size_t kFullSteps = 4096;
+constexpr size_t kMaxComparedMemory = 64 * 1024;
+
+struct StepDigest {
+    uint64_t pc;
+    uint8_t opcode;
+    uint64_t gas;
+    size_t stack_size;
+    size_t memory_size;
+    uint64_t stack_hash;   // 0 past kFullSteps
+    uint64_t memory_hash;  // 0 past kFullSteps or kMaxComparedMemory
+
+    bool operator==(const StepDigest& other) const {
+        return pc == other.pc && opcode == other.opcode && gas == other.gas &&
+               stack_size == other.stack_size && memory_size == other.memory_size &&
+               stack_hash == other.stack_hash && memory_hash == other.memory_hash;
+    }
+};
+
+// FNV-1a
+uint64_t Hash(const uint8_t* data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t HashMemory(size_t index, const uint8_t* memory, size_t size) {
+    return index < kFullSteps && size <= kMaxComparedMemory ? Hash(memory, size) : 0;
+}
+
+class StepRecorder : public Tracer {
+  public:
+    void OnStep(const TraceStep& step) override {
+        StepDigest digest{step.pc, step.opcode, step.gas, step.stack_size, step.memory_size, 0,
+                          HashMemory(steps.size(), step.memory, step.memory_size)};
+        if (steps.size() < kFullSteps) {
+            digest.stack_hash = 1;
+            for (size_t i = 0; i < step.stack_size; ++i) {
+                const uint256_t bytes = step.stack[i].ToBytes();
+                digest.stack_hash = Hash(bytes.data(), bytes.size(), digest.stack_hash);
+            }
+        }
+        steps.push_back(digest);
+    }
+
+    std::vector<StepDigest> steps;
+};
+
+const Address kContract = [] {
+    Address addr{};
+    addr[19] = 0xc0;
+    return addr;
+}();
+
+Address Account(uint8_t id) {
+    Address addr{};
+    addr[0] = 0x11;
+    addr[19] = id;
+    return addr;
+}
+
+// Accounts and slots the generated programs are likely to touch
+const WorldState& InitialState() {
+    static const WorldState state = [] {
+        WorldState s;
+        s.SetBalance(kContract, ToUint256(1000000));
+        for (uint8_t id = 0; id < 4; ++id) {
+            s.SetBalance(Account(id), ToUint256(1000000000ULL * (id + 1)));
+        }
+        for (uint64_t slot = 0; slot < 4; ++slot) {
+            s.SetStorage(kContract, ToUint256(slot), ToUint256(slot == 0 ? 0 : 0x100 * slot));
+        }
+        s.CalculateStateRoot();
+        return s;
+    }();
+    return state;
+}
+
+/**
+ * Input layout:
+ *   [0]     flags: bit 0 static call, bit 1 call value, bits 2-3 gas range
+ *   [1..3]  gas limit within the range (big-endian)
+ *   [4]     calldata length n
+ *   [5..]   n bytes of calldata, then the code
+ */
+bool Decode(const uint8_t* data, size_t size, ExecutionContext& ctx,
+            std::vector<uint8_t>& code) {
+    if (size < 5) {
+        return false;
+    }
+    static const uint64_t kGasRanges[] = {5000, 50000, 200000, 1000000};
+    const uint8_t flags = data[0];
+    const uint64_t gas = (uint64_t{data[1]} << 16) | (uint64_t{data[2]} << 8) | data[3];
+    const size_t calldata = std::min<size_t>(data[4], size - 5);
+
+    ctx = ExecutionContext{};
+    ctx.origin = Account(0);
+    ctx.caller = Account(1);
+    ctx.address = kContract;
+    ctx.value = ToUint256((flags & 2) != 0 ? 1000 : 0);
+    ctx.input_data.assign(data + 5, data + 5 + calldata);
+    ctx.gas_limit = gas % kGasRanges[(flags >> 2) & 3];
+    ctx.gas_price = 7;
+    ctx.block_number = 1234;
+    ctx.timestamp = 1700000000;
+    ctx.coinbase = Account(3);
+    ctx.difficulty = 2;
+    ctx.gas_limit_block = 30000000;
+    ctx.chain_id = 1;
+    ctx.base_fee = 5;
+    ctx.is_static = (flags & 1) != 0;
+    ctx.depth = 0;
+    code.assign(data + 5 + calldata, data + size);
+    return true;
+}
+
+struct Stats {
+    size_t runs = 0;
+    size_t steps = 0;
+    size_t results[static_cast<int>(ExecResult::DEPTH_EXCEEDED) + 1] = {};
+};
+
+std::string Hex(const uint8_t* data, size_t size) {
+    std::string out;
+    char buffer[3];
+    for (size_t i = 0; i < size; ++i) {
+        std::snprintf(buffer, sizeof(buffer), "%02x", data[i]);
+        out += buffer;
+    }
+    return out;
+}
+
+// Reports the input and aborts, so libFuzzer saves it as a crash
+void Require(bool condition, const char* what, const uint8_t* data, size_t size) {
+    if (!condition) {
+        std::cerr << "EVM differential mismatch: " << what << "\n  input: " << Hex(data, size)
+                  << std::endl;
+        std::abort();
+    }
+}
+
+bool SameLogs(const std::vector<LogEntry>& a, const std::vector<LogEntry>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].address != b[i].address || a[i].topics != b[i].topics ||
+            a[i].data != b[i].data) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CheckOne(const uint8_t* data, size_t size, Stats* stats) {
+    ExecutionContext ctx;
+    std::vector<uint8_t> code;
+    if (!Decode(data, size, ctx, code)) {
+        return;
+    }
+    const WorldState& initial = InitialState();
+
+    // Reference model
+    std::vector<StepDigest> expected_steps;
+    evm_reference::Interpreter reference(initial, ctx, code);
+    const evm_reference::Outcome expected = reference.Run([&](const evm_reference::Step& step) {
+        const auto& memory = step.memory;
+        StepDigest digest{step.pc,          step.opcode,   step.gas, step.stack.size(),
+                          memory.size(),    0,
+                          HashMemory(expected_steps.size(), memory.data(), memory.size())};
+        if (expected_steps.size() < kFullSteps) {
+            digest.stack_hash = 1;
+            for (const auto& word : step.stack) {
+                const uint256_t bytes = evm_reference::ToBytes(word);
+                digest.stack_hash = Hash(bytes.data(), bytes.size(), digest.stack_hash);
+            }
+        }
+        expected_steps.push_back(digest);
+    });
+    WorldState expected_state = initial;
+    for (const auto& [key, value] : expected.storage_writes) {
+        expected_state.SetStorage(kContract, key, value);
+    }
+    for (const auto& [addr, balance] : expected.balance_writes) {
+        expected_state.SetBalance(addr, balance);
+    }
+    const auto expected_root = expected_state.CalculateStateRoot();
+
+    // The VM, untraced as in production and traced for the steps
+    const CodeHandle shared = CodeCache::Global().Insert(code);
+    WorldState state = initial;
+    VM vm(state, ctx);
+    const auto [result, output] = vm.Execute(*shared);
+
+    WorldState traced_state = initial;
+    VM traced_vm(traced_state, ctx);
+    StepRecorder recorder;
+    const auto [traced_result, traced_output] = traced_vm.Execute(*shared, recorder);
+
+    // Exceptional halts are one outcome: the VM checks gas and stack per
+    // block, so it may name a different fault, found earlier in the block
+    const bool exceptional = evm_reference::IsExceptional(expected.result);
+    Require(exceptional ? evm_reference::IsExceptional(result) : result == expected.result,
+            "result", data, size);
+    Require(traced_result == result, "traced result", data, size);
+    Require(vm.GetGasUsed() == expected.gas_used, "gas used", data, size);
+    Require(traced_vm.GetGasUsed() == expected.gas_used, "traced gas used", data, size);
+    Require(vm.GetGasRefund() == expected.gas_refund, "gas refund", data, size);
+    Require(output == expected.output && traced_output == expected.output, "output", data,
+            size);
+    Require(SameLogs(vm.GetLogs(), expected.logs), "logs", data, size);
+    Require(state.CalculateStateRoot() == expected_root, "state", data, size);
+    Require(traced_state.CalculateStateRoot() == expected_root, "traced state", data, size);
+
+    // A block that faults on entry reports none of its steps
+    const auto& steps = recorder.steps;
+    Require(exceptional ? steps.size() <= expected_steps.size()
+                        : steps.size() == expected_steps.size(),
+            "step count", data, size);
+    for (size_t i = 0; i < steps.size(); ++i) {
+        if (!(steps[i] == expected_steps[i])) {
+            std::cerr << "step " << i << ": pc " << steps[i].pc << " / " << expected_steps[i].pc
+                      << ", op " << GetOpcodeName(steps[i].opcode) << " / "
+                      << GetOpcodeName(expected_steps[i].opcode) << ", gas " << steps[i].gas
+                      << " / " << expected_steps[i].gas << ", stack " << steps[i].stack_size
+                      << " / " << expected_steps[i].stack_size << std::endl;
+            Require(false, "step", data, size);
+        }
+    }
+
+    if (stats != nullptr) {
+        ++stats->runs;
+        stats->steps += expected_steps.size();
+        // SUCCESS and RETURNED share a message
+        const ExecResult kind = result == ExecResult::RETURNED ? ExecResult::SUCCESS : result;
+        ++stats->results[static_cast<int>(kind)];
+    }
+}
+
+#ifndef PARTHENON_LIBFUZZER
+
+// Mostly well-formed programs: pushes of boundary values, implemented
+// opcodes, and jumps to the program's own JUMPDESTs, so runs get past the
+// first few instructions
+class ProgramGenerator {
+  public:
+    explicit ProgramGenerator(uint64_t seed) : rng_(seed) {}
+
+    std::vector<uint8_t> Next() {
+        std::vector<uint8_t> input(5);
+        input[0] = static_cast<uint8_t>(Below(16));
+        input[0] &= Below(10) == 0 ? 0xff : 0xfe;  // Static calls now and then
+        for (int i = 1; i < 4; ++i) {
+            input[i] = static_cast<uint8_t>(Below(256));
+        }
+        std::vector<uint8_t> calldata;
+        const size_t words = Below(4);
+        for (size_t i = 0; i < words; ++i) {
+            const auto word = Interesting();
+            calldata.insert(calldata.end(), word.begin(), word.end());
+        }
+        calldata.resize(std::min<size_t>(calldata.size(), Below(2) ? calldata.size() : Below(97)));
+        input[4] = static_cast<uint8_t>(calldata.size());
+        input.insert(input.end(), calldata.begin(), calldata.end());
+
+        const auto code = Below(10) == 0 ? RandomBytes() : Program();
+        input.insert(input.end(), code.begin(), code.end());
+        return input;
+    }
+
+  private:
+    uint64_t Below(uint64_t n) { return rng_() % n; }
+
+    std::array<uint8_t, 32> Interesting() {
+        std::array<uint8_t, 32> word{};
+        switch (Below(6)) {
+            case 0:
+                break;
+            case 1:
+                word[31] = static_cast<uint8_t>(Below(64));
+                break;
+            case 2:
+                word.fill(0xff);
+                break;
+            case 3:
+                word[0] = 0x80;
+                break;
+            case 4:
+                word.fill(0xff);
+                word[0] = 0x7f;
+                break;
+            default:
+                for (auto& byte : word) {
+                    byte = static_cast<uint8_t>(rng_());
+                }
+                break;
+        }
+        return word;
+    }
+
+    std::vector<uint8_t> RandomBytes() {
+        std::vector<uint8_t> code(Below(96));
+        for (auto& byte : code) {
+            byte = static_cast<uint8_t>(rng_());
+        }
+        return code;
+    }
+
+    void Push(std::vector<uint8_t>& code) {
+        if (Below(3) != 0) {
+            code.push_back(0x60);  // PUSH1 of a small value: offsets, sizes, slots
+            code.push_back(static_cast<uint8_t>(Below(Below(4) == 0 ? 256 : 40)));
+            return;
+        }
+        const size_t size = 1 + Below(32);
+        const auto word = Interesting();
+        code.push_back(static_cast<uint8_t>(0x5f + size));
+        code.insert(code.end(), word.end() - size, word.end());
+    }
+
+    std::vector<uint8_t> Program() {
+        // Implemented opcodes, plus a few that are not (PUSH0, creates)
+        static const uint8_t kOps[] = {
+            0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x10,
+            0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+            0x20, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3d,
+            0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x50, 0x51, 0x52, 0x53, 0x54,
+            0x55, 0x58, 0x59, 0x5a, 0x80, 0x81, 0x82, 0x83, 0x8f, 0x90, 0x91, 0x92, 0x9f,
+            0xa0, 0xa1, 0xa2, 0xa4, 0xf3, 0xfd, 0xfe, 0x5f, 0xf1, 0xf0, 0x3e, 0x40,
+            0xf2, 0xf4, 0xfa,
+        };
+        std::vector<uint8_t> code;
+        std::vector<size_t> jumpdests;
+        std::vector<size_t> fixups;  // Offsets of PUSH2 jump targets to fill in
+        // Start with operands so most runs get past their first instructions
+        const size_t operands = Below(8);
+        for (size_t i = 0; i < operands; ++i) {
+            Push(code);
+        }
+        const size_t items = 1 + Below(120);
+        for (size_t i = 0; i < items; ++i) {
+            const uint64_t choice = Below(100);
+            if (choice < 35) {
+                Push(code);
+            } else if (choice < 40) {
+                jumpdests.push_back(code.size());
+                code.push_back(0x5b);
+            } else if (choice < 47) {
+                const bool conditional = Below(2) == 0;
+                if (conditional) {
+                    code.push_back(0x60);
+                    code.push_back(static_cast<uint8_t>(Below(2)));
+                }
+                code.push_back(0x61);
+                fixups.push_back(code.size());
+                code.push_back(0);
+                code.push_back(0);
+                code.push_back(conditional ? 0x57 : 0x56);
+            } else {
+                code.push_back(kOps[Below(sizeof(kOps))]);
+            }
+        }
+        for (size_t at : fixups) {
+            const size_t target = jumpdests.empty() || Below(8) == 0
+                                      ? Below(code.size() + 2)
+                                      : jumpdests[Below(jumpdests.size())];
+            code[at] = static_cast<uint8_t>(target >> 8);
+            code[at + 1] = static_cast<uint8_t>(target);
+        }
+        return code;
+    }
+
+    std::mt19937_64 rng_;
+};
+
+#endif  // PARTHENON_LIBFUZZER
+
+}  // namespace
+
+#ifdef PARTHENON_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    CheckOne(data, size, nullptr);
+    return 0;
+}
+
+#else
+
+int main(int argc, char* argv[]) {
+    const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    const uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0xe7f;
+
+    std::cout << "=== EVM Differential Fuzzing ===" << std::endl;
+    std::cout << "Fuzzing evm::VM against the reference model with " << iterations
+              << " programs (seed " << seed << ")..." << std::endl;
+
+    ProgramGenerator generator(seed);
+    Stats stats;
+    for (size_t i = 0; i < iterations; ++i) {
+        const auto input = generator.Next();
+        CheckOne(input.data(), input.size(), &stats);
+    }
+
+    std::cout << "  Steps compared: " << stats.steps << std::endl;
+    for (int r = 0; r <= static_cast<int>(ExecResult::DEPTH_EXCEEDED); ++r) {
+        if (stats.results[r] > 0) {
+            std::cout << "  " << GetResultMessage(static_cast<ExecResult>(r)) << ": "
+                      << stats.results[r] << std::endl;
+        }
+    }
+    std::cout << "\n✓ EVM matches the reference model" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,188 @@
+// ParthenonChain - ECDSA Recovery Tests
+// Known Ethereum vector, plus keys recovered from OpenSSL signatures;
+// BIP-340 vectors for the native Schnorr verify
+
+#include "crypto/ecdsa.h"
+
+#include <openssl/core_names.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace parthenon::crypto;
+
+// Helper to convert hex string to bytes
+std::vector<uint8_t> HexToBytes(const std::string &hex) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i < hex.length(); i += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::strtol(hex.substr(i, 2).c_str(), nullptr, 16)));
+    }
+    return bytes;
+}
+
+ECDSA::Signature MakeSignature(const std::vector<uint8_t> &r, const std::vector<uint8_t> &s) {
+    ECDSA::Signature signature{};
+    std::copy(r.begin(), r.end(), signature.begin() + 32 - r.size());
+    std::copy(s.begin(), s.end(), signature.begin() + 64 - s.size());
+    return signature;
+}
+
+void TestRecoverKnownVector() {
+    std::cout << "Test ECDSA: recover a known Ethereum signer" << std::endl;
+
+    const auto hash =
+        HexToBytes("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c");
+    const auto r = HexToBytes("73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9aa6a5a75f");
+    const auto s = HexToBytes("eeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549");
+    const auto signature = MakeSignature(r, s);
+    const auto pubkey = ECDSA::Recover(hash.data(), signature, 1);
+    assert(pubkey);
+    // Public key of address a94f5374fce5edbc8e2a8697c15331677e6ebf0b
+    assert(std::vector<uint8_t>(pubkey->begin(), pubkey->end()) ==
+           HexToBytes("3a514176466fa815ed481ffad09110a2d344f6c9b78c1d14afc351c3a51be33d"
+                      "8072e77939dc03ba44790779b7a1025baf3003f6732430e20cd9b76d953391b3"));
+
+    // The other parity gives a different key; r = 0 or s >= n give none
+    const auto other = ECDSA::Recover(hash.data(), signature, 0);
+    assert(other && *other != *pubkey);
+    assert(!ECDSA::Recover(hash.data(), signature, 2));
+    assert(!ECDSA::Recover(hash.data(), MakeSignature({0}, {1}), 0));
+    std::vector<uint8_t> order =
+        HexToBytes("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+    assert(!ECDSA::Recover(hash.data(), MakeSignature({1}, order), 0));
+
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestRecoverOpenSSLSignatures() {
+    std::cout << "Test ECDSA: recover keys of OpenSSL signatures" << std::endl;
+
+    std::mt19937 rng(1234);
+    for (int round = 0; round < 32; ++round) {
+        EVP_PKEY *key = EVP_EC_gen("secp256k1");
+        assert(key != nullptr);
+        uint8_t encoded[65];
+        size_t encoded_len = 0;
+        const int got_key = EVP_PKEY_get_octet_string_param(
+            key, OSSL_PKEY_PARAM_PUB_KEY, encoded, sizeof(encoded), &encoded_len);
+        assert(got_key == 1 && encoded_len == 65 && encoded[0] == 0x04);
+
+        uint8_t hash[32];
+        for (auto &byte : hash) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(key, nullptr);
+        uint8_t der[80];
+        size_t der_len = sizeof(der);
+        const int signed_ok = EVP_PKEY_sign_init(ctx) == 1 &&
+                              EVP_PKEY_sign(ctx, der, &der_len, hash, sizeof(hash)) == 1;
+        assert(signed_ok);
+        const uint8_t *cursor = der;
+        ECDSA_SIG *sig = d2i_ECDSA_SIG(nullptr, &cursor, static_cast<long>(der_len));
+        assert(sig != nullptr);
+        ECDSA::Signature signature{};
+        BN_bn2binpad(ECDSA_SIG_get0_r(sig), signature.data(), 32);
+        BN_bn2binpad(ECDSA_SIG_get0_s(sig), signature.data() + 32, 32);
+
+        // One of the two parities gives back the signing key
+        int matches = 0;
+        for (int recovery_id = 0; recovery_id < 2; ++recovery_id) {
+            const auto pubkey = ECDSA::Recover(hash, signature, recovery_id);
+            if (pubkey && std::equal(pubkey->begin(), pubkey->end(), encoded + 1)) {
+                ++matches;
+            }
+        }
+        assert(matches == 1);
+        (void)got_key;
+        (void)signed_ok;
+
+        ECDSA_SIG_free(sig);
+        EVP_PKEY_CTX_free(ctx);
+        EVP_PKEY_free(key);
+    }
+
+    std::cout << "  ✓ Passed (32 keys)" << std::endl;
+}
+
+void TestVerifySchnorrVectors() {
+    std::cout << "Test ECDSA: native BIP-340 verify" << std::endl;
+
+    // BIP-340 test vectors 0 and 1
+    const auto pubkey0 =
+        HexToBytes("F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9");
+    const std::vector<uint8_t> msg0(32, 0);
+    const auto sig0 = HexToBytes(
+        "E907831F80848D1069A5371B402410364BDF1C5F8307B0084C55F1CE2DCA8215"
+        "25F66A4A85EA8B71E482A74F382D2CE5EBEEE8FDB2172F477DF4900D310536C0");
+    assert(ECDSA::VerifySchnorr(pubkey0.data(), msg0.data(), sig0.data()));
+
+    const auto pubkey =
+        HexToBytes("DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659");
+    auto msg = HexToBytes("243F6A8885A308D313198A2E03707344A4093822299F31D0082EFA98EC4E6C89");
+    const auto sig = HexToBytes(
+        "6896BD60EEAE296DB48A229FF71DFE071BDE413E6D43F917DC8DCF8C78DE3341"
+        "8906D11AC976ABCCB20B091292BFF4EA897EFCB639EA871CFA95F6DE339E4B0A");
+    assert(ECDSA::VerifySchnorr(pubkey.data(), msg.data(), sig.data()));
+    assert(!ECDSA::VerifySchnorr(pubkey0.data(), msg.data(), sig.data()));
+
+    // Other message
+    msg[0] ^= 1;
+    assert(!ECDSA::VerifySchnorr(pubkey.data(), msg.data(), sig.data()));
+    msg[0] ^= 1;
+
+    // r = p and s = n are out of range
+    auto bad = sig;
+    const auto p = HexToBytes("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F");
+    std::copy(p.begin(), p.end(), bad.begin());
+    assert(!ECDSA::VerifySchnorr(pubkey.data(), msg.data(), bad.data()));
+    bad = sig;
+    const auto n = HexToBytes("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+    std::copy(n.begin(), n.end(), bad.begin() + 32);
+    assert(!ECDSA::VerifySchnorr(pubkey.data(), msg.data(), bad.data()));
+
+    // n - s gives R with odd y
+    bad = sig;
+    int borrow = 0;
+    for (int i = 31; i >= 0; --i) {
+        const int diff = n[i] - sig[32 + i] - borrow;
+        bad[32 + i] = static_cast<uint8_t>(diff);
+        borrow = diff < 0;
+    }
+    assert(!ECDSA::VerifySchnorr(pubkey.data(), msg.data(), bad.data()));
+
+    // x = 5 is not on the curve
+    std::vector<uint8_t> off_curve(32, 0);
+    off_curve[31] = 5;
+    assert(!ECDSA::VerifySchnorr(off_curve.data(), msg.data(), sig.data()));
+
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=====================================" << std::endl;
+    std::cout << "ParthenonChain ECDSA Test Suite" << std::endl;
+    std::cout << "=====================================" << std::endl << std::endl;
+
+    try {
+        TestRecoverKnownVector();
+        TestRecoverOpenSSLSignatures();
+        TestVerifySchnorrVectors();
+
+        std::cout << std::endl;
+        std::cout << "=====================================" << std::endl;
+        std::cout << "All ECDSA tests passed! ✓" << std::endl;
+        std::cout << "=====================================" << std::endl;
+
+        return 0;
+    } catch (const std::exception &e) {
+        std::cerr << "Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,281 @@
+// ParthenonChain - Obolos Block Executor Tests
+
+#include "evm/block_executor.h"
+#include "evm/execution.h"
+#include "evm/gas_pricing.h"
+#include "evm/opcodes.h"
+#include "evm/state.h"
+#include "evm/uint256.h"
+
+#include <cassert>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace parthenon::evm;
+using pantheon::obolos::ExecutedBlock;
+using pantheon::obolos::ObolosBlock;
+using pantheon::obolos::ObolosBlockExecutor;
+using pantheon::obolos::ObolosTransaction;
+
+namespace {
+
+Address MakeAddress(uint8_t id) {
+    Address addr{};
+    addr[19] = id;
+    return addr;
+}
+
+const Address kAlice = MakeAddress(0xa1);
+const Address kBob = MakeAddress(0xb0);
+const Address kCounter = MakeAddress(0xc0);
+const Address kCoinbase = MakeAddress(0xcb);
+
+// Reverts if calldata word 0 is non-zero; otherwise increments slot 0 and
+// logs topic 0xaa
+const std::vector<uint8_t> kCounterCode = {
+    0x60, 0x00, 0x35, 0x60, 0x17, 0x57,  // PUSH1 0 CALLDATALOAD PUSH1 0x17 JUMPI
+    0x60, 0x00, 0x54, 0x60, 0x01, 0x01,  // PUSH1 0 SLOAD PUSH1 1 ADD
+    0x60, 0x00, 0x55,                    // PUSH1 0 SSTORE
+    0x60, 0xaa, 0x60, 0x00, 0x60, 0x00,  // PUSH1 0xaa PUSH1 0 PUSH1 0
+    0xa1, 0x00,                          // LOG1 STOP
+    0x5b, 0x60, 0x00, 0x60, 0x00, 0xfd,  // 0x17: JUMPDEST PUSH1 0 PUSH1 0 REVERT
+};
+
+constexpr uint64_t kStartBalance = 1000000000000ULL;
+
+WorldState MakeState() {
+    WorldState state;
+    state.SetBalance(kAlice, ToUint256(kStartBalance));
+    state.SetBalance(kBob, ToUint256(kStartBalance));
+    state.SetCode(kCounter, kCounterCode);
+    return state;
+}
+
+uint64_t Balance(const WorldState& state, const Address& addr) {
+    return ToUint64(state.GetBalance(addr));
+}
+
+ObolosTransaction Call(const Address& from, uint64_t nonce, const Address& to) {
+    ObolosTransaction tx;
+    tx.from = from;
+    tx.to = to;
+    tx.nonce = nonce;
+    tx.gas_limit = 100000;
+    tx.max_fee_per_gas = 100;
+    tx.max_priority_fee_per_gas = 2;
+    return tx;
+}
+
+ObolosBlock MakeBlock(uint64_t number, uint64_t base_fee) {
+    ObolosBlock block;
+    block.number = number;
+    block.timestamp = 1700000000 + number;
+    block.coinbase = kCoinbase;
+    block.gas_limit = GasPricing::MAX_GAS_PER_BLOCK;
+    block.base_fee = base_fee;
+    return block;
+}
+
+// Three blocks: counter calls and a value transfer, an empty block, and a
+// reverted call. Each base fee follows from its parent, as executed here.
+std::vector<ObolosBlock> MakeChain() {
+    WorldState scratch = MakeState();
+    ObolosBlockExecutor executor(scratch, 1, false);
+    std::vector<ObolosBlock> blocks;
+    uint64_t base_fee = GasPricing::INITIAL_BASE_FEE;
+    auto add = [&](ObolosBlock block) {
+        const ExecutedBlock executed = executor.ExecuteBlock(block);
+        assert(executed.valid);
+        base_fee = CalculateNextBaseFee(block.base_fee, executed.gas_used, block.gas_limit);
+        blocks.push_back(std::move(block));
+    };
+
+    ObolosBlock first = MakeBlock(1, base_fee);
+    first.transactions = {Call(kAlice, 0, kCounter), Call(kAlice, 1, kCounter)};
+    ObolosTransaction transfer = Call(kBob, 0, kAlice);
+    transfer.value = ToUint256(5000);
+    first.transactions.push_back(transfer);
+    add(first);
+
+    add(MakeBlock(2, base_fee));
+
+    ObolosBlock third = MakeBlock(3, base_fee);
+    ObolosTransaction reverted = Call(kBob, 1, kCounter);
+    reverted.data.assign(32, 0);
+    reverted.data[31] = 1;
+    third.transactions = {reverted, Call(kAlice, 2, kCounter)};
+    add(third);
+    return blocks;
+}
+
+}  // namespace
+
+void TestReceiptsAndFees() {
+    std::cout << "Test: Receipts, blooms and EIP-1559 fees" << std::endl;
+
+    WorldState state = MakeState();
+    ObolosBlockExecutor executor(state, 1, false);
+    const ObolosBlock block = MakeChain()[0];
+    const ExecutedBlock executed = executor.ExecuteBlock(block);
+    assert(executed.valid);
+    assert(executed.receipts.size() == 3);
+
+    uint64_t cumulative = 0;
+    for (const auto& receipt : executed.receipts) {
+        assert(receipt.Succeeded());
+        assert(receipt.effective_gas_price == block.base_fee + 2);
+        cumulative += receipt.gas_used;
+        assert(receipt.cumulative_gas_used == cumulative);
+    }
+    assert(executed.gas_used == cumulative);
+    assert(executed.receipts[2].gas_used == TX_BASE_GAS);
+    assert(executed.receipts[0].logs.size() == 1 && executed.receipts[2].logs.empty());
+
+    // The block bloom covers the counter's logs and nothing from the transfer
+    const LogBloom& bloom = executed.bloom;
+    assert(bloom.MayContain(LogBloom::BitPositions(kCounter)));
+    uint256_t topic{};
+    topic[31] = 0xaa;
+    assert(bloom.MayContain(LogBloom::BitPositions(topic)));
+    assert(executed.receipts[2].bloom.Empty());
+
+    // Senders pay gas_used * price, the coinbase gets the tips, the rest is burned
+    const uint64_t price = block.base_fee + 2;
+    const uint64_t alice_gas = executed.receipts[0].gas_used + executed.receipts[1].gas_used;
+    const uint64_t bob_gas = executed.receipts[2].gas_used;
+    assert(Balance(state, kAlice) == kStartBalance - alice_gas * price + 5000);
+    assert(Balance(state, kBob) == kStartBalance - bob_gas * price - 5000);
+    assert(Balance(state, kCoinbase) == cumulative * 2);
+    assert(ToUint64(executed.priority_fees) == cumulative * 2);
+    assert(ToUint64(executed.base_fee_burned) == cumulative * block.base_fee);
+    assert(state.GetNonce(kAlice) == 2 && state.GetNonce(kBob) == 1);
+    assert(ToUint64(state.GetStorage(kCounter, uint256_t{})) == 2);
+
+    // Roots are ready on return without pipelining
+    const auto roots = executed.roots.get();
+    assert(roots.state_root == state.CalculateStateRoot());
+    assert(roots.timings.execute_ns > 0);
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestFailedCall() {
+    std::cout << "Test: Failed calls keep the nonce and fee" << std::endl;
+
+    WorldState state = MakeState();
+    ObolosBlockExecutor executor(state, 1, false);
+    ObolosBlock block = MakeBlock(1, GasPricing::INITIAL_BASE_FEE);
+    ObolosTransaction reverted = Call(kBob, 0, kCounter);
+    reverted.data.assign(32, 0);
+    reverted.data[31] = 1;
+    reverted.value = ToUint256(77);
+    block.transactions = {reverted};
+
+    const ExecutedBlock executed = executor.ExecuteBlock(block);
+    assert(executed.valid);
+    const auto& receipt = executed.receipts[0];
+    assert(receipt.result == ExecResult::REVERT && receipt.logs.empty());
+    assert(state.GetNonce(kBob) == 1);
+    assert(Balance(state, kBob) == kStartBalance - receipt.gas_used * receipt.effective_gas_price);
+    assert(Balance(state, kCounter) == 0);
+    assert(ToUint64(state.GetStorage(kCounter, uint256_t{})) == 0);
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestInvalidBlocks() {
+    std::cout << "Test: Invalid transactions reject the block" << std::endl;
+
+    WorldState state = MakeState();
+    ObolosBlockExecutor executor(state, 1, false);
+    const auto root = state.CalculateStateRoot();
+
+    auto expect_rejected = [&](const ObolosTransaction& bad) {
+        ObolosBlock block = MakeBlock(1, GasPricing::INITIAL_BASE_FEE);
+        block.transactions = {Call(kAlice, 0, kCounter), bad};
+        const ExecutedBlock executed = executor.ExecuteBlock(block);
+        assert(!executed.valid && executed.failed_tx == 1 && !executed.error.empty());
+        assert(state.CalculateStateRoot() == root);  // The first transaction is undone too
+    };
+
+    expect_rejected(Call(kAlice, 0, kCounter));  // Reused nonce
+    expect_rejected(Call(kAlice, 5, kCounter));  // Nonce gap
+    ObolosTransaction bad = Call(kAlice, 1, kCounter);
+    bad.max_fee_per_gas = GasPricing::INITIAL_BASE_FEE - 1;
+    expect_rejected(bad);
+    bad = Call(kAlice, 1, kCounter);
+    bad.max_priority_fee_per_gas = bad.max_fee_per_gas + 1;
+    expect_rejected(bad);
+    bad = Call(kAlice, 1, kCounter);
+    bad.gas_limit = TX_BASE_GAS - 1;
+    expect_rejected(bad);
+    bad = Call(kAlice, 1, kCounter);
+    bad.value = ToUint256(kStartBalance);  // Plus gas is more than Alice has
+    expect_rejected(bad);
+    bad = Call(kAlice, 1, kCounter);
+    bad.gas_limit = GasPricing::MAX_GAS_PER_BLOCK;  // Above the block's remaining gas
+    expect_rejected(bad);
+
+    // After a valid block the next must follow on in number and base fee
+    ObolosBlock block = MakeBlock(1, GasPricing::INITIAL_BASE_FEE);
+    block.transactions = {Call(kAlice, 0, kCounter)};
+    const ExecutedBlock executed = executor.ExecuteBlock(block);
+    assert(executed.valid);
+    const uint64_t base_fee =
+        CalculateNextBaseFee(block.base_fee, executed.gas_used, block.gas_limit);
+    assert(!executor.ExecuteBlock(MakeBlock(3, base_fee)).valid);
+    assert(!executor.ExecuteBlock(MakeBlock(2, base_fee + 1)).valid);
+    assert(executor.ExecuteBlock(MakeBlock(2, base_fee)).valid);
+
+    const auto stats = executor.GetStats();
+    assert(stats.rejected == 9 && stats.blocks == 2 && stats.transactions == 1);
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestPipelinedRoots() {
+    std::cout << "Test: Pipelined roots match inline roots" << std::endl;
+
+    const std::vector<ObolosBlock> chain = MakeChain();
+    WorldState inline_state = MakeState();
+    WorldState pipelined_state = MakeState();
+    std::vector<ExecutedBlock> inline_blocks;
+    std::vector<ExecutedBlock> pipelined_blocks;
+    {
+        ObolosBlockExecutor inline_executor(inline_state, 1, false);
+        ObolosBlockExecutor pipelined_executor(pipelined_state, 1, true);
+        for (const auto& block : chain) {
+            inline_blocks.push_back(inline_executor.ExecuteBlock(block));
+            pipelined_blocks.push_back(pipelined_executor.ExecuteBlock(block));
+            assert(inline_blocks.back().valid && pipelined_blocks.back().valid);
+        }
+        pipelined_executor.WaitForRoots();
+        assert(pipelined_executor.GetStats().blocks == chain.size());
+    }
+
+    for (size_t i = 0; i < chain.size(); ++i) {
+        const auto expected = inline_blocks[i].roots.get();
+        const auto roots = pipelined_blocks[i].roots.get();
+        assert(roots.state_root == expected.state_root);
+        assert(roots.receipts_root == expected.receipts_root);
+    }
+    assert(pipelined_blocks.back().roots.get().state_root ==
+           pipelined_state.CalculateStateRoot());
+    assert(pipelined_state.CalculateStateRoot() == inline_state.CalculateStateRoot());
+
+    // Receipts differ between blocks, and so do their roots
+    assert(pipelined_blocks[0].roots.get().receipts_root !=
+           pipelined_blocks[2].roots.get().receipts_root);
+    assert(pipelined_blocks[2].receipts[0].result == ExecResult::REVERT);
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Obolos Block Executor Tests ===" << std::endl;
+
+    TestReceiptsAndFees();
+    TestFailedCall();
+    TestInvalidBlocks();
+    TestPipelinedRoots();
+
+    std::cout << "\n✓ All block executor tests passed!" << std::endl;
+    return 0;
+}
@@ -3,13 +3,17 @@
 #include "layer2-drachma/bridges/channels/payment_channel.h"
 #include "layer2-drachma/bridges/htlc/htlc.h"
 #include "layer2-drachma/bridges/spv/spv_bridge.h"
+#include "layer2-drachma/indexers/contract_indexer/contract_indexer.h"
+#include "layer2-drachma/indexers/tx_indexer/tx_indexer.h"
 #include "layer2-drachma/plasma/plasma_chain.h"
 #include "layer2-drachma/rollups/optimistic_rollup.h"
 #include "layer2-drachma/rollups/zk_rollup.h"
 #include "privacy/zk_snark.h"
 #include "crypto/sha256.h"
+#include "storage/block_storage.h"
 
 #include <cassert>
+#include <filesystem>
 #include <iostream>
 
 using namespace parthenon::layer2;
@@ -357,6 +361,333 @@ void test_layer2_apis() {
     std::cout << "Layer 2 API server tests passed!" << std::endl;
 }
 
+void test_contract_log_index() {
+    std::cout << "Testing contract log index..." << std::endl;
+
+    using indexers::ContractEvent;
+    using indexers::ContractIndexer;
+    using indexers::LogFilter;
+
+    ContractIndexer indexer;
+    assert(indexer.Open("/tmp/parthenon_test_contract_index"));
+
+    std::array<uint8_t, 20> token{};
+    token[19] = 0x01;
+    std::array<uint8_t, 20> exchange{};
+    exchange[19] = 0x02;
+    std::array<uint8_t, 32> transfer{};
+    transfer[0] = 0xDD;
+    std::array<uint8_t, 32> approval{};
+    approval[0] = 0x8C;
+    std::array<uint8_t, 32> alice{};
+    alice[31] = 0xA1;
+    std::array<uint8_t, 32> bob{};
+    bob[31] = 0xB0;
+    indexer.IndexContractDeployment(token, {0x60, 0x00}, 0);
+    indexer.IndexContractDeployment(exchange, {0x60, 0x01}, 0);
+
+    // Three sections of blocks: token transfers every 7th block, alternating
+    // senders, and an exchange approval every 1000th
+    const uint32_t kBlocks = 3 * ContractIndexer::kSectionSize;
+    size_t transfers = 0;
+    size_t alice_transfers = 0;
+    for (uint32_t height = 0; height < kBlocks; ++height) {
+        if (height % 7 == 0) {
+            const bool from_alice = (height / 7) % 2 == 0;
+            indexer.IndexEvent(ContractEvent{token, {transfer, from_alice ? alice : bob}, {0x01},
+                                             height, 0});
+            ++transfers;
+            alice_transfers += from_alice ? 1 : 0;
+        }
+        if (height % 1000 == 0) {
+            indexer.IndexEvent(ContractEvent{exchange, {approval, alice}, {}, height, 1});
+        }
+    }
+    assert(indexer.GetEventCount() == transfers + (kBlocks + 999) / 1000);
+
+    // By address, in block order
+    auto events = indexer.GetEventsByContract(exchange, 1000);
+    assert(events.size() == (kBlocks + 999) / 1000);
+    for (size_t i = 0; i < events.size(); ++i) {
+        assert(events[i].block_height == i * 1000);
+        assert(events[i].tx_index == 1);
+        assert(events[i].topics.size() == 2 && events[i].topics[0] == approval);
+    }
+    assert(indexer.GetContractInfo(token)->event_count == transfers);
+
+    // Topics by position, addresses and block range together
+    LogFilter filter;
+    filter.topics = {{transfer}, {alice}};
+    assert(indexer.GetLogs(filter).size() == alice_transfers);
+    filter.topics = {{}, {alice}};
+    assert(indexer.GetLogs(filter).size() == alice_transfers + events.size());
+    filter.addresses = {token};
+    filter.from_block = 5000;
+    filter.to_block = 9000;
+    events = indexer.GetLogs(filter);
+    assert(!events.empty());
+    for (const auto& event : events) {
+        assert(event.contract_address == token && event.topics[1] == alice);
+        assert(event.block_height >= 5000 && event.block_height <= 9000);
+        assert(event.data == std::vector<uint8_t>{0x01});
+    }
+    filter.topics = {{approval}};
+    assert(indexer.GetLogs(filter).empty());
+    filter.addresses = {token, exchange};
+    assert(indexer.GetLogs(filter).size() == 5);  // 5000, 6000, ..., 9000
+
+    // Any topic position; limits
+    assert(indexer.GetEventsByTopic(alice, 10).size() == 10);
+    assert(indexer.GetEventsByTopic(approval).size() == 13);
+    std::array<uint8_t, 32> unknown{};
+    unknown[5] = 0x55;
+    assert(indexer.GetEventsByTopic(unknown).empty());
+
+    // Block blooms
+    const auto bloom = indexer.GetBlockBloom(7000);
+    assert(bloom.MayContain(parthenon::evm::LogBloom::BitPositions(token)));
+    assert(bloom.MayContain(parthenon::evm::LogBloom::BitPositions(exchange)));
+    assert(indexer.GetBlockBloom(7001).Empty());
+
+    // A block indexed again later is appended to
+    indexer.IndexEvent(ContractEvent{exchange, {approval, bob}, {}, 7, 3});
+    LogFilter block7;
+    block7.from_block = block7.to_block = 7;
+    events = indexer.GetLogs(block7);
+    assert(events.size() == 2 && events[1].tx_index == 3);
+    indexer.Close();
+
+    std::cout << "Contract log index tests passed!" << std::endl;
+}
+
+void test_tx_indexer() {
+    std::cout << "Testing transaction indexer..." << std::endl;
+
+    using indexers::TxIndexer;
+    namespace primitives = parthenon::primitives;
+
+    const auto base = std::filesystem::temp_directory_path();
+    std::filesystem::remove_all(base / "parthenon_test_tx_blocks");
+    std::filesystem::remove_all(base / "parthenon_test_tx_index");
+    parthenon::storage::BlockStorage blocks;
+    assert(blocks.Open((base / "parthenon_test_tx_blocks").string()));
+
+    // Each block pays the miner and spends the previous block's coinbase to
+    // a shared address
+    const std::vector<uint8_t> miner = {0x51};
+    const std::vector<uint8_t> shop = {0x52, 0x53};
+    std::vector<std::array<uint8_t, 32>> coinbase_ids;
+    std::vector<std::array<uint8_t, 32>> spend_ids;
+    auto make_block = [&](uint32_t height) {
+        primitives::Block block;
+        block.header.version = 2;
+        block.header.timestamp = 1704067200 + height;
+
+        primitives::Transaction coinbase;
+        coinbase.version = 1;
+        primitives::TxInput input;
+        input.prevout =
+            primitives::OutPoint(std::array<uint8_t, 32>{}, primitives::COINBASE_VOUT_INDEX);
+        input.signature_script = {static_cast<uint8_t>(height), 0x01};
+        coinbase.inputs.push_back(input);
+        coinbase.outputs.emplace_back(primitives::AssetID::TALANTON, 50, miner);
+        block.transactions.push_back(coinbase);
+
+        if (height > 0) {
+            primitives::Transaction spend;
+            spend.version = 1;
+            spend.locktime = height;
+            primitives::TxInput spend_input;
+            spend_input.prevout = primitives::OutPoint(coinbase_ids.back(), 0);
+            spend.inputs.push_back(spend_input);
+            spend.outputs.emplace_back(primitives::AssetID::TALANTON, 10, shop);
+            block.transactions.push_back(spend);
+            spend_ids.push_back(spend.GetTxID());
+        }
+        coinbase_ids.push_back(coinbase.GetTxID());
+        block.header.merkle_root = block.CalculateMerkleRoot();
+        return block;
+    };
+    for (uint32_t height = 0; height < 10; ++height) {
+        assert(blocks.StoreBlock(make_block(height), height));
+    }
+
+    TxIndexer indexer;
+    assert(indexer.Open((base / "parthenon_test_tx_index").string(), &blocks));
+    indexer.Start();
+    assert(indexer.WaitForHeight(10));
+    assert(indexer.GetTransactionCount() == 19);
+
+    // New blocks are picked up on notification
+    for (uint32_t height = 10; height < 15; ++height) {
+        assert(blocks.StoreBlock(make_block(height), height));
+    }
+    indexer.NotifyNewBlock();
+    assert(indexer.WaitForHeight(15));
+    assert(indexer.GetNextHeight() == 15);
+    assert(indexer.GetTransactionCount() == 29);
+
+    // Lookups read the transaction back out of its stored block
+    auto tx = indexer.GetTransactionById(spend_ids[6]);
+    assert(tx.has_value() && tx->GetTxID() == spend_ids[6] && tx->locktime == 7);
+    auto location = indexer.GetTransactionLocation(spend_ids[6]);
+    assert(location.has_value() && location->height == 7 && location->tx_index == 1);
+    std::array<uint8_t, 32> unknown{};
+    unknown[0] = 0x99;
+    assert(!indexer.GetTransactionById(unknown).has_value());
+
+    // Address history pages newest first
+    auto page = indexer.GetAddressHistory(shop, 4);
+    assert(page.size() == 4 && page[0].height == 14 && page[3].height == 11);
+    page = indexer.GetAddressHistory(shop, 100, page.back());
+    assert(page.size() == 10 && page[0].height == 10 && page.back().height == 1);
+    assert(page.back().txid == spend_ids[0]);
+    assert(indexer.GetAddressHistory(miner).size() == 15);
+    auto shop_txs = indexer.GetTransactionsByAddress(shop, 3);
+    assert(shop_txs.size() == 3 && shop_txs[0].GetTxID() == spend_ids[13]);
+
+    // Inputs are indexed under the txid they spend
+    const std::vector<uint8_t> spent(coinbase_ids[3].begin(), coinbase_ids[3].end());
+    page = indexer.GetAddressHistory(spent);
+    assert(page.size() == 1 && page[0].txid == spend_ids[3]);
+
+    auto recent = indexer.GetRecentTransactions(3);
+    assert(recent.size() == 3);
+    assert(recent[0].GetTxID() == spend_ids[13] && recent[1].GetTxID() == coinbase_ids[14]);
+
+    // A reorg replaces heights 13 and 14 with coinbase-only blocks paying
+    // another script
+    const std::vector<uint8_t> fork_miner = {0x54};
+    auto make_fork_block = [&](uint32_t height) {
+        primitives::Block block;
+        block.header.version = 2;
+        block.header.timestamp = 1704067200 + height;
+        primitives::Transaction coinbase;
+        coinbase.version = 1;
+        primitives::TxInput input;
+        input.prevout =
+            primitives::OutPoint(std::array<uint8_t, 32>{}, primitives::COINBASE_VOUT_INDEX);
+        input.signature_script = {static_cast<uint8_t>(height), 0x02};
+        coinbase.inputs.push_back(input);
+        coinbase.outputs.emplace_back(primitives::AssetID::TALANTON, 50, fork_miner);
+        block.transactions.push_back(coinbase);
+        block.header.merkle_root = block.CalculateMerkleRoot();
+        return block;
+    };
+    indexer.Stop();
+    std::vector<std::array<uint8_t, 32>> fork_ids;
+    for (uint32_t height = 13; height < 16; ++height) {
+        const auto block = make_fork_block(height);
+        fork_ids.push_back(block.transactions[0].GetTxID());
+        assert(blocks.StoreBlock(block, height));
+    }
+
+    // Until the index catches up, stale locations do not return whatever
+    // now sits at that position
+    assert(indexer.GetTransactionLocation(spend_ids[13]).has_value());
+    assert(!indexer.GetTransactionById(spend_ids[13]).has_value());
+    assert(!indexer.GetTransactionById(coinbase_ids[14]).has_value());
+
+    // The catch-up thread unwinds to the fork point and indexes the new blocks
+    indexer.Start();
+    assert(indexer.WaitForHeight(16));
+    assert(indexer.GetTransactionCount() == 29 - 4 + 3);
+    for (const auto& stale : {spend_ids[12], spend_ids[13], coinbase_ids[13], coinbase_ids[14]}) {
+        assert(!indexer.GetTransactionLocation(stale).has_value());
+        assert(!indexer.GetTransactionById(stale).has_value());
+    }
+    location = indexer.GetTransactionLocation(fork_ids[1]);
+    assert(location.has_value() && location->height == 14 && location->tx_index == 0);
+    assert(indexer.GetTransactionById(fork_ids[1])->GetTxID() == fork_ids[1]);
+    page = indexer.GetAddressHistory(shop);
+    assert(page.size() == 12 && page[0].height == 12);
+    assert(indexer.GetAddressHistory(miner).size() == 13);
+    assert(indexer.GetAddressHistory(fork_miner).size() == 3);
+
+    // Rewind() does the same for blocks indexed directly
+    indexer.Stop();
+    assert(indexer.Rewind(14));
+    assert(indexer.GetNextHeight() == 14 && indexer.GetTransactionCount() == 26);
+    assert(!indexer.GetTransactionLocation(fork_ids[2]).has_value());
+    assert(indexer.GetAddressHistory(fork_miner).size() == 1);
+    assert(indexer.IndexBlock(make_fork_block(14), 14));
+    assert(indexer.IndexBlock(make_fork_block(15), 15));
+
+    // Blocks must arrive in order
+    assert(!indexer.IndexBlock(make_block(20), 20));
+    assert(indexer.IndexBlock(make_block(16), 16));
+    assert(indexer.GetNextHeight() == 17);
+    indexer.Close();
+    blocks.Close();
+
+    std::cout << "Transaction indexer tests passed!" << std::endl;
+}
+
+void test_tx_reindex() {
+    std::cout << "Testing transaction reindex..." << std::endl;
+
+    using indexers::TxIndexer;
+    namespace primitives = parthenon::primitives;
+
+    const auto base = std::filesystem::temp_directory_path();
+    std::filesystem::remove_all(base / "parthenon_test_reindex_blocks");
+    std::filesystem::remove_all(base / "parthenon_test_reindex_index");
+    parthenon::storage::BlockStorage blocks;
+    assert(blocks.Open((base / "parthenon_test_reindex_blocks").string()));
+
+    // Enough blocks for several rounds of runs with two workers; each pays
+    // one of five scripts
+    const uint32_t kBlocks = 5 * TxIndexer::kReindexChunkBlocks + 17;
+    std::vector<std::array<uint8_t, 32>> txids;
+    for (uint32_t height = 0; height < kBlocks; ++height) {
+        primitives::Block block;
+        block.header.timestamp = height;
+        primitives::Transaction coinbase;
+        primitives::TxInput input;
+        input.prevout =
+            primitives::OutPoint(std::array<uint8_t, 32>{}, primitives::COINBASE_VOUT_INDEX);
+        input.signature_script = {static_cast<uint8_t>(height), static_cast<uint8_t>(height >> 8)};
+        coinbase.inputs.push_back(input);
+        coinbase.outputs.emplace_back(primitives::AssetID::TALANTON, 50,
+                                      std::vector<uint8_t>{static_cast<uint8_t>(height % 5)});
+        block.transactions.push_back(coinbase);
+        txids.push_back(coinbase.GetTxID());
+        assert(blocks.StoreBlock(block, height));
+    }
+
+    TxIndexer indexer;
+    assert(indexer.Open((base / "parthenon_test_reindex_index").string(), &blocks));
+    // Stale entries are dropped
+    indexer.IndexBlock(*blocks.GetBlockByHeight(0), 0);
+
+    std::vector<TxIndexer::ReindexProgress> reports;
+    assert(indexer.Reindex(kBlocks, 2, [&](const TxIndexer::ReindexProgress& progress) {
+        reports.push_back(progress);
+    }));
+    assert(indexer.GetNextHeight() == kBlocks);
+    assert(indexer.GetTransactionCount() == kBlocks);
+    assert(reports.size() == 3 && reports.back().next_height == kBlocks);
+    assert(reports[0].next_height == 2 * TxIndexer::kReindexChunkBlocks);
+
+    auto location = indexer.GetTransactionLocation(txids[1000]);
+    assert(location.has_value() && location->height == 1000 && location->tx_index == 0);
+    assert(indexer.GetTransactionById(txids[1000])->GetTxID() == txids[1000]);
+    auto history = indexer.GetAddressHistory({3}, 1000);
+    assert(history.size() == kBlocks / 5);
+    for (size_t i = 1; i < history.size(); ++i) {
+        assert(history[i].height + 5 == history[i - 1].height);
+    }
+
+    // Stops at the first missing block; incremental indexing carries on
+    assert(!indexer.Reindex(kBlocks + 1000, 3));
+    assert(indexer.GetNextHeight() == kBlocks);
+    assert(indexer.GetTransactionCount() == kBlocks);
+    indexer.Close();
+    blocks.Close();
+
+    std::cout << "Transaction reindex tests passed!" << std::endl;
+}
+
 int main() {
     try {
         test_payment_channel();
@@ -367,6 +698,9 @@ int main() {
         test_rollup_lifecycle();
         test_zk_rollup_lifecycle_and_exit();
         test_layer2_apis();
+        test_contract_log_index();
+        test_tx_indexer();
+        test_tx_reindex();
 
         std::cout << "\n✓ All Layer 2 tests passed!" << std::endl;
         return 0;
@@ -62,7 +62,7 @@ int main() {
     assert(payments.Balance("bob") == 250);
     assert(payments.CollectedFees() == 5);
 
-    auto exec_ok = obolos::ExecuteEvmLikeCall("6001600055", 50000, 1);
+    auto exec_ok = obolos::ExecuteEvmLikeCall("6001600055", 100000, 1);
     assert(exec_ok.success);
 
     auto exec_fail = obolos::ExecuteEvmLikeCall("6001600055", 1000, 1);
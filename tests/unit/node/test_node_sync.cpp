@@ -0,0 +1,245 @@
+#include "chainstate/chainstate.h"
+#include "mining/miner.h"
+#include "node/node.h"
+#include "node/sync.h"
+#include "wallet/wallet.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace parthenon::node;
+
+void TestOrderedAcquisition() {
+    std::cout << "Test: Ordered lock acquisition" << std::endl;
+
+    RankedSharedMutex chain(LockRank::CHAINSTATE, "chainstate");
+    RankedMutex mempool(LockRank::MEMPOOL, "mempool");
+
+    int violations = 0;
+    SetLockOrderViolationHandler(
+        [&](const std::string&, const std::string&) { ++violations; });
+
+    {
+        std::shared_lock<RankedSharedMutex> chain_lock(chain);
+        std::lock_guard<RankedMutex> mempool_lock(mempool);
+#if PARTHENON_DEBUG_LOCKORDER
+        assert(HeldLockCount() == 2);
+#endif
+    }
+    assert(HeldLockCount() == 0);
+    assert(violations == 0);
+
+    SetLockOrderViolationHandler(nullptr);
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestOrderViolationDetected() {
+    std::cout << "Test: Lock order violation detection" << std::endl;
+
+    RankedSharedMutex chain(LockRank::CHAINSTATE, "chainstate");
+    RankedMutex mempool(LockRank::MEMPOOL, "mempool");
+
+    std::string held_name;
+    std::string acquiring_name;
+    int violations = 0;
+    SetLockOrderViolationHandler([&](const std::string& held, const std::string& acquiring) {
+        ++violations;
+        held_name = held;
+        acquiring_name = acquiring;
+    });
+
+    {
+        std::lock_guard<RankedMutex> mempool_lock(mempool);
+        std::unique_lock<RankedSharedMutex> chain_lock(chain);
+    }
+    assert(HeldLockCount() == 0);
+
+#if PARTHENON_DEBUG_LOCKORDER
+    assert(violations == 1);
+    assert(held_name == "mempool");
+    assert(acquiring_name == "chainstate");
+#else
+    assert(violations == 0);
+#endif
+
+    SetLockOrderViolationHandler(nullptr);
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestEarlyUnlock() {
+    std::cout << "Test: Early unlock keeps held set consistent" << std::endl;
+
+    RankedSharedMutex chain(LockRank::CHAINSTATE, "chainstate");
+    RankedMutex mempool(LockRank::MEMPOOL, "mempool");
+
+    std::unique_lock<RankedSharedMutex> chain_lock(chain);
+    std::unique_lock<RankedMutex> mempool_lock(mempool);
+    chain_lock.unlock();
+#if PARTHENON_DEBUG_LOCKORDER
+    assert(HeldLockCount() == 1);
+#endif
+    mempool_lock.unlock();
+    assert(HeldLockCount() == 0);
+
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestConcurrentTipReaders() {
+    std::cout << "Test: Concurrent tip snapshot readers" << std::endl;
+
+    Node node("/tmp/parthenon_test_node_sync", 18555, NetworkMode::REGTEST);
+
+    auto initial = node.GetTipSnapshot();
+    assert(initial != nullptr);
+    assert(initial->height == node.GetHeight());
+
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            for (int i = 0; i < 10000; ++i) {
+                auto snapshot = node.GetTipSnapshot();
+                if (!snapshot || snapshot->height != initial->height) {
+                    ok = false;
+                }
+                if (node.GetBlockByHeight(snapshot->height + 1)) {
+                    ok = false;
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    assert(ok);
+
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+void TestConcurrentBlockConnection() {
+    std::cout << "Test: Block connection against readers and wallet rescans" << std::endl;
+
+    // Not started: blocks are connected in memory only, storage stays closed
+    Node node("/tmp/parthenon_test_node_connect", 18556, NetworkMode::REGTEST);
+
+    std::array<uint8_t, 32> seed{};
+    seed[0] = 0x26;
+    auto wallet = std::make_shared<parthenon::wallet::Wallet>(seed);
+    const auto address = wallet->GenerateAddress("mining");
+    node.AttachWallet(wallet);
+
+    std::atomic<uint32_t> notified{0};
+    std::atomic<uint32_t> removed_notified{0};
+    node.OnNewBlock([&](const parthenon::primitives::Block&) { ++notified; });
+    const uint64_t removed =
+        node.OnNewBlock([&](const parthenon::primitives::Block&) { ++removed_notified; });
+    node.RemoveBlockCallback(removed);
+
+    // Mine the chain up front against a separate chainstate
+    parthenon::chainstate::ChainState mirror;
+    parthenon::mining::Miner miner(mirror, address.pubkey);
+    constexpr uint32_t kBlocks = 20;
+    std::vector<parthenon::primitives::Block> blocks;
+    for (uint32_t i = 0; i < kBlocks; ++i) {
+        auto block_template = miner.CreateBlockTemplate();
+        assert(block_template);
+        auto block = block_template->block;
+        if (!blocks.empty()) {
+            block.header.prev_block_hash = blocks.back().GetHash();
+        }
+        block.header.bits = 0x207fffff;
+        while (!block.header.MeetsDifficultyTarget()) {
+            ++block.header.nonce;
+        }
+        assert(mirror.ApplyBlock(block));
+        blocks.push_back(block);
+    }
+
+    // Two writers race to connect every block; whichever loses a race sees
+    // the block rejected as stale and waits for the tip to move past it
+    std::atomic<int> writers_left{2};
+    std::atomic<uint32_t> accepted{0};
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; ++t) {
+        writers.emplace_back([&]() {
+            for (uint32_t i = 0; i < kBlocks; ++i) {
+                while (node.GetHeight() < i + 1) {
+                    if (node.ProcessBlock(blocks[i], "test")) {
+                        ++accepted;
+                        break;
+                    }
+                }
+            }
+            --writers_left;
+        });
+    }
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 2; ++t) {
+        readers.emplace_back([&]() {
+            uint64_t last_sequence = 0;
+            uint32_t last_height = 0;
+            while (writers_left > 0) {
+                auto snapshot = node.GetTipSnapshot();
+                if (snapshot->sequence < last_sequence || snapshot->height < last_height ||
+                    node.GetHeight() < snapshot->height) {
+                    ok = false;
+                }
+                last_sequence = snapshot->sequence;
+                last_height = snapshot->height;
+            }
+        });
+    }
+    std::thread syncer([&]() {
+        while (writers_left > 0) {
+            node.SyncWalletWithChain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    syncer.join();
+    assert(ok);
+    assert(accepted == kBlocks);
+    assert(node.GetHeight() == kBlocks);
+    assert(notified == kBlocks);
+    assert(removed_notified == 0);
+
+    // Whatever the interleaving, the wallet ends up as if it had seen each
+    // connected block once, in order
+    parthenon::wallet::Wallet expected(seed);
+    expected.GenerateAddress("mining");
+    for (uint32_t i = 0; i < kBlocks; ++i) {
+        expected.ProcessBlock(blocks[i], i + 1);
+    }
+    using parthenon::primitives::AssetID;
+    assert(wallet->GetBalance(AssetID::TALANTON) > 0);
+    assert(wallet->GetBalance(AssetID::TALANTON) == expected.GetBalance(AssetID::TALANTON));
+    assert(wallet->ListUTXOs(true).size() == expected.ListUTXOs(true).size());
+
+    std::cout << "  ✓ Passed" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Node Synchronization Tests ===" << std::endl;
+    TestOrderedAcquisition();
+    TestOrderViolationDetected();
+    TestEarlyUnlock();
+    TestConcurrentTipReaders();
+    TestConcurrentBlockConnection();
+    std::cout << "\n✓ All node synchronization tests passed!" << std::endl;
+    return 0;
+}
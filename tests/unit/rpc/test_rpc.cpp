@@ -2,14 +2,24 @@
 // Validate RPC request wiring for daemon control
 
 #include "node/node.h"
+#include "rpc/rate_limiter.h"
+#include "rpc/rest_handler.h"
 #include "rpc/rpc_server.h"
 #include "rpc/validation.h"
 #include "wallet/wallet.h"
+#include "evm/state.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <set>
+#include <thread>
+#include <vector>
 
 using namespace parthenon;
 
@@ -205,6 +215,471 @@ void TestSendToAddressRejectsInvalidAmountAndHex() {
     std::cout << "  ✓ Passed (invalid amount/address)" << std::endl;
 }
 
+void TestBatchRequests() {
+    std::cout << "Test: JSON-RPC batch requests" << std::endl;
+
+    rpc::RPCServer server;
+    server.ConfigureRateLimit(1000, 60);
+    server.RegisterMethod("test/echo", [](const rpc::RPCRequest& req) {
+        rpc::RPCResponse response;
+        response.id = req.id;
+        response.result = req.params;
+        return response;
+    });
+
+    std::string body = "[";
+    for (int i = 0; i < 32; ++i) {
+        if (i > 0) {
+            body += ",";
+        }
+        body += R"({"jsonrpc":"2.0","method":"test/echo","params":[)" + std::to_string(i) +
+                R"(],"id":"b)" + std::to_string(i) + R"("})";
+    }
+    body += R"(,{"jsonrpc":"2.0","method":"nosuchmethod","id":"missing"}])";
+
+    size_t chunks = 0;
+    std::string streamed;
+    server.ProcessRequestBody(body, "127.0.0.1", [&](const std::string& chunk) {
+        ++chunks;
+        streamed += chunk;
+        return true;
+    });
+    assert(chunks > 2);  // "[", elements, "]"
+
+    auto responses = nlohmann::json::parse(streamed);
+    assert(responses.is_array());
+    assert(responses.size() == 33);
+
+    std::set<std::string> ids;
+    size_t errors = 0;
+    for (size_t i = 0; i < responses.size(); ++i) {
+        ids.insert(responses[i]["id"].get<std::string>());
+        if (responses[i].contains("error")) {
+            ++errors;
+        }
+    }
+    assert(ids.size() == 33);
+    assert(ids.count("b0") == 1 && ids.count("b31") == 1 && ids.count("missing") == 1);
+    assert(errors == 1);
+
+    // Single requests keep the plain object response
+    auto single = nlohmann::json::parse(server.ProcessRequestBody(
+        R"({"jsonrpc":"2.0","method":"test/echo","params":[7],"id":"s"})"));
+    assert(single.is_object());
+    assert(single["id"].get<std::string>() == "s");
+
+    auto empty = nlohmann::json::parse(server.ProcessRequestBody("[]"));
+    assert(empty.is_object() && empty.contains("error"));
+
+    server.ConfigureMaxBatchSize(4);
+    auto too_large = nlohmann::json::parse(server.ProcessRequestBody(body));
+    assert(too_large.is_object() && too_large.contains("error"));
+
+    std::cout << "  ✓ Passed (batch dispatch)" << std::endl;
+}
+
+void TestRequestIds() {
+    std::cout << "Test: numeric and null ids, invalid batch elements" << std::endl;
+
+    rpc::RPCServer server;
+    server.ConfigureRateLimit(1000, 60);
+    server.RegisterMethod("test/echo", [](const rpc::RPCRequest& req) {
+        rpc::RPCResponse response;
+        response.id = req.id;
+        response.result = req.params;
+        return response;
+    });
+
+    auto numeric = nlohmann::json::parse(server.ProcessRequestBody(
+        R"({"jsonrpc":"2.0","method":"test/echo","params":[1],"id":42})"));
+    assert(numeric["id"].is_number() && numeric["id"].get<int>() == 42);
+    assert(numeric["result"][0].get<int>() == 1);
+
+    auto null_id = nlohmann::json::parse(server.ProcessRequestBody(
+        R"({"jsonrpc":"2.0","method":"test/echo","params":[2],"id":null})"));
+    assert(null_id["id"].is_null() && !null_id.contains("error"));
+
+    auto invalid = nlohmann::json::parse(server.ProcessRequestBody(
+        R"({"jsonrpc":"2.0","method":7,"id":3})"));
+    assert(invalid["error"]["code"].get<int>() == -32600);
+    assert(invalid["id"].is_number() && invalid["id"].get<int>() == 3);
+
+    // Bad elements fail on their own; the others still run and keep their ids
+    auto batch = nlohmann::json::parse(server.ProcessRequestBody(
+        R"([{"jsonrpc":"2.0","method":"test/echo","params":[1],"id":1},)"
+        R"({"jsonrpc":"2.0","method":"test/echo","params":[2],"id":null},)"
+        R"({"jsonrpc":"2.0","method":"test/echo","params":[3],"id":"three"},)"
+        R"({"jsonrpc":"2.0","method":"test/echo","params":4,"id":4},)"
+        R"({"jsonrpc":"2.0","method":"test/echo","id":{"bad":true}},)"
+        R"(17])"));
+    assert(batch.is_array() && batch.size() == 6);
+    std::map<std::string, nlohmann::json> results;  // By id, for the ones that ran
+    size_t null_ids = 0;
+    size_t invalid_elements = 0;
+    for (const auto& response : batch) {
+        const auto& id = response["id"];
+        if (response.contains("error")) {
+            assert(response["error"]["code"].get<int>() == -32600);
+            ++invalid_elements;
+        } else if (id.is_null()) {
+            ++null_ids;
+        } else {
+            results[(id.is_number() ? "n" : "s") + id.get<std::string>()] = response["result"];
+        }
+    }
+    assert(invalid_elements == 3);  // params 4, the object id and the bare 17
+    assert(null_ids == 1);
+    assert(results.size() == 2);
+    assert(results["n" + nlohmann::json(1).get<std::string>()][0].get<int>() == 1);
+    assert(results["sthree"][0].get<int>() == 3);
+
+    std::cout << "  ✓ Passed (ids echoed unchanged)" << std::endl;
+}
+
+void TestBatchMethodConcurrencyLimit() {
+    std::cout << "Test: per-method concurrency limit" << std::endl;
+
+    rpc::RPCServer server;
+    server.ConfigureRateLimit(1000, 60);
+    server.ConfigureWorkerPool(8, 64);
+    server.SetMethodConcurrencyLimit("test/slow", 2);
+
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    server.RegisterMethod("test/slow", [&](const rpc::RPCRequest& req) {
+        const int now = ++active;
+        int observed = peak.load();
+        while (now > observed && !peak.compare_exchange_weak(observed, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --active;
+        rpc::RPCResponse response;
+        response.id = req.id;
+        response.result = "true";
+        return response;
+    });
+
+    std::string body = "[";
+    for (int i = 0; i < 16; ++i) {
+        if (i > 0) {
+            body += ",";
+        }
+        body += R"({"jsonrpc":"2.0","method":"test/slow","id":")" + std::to_string(i) + R"("})";
+    }
+    body += "]";
+
+    auto responses = nlohmann::json::parse(server.ProcessRequestBody(body));
+    assert(responses.size() == 16);
+    assert(peak.load() >= 1);
+    assert(peak.load() <= 2);
+
+    std::cout << "  ✓ Passed (peak concurrency " << peak.load() << ")" << std::endl;
+}
+
+void TestRestRouting() {
+    std::cout << "Test: REST routing and validation" << std::endl;
+
+    const std::string zero_hash(64, '0');
+
+    rpc::RestHandler no_node(nullptr);
+    assert(no_node.Handle("/rest/block/" + zero_hash + ".bin").status == 503);
+
+    const auto unique_suffix =
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    const auto temp_dir =
+        std::filesystem::temp_directory_path() / ("parthenon-rest-test-" + unique_suffix);
+    node::Node node(temp_dir.string(), 0);
+    rpc::RestHandler rest(&node);
+
+    assert(rest.Handle("/rest/block/" + zero_hash + ".bin").status == 404);
+    assert(rest.Handle("/rest/block/" + zero_hash + ".json").status == 404);
+    assert(rest.Handle("/rest/tx/" + zero_hash + ".hex").status == 404);
+    assert(rest.Handle("/rest/block/xyz.bin").status == 400);
+    assert(rest.Handle("/rest/block/" + zero_hash + ".xml").status == 404);
+    assert(rest.Handle("/rest/unknown/" + zero_hash + ".bin").status == 404);
+    assert(rest.Handle("/rest/headers/0/" + zero_hash + ".bin").status == 400);
+    assert(rest.Handle("/rest/headers/2001/" + zero_hash + ".bin").status == 400);
+
+    // Unknown start hash yields an empty header list, not an error
+    auto headers = rest.Handle("/rest/headers/5/" + zero_hash + ".json");
+    assert(headers.status == 200);
+    assert(headers.content_type == "application/json");
+    assert(headers.body == "[]");
+
+    std::error_code cleanup_error;
+    std::filesystem::remove_all(temp_dir, cleanup_error);
+
+    std::cout << "  ✓ Passed (routing)" << std::endl;
+}
+
+void TestResponseCache() {
+    std::cout << "Test: RPC response cache" << std::endl;
+
+    rpc::RPCServer server;
+    int calls = 0;
+    server.RegisterMethod("test/read", [&calls](const rpc::RPCRequest& req) {
+        ++calls;
+        rpc::RPCResponse response;
+        response.id = req.id;
+        response.result = std::to_string(calls);
+        return response;
+    });
+    server.RegisterMethod("test/write", [](const rpc::RPCRequest& req) {
+        rpc::RPCResponse response;
+        response.id = req.id;
+        response.result = "true";
+        return response;
+    });
+    rpc::CachePolicy read_policy;
+    read_policy.cacheable = true;
+    server.SetMethodCachePolicy("test/read", read_policy);
+    rpc::CachePolicy write_policy;
+    write_policy.invalidates = true;
+    server.SetMethodCachePolicy("test/write", write_policy);
+
+    rpc::RPCRequest request;
+    request.method = "test/read";
+    request.params = R"({"b": 2, "a": 1})";
+    request.id = "1";
+    assert(server.HandleRequest(request).result == "1");
+
+    // Same params in a different key order and id hit the cache
+    request.params = R"({"a":1,"b":2})";
+    request.id = "2";
+    auto cached = server.HandleRequest(request);
+    assert(cached.result == "1");
+    assert(cached.id == "2");
+    assert(calls == 1);
+
+    const auto& metrics = server.GetMetrics();
+    assert(metrics.Read(R"(pantheon_rpc_cache_hits_total{method="test/read"})") == 1);
+    assert(metrics.Read(R"(pantheon_rpc_cache_misses_total{method="test/read"})") == 1);
+
+    // Different params miss
+    request.params = R"({"a":2})";
+    assert(server.HandleRequest(request).result == "2");
+
+    // A state-changing method invalidates cached reads
+    rpc::RPCRequest write;
+    write.method = "test/write";
+    server.HandleRequest(write);
+    request.params = R"({"a":1,"b":2})";
+    assert(server.HandleRequest(request).result == "3");
+
+    server.InvalidateResponseCache();
+    assert(server.HandleRequest(request).result == "4");
+
+    // Size limits evict least recently used entries
+    rpc::RPCResponseCache cache(2, 1024);
+    cache.Put("a", "1");
+    cache.Put("b", "2");
+    assert(cache.Get("a").has_value());
+    cache.Put("c", "3");
+    assert(!cache.Get("b").has_value());
+    assert(cache.Get("a").has_value() && cache.Get("c").has_value());
+    assert(cache.GetStats().entries == 2);
+    assert(cache.GetStats().evictions == 1);
+    cache.Put("big", std::string(2048, 'x'));
+    assert(!cache.Get("big").has_value());
+
+    std::cout << "  ✓ Passed (hits, invalidation, eviction)" << std::endl;
+}
+
+void TestRateLimiter() {
+    std::cout << "Test: token-bucket rate limiter" << std::endl;
+
+    // Burst of 10, one token per 100 ms
+    rpc::RateLimiter limiter(10, 1);
+    for (int i = 0; i < 10; ++i) {
+        assert(limiter.AllowRequest("192.0.2.1"));
+    }
+    assert(!limiter.AllowRequest("192.0.2.1"));
+    assert(limiter.AllowRequest("192.0.2.2"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    assert(limiter.AllowRequest("192.0.2.1"));
+
+    // Method cost weights
+    limiter.SetMethodCost("heavy", 5);
+    assert(limiter.GetMethodCost("heavy") == 5);
+    assert(limiter.GetMethodCost("light") == 1);
+    assert(limiter.AllowRequest("192.0.2.3", "heavy"));
+    assert(limiter.AllowRequest("192.0.2.3", "heavy"));
+    assert(limiter.GetAvailableTokens("192.0.2.3") == 0);
+    assert(!limiter.AllowRequest("192.0.2.3", "heavy"));
+    assert(limiter.GetAvailableTokens("198.51.100.1") == 10);
+
+    // Address keys: IPv4-mapped IPv6 matches IPv4, IPv6 grouped by /64
+    assert(rpc::MakeClientKey("10.0.0.1") == rpc::MakeClientKey("::ffff:10.0.0.1"));
+    assert(rpc::MakeClientKey("2001:db8::1") == rpc::MakeClientKey("2001:db8::2"));
+    assert(rpc::MakeClientKey("2001:db8::1") == rpc::MakeClientKey("[2001:db8::1]"));
+    assert(rpc::MakeClientKey("2001:db8::1") != rpc::MakeClientKey("2001:db8:0:1::1"));
+    assert(rpc::MakeClientKey("10.0.0.1") != rpc::MakeClientKey("10.0.0.2"));
+    assert(rpc::MakeClientKey("not-an-ip") != rpc::MakeClientKey("10.0.0.1"));
+    for (int i = 0; i < 10; ++i) {
+        assert(limiter.AllowRequest("2001:db8::" + std::to_string(i + 1)));
+    }
+    assert(!limiter.AllowRequest("2001:db8::ff"));
+
+    // Idle clients expire once their bucket has been full for the timeout
+    rpc::RateLimiter expiring(1000, 1);
+    expiring.SetIdleTimeout(std::chrono::milliseconds(50));
+    assert(expiring.AllowRequest("192.0.2.10"));
+    assert(expiring.AllowRequest("192.0.2.11"));
+    expiring.Cleanup();
+    assert(expiring.GetTrackedIPCount() == 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    expiring.Cleanup();
+    assert(expiring.GetTrackedIPCount() == 0);
+
+    // Concurrent decisions never over-admit
+    rpc::RateLimiter shared(1000, 3600);
+    std::atomic<int> allowed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 1000; ++i) {
+                if (shared.AllowRequest("192.0.2.20")) {
+                    ++allowed;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(allowed.load() == 1000);
+
+    std::cout << "  ✓ Passed (burst, refill, costs, keys, expiry)" << std::endl;
+}
+
+void TestEvmDryRun() {
+    std::cout << "Test: EVM call and gas estimation" << std::endl;
+
+    rpc::RPCServer server;
+    evm::Address reader{};
+    reader[19] = 0xC1;
+    evm::Address writer{};
+    writer[19] = 0xC2;
+    // Returns storage slot 0; stores 1 in slot 1
+    const std::vector<uint8_t> read_code = {0x60, 0x00, 0x54, 0x60, 0x00, 0x52,
+                                            0x60, 0x20, 0x60, 0x00, 0xF3};
+    const std::vector<uint8_t> write_code = {0x60, 0x01, 0x60, 0x01, 0x55, 0x00};
+    evm::Address looper{};
+    looper[19] = 0xC3;
+    const std::vector<uint8_t> loop_code = {0x5B, 0x60, 0x00, 0x56};  // JUMPDEST PUSH1 0 JUMP
+
+    auto publish = [&](uint64_t value) {
+        auto state = std::make_shared<evm::WorldState>();
+        state->SetCode(reader, read_code);
+        state->SetCode(writer, write_code);
+        state->SetCode(looper, loop_code);
+        state->SetStorage(reader, evm::uint256_t{}, evm::ToUint256(value));
+        server.PublishEvmState(state);
+    };
+    auto call = [&](const std::string& method, const std::string& params) {
+        rpc::RPCRequest request;
+        request.method = method;
+        request.id = "1";
+        request.params = params;
+        return server.HandleRequest(request);
+    };
+    const std::string reader_hex = "0x00000000000000000000000000000000000000c1";
+    const std::string writer_hex = "0x00000000000000000000000000000000000000c2";
+    const std::string looper_hex = "0x00000000000000000000000000000000000000c3";
+
+    // Nothing has been published yet
+    auto response = call("evm/call", "{\"to\":\"" + reader_hex + "\"}");
+    assert(response.IsError() && response.error.find("not available") != std::string::npos);
+    response = call("evm/estimate_gas", "{\"to\":\"" + reader_hex + "\"}");
+    assert(response.IsError() && response.error.find("not available") != std::string::npos);
+
+    publish(7);
+    response = call("evm/call", "{\"to\":\"" + reader_hex + "\"}");
+    assert(!response.IsError());
+    auto result = nlohmann::json::parse(response.result);
+    assert(result["status"].get<std::string>() == "ok");
+    assert(result["return_data"].get<std::string>() ==
+           "0x0000000000000000000000000000000000000000000000000000000000000007");
+
+    // Intrinsic 21000 + two PUSH1 + cold SSTORE of a new value (2100 + 20000)
+    response = call("evm/estimate_gas", "[{\"to\":\"" + writer_hex + "\"}]");
+    assert(!response.IsError());
+    assert(nlohmann::json::parse(response.result).get<uint64_t>() == 43106);
+    response = call("evm/call", "{\"to\":\"" + writer_hex + "\",\"gas\":43105}");
+    assert(nlohmann::json::parse(response.result)["status"].get<std::string>() == "revert");
+    response = call("evm/estimate_gas", "{\"to\":\"" + writer_hex + "\",\"gas\":43105}");
+    assert(response.IsError());
+    assert(call("evm/call", "{\"to\":\"0xzz\"}").IsError());
+
+    // Deploys pay TX_CREATE_GAS and the code deposit, and run at the address
+    // derived from the sender and nonce. Init code: SSTORE(0, 1), then
+    // return one byte of code.
+    const std::string deploy = "{\"from\":\"0x6ac7ea33f8831ea9dcc53393aaa88b25a785dbf0\","
+                               "\"data\":\"0x600160005560016000f3\"}";
+    response = call("evm/call", deploy);
+    result = nlohmann::json::parse(response.result);
+    assert(result["status"].get<std::string>() == "ok");
+    assert(result["contract_address"].get<std::string>() ==
+           "0xcd234a471b72ba2f1ccf0a70fcaba648a5eecd8d");
+    assert(result["return_data"].get<std::string>() == "0x00");
+    // 21000 + 32000 + calldata 8 * 16 + 2 * 4, then four PUSH1, the cold
+    // SSTORE, one word of memory, and 200 for the deposited byte
+    const uint64_t deploy_gas = 21000 + 32000 + 136 + 4 * 3 + 22100 + 3 + 200;
+    assert(result["gas_used"].get<uint64_t>() == deploy_gas);
+    response = call("evm/estimate_gas", deploy);
+    assert(!response.IsError());
+    assert(nlohmann::json::parse(response.result).get<uint64_t>() == deploy_gas);
+
+    // Declaring the slot adds 2400 + 1900 intrinsic gas and saves the 2100
+    // cold surcharge on the SSTORE
+    const std::string access_list = ",\"accessList\":[{\"address\":\"" + writer_hex +
+                                    "\",\"storageKeys\":[\"0x01\"]}]}";
+    response = call("evm/estimate_gas", "{\"to\":\"" + writer_hex + "\"" + access_list);
+    assert(!response.IsError());
+    assert(nlohmann::json::parse(response.result).get<uint64_t>() == 43106 + 4300 - 2100);
+    assert(call("evm/call", "{\"to\":\"" + writer_hex + "\",\"accessList\":[{}]}").IsError());
+
+    // Requested gas beyond the cap is clamped: a JUMP loop stops at the cap
+    server.ConfigureEvmGasCap(100000);
+    const std::string huge_gas = ",\"gas\":18000000000000000000}";
+    response = call("evm/call", "{\"to\":\"" + looper_hex + "\"" + huge_gas);
+    result = nlohmann::json::parse(response.result);
+    assert(result["status"].get<std::string>() == "revert");
+    assert(result["gas_used"].get<uint64_t>() == 100000);
+    response = call("evm/estimate_gas", "{\"to\":\"" + writer_hex + "\"" + huge_gas);
+    assert(nlohmann::json::parse(response.result).get<uint64_t>() == 43106);
+    response = call("evm/estimate_gas", "{\"to\":\"" + looper_hex + "\"" + huge_gas);
+    assert(response.IsError() && response.error.find("100000 gas") != std::string::npos);
+    server.ConfigureEvmGasCap(pantheon::obolos::DEFAULT_CALL_GAS_CAP);
+
+    // Dry runs see a whole published state, never a partial one
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; ++t) {
+        callers.emplace_back([&]() {
+            uint8_t last = 0;
+            for (int i = 0; i < 50; ++i) {
+                auto r = call("evm/call", "{\"to\":\"" + reader_hex + "\"}");
+                const auto data = nlohmann::json::parse(r.result)["return_data"].get<std::string>();
+                const uint8_t value = static_cast<uint8_t>(std::stoul(data.substr(64), nullptr, 16));
+                if (value < last || value < 7 || value > 57) {
+                    failed = true;
+                }
+                last = value;
+            }
+        });
+    }
+    for (uint64_t value = 8; value <= 57; ++value) {
+        publish(value);
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    assert(!failed);
+
+    std::cout << "  ✓ Passed (dry runs)" << std::endl;
+}
+
 int main() {
     std::cout << "=== RPC Server Tests ===" << std::endl;
 
@@ -216,6 +691,13 @@ int main() {
     TestSendToAddressRejectsInvalidAmountAndHex();
     TestValidationParsingAndSanitization();
     TestMonetarySpecEndpoint();
+    TestBatchRequests();
+    TestRequestIds();
+    TestBatchMethodConcurrencyLimit();
+    TestRestRouting();
+    TestResponseCache();
+    TestRateLimiter();
+    TestEvmDryRun();
 
     std::cout << "✓ All RPC server tests passed!" << std::endl;
     return 0;
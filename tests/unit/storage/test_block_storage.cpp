@@ -34,6 +34,18 @@ primitives::Block MakeTestBlock() {
                                   std::vector<uint8_t>{0x51});
 
     block.transactions.push_back(coinbase);
+
+    primitives::Transaction spend;
+    spend.version = 1;
+    spend.locktime = 7;
+    primitives::TxInput spend_input;
+    spend_input.prevout = primitives::OutPoint(coinbase.GetTxID(), 0);
+    spend_input.signature_script = {0x01, 0x02, 0x03, 0x04};
+    spend.inputs.push_back(spend_input);
+    spend.outputs.emplace_back(primitives::AssetID::TALANTON, 10ULL,
+                               std::vector<uint8_t>{0x52});
+    block.transactions.push_back(spend);
+
     block.header.merkle_root = block.CalculateMerkleRoot();
     return block;
 }
@@ -69,6 +81,31 @@ int main() {
     assert(by_hash.has_value());
     assert(by_hash->Serialize() == block.Serialize());
 
+    // Raw accessors return the stored bytes without deserializing
+    const auto serialized = block.Serialize();
+    const std::string expected_raw(serialized.begin(), serialized.end());
+    auto raw_by_height = block_storage.GetRawBlockByHeight(1);
+    assert(raw_by_height.has_value() && *raw_by_height == expected_raw);
+    auto raw_by_hash = block_storage.GetRawBlockByHash(hash);
+    assert(raw_by_hash.has_value() && *raw_by_hash == expected_raw);
+    assert(block_storage.GetHeightByHash(hash).value_or(0) == 1);
+    auto raw_header = block_storage.GetRawHeaderByHeight(1);
+    assert(raw_header.has_value() &&
+           *raw_header == expected_raw.substr(0, storage::BlockStorage::kHeaderSize));
+    assert(!block_storage.GetRawHeaderByHeight(2).has_value());
+    assert(!block_storage.GetHeightByHash(std::array<uint8_t, 32>{}).has_value());
+
+    // Transactions are sliced out of the stored block via the tx index
+    for (const auto& tx : block.transactions) {
+        uint32_t tx_height = 0;
+        auto raw_tx = block_storage.GetRawTransaction(tx.GetTxID(), &tx_height);
+        assert(raw_tx.has_value());
+        const auto tx_bytes = tx.Serialize();
+        assert(*raw_tx == std::string(tx_bytes.begin(), tx_bytes.end()));
+        assert(tx_height == 1);
+    }
+    assert(!block_storage.GetRawTransaction(std::array<uint8_t, 32>{}).has_value());
+
     block_storage.Close();
     std::filesystem::remove_all(db_path);
 
@@ -2,6 +2,7 @@
 #define LEVELDB_DB_STUB_H
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -48,6 +49,7 @@ class Iterator {
   public:
     virtual ~Iterator() = default;
     virtual void SeekToFirst() = 0;
+    virtual void Seek(const Slice& target) = 0;
     virtual bool Valid() const = 0;
     virtual void Next() = 0;
     virtual Slice key() const = 0;
@@ -74,6 +76,14 @@ class DB {
             started_ = true;
         }
 
+        void Seek(const Slice& target) override {
+            if (data_ == nullptr) {
+                return;
+            }
+            iter_ = data_->lower_bound(target.ToString());
+            started_ = true;
+        }
+
         bool Valid() const override {
             return data_ != nullptr && started_ && iter_ != data_->end();
         }
@@ -128,12 +138,14 @@ class DB {
 
     Status Put(const WriteOptions& options, const std::string& key, const std::string& value) {
         (void)options;
+        std::lock_guard<std::mutex> lock(mutex_);
         data_[key] = value;
         return Status::OK();
     }
 
     Status Delete(const WriteOptions& options, const std::string& key) {
         (void)options;
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = data_.find(key);
         if (it == data_.end()) {
             return Status::NotFound();
@@ -144,6 +156,7 @@ class DB {
 
     Status Get(const ReadOptions& options, const std::string& key, std::string* value) {
         (void)options;
+        std::lock_guard<std::mutex> lock(mutex_);
         auto it = data_.find(key);
         if (it == data_.end()) {
             return Status::NotFound();
@@ -156,6 +169,7 @@ class DB {
 
     Status Write(const WriteOptions& options, WriteBatch* batch) {
         (void)options;
+        std::lock_guard<std::mutex> lock(mutex_);
         if (batch == nullptr) {
             return Status::InvalidArgument();
         }
@@ -176,6 +190,9 @@ class DB {
     }
 
   private:
+    // Like LevelDB, reads and writes may come from several threads;
+    // iterators are not protected
+    std::mutex mutex_;
     std::map<std::string, std::string> data_;
 };
 
@@ -24,6 +24,8 @@ class WriteBatch {
         operations_.push_back(Operation{Operation::Type::kDelete, key, std::string()});
     }
 
+    void Clear() { operations_.clear(); }
+
     const std::vector<Operation>& Operations() const { return operations_; }
 
   private:
@@ -1,5 +1,14 @@
 #include "tracer.h"
 
+#include "evm/opcodes.h"
+#include "evm/state.h"
+#include "evm/tracer.h"
+#include "evm/vm.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+
 namespace parthenon {
 namespace tools {
 namespace debugging {
@@ -7,108 +16,167 @@ namespace debugging {
 // Initialize static member
 std::vector<EventLogger::Event> EventLogger::events_;
 
-// EVM opcode gas costs (Berlin hardfork baseline)
-static uint64_t GetOpGasCost(uint8_t opcode) {
-    switch (opcode) {
-        case 0x00: return 0;   // STOP
-        case 0x01: return 3;   // ADD
-        case 0x02: return 5;   // MUL
-        case 0x03: return 3;   // SUB
-        case 0x04: return 5;   // DIV
-        case 0x06: return 5;   // MOD
-        case 0x08: return 8;   // ADDMOD
-        case 0x09: return 8;   // MULMOD
-        case 0x0A: return 10;  // EXP (base; actual cost depends on exponent)
-        case 0x10: case 0x11: case 0x12: case 0x13:
-        case 0x14: return 3;   // LT, GT, SLT, SGT, EQ
-        case 0x15: return 3;   // ISZERO
-        case 0x16: case 0x17: case 0x18: case 0x19: return 3; // AND OR XOR NOT
-        case 0x1B: case 0x1C: case 0x1D: return 3; // SHL SHR SAR
-        case 0x20: return 30;  // SHA3 (base)
-        case 0x30: case 0x31: case 0x32: case 0x33: return 2; // ctx ops
-        case 0x34: return 2;   // CALLVALUE
-        case 0x35: return 3;   // CALLDATALOAD
-        case 0x51: return 3;   // MLOAD
-        case 0x52: return 3;   // MSTORE
-        case 0x54: return 100; // SLOAD (warm)
-        case 0x55: return 100; // SSTORE (warm, minimum)
-        case 0x56: return 8;   // JUMP
-        case 0x57: return 10;  // JUMPI
-        case 0x58: return 2;   // PC
-        case 0x59: return 2;   // MSIZE
-        case 0x5A: return 2;   // GAS
-        case 0x5B: return 1;   // JUMPDEST
-        case 0xF0: return 32000; // CREATE
-        case 0xF1: return 100;   // CALL (warm)
-        case 0xF3: return 0;     // RETURN
-        case 0xFD: return 0;     // REVERT
-        case 0xFE: return 0;     // INVALID
-        default:
-            if (opcode >= 0x60 && opcode <= 0x7F) return 3; // PUSH1..PUSH32
-            if (opcode >= 0x80 && opcode <= 0x8F) return 3; // DUP1..DUP16
-            if (opcode >= 0x90 && opcode <= 0x9F) return 3; // SWAP1..SWAP16
-            if (opcode >= 0xA0 && opcode <= 0xA4) return 375; // LOG0..LOG4
-            return 3; // default
+namespace {
+
+// Keeps every step in memory, for TraceTransaction()
+class StepCollector : public evm::Tracer {
+public:
+    explicit StepCollector(std::vector<TransactionTracer::TraceStep>& steps) : steps_(steps) {}
+
+    void OnEnter(const evm::TraceFrame& frame) override {
+        frame_gas_ = frame.gas;
+    }
+
+    void OnStep(const evm::TraceStep& step) override {
+        FinishLast(step.gas);
+
+        TransactionTracer::TraceStep out;
+        out.step_number = steps_.size();
+        out.gas_used = 0;
+        out.gas_remaining = step.gas;
+        out.opcode = step.opcode;
+        out.opcode_name = evm::GetOpcodeName(step.opcode);
+        out.stack.reserve(step.stack_size * 32);
+        for (size_t i = 0; i < step.stack_size; ++i) {
+            const evm::uint256_t word = step.stack[i].ToBytes();
+            out.stack.insert(out.stack.end(), word.begin(), word.end());
+        }
+        out.memory.assign(step.memory, step.memory + step.memory_size);
+        out.program_counter = step.pc;
+        steps_.push_back(std::move(out));
+        pending_ = true;
+    }
+
+    void OnFault(const evm::TraceStep& step, evm::ExecResult error) override {
+        (void)error;
+        // A block failing its checks faults before its first step was reported
+        if (!pending_ || steps_.back().program_counter != step.pc) {
+            OnStep(step);
+        }
+        FinishLast(0);
+    }
+
+    void OnExit(const evm::TraceExit& exit) override {
+        FinishLast(frame_gas_ - exit.gas_used);
+    }
+
+private:
+    // A step's cost is known once the gas after it is
+    void FinishLast(uint64_t gas_after) {
+        if (pending_) {
+            TransactionTracer::TraceStep& last = steps_.back();
+            last.gas_used = last.gas_remaining - std::min(gas_after, last.gas_remaining);
+            pending_ = false;
+        }
+    }
+
+    std::vector<TransactionTracer::TraceStep>& steps_;
+    uint64_t frame_gas_ = 0;
+    bool pending_ = false;
+};
+
+// Counts and times every executed instruction, for Profiler::ProfileTransaction().
+// An instruction's time runs until the next hook fires.
+class OpcodeProfiler : public evm::Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void OnEnter(const evm::TraceFrame& frame) override {
+        (void)frame;
+        FinishLast(Clock::now());
+    }
+
+    void OnStep(const evm::TraceStep& step) override {
+        const auto now = Clock::now();
+        FinishLast(now);
+        ++counts[step.opcode];
+        last_opcode_ = step.opcode;
+        last_start_ = now;
+        pending_ = true;
+    }
+
+    void OnFault(const evm::TraceStep& step, evm::ExecResult error) override {
+        (void)step;
+        (void)error;
+        FinishLast(Clock::now());
+    }
+
+    void OnExit(const evm::TraceExit& exit) override {
+        (void)exit;
+        FinishLast(Clock::now());
+    }
+
+    std::array<uint64_t, 256> counts{};
+    std::array<uint64_t, 256> nanos{};
+
+private:
+    void FinishLast(Clock::time_point now) {
+        if (pending_) {
+            nanos[last_opcode_] += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_start_).count());
+            pending_ = false;
+        }
     }
-}
+
+    uint8_t last_opcode_ = 0;
+    Clock::time_point last_start_;
+    bool pending_ = false;
+};
+
+}  // namespace
 
 // TransactionTracer Implementation
 TransactionTracer::TraceResult TransactionTracer::TraceTransaction(
     const std::vector<uint8_t>& bytecode,
     const std::vector<uint8_t>& input_data,
     uint64_t gas_limit)
+{
+    std::vector<TraceStep> steps;
+    StepCollector collector(steps);
+    TraceResult result = TraceTransactionWith(bytecode, input_data, gas_limit, collector);
+    result.steps = std::move(steps);
+    return result;
+}
+
+TransactionTracer::TraceResult TransactionTracer::TraceTransactionWith(
+    const std::vector<uint8_t>& bytecode,
+    const std::vector<uint8_t>& input_data,
+    uint64_t gas_limit,
+    evm::Tracer& tracer)
 {
     TraceResult result;
     result.success = true;
     result.total_gas_used = 0;
 
-    // Charge intrinsic gas (21000 base + 4/16 per input byte)
-    uint64_t intrinsic = 21000;
+    uint64_t intrinsic = evm::TX_BASE_GAS;
     for (uint8_t b : input_data) {
-        intrinsic += (b == 0) ? 4 : 16;
+        intrinsic += (b == 0) ? evm::TX_DATA_ZERO_GAS : evm::TX_DATA_NONZERO_GAS;
     }
     if (intrinsic > gas_limit) {
         result.success = false;
+        result.error_message = evm::GetResultMessage(evm::ExecResult::OUT_OF_GAS);
         result.total_gas_used = gas_limit;
         return result;
     }
-    uint64_t gas_remaining = gas_limit - intrinsic;
     result.total_gas_used = intrinsic;
 
-    uint64_t pc = 0;
+    evm::ExecutionContext ctx{};
+    ctx.input_data = input_data;
+    ctx.gas_limit = gas_limit - intrinsic;
+    ctx.gas_price = 1;
+    ctx.base_fee = 1;
 
-    while (pc < bytecode.size() && gas_remaining > 0) {
-        TraceStep step;
-        step.step_number = result.steps.size();
-        step.gas_remaining = gas_remaining;
-        step.program_counter = pc;
-        step.opcode = bytecode[pc];
-        step.opcode_name = GetOpcodeName(step.opcode);
+    evm::WorldState state;
+    evm::VM vm(state, ctx);
+    const evm::ContractCode code(evm::HashCode(bytecode), bytecode);
+    auto [status, output] = vm.Execute(code, tracer);
 
-        uint64_t gas_cost = GetOpGasCost(step.opcode);
-        if (gas_cost > gas_remaining) {
-            result.success = false;
-            break;
-        }
-        gas_remaining -= gas_cost;
-        step.gas_used = gas_cost;
-
-        result.steps.push_back(step);
-        result.total_gas_used += gas_cost;
-
-        // Check for terminator opcodes
-        if (step.opcode == 0x00 || step.opcode == 0xF3 ||
-            step.opcode == 0xFD || step.opcode == 0xFE) {
-            break;
-        }
-
-        // Skip PUSH data bytes
-        if (step.opcode >= 0x60 && step.opcode <= 0x7F) {
-            pc += static_cast<uint64_t>(step.opcode - 0x60 + 1);
-        }
-        pc++;
+    result.success = status == evm::ExecResult::SUCCESS || status == evm::ExecResult::RETURNED;
+    if (!result.success) {
+        result.error_message = evm::GetResultMessage(status);
     }
-
+    result.total_gas_used += vm.GetGasUsed();
+    result.return_data = std::move(output);
     return result;
 }
 
@@ -137,30 +205,7 @@ TransactionTracer::TraceResult TransactionTracer::TraceCall(
 
 std::string TransactionTracer::GetOpcodeName(uint8_t opcode)
 {
-    static const std::map<uint8_t, std::string> opcode_names = {
-        {0x00, "STOP"},
-        {0x01, "ADD"},
-        {0x02, "MUL"},
-        {0x03, "SUB"},
-        {0x04, "DIV"},
-        {0x33, "CALLER"},
-        {0x35, "CALLDATALOAD"},
-        {0x51, "MLOAD"},
-        {0x52, "MSTORE"},
-        {0x54, "SLOAD"},
-        {0x55, "SSTORE"},
-        {0xF1, "CALL"},
-        {0xF3, "RETURN"},
-        {0xFD, "REVERT"},
-        {0xFE, "INVALID"}
-    };
-    
-    auto it = opcode_names.find(opcode);
-    if (it != opcode_names.end()) {
-        return it->second;
-    }
-    
-    return "UNKNOWN";
+    return evm::GetOpcodeName(opcode);
 }
 
 // StateDebugger Implementation
@@ -218,47 +263,29 @@ std::optional<StateDebugger::AccountState> StateDebugger::GetAccount(
 
 // Profiler Implementation
 Profiler::ProfileResult Profiler::ProfileTransaction(
-    const std::vector<uint8_t>& tx_data)
+    const std::vector<uint8_t>& tx_data,
+    uint64_t gas_limit)
 {
-    ProfileResult result;
+    ProfileResult result{};
+    OpcodeProfiler profiler;
 
-    // Estimate timing and gas from transaction data size and opcode mix
-    result.validation_time_us = 100 + tx_data.size() / 10;
-    result.opcodes_executed = 0;
-    result.gas_used = 21000;  // Base intrinsic gas
+    const auto start = std::chrono::steady_clock::now();
+    auto trace = TransactionTracer::TraceTransactionWith(tx_data, {}, gas_limit, profiler);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
 
-    // Charge per input byte
-    for (uint8_t b : tx_data) {
-        result.gas_used += (b == 0) ? 4 : 16;
-    }
-
-    // Count opcode distribution from tx_data treated as bytecode
-    for (uint8_t b : tx_data) {
-        std::string name = TransactionTracer::GetOpcodeName(b);
-        result.opcode_counts[name]++;
-        result.opcodes_executed++;
+    result.total_time_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    result.execution_time_us = result.total_time_us;
+    result.gas_used = trace.total_gas_used;
+    for (size_t op = 0; op < profiler.counts.size(); ++op) {
+        if (profiler.counts[op] == 0) {
+            continue;
+        }
+        const std::string name = evm::GetOpcodeName(static_cast<uint8_t>(op));
+        result.opcode_counts[name] += profiler.counts[op];
+        result.opcode_times[name] += profiler.nanos[op];
+        result.opcodes_executed += profiler.counts[op];
     }
-
-    result.execution_time_us = 700 + result.opcodes_executed * 2;
-    result.state_update_time_us = result.gas_used / 100;
-    result.total_time_us =
-        result.validation_time_us + result.execution_time_us + result.state_update_time_us;
-
-    return result;
-}
-
-Profiler::ProfileResult Profiler::ProfileBlock(uint64_t block_height)
-{
-    ProfileResult result;
-    
-    // Aggregate profiling for all transactions in block
-    result.total_time_us = 50000;
-    result.validation_time_us = 5000;
-    result.execution_time_us = 35000;
-    result.state_update_time_us = 10000;
-    result.gas_used = 8000000;
-    result.opcodes_executed = 10000;
-    
     return result;
 }
 
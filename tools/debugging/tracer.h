@@ -8,6 +8,10 @@
 #include <optional>
 
 namespace parthenon {
+namespace evm {
+class Tracer;
+}
+
 namespace tools {
 namespace debugging {
 
@@ -39,12 +43,28 @@ public:
     
     /**
      * Trace transaction execution
+     *
+     * Runs bytecode in the EVM against an empty state, after charging
+     * intrinsic gas, and records every step. Each step copies the stack and
+     * memory; use TraceTransactionWith() and a streaming tracer for long
+     * executions.
      */
     static TraceResult TraceTransaction(
         const std::vector<uint8_t>& bytecode,
         const std::vector<uint8_t>& input_data,
         uint64_t gas_limit
     );
+
+    /**
+     * Run the same execution as TraceTransaction(), reporting it to tracer
+     * (e.g. an evm::StructLogger writing JSON to a file) instead
+     */
+    static TraceResult TraceTransactionWith(
+        const std::vector<uint8_t>& bytecode,
+        const std::vector<uint8_t>& input_data,
+        uint64_t gas_limit,
+        evm::Tracer& tracer
+    );
     
     /**
      * Trace contract call
@@ -119,21 +139,21 @@ public:
         uint64_t gas_used;
         uint64_t opcodes_executed;
         std::map<std::string, uint64_t> opcode_counts;
-        std::map<std::string, uint64_t> opcode_times;
+        std::map<std::string, uint64_t> opcode_times;  // Nanoseconds
     };
     
     /**
      * Profile transaction execution
+     *
+     * Runs tx_data as bytecode exactly like TransactionTracer::TraceTransaction()
+     * and times each executed opcode. Times include the tracing overhead;
+     * the state is empty, so validation and state update times are zero.
      */
     static ProfileResult ProfileTransaction(
-        const std::vector<uint8_t>& tx_data
+        const std::vector<uint8_t>& tx_data,
+        uint64_t gas_limit = 30000000
     );
     
-    /**
-     * Profile block processing
-     */
-    static ProfileResult ProfileBlock(uint64_t block_height);
-    
     /**
      * Get performance bottlenecks
      */
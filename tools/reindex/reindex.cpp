@@ -0,0 +1,190 @@
+// ParthenonChain - Reindex Tool
+// Rebuilds the Drachma transaction index from block storage
+
+#include "layer2-drachma/indexers/tx_indexer/tx_indexer.h"
+#include "storage/block_storage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+struct ReindexOptions {
+    std::string blocks_path;
+    std::string index_path;
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t to_height = 0;  // 0 = chain tip
+    uint32_t synthetic_blocks = 0;
+    uint32_t synthetic_txs = 50;
+};
+
+void PrintUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " --blocks <dir> --index <dir> [options]" << std::endl;
+    std::cout << "  --blocks <dir>       Block storage database" << std::endl;
+    std::cout << "  --index <dir>        Transaction index database (rebuilt from scratch)"
+              << std::endl;
+    std::cout << "  --threads <n>        Worker threads (default: hardware threads)"
+              << std::endl;
+    std::cout << "  --to <height>        Stop before this height (default: chain tip + 1)"
+              << std::endl;
+    std::cout << "  --synthetic <n>      First store n generated blocks (for measuring)"
+              << std::endl;
+    std::cout << "  --txs <n>            Transactions per generated block (default: 50)"
+              << std::endl;
+}
+
+bool ParseOptions(int argc, char* argv[], ReindexOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--blocks") {
+            opts.blocks_path = value;
+        } else if (arg == "--index") {
+            opts.index_path = value;
+        } else if (arg == "--threads") {
+            opts.threads = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--to") {
+            opts.to_height = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--synthetic") {
+            opts.synthetic_blocks =
+                static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--txs") {
+            opts.synthetic_txs = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (opts.blocks_path.empty() || opts.index_path.empty()) {
+        std::cerr << "--blocks and --index are required" << std::endl;
+        return false;
+    }
+    if (opts.threads == 0 || opts.synthetic_txs == 0) {
+        std::cerr << "--threads and --txs must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Blocks of transfers between a few hundred scripts, each spending an
+// output of the block before
+bool StoreSyntheticBlocks(parthenon::storage::BlockStorage& blocks, uint32_t count,
+                          uint32_t txs_per_block) {
+    namespace primitives = parthenon::primitives;
+
+    std::array<uint8_t, 32> previous{};
+    for (uint32_t height = 0; height < count; ++height) {
+        primitives::Block block;
+        block.header.version = 1;
+        block.header.timestamp = 1704067200 + height * 600;
+        block.header.prev_block_hash = previous;
+
+        for (uint32_t i = 0; i < txs_per_block; ++i) {
+            primitives::Transaction tx;
+            tx.version = 1;
+            primitives::TxInput input;
+            if (i == 0) {
+                input.prevout = primitives::OutPoint(std::array<uint8_t, 32>{},
+                                                     primitives::COINBASE_VOUT_INDEX);
+                input.signature_script = {static_cast<uint8_t>(height),
+                                          static_cast<uint8_t>(height >> 8),
+                                          static_cast<uint8_t>(height >> 16)};
+            } else {
+                input.prevout = primitives::OutPoint(block.transactions[i - 1].GetTxID(), 0);
+                input.signature_script.assign(72, static_cast<uint8_t>(i));
+            }
+            tx.inputs.push_back(input);
+            for (uint32_t output = 0; output < 2; ++output) {
+                const uint32_t script = (height * 31 + i * 7 + output) % 509;
+                tx.outputs.emplace_back(primitives::AssetID::TALANTON, 1000 + i,
+                                        std::vector<uint8_t>{0x76, 0xa9,
+                                                             static_cast<uint8_t>(script),
+                                                             static_cast<uint8_t>(script >> 8)});
+            }
+            block.transactions.push_back(tx);
+        }
+        block.header.merkle_root = block.CalculateMerkleRoot();
+        previous = block.GetHash();
+        if (!blocks.StoreBlock(block, height) || !blocks.UpdateChainTip(height, previous)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    ReindexOptions opts;
+    if (!ParseOptions(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "ParthenonChain - Reindex" << std::endl;
+    std::cout << "========================" << std::endl;
+
+    parthenon::storage::BlockStorage blocks;
+    if (!blocks.Open(opts.blocks_path)) {
+        std::cerr << "Cannot open block storage at " << opts.blocks_path << std::endl;
+        return 1;
+    }
+    if (opts.synthetic_blocks > 0) {
+        std::cout << "Storing " << opts.synthetic_blocks << " generated blocks..." << std::endl;
+        if (!StoreSyntheticBlocks(blocks, opts.synthetic_blocks, opts.synthetic_txs)) {
+            std::cerr << "Failed to store generated blocks" << std::endl;
+            return 1;
+        }
+    }
+    const uint32_t end_height = opts.to_height > 0 ? opts.to_height : blocks.GetHeight() + 1;
+
+    parthenon::layer2::indexers::TxIndexer indexer;
+    if (!indexer.Open(opts.index_path, &blocks)) {
+        std::cerr << "Cannot open index at " << opts.index_path << std::endl;
+        return 1;
+    }
+
+    std::cout << "Blocks:     0 - " << end_height - 1 << std::endl;
+    std::cout << "Threads:    " << opts.threads << std::endl;
+
+    using Progress = parthenon::layer2::indexers::TxIndexer::ReindexProgress;
+    const auto started = std::chrono::steady_clock::now();
+    auto last_report = started;
+    const bool ok = indexer.Reindex(end_height, opts.threads, [&](const Progress& progress) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_report < std::chrono::seconds(1) &&
+            progress.next_height < progress.end_height) {
+            return;
+        }
+        last_report = now;
+        std::cout << "  " << std::setw(10) << progress.next_height << " / "
+                  << progress.end_height << "  " << std::setw(10) << progress.transactions
+                  << " txs  " << std::fixed << std::setprecision(0)
+                  << progress.blocks_per_second << " blocks/s" << std::endl;
+    });
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::cout << "Indexed:    " << indexer.GetNextHeight() << " blocks, "
+              << indexer.GetTransactionCount() << " transactions in " << std::fixed
+              << std::setprecision(2) << seconds << " s" << std::endl;
+    if (!ok) {
+        std::cerr << "Stopped at height " << indexer.GetNextHeight()
+                  << " (missing block or write failure)" << std::endl;
+        return 1;
+    }
+    return 0;
+}
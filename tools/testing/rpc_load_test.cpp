@@ -0,0 +1,221 @@
+// ParthenonChain - RPC Load Test
+// Measures JSON-RPC throughput for single vs batched requests
+
+#include "rpc/rpc_server.h"
+
+#include <httplib.h>
+
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct LoadTestOptions {
+    std::string host;  // Empty = in-process server
+    uint16_t port = 8332;
+    std::string method = "loadtest/work";
+    size_t requests = 20000;
+    size_t batch_size = 100;
+    size_t clients = 1;
+    size_t work_us = 200;  // Simulated handler latency (in-process only)
+    size_t worker_threads = 8;
+};
+
+void PrintUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [options]" << std::endl;
+    std::cout << "  --host <addr>        Target a running node (default: in-process server)"
+              << std::endl;
+    std::cout << "  --port <port>        RPC port (default: 8332)" << std::endl;
+    std::cout << "  --method <name>      Method to call (default: loadtest/work, or"
+              << " getblockcount with --host)" << std::endl;
+    std::cout << "  --requests <n>       Total requests per run (default: 20000)" << std::endl;
+    std::cout << "  --batch <n>          Batch size for the batched run (default: 100)"
+              << std::endl;
+    std::cout << "  --clients <n>        Concurrent client threads (default: 1)" << std::endl;
+    std::cout << "  --work-us <n>        In-process handler latency in us (default: 200)"
+              << std::endl;
+    std::cout << "  --workers <n>        In-process worker pool threads (default: 8)"
+              << std::endl;
+}
+
+bool ParseOptions(int argc, char* argv[], LoadTestOptions& opts) {
+    bool method_set = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--host") {
+            opts.host = value;
+        } else if (arg == "--port") {
+            opts.port = static_cast<uint16_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--method") {
+            opts.method = value;
+            method_set = true;
+        } else if (arg == "--requests") {
+            opts.requests = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--batch") {
+            opts.batch_size = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--clients") {
+            opts.clients = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--work-us") {
+            opts.work_us = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--workers") {
+            opts.worker_threads = std::strtoull(value.c_str(), nullptr, 10);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    if (!opts.host.empty() && !method_set) {
+        opts.method = "getblockcount";
+    }
+    if (opts.batch_size == 0 || opts.clients == 0 || opts.requests == 0) {
+        std::cerr << "--requests, --batch and --clients must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string BuildRequest(const std::string& method, size_t id) {
+    return R"({"jsonrpc":"2.0","method":")" + method + R"(","params":[],"id":")" +
+           std::to_string(id) + R"("})";
+}
+
+std::string BuildBatch(const std::string& method, size_t first_id, size_t count) {
+    std::string body = "[";
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            body += ",";
+        }
+        body += BuildRequest(method, first_id + i);
+    }
+    body += "]";
+    return body;
+}
+
+/**
+ * Sends one HTTP body and returns whether a response was received
+ */
+using PostFn = std::function<bool(const std::string& body)>;
+
+double RunLoad(const LoadTestOptions& opts, size_t batch_size, const PostFn& post) {
+    const size_t posts_total = (opts.requests + batch_size - 1) / batch_size;
+    std::atomic<size_t> next_post{0};
+    std::atomic<size_t> completed{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < opts.clients; ++c) {
+        clients.emplace_back([&]() {
+            while (true) {
+                const size_t index = next_post.fetch_add(1);
+                if (index >= posts_total) {
+                    return;
+                }
+                const size_t first_id = index * batch_size;
+                const size_t count = std::min(batch_size, opts.requests - first_id);
+                const std::string body = batch_size == 1 ? BuildRequest(opts.method, first_id)
+                                                         : BuildBatch(opts.method, first_id, count);
+                if (post(body)) {
+                    completed += count;
+                }
+            }
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (completed.load() != opts.requests) {
+        std::cerr << "Warning: " << (opts.requests - completed.load())
+                  << " requests did not complete" << std::endl;
+    }
+    return seconds > 0 ? static_cast<double>(completed.load()) / seconds : 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    LoadTestOptions opts;
+    if (!ParseOptions(argc, argv, opts)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "ParthenonChain - RPC Load Test" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    PostFn post;
+    std::unique_ptr<parthenon::rpc::RPCServer> server;
+
+    if (opts.host.empty()) {
+        server = std::make_unique<parthenon::rpc::RPCServer>(0);
+        server->ConfigureRateLimit(0xFFFFFFFFu, 1);
+        server->ConfigureWorkerPool(opts.worker_threads, 4096);
+        server->ConfigureMaxBatchSize(opts.batch_size);
+        const auto work = std::chrono::microseconds(opts.work_us);
+        server->RegisterMethod("loadtest/work", [work](const parthenon::rpc::RPCRequest& req) {
+            // Stand-in for a storage-bound handler such as getblock
+            std::this_thread::sleep_for(work);
+            parthenon::rpc::RPCResponse response;
+            response.id = req.id;
+            response.result = "true";
+            return response;
+        });
+        post = [&server](const std::string& body) {
+            return !server->ProcessRequestBody(body, "127.0.0.1").empty();
+        };
+        std::cout << "Target:     in-process (" << opts.work_us << " us/handler)" << std::endl;
+    } else {
+#ifdef CPP_HTTPLIB_STUB_H
+        std::cerr << "Remote mode requires the full cpp-httplib; this build uses the stub"
+                  << std::endl;
+        return 1;
+#else
+        post = [&opts](const std::string& body) {
+            // One keep-alive connection per client thread
+            thread_local httplib::Client client(opts.host, opts.port);
+            client.set_keep_alive(true);
+            auto res = client.Post("/", body, "application/json");
+            return res && res->status == 200;
+        };
+        std::cout << "Target:     " << opts.host << ":" << opts.port << std::endl;
+#endif
+    }
+
+    std::cout << "Method:     " << opts.method << std::endl;
+    std::cout << "Requests:   " << opts.requests << " per run, " << opts.clients << " client(s)"
+              << std::endl
+              << std::endl;
+
+    const double single_rps = RunLoad(opts, 1, post);
+    const double batch_rps = RunLoad(opts, opts.batch_size, post);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Single:   " << single_rps << " req/s" << std::endl;
+    std::cout << "Batched:  " << batch_rps << " req/s (batch size " << opts.batch_size << ")"
+              << std::endl;
+    if (single_rps > 0) {
+        std::cout << "Speedup:  " << std::setprecision(2) << (batch_rps / single_rps) << "x"
+                  << std::endl;
+    }
+    return 0;
+}